@@ -256,15 +256,20 @@ boost::shared_ptr<AbstractCellMutationState> Cell::GetMutationState() const
 
 boost::shared_ptr<CellData> Cell::GetCellData() const
 {
-    CellPropertyCollection cell_data_collection = mCellPropertyCollection.GetPropertiesType<CellData>();
+    // The CellData is only searched for again if it has been removed from the collection
+    if (!mpCellData || !mCellPropertyCollection.HasProperty(mpCellData))
+    {
+        CellPropertyCollection cell_data_collection = mCellPropertyCollection.GetPropertiesType<CellData>();
 
-    /*
-     * Note: In its current form the code requires each cell to have exactly
-     * one CellData object. This is reflected in the assertion below.
-     */
-    assert(cell_data_collection.GetSize() <= 1);
+        /*
+         * Note: In its current form the code requires each cell to have exactly
+         * one CellData object. This is reflected in the assertion below.
+         */
+        assert(cell_data_collection.GetSize() <= 1);
 
-    return boost::static_pointer_cast<CellData>(cell_data_collection.GetProperty());
+        mpCellData = boost::static_pointer_cast<CellData>(cell_data_collection.GetProperty());
+    }
+    return mpCellData;
 }
 
 bool Cell::HasCellVecData() const
@@ -148,6 +148,12 @@ protected:
     /** Whether the cell is being tracked specially. */
     bool mIsLogged;
 
+    /**
+     * The CellData last found in the property collection by GetCellData(), to save searching
+     * the collection on every call. It is not archived.
+     */
+    mutable boost::shared_ptr<CellData> mpCellData;
+
 public:
 
     /**
@@ -108,6 +108,11 @@ unsigned AbstractCellCycleModel::GetDimension() const
     return mDimension;
 }
 
+bool AbstractCellCycleModel::CanUpdateConcurrently()
+{
+    return false;
+}
+
 bool AbstractCellCycleModel::CanCellTerminallyDifferentiate()
 {
     return true;
@@ -232,6 +232,16 @@ public:
      */
     virtual bool ReadyToDivide()=0;
 
+    /**
+     * @return whether ReadyToDivide() may be called for different cells at the same time,
+     * on different threads. This requires it to modify only this model and its cell, and to
+     * draw any random numbers it needs from a RandomNumberStream (for example one keyed by
+     * the cell id and time step) rather than from the RandomNumberGenerator singleton.
+     *
+     * Defaults to false; models for which this holds may override this method.
+     */
+    virtual bool CanUpdateConcurrently();
+
     /**
      * Each cell-cycle model must be able to be reset 'after' a cell division.
      *
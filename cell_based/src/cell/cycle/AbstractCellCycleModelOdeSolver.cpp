@@ -35,6 +35,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCellCycleModelOdeSolver.hpp"
 #include "CvodeAdaptor.hpp"
+#include "OpenMpTools.hpp"
 
 AbstractCellCycleModelOdeSolver::AbstractCellCycleModelOdeSolver()
     : mSizeOfOdeSystem(UNSIGNED_UNSET)
@@ -51,19 +52,69 @@ void AbstractCellCycleModelOdeSolver::SolveAndUpdateStateVariable(AbstractOdeSys
                                                                   double timeStep)
 {
     assert(IsSetUp());
-    mpOdeSolver->SolveAndUpdateStateVariable(pAbstractOdeSystem, startTime, endTime, timeStep);
+    GetOdeSolverForThisThread()->SolveAndUpdateStateVariable(pAbstractOdeSystem, startTime, endTime, timeStep);
 }
 
 bool AbstractCellCycleModelOdeSolver::StoppingEventOccurred()
 {
     assert(IsSetUp());
-    return mpOdeSolver->StoppingEventOccurred();
+    return GetOdeSolverForThisThread()->StoppingEventOccurred();
 }
 
 double AbstractCellCycleModelOdeSolver::GetStoppingTime()
 {
     assert(IsSetUp());
-    return mpOdeSolver->GetStoppingTime();
+    return GetOdeSolverForThisThread()->GetStoppingTime();
+}
+
+AbstractIvpOdeSolver* AbstractCellCycleModelOdeSolver::GetOdeSolverForThisThread()
+{
+    const unsigned thread = OpenMpTools::GetThreadNum();
+    if (thread == 0)
+    {
+        return mpOdeSolver.get();
+    }
+
+    // Other threads share mThreadOdeSolvers, which may grow as they first use this solver
+    AbstractIvpOdeSolver* p_solver;
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCellCycleModelOdeSolver_ThreadOdeSolvers)
+#endif // CHASTE_OPENMP
+    {
+        if (thread >= mThreadOdeSolvers.size())
+        {
+            mThreadOdeSolvers.resize(thread + 1);
+        }
+        if (!mThreadOdeSolvers[thread])
+        {
+            mThreadOdeSolvers[thread] = CreateOdeSolverForThread();
+        }
+        p_solver = mThreadOdeSolvers[thread].get();
+    }
+    return p_solver;
+}
+
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::CreateOdeSolverForThread()
+{
+    boost::shared_ptr<AbstractIvpOdeSolver> p_solver = CreateOdeSolver();
+#ifdef CHASTE_CVODE
+    // Give the copy the settings of the master thread's solver
+    boost::shared_ptr<CvodeAdaptor> p_master_cvode = boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver);
+    if (p_master_cvode)
+    {
+        boost::shared_ptr<CvodeAdaptor> p_cvode = boost::static_pointer_cast<CvodeAdaptor>(p_solver);
+        p_cvode->SetTolerances(p_master_cvode->GetRelativeTolerance(), p_master_cvode->GetAbsoluteTolerance());
+        p_cvode->SetMaxSteps(p_master_cvode->GetMaxSteps());
+        if (p_master_cvode->GetCheckForStoppingEvents())
+        {
+            p_cvode->CheckForStoppingEvents();
+        }
+
+        // As in Initialise(), the solver is shared between cells so must not reuse CVODE's internal state
+        p_cvode->SetForceReset(true);
+    }
+#endif //CHASTE_CVODE
+    return p_solver;
 }
 
 void AbstractCellCycleModelOdeSolver::SetSizeOfOdeSystem(unsigned sizeOfOdeSystem)
@@ -83,6 +134,13 @@ void AbstractCellCycleModelOdeSolver::CheckForStoppingEvents()
     if (boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver))
     {
         (boost::static_pointer_cast<CvodeAdaptor>(mpOdeSolver))->CheckForStoppingEvents();
+        for (unsigned thread=0; thread<mThreadOdeSolvers.size(); thread++)
+        {
+            if (mThreadOdeSolvers[thread])
+            {
+                (boost::static_pointer_cast<CvodeAdaptor>(mThreadOdeSolvers[thread]))->CheckForStoppingEvents();
+            }
+        }
     }
 #endif //CHASTE_CVODE
 }
@@ -94,6 +152,13 @@ void AbstractCellCycleModelOdeSolver::SetMaxSteps(long int numSteps)
     if (boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver))
     {
         (boost::static_pointer_cast<CvodeAdaptor>(mpOdeSolver))->SetMaxSteps(numSteps);
+        for (unsigned thread=0; thread<mThreadOdeSolvers.size(); thread++)
+        {
+            if (mThreadOdeSolvers[thread])
+            {
+                (boost::static_pointer_cast<CvodeAdaptor>(mThreadOdeSolvers[thread]))->SetMaxSteps(numSteps);
+            }
+        }
     }
 #endif //CHASTE_CVODE
 }
@@ -105,6 +170,13 @@ void AbstractCellCycleModelOdeSolver::SetTolerances(double relTol, double absTol
     if (boost::dynamic_pointer_cast<CvodeAdaptor>(mpOdeSolver))
     {
         (boost::static_pointer_cast<CvodeAdaptor>(mpOdeSolver))->SetTolerances(relTol, absTol);
+        for (unsigned thread=0; thread<mThreadOdeSolvers.size(); thread++)
+        {
+            if (mThreadOdeSolvers[thread])
+            {
+                (boost::static_pointer_cast<CvodeAdaptor>(mThreadOdeSolvers[thread]))->SetTolerances(relTol, absTol);
+            }
+        }
     }
 #endif //CHASTE_CVODE
 }
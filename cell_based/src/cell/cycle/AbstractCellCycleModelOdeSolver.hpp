@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 #include "AbstractIvpOdeSolver.hpp"
 
@@ -59,6 +60,7 @@ private:
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
+    friend class TestCellCycleModelOdeSolver;
     /**
      * Archive the object and its the member variables.
      *
@@ -80,6 +82,35 @@ protected:
     /** The size of the ODE system to be solved. */
     unsigned mSizeOfOdeSystem;
 
+    /**
+     * Copies of the ODE solver for threads other than the master thread of a parallel
+     * region, indexed by thread number and created when first needed, so that cells
+     * sharing this solver may be updated concurrently. Not archived.
+     */
+    std::vector<boost::shared_ptr<AbstractIvpOdeSolver> > mThreadOdeSolvers;
+
+    /**
+     * @return a new ODE solver of the type used by this class.
+     *
+     * As this method is pure virtual, it must be overridden
+     * in subclasses.
+     */
+    virtual boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolver()=0;
+
+    /**
+     * @return the ODE solver to be used by the calling thread: mpOdeSolver outside
+     * a parallel region or on the master thread, and otherwise this thread's entry
+     * of mThreadOdeSolvers.
+     */
+    AbstractIvpOdeSolver* GetOdeSolverForThisThread();
+
+    /**
+     * @return a new ODE solver for a thread other than the master thread, with the same
+     * settings as mpOdeSolver (for CVODE, the tolerances, maximum number of steps and
+     * whether to check for stopping events).
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolverForThread();
+
 public:
 
     /**
@@ -109,7 +140,7 @@ public:
     virtual void Reset()=0;
 
     /**
-     * Call mpOdeSolver->SolveAndUpdateStateVariable.
+     * Call SolveAndUpdateStateVariable on the ODE solver for the calling thread.
      *
      * @param pAbstractOdeSystem  pointer to the concrete ODE system to be solved
      * @param startTime  the time at which the initial conditions are specified
@@ -137,7 +168,7 @@ public:
     bool StoppingEventOccurred();
 
     /**
-     * Call mpOdeSolver->GetStoppingTime.
+     * Call GetStoppingTime on the ODE solver for the calling thread.
      *
      * @return mStoppingTime.
      */
@@ -186,6 +217,7 @@ public:
      * The base class version just returns true iff the solver is the CvodeAdaptor class.
      */
     virtual bool IsAdaptive();
+
 };
 
 #endif /*ABSTRACTCELLCYCLEMODELODESOLVER_HPP_*/
@@ -104,14 +104,21 @@ void Alarcon2004OxygenBasedCellCycleModel::Initialise()
 
 void Alarcon2004OxygenBasedCellCycleModel::AdjustOdeParameters(double currentTime)
 {
-    // Pass this time step's oxygen concentration into the solver as a constant over this time step
-    mpOdeSystem->rGetStateVariables()[5] = mpCell->GetCellData()->GetItem("oxygen");
+    // Pass this time step's oxygen concentration into the solver as a constant over this time step,
+    // looking up its index in CellData only once
+    static const unsigned oxygen_index = CellDataRegistry::Instance()->GetIndex("oxygen");
+    mpOdeSystem->rGetStateVariables()[5] = mpCell->GetCellData()->GetItem(oxygen_index);
 
     // Use whether the cell is currently labelled as another input
     bool is_labelled = mpCell->HasCellProperty<CellLabel>();
     static_cast<Alarcon2004OxygenBasedCellCycleOdeSystem*>(mpOdeSystem)->SetIsLabelled(is_labelled);
 }
 
+bool Alarcon2004OxygenBasedCellCycleModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void Alarcon2004OxygenBasedCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
@@ -126,6 +126,14 @@ public:
      */
     void Initialise();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since updating the cell-cycle phase only reads the oxygen concentration from the
+     * cell's CellData and solves the ODEs of this cell.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Overridden OutputCellCycleModelParameters() method.
      *
@@ -79,6 +79,11 @@ private:
         archive & mpInstance;
     }
 
+protected:
+
+    /** @return a new ODE_SOLVER. */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolver();
+
 public:
     /** @return a pointer to the singleton instance, creating it if necessary. */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > Instance();
@@ -130,6 +135,12 @@ boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > CellCy
     return mpInstance;
 }
 
+template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
+boost::shared_ptr<AbstractIvpOdeSolver> CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::CreateOdeSolver()
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new ODE_SOLVER);
+}
+
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
 bool CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::IsSetUp()
 {
@@ -139,7 +150,8 @@ bool CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::IsSetUp()
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
 void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::Initialise()
 {
-    mpOdeSolver.reset(new ODE_SOLVER);
+    mpOdeSolver = CreateOdeSolver();
+    mThreadOdeSolvers.clear();
     // If this is a CVODE solver we need to tell it to reset. Otherwise
     // the fact this is a singleton will lead to all sorts of problems
     // as CVODE will have the internal state for the wrong ODE system!
@@ -192,6 +204,11 @@ private:
         archive & mpInstance;
     }
 
+protected:
+
+    /** @return a new BackwardEulerIvpOdeSolver for an ODE system of size mSizeOfOdeSystem. */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateOdeSolver();
+
 public:
     /** @return a pointer to the singleton instance, creating it if necessary. */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> > Instance();
@@ -225,6 +242,12 @@ boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeS
     return mpInstance;
 }
 
+template<class CELL_CYCLE_MODEL>
+boost::shared_ptr<AbstractIvpOdeSolver> CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::CreateOdeSolver()
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
+}
+
 template<class CELL_CYCLE_MODEL>
 bool CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::IsSetUp()
 {
@@ -238,7 +261,8 @@ void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Initi
     {
         EXCEPTION("SetSizeOfOdeSystem() must be called before calling Initialise()");
     }
-    mpOdeSolver.reset(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
+    mpOdeSolver = CreateOdeSolver();
+    mThreadOdeSolvers.clear();
 }
 
 template<class CELL_CYCLE_MODEL>
@@ -246,6 +270,7 @@ void CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Reset
 {
     mSizeOfOdeSystem = UNSIGNED_UNSET;
     mpOdeSolver.reset();
+    mThreadOdeSolvers.clear();
 }
 
 #endif /*CELLCYCLEMODELODESOLVER_HPP_*/
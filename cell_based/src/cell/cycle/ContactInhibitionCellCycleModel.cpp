@@ -76,8 +76,9 @@ void ContactInhibitionCellCycleModel::UpdateCellCyclePhase()
         EXCEPTION("The member variables mQuiescentVolumeFraction and mEquilibriumVolume have not yet been set.");
     }
 
-    // Get cell volume
-    double cell_volume = mpCell->GetCellData()->GetItem("volume");
+    // Get cell volume, looking up its index in CellData only once
+    static const unsigned volume_index = CellDataRegistry::Instance()->GetIndex("volume");
+    double cell_volume = mpCell->GetCellData()->GetItem(volume_index);
 
     // Removes the cell label
     mpCell->RemoveCellProperty<CellLabel>();
@@ -45,6 +45,11 @@ bool NoCellCycleModel::ReadyToDivide()
     return false;
 }
 
+bool NoCellCycleModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 // LCOV_EXCL_START
 AbstractCellCycleModel* NoCellCycleModel::CreateCellCycleModel()
 {
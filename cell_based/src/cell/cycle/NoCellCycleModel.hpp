@@ -76,6 +76,13 @@ public:
      */
     bool ReadyToDivide();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Overridden builder method to create new copies of
      * this cell-cycle model.
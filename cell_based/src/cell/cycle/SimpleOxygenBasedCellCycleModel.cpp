@@ -66,8 +66,9 @@ void SimpleOxygenBasedCellCycleModel::UpdateCellCyclePhase()
     {
         UpdateHypoxicDuration();
 
-        // Get cell's oxygen concentration
-        double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+        // Get cell's oxygen concentration, looking up its index in CellData only once
+        static const unsigned oxygen_index = CellDataRegistry::Instance()->GetIndex("oxygen");
+        double oxygen_concentration = mpCell->GetCellData()->GetItem(oxygen_index);
 
         AbstractSimplePhaseBasedCellCycleModel::UpdateCellCyclePhase();
 
@@ -118,8 +119,9 @@ void SimpleOxygenBasedCellCycleModel::UpdateHypoxicDuration()
     assert(!(mpCell->HasCellProperty<ApoptoticCellProperty>()));
     assert(!mpCell->HasApoptosisBegun());
 
-    // Get cell's oxygen concentration
-    double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+    // Get cell's oxygen concentration, looking up its index in CellData only once
+    static const unsigned oxygen_index = CellDataRegistry::Instance()->GetIndex("oxygen");
+    double oxygen_concentration = mpCell->GetCellData()->GetItem(oxygen_index);
 
     if (oxygen_concentration < mHypoxicConcentration)
     {
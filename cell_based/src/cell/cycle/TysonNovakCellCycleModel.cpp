@@ -153,6 +153,11 @@ bool TysonNovakCellCycleModel::CanCellTerminallyDifferentiate()
     return false;
 }
 
+bool TysonNovakCellCycleModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void TysonNovakCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
@@ -144,6 +144,13 @@ public:
      */
     bool CanCellTerminallyDifferentiate();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since ReadyToDivide() only solves the ODEs of this cell, and each thread has its own copy of the ODE solver.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Overridden OutputCellCycleModelParameters() method.
      *
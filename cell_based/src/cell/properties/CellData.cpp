@@ -33,50 +33,99 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
+
 #include "CellData.hpp"
 
+CellData::CellData()
+    : mNumItems(0)
+{
+}
+
 CellData::~CellData()
 {
 }
 
 void CellData::SetItem(const std::string& rVariableName, double data)
 {
-    mCellData[rVariableName] = data;
+    SetItem(CellDataRegistry::Instance()->GetIndex(rVariableName), data);
 }
 
 double CellData::GetItem(const std::string& rVariableName) const
 {
-    /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
-     */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
+    // Looking up an item doesn't register its name
+    unsigned index = CellDataRegistry::Instance()->FindIndex(rVariableName);
+    if (!HasItem(index))
     {
         EXCEPTION("The item " << rVariableName << " is not stored");
     }
-    return(it->second);
+    return mValues[index];
+}
+
+void CellData::SetItem(unsigned index, double data)
+{
+    if (index >= mValues.size())
+    {
+        mValues.resize(index + 1, 0.0);
+        mIsStored.resize(index + 1, false);
+    }
+    if (!mIsStored[index])
+    {
+        mIsStored[index] = true;
+        mNumItems++;
+    }
+    mValues[index] = data;
+}
+
+double CellData::GetItem(unsigned index) const
+{
+    if (!HasItem(index))
+    {
+        EXCEPTION("The item " << CellDataRegistry::Instance()->rGetName(index) << " is not stored");
+    }
+    return mValues[index];
+}
+
+bool CellData::HasItem(unsigned index) const
+{
+    return (index < mIsStored.size()) && mIsStored[index];
 }
 
 unsigned CellData::GetNumItems() const
 {
-    return mCellData.size();
+    return mNumItems;
 }
 
 std::vector<std::string> CellData::GetKeys() const
 {
     std::vector<std::string> keys;
-    for (std::map<std::string, double>::const_iterator it = mCellData.begin(); it != mCellData.end(); ++it)
+    keys.reserve(mNumItems);
+    for (unsigned index=0; index<mIsStored.size(); index++)
     {
-        keys.push_back(it->first);
+        if (mIsStored[index])
+        {
+            keys.push_back(CellDataRegistry::Instance()->rGetName(index));
+        }
     }
+    std::sort(keys.begin(), keys.end());
 
-    // From STL documentation we assume that the iterator is returning sorted keys sort(keys.begin(), keys.end());
     return keys;
 }
 
+std::vector<unsigned> CellData::GetIndices() const
+{
+    std::vector<unsigned> indices;
+    indices.reserve(mNumItems);
+    for (unsigned index=0; index<mIsStored.size(); index++)
+    {
+        if (mIsStored[index])
+        {
+            indices.push_back(index);
+        }
+    }
+    return indices;
+}
+
 #include "SerializationExportWrapperForCpp.hpp"
 // Declare identifier for the serializer
 CHASTE_CLASS_EXPORT(CellData)
@@ -45,7 +45,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
 #include "Exception.hpp"
+#include "CellDataRegistry.hpp"
 
 /**
  * CellData class.
@@ -56,18 +58,54 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Within the Cell constructor, an empty CellData object is created and passed to the Cell
  * (unless there is already a CellData object present in mCellPropertyCollection).
+ *
+ * The values are stored in a flat array indexed by the item's index in the CellDataRegistry.
+ * Items may be accessed by name, or more quickly by index: code that accesses an item for
+ * every cell should look up its index once with CellDataRegistry::Instance()->GetIndex().
  */
 class CellData : public AbstractCellProperty
 {
 private:
 
     /**
-     * The cell data.
+     * The value of each item, indexed by its index in the CellDataRegistry.
+     */
+    std::vector<double> mValues;
+
+    /**
+     * Whether each item is stored, indexed as mValues.
+     */
+    std::vector<bool> mIsStored;
+
+    /**
+     * The number of items stored.
      */
-    std::map<std::string, double> mCellData;
+    unsigned mNumItems;
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
+    /**
+     * Archive the member variables. The items are archived by name, as in a
+     * std::map<std::string, double>, since their indices depend on the run.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void save(Archive & archive, const unsigned int version) const
+    {
+        archive & boost::serialization::base_object<AbstractCellProperty>(*this);
+        std::map<std::string, double> cell_data;
+        for (unsigned index=0; index<mValues.size(); index++)
+        {
+            if (mIsStored[index])
+            {
+                cell_data[CellDataRegistry::Instance()->rGetName(index)] = mValues[index];
+            }
+        }
+        archive & cell_data;
+    }
+
     /**
      * Archive the member variables.
      *
@@ -75,14 +113,25 @@ private:
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void load(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellProperty>(*this);
-        archive & mCellData;
+        std::map<std::string, double> cell_data;
+        archive & cell_data;
+        for (std::map<std::string, double>::iterator it = cell_data.begin(); it != cell_data.end(); ++it)
+        {
+            SetItem(it->first, it->second);
+        }
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 public:
 
+    /**
+     * Default constructor.
+     */
+    CellData();
+
     /**
      * We need the empty virtual destructor in this class to ensure Boost
      * serialization works correctly with static libraries.
@@ -90,7 +139,7 @@ public:
     virtual ~CellData();
 
     /**
-     * This assigns the cell data.
+     * This assigns the cell data. Looking up the name is slower than using SetItem(unsigned, double).
      *
      * @param rVariableName the name of the data to be set.
      * @param data the value to set it to.
@@ -98,13 +147,36 @@ public:
     void SetItem(const std::string& rVariableName, double data);
 
     /**
-     * @return data.
+     * @return data. Looking up the name is slower than using GetItem(unsigned).
      *
-     * @param rVariableName the index of the data required.
+     * @param rVariableName the name of the data required.
      * throws if rVariableName has not been stored
      */
     double GetItem(const std::string& rVariableName) const;
 
+    /**
+     * This assigns the cell data.
+     *
+     * @param index the index of the data in the CellDataRegistry.
+     * @param data the value to set it to.
+     */
+    void SetItem(unsigned index, double data);
+
+    /**
+     * @return data.
+     *
+     * @param index the index of the data in the CellDataRegistry.
+     * throws if the item has not been stored
+     */
+    double GetItem(unsigned index) const;
+
+    /**
+     * @return whether an item is stored.
+     *
+     * @param index the index of the data in the CellDataRegistry.
+     */
+    bool HasItem(unsigned index) const;
+
     /**
      * @return number of data items
      */
@@ -113,9 +185,15 @@ public:
     /**
      * @return all keys.
      *
-     * According to STL these are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
+     * These are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
      */
     std::vector<std::string> GetKeys() const;
+
+    /**
+     * @return the indices in the CellDataRegistry of all stored items, in increasing order.
+     * Unlike GetKeys(), this doesn't look up or sort any names.
+     */
+    std::vector<unsigned> GetIndices() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -0,0 +1,121 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "CellDataRegistry.hpp"
+
+#include <cassert>
+
+#include "Exception.hpp"
+
+CellDataRegistry* CellDataRegistry::mpInstance = nullptr;
+
+CellDataRegistry* CellDataRegistry::Instance()
+{
+    if (mpInstance == nullptr)
+    {
+        mpInstance = new CellDataRegistry;
+    }
+    return mpInstance;
+}
+
+CellDataRegistry::CellDataRegistry()
+{
+}
+
+unsigned CellDataRegistry::GetIndex(const std::string& rName)
+{
+    unsigned index;
+
+    // Cell-cycle and SRN models may look up items by name while being updated concurrently
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellDataRegistry_GetIndex)
+#endif // CHASTE_OPENMP
+    {
+        std::map<std::string, unsigned>::iterator it = mIndices.find(rName);
+        if (it == mIndices.end())
+        {
+            it = mIndices.insert(std::make_pair(rName, mNames.size())).first;
+            mNames.push_back(rName);
+        }
+        index = it->second;
+    }
+    return index;
+}
+
+unsigned CellDataRegistry::FindIndex(const std::string& rName) const
+{
+    unsigned index = UNSIGNED_UNSET;
+
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellDataRegistry_GetIndex)
+#endif // CHASTE_OPENMP
+    {
+        std::map<std::string, unsigned>::const_iterator it = mIndices.find(rName);
+        if (it != mIndices.end())
+        {
+            index = it->second;
+        }
+    }
+    return index;
+}
+
+const std::string& CellDataRegistry::rGetName(unsigned index) const
+{
+    const std::string* p_name;
+
+    // Another thread may be registering a name in GetIndex()
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellDataRegistry_GetIndex)
+#endif // CHASTE_OPENMP
+    {
+        assert(index < mNames.size());
+        p_name = &(mNames[index]);
+    }
+    return *p_name;
+}
+
+unsigned CellDataRegistry::GetNumNames() const
+{
+    unsigned num_names;
+
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellDataRegistry_GetIndex)
+#endif // CHASTE_OPENMP
+    {
+        num_names = mNames.size();
+    }
+    return num_names;
+}
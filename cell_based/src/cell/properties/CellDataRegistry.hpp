@@ -0,0 +1,128 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef CELLDATAREGISTRY_HPP_
+#define CELLDATAREGISTRY_HPP_
+
+#include <deque>
+#include <map>
+#include <string>
+
+/**
+ * A singleton registry of the names of CellData items.
+ *
+ * Each name is given a small integer index the first time it is seen, and keeps
+ * it for the rest of the program. CellData stores the value of each item at its
+ * index, so code which reads or writes an item for every cell should look up
+ * its index once and use CellData::GetItem(unsigned) and CellData::SetItem(unsigned, double).
+ *
+ * Indices depend on the order in which names are registered, so may differ
+ * between processes and runs; they are never archived or communicated.
+ */
+class CellDataRegistry
+{
+public:
+
+    /**
+     * @return the single instance of the registry.
+     */
+    static CellDataRegistry* Instance();
+
+    /**
+     * @return the index of a CellData item, registering its name if necessary.
+     * Use this to set an item, or to keep an index for items that may not have
+     * been stored by any cell yet.
+     *
+     * @param rName the name of the item
+     */
+    unsigned GetIndex(const std::string& rName);
+
+    /**
+     * @return the index of a CellData item, or UNSIGNED_UNSET if its name has
+     * not been registered, in which case no cell stores it. Unlike GetIndex(),
+     * this never registers the name.
+     *
+     * @param rName the name of the item
+     */
+    unsigned FindIndex(const std::string& rName) const;
+
+    /**
+     * @return the name of a CellData item. The reference remains valid as more
+     * names are registered.
+     *
+     * @param index the index of the item
+     */
+    const std::string& rGetName(unsigned index) const;
+
+    /**
+     * @return the number of names registered.
+     */
+    unsigned GetNumNames() const;
+
+private:
+
+    /**
+     * Default constructor.
+     */
+    CellDataRegistry();
+
+    /**
+     * Copy constructor.
+     */
+    CellDataRegistry(const CellDataRegistry&);
+
+    /**
+     * Overloaded assignment operator.
+     * @return reference by convention
+     */
+    CellDataRegistry& operator= (const CellDataRegistry&);
+
+    /**
+     * A pointer to the singleton instance of this class.
+     */
+    static CellDataRegistry* mpInstance;
+
+    /** The index of each registered name. */
+    std::map<std::string, unsigned> mIndices;
+
+    /**
+     * The registered names, in order of their indices. A deque, so that registering
+     * a name doesn't move those already registered.
+     */
+    std::deque<std::string> mNames;
+};
+
+#endif /* CELLDATAREGISTRY_HPP_ */
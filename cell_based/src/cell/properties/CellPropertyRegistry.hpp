@@ -153,19 +153,26 @@ template<class SUBCLASS>
 boost::shared_ptr<AbstractCellProperty> CellPropertyRegistry::Get()
 {
     boost::shared_ptr<AbstractCellProperty> p_property;
-    for (unsigned i=0; i<mCellProperties.size(); i++)
+
+    // Cell-cycle models may change the properties of their cells while being updated concurrently
+#ifdef CHASTE_OPENMP
+#pragma omp critical(CellPropertyRegistry_Get)
+#endif // CHASTE_OPENMP
     {
-        if (mCellProperties[i]->IsType<SUBCLASS>())
+        for (unsigned i=0; i<mCellProperties.size(); i++)
         {
-            p_property = mCellProperties[i];
-            break;
+            if (mCellProperties[i]->IsType<SUBCLASS>())
+            {
+                p_property = mCellProperties[i];
+                break;
+            }
+        }
+        if (!p_property)
+        {
+            // Create a new cell property
+            p_property.reset(new SUBCLASS);
+            mCellProperties.push_back(p_property);
         }
-    }
-    if (!p_property)
-    {
-        // Create a new cell property
-        p_property.reset(new SUBCLASS);
-        mCellProperties.push_back(p_property);
     }
     return p_property;
 }
@@ -78,6 +78,11 @@ void AbstractSrnModel::ResetForDivision()
     assert(mSimulatedToTime == SimulationTime::Instance()->GetTime());
 }
 
+bool AbstractSrnModel::CanUpdateConcurrently()
+{
+    return false;
+}
+
 void AbstractSrnModel::SetCell(CellPtr pCell)
 {
     mpCell = pCell;
@@ -201,6 +201,16 @@ public:
      */
     virtual void ResetForDivision();
 
+    /**
+     * @return whether SimulateToCurrentTime() may be called for different cells at the
+     * same time, on different threads. This requires it to modify only this model and its
+     * cell, and to draw any random numbers it needs from a RandomNumberStream rather than
+     * from the RandomNumberGenerator singleton.
+     *
+     * Defaults to false; models for which this holds may override this method.
+     */
+    virtual bool CanUpdateConcurrently();
+
     /**
      * Builder method to create new instances of the SRN model.
      *
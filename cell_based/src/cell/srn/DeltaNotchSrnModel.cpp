@@ -124,6 +124,11 @@ double DeltaNotchSrnModel::GetMeanNeighbouringDelta()
     return mean_neighbouring_delta;
 }
 
+bool DeltaNotchSrnModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void DeltaNotchSrnModel::OutputSrnModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
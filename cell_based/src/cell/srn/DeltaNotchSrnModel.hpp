@@ -140,6 +140,14 @@ public:
      */
     double GetMeanNeighbouringDelta();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since the mean neighbouring delta is read from this cell's CellData, which is
+     * only written outside the cell-cycle update.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Output SRN model parameters to file.
      *
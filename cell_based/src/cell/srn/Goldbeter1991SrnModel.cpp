@@ -86,6 +86,11 @@ void Goldbeter1991SrnModel::Initialise()
     AbstractOdeSrnModel::Initialise(new Goldbeter1991OdeSystem);
 }
 
+bool Goldbeter1991SrnModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void Goldbeter1991SrnModel::OutputSrnModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
@@ -112,6 +112,13 @@ public:
      */
     void SimulateToCurrentTime();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since SimulateToCurrentTime() only solves the ODEs of this cell.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Output SRN model parameters to file.
      *
@@ -52,6 +52,11 @@ void NullSrnModel::SimulateToCurrentTime()
     SetSimulatedToTime(current_time);
 }
 
+bool NullSrnModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 
 NullSrnModel::NullSrnModel(const NullSrnModel& rModel)
     : AbstractSrnModel(rModel)
@@ -104,6 +104,13 @@ public:
      */
     void SimulateToCurrentTime();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true
+     */
+    bool CanUpdateConcurrently();
+
     /*
      * Overridden CreateSrnModel() method.
      *
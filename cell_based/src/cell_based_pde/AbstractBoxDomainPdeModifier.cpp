@@ -50,7 +50,8 @@ AbstractBoxDomainPdeModifier<DIM>::AbstractBoxDomainPdeModifier(boost::shared_pt
                                solution),
       mpMeshCuboid(pMeshCuboid),
       mStepSize(stepSize),
-      mSetBcsOnBoxBoundary(true)
+      mSetBcsOnBoxBoundary(true),
+      mAssembleOperatorsOnce(false)
 {
     if (pMeshCuboid)
     {
@@ -83,6 +84,18 @@ bool AbstractBoxDomainPdeModifier<DIM>::AreBcsSetOnBoxBoundary()
     return mSetBcsOnBoxBoundary;
 }
 
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::SetAssembleOperatorsOnce(bool assembleOperatorsOnce)
+{
+    mAssembleOperatorsOnce = assembleOperatorsOnce;
+}
+
+template<unsigned DIM>
+bool AbstractBoxDomainPdeModifier<DIM>::AreOperatorsAssembledOnce()
+{
+    return mAssembleOperatorsOnce;
+}
+
 template<unsigned DIM>
 void AbstractBoxDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
@@ -134,6 +147,18 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the CellData items once, rather than by name for every cell
+    unsigned solution_index = CellDataRegistry::Instance()->GetIndex(this->mDependentVariableName);
+    std::vector<unsigned> gradient_indices;
+    if (this->mOutputGradient)
+    {
+        const std::string suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned j=0; j<DIM; j++)
+        {
+            gradient_indices.push_back(CellDataRegistry::Instance()->GetIndex(this->mDependentVariableName + suffixes[j]));
+        }
+    }
+
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
          ++cell_iter)
@@ -155,7 +180,8 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
             solution_at_cell += nodal_value * weights(i);
         }
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_cell);
+        boost::shared_ptr<CellData> p_cell_data = cell_iter->GetCellData();
+        p_cell_data->SetItem(solution_index, solution_at_cell);
 
         if (this->mOutputGradient)
         {
@@ -180,22 +206,9 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
                 }
             }
 
-            switch (DIM)
+            for (unsigned j=0; j<DIM; j++)
             {
-                case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    break;
-                case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    break;
-                case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
-                    break;
-                default:
-                    NEVER_REACHED;
+                p_cell_data->SetItem(gradient_indices[j], solution_gradient(j));
             }
         }
     }
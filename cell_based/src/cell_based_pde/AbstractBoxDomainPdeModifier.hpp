@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ABSTRACTBOXDOMAINPDEMODIFIER_HPP_
 
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include <boost/serialization/base_object.hpp>
 
 #include "AbstractPdeModifier.hpp"
@@ -71,6 +72,10 @@ private:
         archive & mpMeshCuboid;
         archive & mStepSize;
         archive & mSetBcsOnBoxBoundary;
+        if (version > 0)
+        {
+            archive & mAssembleOperatorsOnce;
+        }
     }
 
 protected:
@@ -96,6 +101,13 @@ protected:
      */
     bool mSetBcsOnBoxBoundary;
 
+    /**
+     * Whether to assemble the parts of the linear system that do not depend on the cells
+     * only once, and keep the linear system and its KSP solver between time steps.
+     * Defaults to false.
+     */
+    bool mAssembleOperatorsOnce;
+
 public:
 
     /**
@@ -138,6 +150,24 @@ public:
      */
     bool AreBcsSetOnBoxBoundary();
 
+    /**
+     * Set mAssembleOperatorsOnce.
+     *
+     * Since the FE mesh does not change, the matrices arising from the diffusion and time
+     * derivative terms of the PDE need only be assembled on the first time step, after
+     * which only the source terms are updated from the cells. The linear system, its KSP
+     * solver and preconditioner are then kept between time steps. This assumes that the
+     * diffusion and time derivative coefficients of the PDE do not change over time.
+     *
+     * @param assembleOperatorsOnce whether to assemble the operators only once
+     */
+    void SetAssembleOperatorsOnce(bool assembleOperatorsOnce=true);
+
+    /**
+     * @return mAssembleOperatorsOnce.
+     */
+    bool AreOperatorsAssembledOnce();
+
     /**
      * Overridden SetupSolve() method.
      *
@@ -196,4 +226,23 @@ public:
 #include "SerializationExportWrapper.hpp"
 TEMPLATED_CLASS_IS_ABSTRACT_1_UNSIGNED(AbstractBoxDomainPdeModifier)
 
+namespace boost
+{
+namespace serialization
+{
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(AbstractBoxDomainPdeModifier, 1)
+ * with a templated class.
+ */
+template <unsigned DIM>
+struct version<AbstractBoxDomainPdeModifier<DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+} // namespace serialization
+} // namespace boost
+
 #endif /*ABSTRACTBOXDOMAINPDEMODIFIER_HPP_*/
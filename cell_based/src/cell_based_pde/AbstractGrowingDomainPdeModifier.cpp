@@ -86,6 +86,18 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the CellData items once, rather than by name for every cell
+    unsigned solution_index = CellDataRegistry::Instance()->GetIndex(this->mDependentVariableName);
+    std::vector<unsigned> gradient_indices;
+    if (this->mOutputGradient)
+    {
+        const std::string suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned j=0; j<DIM; j++)
+        {
+            gradient_indices.push_back(CellDataRegistry::Instance()->GetIndex(this->mDependentVariableName + suffixes[j]));
+        }
+    }
+
     // Local cell index used by the CA simulation
     unsigned cell_index = 0;
 
@@ -116,7 +128,8 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
 
         double solution_at_node = solution_repl[tet_node_index];
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_node);
+        boost::shared_ptr<CellData> p_cell_data = cell_iter->GetCellData();
+        p_cell_data->SetItem(solution_index, solution_at_node);
 
         if (this->mOutputGradient)
         {
@@ -153,22 +166,9 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
             // Divide by number of containing elements
             solution_gradient /= p_tet_node->GetNumContainingElements();
 
-            switch (DIM)
+            for (unsigned j=0; j<DIM; j++)
             {
-                case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    break;
-                case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    break;
-                case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
-                    break;
-                default:
-                    NEVER_REACHED;
+                p_cell_data->SetItem(gradient_indices[j], solution_gradient(j));
             }
         }
     }
@@ -0,0 +1,206 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "CachedOperatorEllipticPdeSolver.hpp"
+#include "LinearBasisFunction.hpp"
+
+template<unsigned DIM>
+CachedOperatorEllipticPdeSolver<DIM>::CachedOperatorEllipticPdeSolver(TetrahedralMesh<DIM,DIM>* pMesh,
+                                                                      AbstractLinearEllipticPde<DIM,DIM>* pPde,
+                                                                      BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions)
+    : AbstractStaticLinearPdeSolver<DIM,DIM,1>(pMesh),
+      mpEllipticPde(pPde),
+      mpBoundaryConditions(pBoundaryConditions),
+      mStiffnessMatrix(nullptr)
+{
+    assert(pPde);
+    assert(pBoundaryConditions);
+}
+
+template<unsigned DIM>
+CachedOperatorEllipticPdeSolver<DIM>::~CachedOperatorEllipticPdeSolver()
+{
+    if (mStiffnessMatrix)
+    {
+        PetscTools::Destroy(mStiffnessMatrix);
+    }
+}
+
+template<unsigned DIM>
+void CachedOperatorEllipticPdeSolver<DIM>::SetBoundaryConditions(BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions)
+{
+    assert(pBoundaryConditions);
+    mpBoundaryConditions = pBoundaryConditions;
+}
+
+template<unsigned DIM>
+bool CachedOperatorEllipticPdeSolver<DIM>::IsStiffnessMatrixAssembled() const
+{
+    return (mStiffnessMatrix != nullptr);
+}
+
+template<unsigned DIM>
+void CachedOperatorEllipticPdeSolver<DIM>::InitialiseForSolve(Vec initialSolution)
+{
+    if (this->mpLinearSystem == nullptr)
+    {
+        AbstractLinearPdeSolver<DIM,DIM,1>::InitialiseForSolve(initialSolution);
+        assert(this->mpLinearSystem);
+        this->mpLinearSystem->SetMatrixIsSymmetric(true);
+        this->mpLinearSystem->SetKspType("cg");
+
+        /*
+         * The LHS matrix only changes through the (typically small) mass matrix terms,
+         * so we keep the preconditioner computed on the first solve. The KSP solver still
+         * converges to the usual tolerance on each solve.
+         */
+        this->mpLinearSystem->SetMatrixIsConstant(true);
+    }
+}
+
+template<unsigned DIM>
+void CachedOperatorEllipticPdeSolver<DIM>::AssembleStiffnessMatrix()
+{
+    assert(mStiffnessMatrix == nullptr);
+
+    mElementVolumes.resize(this->mpMesh->GetNumAllElements());
+
+    const ChastePoint<DIM> zero_point;
+    c_matrix<double, DIM, DIM> jacobian, inverse_jacobian;
+    double jacobian_determinant;
+    c_matrix<double, DIM, DIM+1> grad_phi;
+
+    this->mpLinearSystem->ZeroLhsMatrix();
+
+    for (typename AbstractTetrahedralMesh<DIM,DIM>::ElementIterator iter = this->mpMesh->GetElementIteratorBegin();
+         iter != this->mpMesh->GetElementIteratorEnd();
+         ++iter)
+    {
+        Element<DIM,DIM>& r_element = *iter;
+        if (r_element.GetOwnership())
+        {
+            unsigned elem_index = r_element.GetIndex();
+            this->mpMesh->GetInverseJacobianForElement(elem_index, jacobian, jacobian_determinant, inverse_jacobian);
+            mElementVolumes[elem_index] = r_element.GetVolume(jacobian_determinant);
+
+            // The basis function gradients are constant on each element
+            LinearBasisFunction<DIM>::ComputeTransformedBasisFunctionDerivatives(zero_point, inverse_jacobian, grad_phi);
+
+            ChastePoint<DIM> centroid(r_element.CalculateCentroid());
+            c_matrix<double, DIM, DIM> diffusion_term = mpEllipticPde->ComputeDiffusionTerm(centroid);
+
+            c_matrix<double, DIM+1, DIM+1> a_elem = mElementVolumes[elem_index]
+                * prod(trans(grad_phi), c_matrix<double, DIM, DIM+1>(prod(diffusion_term, grad_phi)));
+
+            unsigned p_indices[DIM+1];
+            r_element.GetStiffnessMatrixGlobalIndices(1, p_indices);
+            this->mpLinearSystem->AddLhsMultipleValues(p_indices, a_elem);
+        }
+    }
+
+    this->mpLinearSystem->FinaliseLhsMatrix();
+
+    MatDuplicate(this->mpLinearSystem->rGetLhsMatrix(), MAT_COPY_VALUES, &mStiffnessMatrix);
+}
+
+template<unsigned DIM>
+void CachedOperatorEllipticPdeSolver<DIM>::SetupLinearSystem(Vec currentSolution, bool computeMatrix)
+{
+    if (mStiffnessMatrix == nullptr)
+    {
+        AssembleStiffnessMatrix();
+    }
+    else
+    {
+        // Dirichlet boundary conditions keep the non-zero pattern of the LHS matrix
+        MatCopy(mStiffnessMatrix, this->mpLinearSystem->rGetLhsMatrix(), SAME_NONZERO_PATTERN);
+    }
+    this->mpLinearSystem->ZeroRhsVector();
+
+    // For linear basis functions the element mass matrix is V/((DIM+1)(DIM+2)) * (1 + delta_ij)
+    const double mass_matrix_factor = 1.0/((DIM+1.0)*(DIM+2.0));
+
+    for (typename AbstractTetrahedralMesh<DIM,DIM>::ElementIterator iter = this->mpMesh->GetElementIteratorBegin();
+         iter != this->mpMesh->GetElementIteratorEnd();
+         ++iter)
+    {
+        Element<DIM,DIM>& r_element = *iter;
+        if (r_element.GetOwnership())
+        {
+            unsigned elem_index = r_element.GetIndex();
+            ChastePoint<DIM> centroid(r_element.CalculateCentroid());
+            double linear_in_u_coeff = mpEllipticPde->ComputeLinearInUCoeffInSourceTerm(centroid, &r_element);
+            double constant_in_u_term = mpEllipticPde->ComputeConstantInUSourceTerm(centroid, &r_element);
+
+            unsigned p_indices[DIM+1];
+            r_element.GetStiffnessMatrixGlobalIndices(1, p_indices);
+
+            // This saves adding a mass matrix if it is to be multiplied by zero
+            if (linear_in_u_coeff != 0.0)
+            {
+                double off_diagonal = -linear_in_u_coeff*mElementVolumes[elem_index]*mass_matrix_factor;
+                c_matrix<double, DIM+1, DIM+1> a_elem;
+                for (unsigned i=0; i<DIM+1; i++)
+                {
+                    for (unsigned j=0; j<DIM+1; j++)
+                    {
+                        a_elem(i,j) = (i == j) ? 2.0*off_diagonal : off_diagonal;
+                    }
+                }
+                this->mpLinearSystem->AddLhsMultipleValues(p_indices, a_elem);
+            }
+
+            if (constant_in_u_term != 0.0)
+            {
+                c_vector<double, DIM+1> b_elem = scalar_vector<double>(DIM+1, constant_in_u_term*mElementVolumes[elem_index]/(DIM+1.0));
+                this->mpLinearSystem->AddRhsMultipleValues(p_indices, b_elem);
+            }
+        }
+    }
+
+    this->mpLinearSystem->FinaliseRhsVector();
+    this->mpLinearSystem->SwitchWriteModeLhsMatrix();
+
+    // Add Dirichlet BCs
+    mpBoundaryConditions->ApplyDirichletToLinearProblem(*(this->mpLinearSystem), true);
+
+    this->mpLinearSystem->FinaliseRhsVector();
+    this->mpLinearSystem->FinaliseLhsMatrix();
+}
+
+// Explicit instantiation
+template class CachedOperatorEllipticPdeSolver<1>;
+template class CachedOperatorEllipticPdeSolver<2>;
+template class CachedOperatorEllipticPdeSolver<3>;
@@ -0,0 +1,144 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CACHEDOPERATORELLIPTICPDESOLVER_HPP_
+#define CACHEDOPERATORELLIPTICPDESOLVER_HPP_
+
+#include <vector>
+
+#include "AbstractStaticLinearPdeSolver.hpp"
+#include "AbstractLinearEllipticPde.hpp"
+#include "BoundaryConditionsContainer.hpp"
+#include "TetrahedralMesh.hpp"
+
+/**
+ * A linear elliptic solver for a fixed mesh, intended for repeated solves in which
+ * only the source terms of the PDE change between solves (as for an EllipticBoxDomainPdeModifier).
+ *
+ * The stiffness matrix (from the diffusion term) is assembled once, on the first call
+ * to Solve(), and kept. On each solve the LHS matrix is formed by adding the mass matrix
+ * terms arising from the linear in u part of the source term to a copy of the stiffness
+ * matrix, and only the RHS vector is assembled afresh. The linear system and its KSP
+ * solver are kept between solves, the preconditioner computed on the first solve is
+ * reused, and the previous solution may be passed to Solve() as the initial guess.
+ *
+ * Since linear basis functions are used, element mass matrices and load vectors are
+ * computed in closed form from the element volumes. The diffusion term and source
+ * terms are evaluated at each element's centroid, so the solution coincides with that
+ * of SimpleLinearEllipticSolver provided they are constant on each element, as is
+ * the case for AveragedSourceEllipticPde and UniformSourceEllipticPde. The diffusion
+ * term must not change between solves. Neumann boundary conditions are not supported.
+ */
+template<unsigned DIM>
+class CachedOperatorEllipticPdeSolver : public AbstractStaticLinearPdeSolver<DIM,DIM,1>
+{
+private:
+
+    /** The PDE to be solved. */
+    AbstractLinearEllipticPde<DIM,DIM>* mpEllipticPde;
+
+    /** The boundary conditions to be imposed on the next solve. */
+    BoundaryConditionsContainer<DIM,DIM,1>* mpBoundaryConditions;
+
+    /** The assembled stiffness matrix, or NULL before the first solve. */
+    Mat mStiffnessMatrix;
+
+    /** The volume of each element of the mesh, computed with the stiffness matrix. */
+    std::vector<double> mElementVolumes;
+
+    /**
+     * Assemble the stiffness matrix into the LHS matrix of the linear system and keep
+     * a copy of it in mStiffnessMatrix.
+     */
+    void AssembleStiffnessMatrix();
+
+protected:
+
+    /**
+     * Create the linear system object if it hasn't been already.
+     * Can use an initial solution as PETSc template, or base it on the mesh size.
+     *
+     * Here we also set the KSP solver to reuse its preconditioner.
+     *
+     * @param initialSolution an initial guess
+     */
+    void InitialiseForSolve(Vec initialSolution);
+
+    /**
+     * Implementation of AbstractLinearPdeSolver::SetupLinearSystem().
+     *
+     * Forms the LHS matrix from the cached stiffness matrix and the current linear
+     * in u source term, assembles the RHS vector and applies the boundary conditions.
+     *
+     * @param currentSolution The current solution (not used)
+     * @param computeMatrix Whether to compute the LHS matrix (not used, as the
+     *     matrix is always formed from the cached stiffness matrix)
+     */
+    void SetupLinearSystem(Vec currentSolution, bool computeMatrix);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pMesh pointer to the mesh
+     * @param pPde pointer to the PDE
+     * @param pBoundaryConditions pointer to the boundary conditions
+     */
+    CachedOperatorEllipticPdeSolver(TetrahedralMesh<DIM,DIM>* pMesh,
+                                    AbstractLinearEllipticPde<DIM,DIM>* pPde,
+                                    BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions);
+
+    /**
+     * Destructor.
+     */
+    virtual ~CachedOperatorEllipticPdeSolver();
+
+    /**
+     * Set the boundary conditions to be imposed on subsequent solves. These may
+     * differ from those used on previous solves, for example if they are imposed
+     * on the boundary of a cell population.
+     *
+     * @param pBoundaryConditions pointer to the boundary conditions
+     */
+    void SetBoundaryConditions(BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions);
+
+    /**
+     * @return whether the stiffness matrix has been assembled.
+     */
+    bool IsStiffnessMatrixAssembled() const;
+};
+
+#endif /*CACHEDOPERATORELLIPTICPDESOLVER_HPP_*/
@@ -69,15 +69,36 @@ void EllipticBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopula
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearEllipticSolver as Averaged Source PDE
-    ///\todo allow other PDE classes to be used with this modifier
-    SimpleLinearEllipticSolver<DIM,DIM> solver(this->mpFeMesh,
-                                               boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
-                                               p_bcc.get());
-
-    ///\todo Use solution at previous time step as an initial guess for Solve()
     Vec old_solution_copy = this->mSolution;
-    this->mSolution = solver.Solve();
+    if (this->mAssembleOperatorsOnce)
+    {
+        // Keep the solver, and hence the stiffness matrix and KSP solver, between time steps
+        if (!mpCachedOperatorSolver)
+        {
+            mpCachedOperatorSolver.reset(new CachedOperatorEllipticPdeSolver<DIM>(this->mpFeMesh,
+                                                                                  boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                                  p_bcc.get()));
+        }
+        else
+        {
+            mpCachedOperatorSolver->SetBoundaryConditions(p_bcc.get());
+        }
+        mpCachedOperatorBoundaryConditions = p_bcc;
+
+        // Use the solution at the previous time step as an initial guess
+        this->mSolution = mpCachedOperatorSolver->Solve(old_solution_copy);
+    }
+    else
+    {
+        // Use SimpleLinearEllipticSolver as Averaged Source PDE
+        ///\todo allow other PDE classes to be used with this modifier
+        SimpleLinearEllipticSolver<DIM,DIM> solver(this->mpFeMesh,
+                                                   boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                   p_bcc.get());
+
+        ///\todo Use solution at previous time step as an initial guess for Solve()
+        this->mSolution = solver.Solve();
+    }
     if (old_solution_copy != nullptr)
     {
         PetscTools::Destroy(old_solution_copy);
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "CachedOperatorEllipticPdeSolver.hpp"
 #include "PetscTools.hpp"
 #include "FileFinder.hpp"
 
@@ -61,6 +62,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Examples of PDEs in the source folder that can be solved using this class are
  * AveragedSourceEllipticPde, VolumeDependentAveragedSourceEllipticPde and UniformSourceEllipticPde.
+ *
+ * If SetAssembleOperatorsOnce() is called, the PDE is solved using a CachedOperatorEllipticPdeSolver,
+ * which requires the coefficients of the PDE to be constant on each element of the FE mesh.
  */
 template<unsigned DIM>
 class EllipticBoxDomainPdeModifier : public AbstractBoxDomainPdeModifier<DIM>
@@ -84,6 +88,15 @@ private:
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The solver used when mAssembleOperatorsOnce is true, which is kept between time steps.
+     * Not archived, as it is recreated on the first time step after loading.
+     */
+    boost::shared_ptr<CachedOperatorEllipticPdeSolver<DIM> > mpCachedOperatorSolver;
+
+    /** The boundary conditions currently used by mpCachedOperatorSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpCachedOperatorBoundaryConditions;
+
 public:
 
     /**
@@ -34,7 +34,6 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ParabolicBoxDomainPdeModifier.hpp"
-#include "SimpleLinearParabolicSolver.hpp"
 
 template<unsigned DIM>
 ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_ptr<AbstractLinearPde<DIM,DIM> > pPde,
@@ -48,7 +47,8 @@ ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_
                                         isNeumannBoundaryCondition,
                                         pMeshCuboid,
                                         stepSize,
-                                        solution)
+                                        solution),
+      mCachedOperatorTimeStep(DOUBLE_UNSET)
 {
 }
 
@@ -60,6 +60,12 @@ ParabolicBoxDomainPdeModifier<DIM>::~ParabolicBoxDomainPdeModifier()
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
+    if (this->mAssembleOperatorsOnce)
+    {
+        SolveWithCachedOperators(rCellPopulation);
+        return;
+    }
+
     // Set up boundary conditions
     std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
 
@@ -92,6 +98,44 @@ void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopul
     this->UpdateCellData(rCellPopulation);
 }
 
+template<unsigned DIM>
+void ParabolicBoxDomainPdeModifier<DIM>::SolveWithCachedOperators(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    SimulationTime* p_simulation_time = SimulationTime::Instance();
+    double current_time = p_simulation_time->GetTime();
+    double dt = p_simulation_time->GetTimeStep();
+
+    if (!mpCachedOperatorSolver)
+    {
+        // The boundary conditions are imposed on the box domain, so do not change between time steps
+        mpCachedOperatorBoundaryConditions = ConstructBoundaryConditionsContainer(rCellPopulation);
+        mpCachedOperatorSolver.reset(new SimpleLinearParabolicSolver<DIM,DIM>(this->mpFeMesh,
+                                                                              boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                              mpCachedOperatorBoundaryConditions.get()));
+    }
+    else if (fabs(dt/mCachedOperatorTimeStep - 1.0) > 1e-5)
+    {
+        // The LHS matrix depends on the time step, so must be reassembled
+        mpCachedOperatorSolver->SetMatrixIsNotAssembled();
+    }
+    mCachedOperatorTimeStep = dt;
+
+    this->UpdateCellPdeElementMap(rCellPopulation);
+
+    // Only the source terms, and hence the RHS vector, depend on the cells
+    this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
+
+    mpCachedOperatorSolver->SetTimes(current_time, current_time + dt);
+    mpCachedOperatorSolver->SetTimeStep(dt);
+
+    Vec previous_solution = this->mSolution;
+    mpCachedOperatorSolver->SetInitialCondition(previous_solution);
+
+    this->mSolution = mpCachedOperatorSolver->Solve();
+    PetscTools::Destroy(previous_solution);
+    this->UpdateCellData(rCellPopulation);
+}
+
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
@@ -146,13 +190,14 @@ void ParabolicBoxDomainPdeModifier<DIM>::SetupInitialSolutionVector(AbstractCell
     // Specify homogeneous initial conditions based upon the values stored in CellData.
     // Note need all the CellDataValues to be the same.
 
-    double initial_condition = rCellPopulation.Begin()->GetCellData()->GetItem(this->mDependentVariableName);
+    unsigned solution_index = CellDataRegistry::Instance()->GetIndex(this->mDependentVariableName);
+    double initial_condition = rCellPopulation.Begin()->GetCellData()->GetItem(solution_index);
 
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
          ++cell_iter)
     {
-        double initial_condition_at_cell = cell_iter->GetCellData()->GetItem(this->mDependentVariableName);
+        double initial_condition_at_cell = cell_iter->GetCellData()->GetItem(solution_index);
         UNUSED_OPT(initial_condition_at_cell);
         assert(fabs(initial_condition_at_cell - initial_condition)<1e-12);
     }
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "SimpleLinearParabolicSolver.hpp"
 
 /**
  * A modifier class in which a linear parabolic PDE coupled to a cell-based simulation
@@ -59,6 +60,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Examples of PDEs in the source folder that can be solved using this class are
  * AveragedSourceParabolicPde and UniformSourceParabolicPde.
+ *
+ * If SetAssembleOperatorsOnce() is called, a single SimpleLinearParabolicSolver is kept
+ * for the whole simulation, so its LHS matrix is only assembled on the first time step
+ * (or if the time step changes).
  */
 template<unsigned DIM>
 class ParabolicBoxDomainPdeModifier : public AbstractBoxDomainPdeModifier<DIM>
@@ -82,6 +87,25 @@ private:
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The solver used when mAssembleOperatorsOnce is true, which is kept between time steps.
+     * Not archived, as it is recreated on the first time step after loading.
+     */
+    boost::shared_ptr<SimpleLinearParabolicSolver<DIM,DIM> > mpCachedOperatorSolver;
+
+    /** The boundary conditions used by mpCachedOperatorSolver, which only depend on the box domain. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpCachedOperatorBoundaryConditions;
+
+    /** The time step for which the LHS matrix of mpCachedOperatorSolver was assembled. */
+    double mCachedOperatorTimeStep;
+
+    /**
+     * Helper method for UpdateAtEndOfTimeStep() when mAssembleOperatorsOnce is true.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    void SolveWithCachedOperators(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
 public:
 
     /**
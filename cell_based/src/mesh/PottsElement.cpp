@@ -38,7 +38,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 template<unsigned DIM>
 PottsElement<DIM>::PottsElement(unsigned index, const std::vector<Node<DIM>*>& rNodes)
-    : MutableElement<DIM,DIM>(index, rNodes)
+    : MutableElement<DIM,DIM>(index, rNodes),
+      mCachedSurfaceArea(0.0),
+      mIsSurfaceAreaCached(false)
 {
     this->RegisterWithNodes();
 }
@@ -56,6 +58,42 @@ void PottsElement<DIM>::AddNode(Node<DIM>* pNode,  const unsigned& rIndex)
 
     // Add pNode to mNodes
     this->mNodes.push_back(pNode);
+
+    mIsSurfaceAreaCached = false;
+}
+
+template<unsigned DIM>
+void PottsElement<DIM>::DeleteNode(const unsigned& rIndex)
+{
+    MutableElement<DIM,DIM>::DeleteNode(rIndex);
+    mIsSurfaceAreaCached = false;
+}
+
+template<unsigned DIM>
+void PottsElement<DIM>::UpdateNode(const unsigned& rIndex, Node<DIM>* pNode)
+{
+    MutableElement<DIM,DIM>::UpdateNode(rIndex, pNode);
+    mIsSurfaceAreaCached = false;
+}
+
+template<unsigned DIM>
+bool PottsElement<DIM>::IsSurfaceAreaCached() const
+{
+    return mIsSurfaceAreaCached;
+}
+
+template<unsigned DIM>
+double PottsElement<DIM>::GetCachedSurfaceArea() const
+{
+    assert(mIsSurfaceAreaCached);
+    return mCachedSurfaceArea;
+}
+
+template<unsigned DIM>
+void PottsElement<DIM>::SetCachedSurfaceArea(double surfaceArea)
+{
+    mCachedSurfaceArea = surfaceArea;
+    mIsSurfaceAreaCached = true;
 }
 
 template<unsigned DIM>
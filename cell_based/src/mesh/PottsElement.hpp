@@ -56,6 +56,12 @@ class PottsElement : public MutableElement<DIM, DIM>
 {
 private:
 
+    /** The surface area of the element, if known (see IsSurfaceAreaCached()). Not archived. */
+    double mCachedSurfaceArea;
+
+    /** Whether mCachedSurfaceArea is up to date. Reset whenever a node is added, removed or replaced. */
+    bool mIsSurfaceAreaCached;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -98,6 +104,41 @@ public:
      */
     void AddNode(Node<DIM>* pNode,  const unsigned& rIndex = UINT_MAX);
 
+    /**
+     * Delete a node from the element. This hides MutableElement::DeleteNode() so
+     * that the cached surface area is reset.
+     *
+     * @param rIndex is the local index of the node to remove
+     */
+    void DeleteNode(const unsigned& rIndex);
+
+    /**
+     * Overridden UpdateNode() method, which also resets the cached surface area.
+     *
+     * @param rIndex the local index of the node to change
+     * @param pNode is a pointer to the replacement node
+     */
+    void UpdateNode(const unsigned& rIndex, Node<DIM>* pNode);
+
+    /**
+     * @return whether the element's surface area is cached.
+     */
+    bool IsSurfaceAreaCached() const;
+
+    /**
+     * @return the cached surface area of the element; IsSurfaceAreaCached() must be true.
+     */
+    double GetCachedSurfaceArea() const;
+
+    /**
+     * Cache the surface area of the element. This is done by PottsMesh, which
+     * calculates the surface area and keeps it up to date as nodes move between
+     * elements.
+     *
+     * @param surfaceArea the surface area of the element
+     */
+    void SetCachedSurfaceArea(double surfaceArea);
+
     /**
      * Method to calculate the aspect ratio of the element. Currently only works on 2D
      *
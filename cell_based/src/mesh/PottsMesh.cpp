@@ -196,6 +196,17 @@ double PottsMesh<DIM>::GetVolumeOfElement(unsigned index)
 
 template<unsigned DIM>
 double PottsMesh<DIM>::GetSurfaceAreaOfElement(unsigned index)
+{
+    PottsElement<DIM>* p_element = GetElement(index);
+    if (!p_element->IsSurfaceAreaCached())
+    {
+        p_element->SetCachedSurfaceArea(CalculateSurfaceAreaOfElement(index));
+    }
+    return p_element->GetCachedSurfaceArea();
+}
+
+template<unsigned DIM>
+double PottsMesh<DIM>::CalculateSurfaceAreaOfElement(unsigned index)
 {
     ///\todo not implemented in 3d yet
     assert(DIM==2 || DIM==3); // LCOV_EXCL_LINE
@@ -207,26 +218,90 @@ double PottsMesh<DIM>::GetSurfaceAreaOfElement(unsigned index)
     double surface_area = 0.0;
     for (unsigned node_index=0; node_index<num_nodes; node_index++)
     {
-        std::set<unsigned> neighbouring_node_indices = GetVonNeumannNeighbouringNodeIndices(p_element->GetNode(node_index)->GetIndex());
-        unsigned local_edges = 2*DIM;
-        for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-             iter != neighbouring_node_indices.end();
-             iter++)
+        surface_area += 2*DIM - CountVonNeumannNeighboursInElement(p_element->GetNodeGlobalIndex(node_index), index);
+    }
+    return surface_area;
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::CountVonNeumannNeighboursInElement(unsigned nodeIndex, unsigned elementIndex)
+{
+    const std::set<unsigned>& r_neighbouring_node_indices = mVonNeumannNeighbouringNodeIndices[nodeIndex];
+
+    unsigned count = 0;
+    for (std::set<unsigned>::const_iterator iter = r_neighbouring_node_indices.begin();
+         iter != r_neighbouring_node_indices.end();
+         ++iter)
+    {
+        const std::set<unsigned>& r_neighbouring_node_element_indices = this->mNodes[*iter]->rGetContainingElementIndices();
+        if (!r_neighbouring_node_element_indices.empty() && *(r_neighbouring_node_element_indices.begin()) == elementIndex)
         {
-            std::set<unsigned> neighbouring_node_element_indices = this->mNodes[*iter]->rGetContainingElementIndices();
+            count++;
+        }
+    }
+    return count;
+}
 
-            if (!(neighbouring_node_element_indices.empty()) && (local_edges!=0))
-            {
-                unsigned neighbouring_node_element_index = *(neighbouring_node_element_indices.begin());
-                if (neighbouring_node_element_index == index)
-                {
-                    local_edges--;
-                }
-            }
+template<unsigned DIM>
+void PottsMesh<DIM>::CacheSurfaceAreasOfElements()
+{
+    for (unsigned elem_index=0; elem_index<mElements.size(); elem_index++)
+    {
+        if (!mElements[elem_index]->IsDeleted())
+        {
+            GetSurfaceAreaOfElement(elem_index);
+        }
+    }
+}
+
+template<unsigned DIM>
+void PottsMesh<DIM>::MoveNodeToElement(unsigned nodeIndex, unsigned elementIndex)
+{
+    Node<DIM>* p_node = this->mNodes[nodeIndex];
+
+    // Each node in the mesh must be in at most one element
+    assert(p_node->GetNumContainingElements() <= 1);
+    unsigned old_element_index = p_node->rGetContainingElementIndices().empty() ? UNSIGNED_UNSET : *(p_node->rGetContainingElementIndices().begin());
+
+    if (old_element_index == elementIndex)
+    {
+        return;
+    }
+
+    /*
+     * Each node contributes 2*DIM less its number of Von Neumann neighbours in the same element
+     * to the surface area of that element, so only the old and new elements' surface areas
+     * change, by amounts that depend on the moved node's neighbourhood only.
+     */
+    if (old_element_index != UNSIGNED_UNSET)
+    {
+        PottsElement<DIM>* p_old_element = mElements[old_element_index];
+        bool was_cached = p_old_element->IsSurfaceAreaCached();
+        double surface_area = was_cached ? p_old_element->GetCachedSurfaceArea() : 0.0;
+        double neighbours_in_old_element = CountVonNeumannNeighboursInElement(nodeIndex, old_element_index);
+
+        p_old_element->DeleteNode(p_old_element->GetNodeLocalIndex(nodeIndex));
+
+        if (was_cached)
+        {
+            p_old_element->SetCachedSurfaceArea(surface_area + 2.0*neighbours_in_old_element - 2.0*DIM);
+        }
+    }
+
+    if (elementIndex != UNSIGNED_UNSET)
+    {
+        PottsElement<DIM>* p_new_element = mElements[elementIndex];
+        bool was_cached = p_new_element->IsSurfaceAreaCached();
+        double surface_area = was_cached ? p_new_element->GetCachedSurfaceArea() : 0.0;
+        double neighbours_in_new_element = CountVonNeumannNeighboursInElement(nodeIndex, elementIndex);
+
+        p_new_element->AddNode(p_node);
+
+        if (was_cached)
+        {
+            p_new_element->SetCachedSurfaceArea(surface_area + 2.0*DIM - 2.0*neighbours_in_new_element);
         }
-        surface_area += local_edges;
     }
-    return surface_area;
 }
 
 template<unsigned DIM>
@@ -235,12 +310,24 @@ std::set<unsigned> PottsMesh<DIM>::GetMooreNeighbouringNodeIndices(unsigned node
     return mMooreNeighbouringNodeIndices[nodeIndex];
 }
 
+template<unsigned DIM>
+const std::set<unsigned>& PottsMesh<DIM>::rGetMooreNeighbouringNodeIndices(unsigned nodeIndex) const
+{
+    return mMooreNeighbouringNodeIndices[nodeIndex];
+}
+
 template<unsigned DIM>
 std::set<unsigned> PottsMesh<DIM>::GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex)
 {
     return mVonNeumannNeighbouringNodeIndices[nodeIndex];
 }
 
+template<unsigned DIM>
+const std::set<unsigned>& PottsMesh<DIM>::rGetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex) const
+{
+    return mVonNeumannNeighbouringNodeIndices[nodeIndex];
+}
+
 template<unsigned DIM>
 void PottsMesh<DIM>::DeleteElement(unsigned index)
 {
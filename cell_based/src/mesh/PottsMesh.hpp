@@ -107,6 +107,23 @@ protected:
      */
     unsigned SolveBoundaryElementMapping(unsigned index) const;
 
+    /**
+     * Calculate the surface area (or perimeter in 2D) of a PottsElement from scratch,
+     * as the number of faces between its nodes and nodes not in the element.
+     *
+     * @param index  the global index of a specified PottsElement
+     * @return the surface area of the element
+     */
+    double CalculateSurfaceAreaOfElement(unsigned index);
+
+    /**
+     * @return the number of Von Neumann neighbours of a node which are in a given element.
+     *
+     * @param nodeIndex global index of the node
+     * @param elementIndex global index of the element
+     */
+    unsigned CountVonNeumannNeighboursInElement(unsigned nodeIndex, unsigned elementIndex);
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
 
@@ -260,6 +277,10 @@ public:
     /**
      * Compute the surface area (or perimeter in 2D) of a PottsElement.
      *
+     * The surface area is cached on the element, and kept up to date by
+     * MoveNodeToElement(), so is only calculated from scratch after the element's
+     * nodes have been changed in some other way.
+     *
      * This needs to be overridden in daughter classes for non-Euclidean metrics.
      *
      * @param index  the global index of a specified PottsElement
@@ -276,6 +297,15 @@ public:
      */
     std::set<unsigned> GetMooreNeighbouringNodeIndices(unsigned nodeIndex);
 
+    /**
+     * Given a node, return a reference to the set containing the indices of its Moore
+     * neighbouring nodes, without copying it.
+     *
+     * @param nodeIndex global index of the node
+     * @return neighbouring node indices in Moore neighbourhood
+     */
+    const std::set<unsigned>& rGetMooreNeighbouringNodeIndices(unsigned nodeIndex) const;
+
     /**
      * Given a node, return a set containing the indices of its Von Neumann neighbouring nodes.
      *
@@ -284,6 +314,33 @@ public:
      */
     std::set<unsigned> GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex);
 
+    /**
+     * Given a node, return a reference to the set containing the indices of its Von
+     * Neumann neighbouring nodes, without copying it.
+     *
+     * @param nodeIndex global index of the node
+     * @return neighbouring node indices in Von Neumann neighbourhood
+     */
+    const std::set<unsigned>& rGetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex) const;
+
+    /**
+     * Move a node out of the element containing it (if any) and into another element,
+     * keeping the cached surface areas of both elements up to date. This only looks
+     * at the Von Neumann neighbourhood of the node, so costs the same whatever the
+     * size of the elements.
+     *
+     * @param nodeIndex global index of the node
+     * @param elementIndex global index of the element to move the node to, or
+     *     UNSIGNED_UNSET to move it into the medium
+     */
+    void MoveNodeToElement(unsigned nodeIndex, unsigned elementIndex);
+
+    /**
+     * Make sure the surface area of every element is cached, so that subsequent calls
+     * to GetSurfaceAreaOfElement() do not change the mesh (and so may be made concurrently).
+     */
+    void CacheSurfaceAreasOfElements();
+
     /**
      * Mark a node as deleted. Note that in a Potts mesh this requires the elements and connectivity to be updated accordingley.
      *
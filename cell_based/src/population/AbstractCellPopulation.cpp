@@ -72,7 +72,8 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
       mCells(rCells.begin(), rCells.end()),
       mCentroid(zero_vector<double>(SPACE_DIM)),
       mpCellPropertyRegistry(CellPropertyRegistry::Instance()->TakeOwnership()),
-      mOutputResultsForChasteVisualizer(true)
+      mOutputResultsForChasteVisualizer(true),
+      mUseHashedLocationCellMap(false)
 {
     /*
      * To avoid double-counting problems, clear the passed-in cells vector.
@@ -91,7 +92,7 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
     }
 
     // Set up the map between location indices and cells
-    mLocationCellMap.clear();
+    ClearLocationCellMap();
     mCellLocationMap.clear();
 
     std::list<CellPtr>::iterator it = mCells.begin();
@@ -104,7 +105,8 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
-    : mrMesh(rMesh)
+    : mrMesh(rMesh),
+      mUseHashedLocationCellMap(false)
 {
 }
 
@@ -316,18 +318,70 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
     return cell_cycle_phase_count;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::set<CellPtr>& AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetCellsAtLocation(unsigned index)
+{
+    if (mUseHashedLocationCellMap)
+    {
+        return mHashedLocationCellMap[index];
+    }
+    if (index >= mLocationCellMap.size())
+    {
+        mLocationCellMap.resize(index+1);
+    }
+    return mLocationCellMap[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::set<CellPtr>* AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::FindCellsAtLocation(unsigned index) const
+{
+    if (mUseHashedLocationCellMap)
+    {
+        std::unordered_map<unsigned, std::set<CellPtr> >::const_iterator it = mHashedLocationCellMap.find(index);
+        return (it == mHashedLocationCellMap.end()) ? nullptr : &(it->second);
+    }
+    return (index < mLocationCellMap.size()) ? &(mLocationCellMap[index]) : nullptr;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::UseHashedLocationCellMap()
+{
+    if (!mUseHashedLocationCellMap)
+    {
+        for (unsigned index=0; index<mLocationCellMap.size(); index++)
+        {
+            if (!mLocationCellMap[index].empty())
+            {
+                mHashedLocationCellMap[index].swap(mLocationCellMap[index]);
+            }
+        }
+
+        // Release the dense vector's storage
+        std::vector<std::set<CellPtr> >().swap(mLocationCellMap);
+        mUseHashedLocationCellMap = true;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::ClearLocationCellMap()
+{
+    mLocationCellMap.clear();
+    mHashedLocationCellMap.clear();
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellUsingLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    // Count the cells corresponding to this location index, without copying the set
+    const std::set<CellPtr>* p_cells = FindCellsAtLocation(index);
+    unsigned num_cells = p_cells ? p_cells->size() : 0;
 
     // If there is only one cell attached return the cell. Note currently only one cell per index.
-    if (cells.size() == 1)
+    if (num_cells == 1)
     {
-        return *(cells.begin());
+        return *(p_cells->begin());
     }
-    if (cells.empty())
+    if (num_cells == 0)
     {
         EXCEPTION("Location index input argument does not correspond to a Cell");
     }
@@ -341,17 +395,20 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::set<CellPtr> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellsUsingLocationIndex(unsigned index)
 {
     // Return the set of pointers to cells corresponding to this location index, note the set may be empty.
-    return mLocationCellMap[index];
+    const std::set<CellPtr>* p_cells = FindCellsAtLocation(index);
+    if (p_cells == nullptr)
+    {
+        return std::set<CellPtr>();
+    }
+    return *p_cells;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellAttachedToLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
-
     // Return whether there is a cell attached to the location index
-    return !(cells.empty());
+    const std::set<CellPtr>* p_cells = FindCellsAtLocation(index);
+    return p_cells && !(p_cells->empty());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -363,11 +420,12 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
     // Clear the maps
-    mLocationCellMap[index].clear();
+    std::set<CellPtr>& r_cells = rGetCellsAtLocation(index);
+    r_cells.clear();
     mCellLocationMap.erase(pCell.get());
 
     // Replace with new cell
-    mLocationCellMap[index].insert(pCell);
+    r_cells.insert(pCell);
 
     // Do other half of the map
     mCellLocationMap[pCell.get()] = index;
@@ -376,23 +434,30 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(u
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    mLocationCellMap[index].insert(pCell);
+    rGetCellsAtLocation(index).insert(pCell);
     mCellLocationMap[pCell.get()] = index;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    std::set<CellPtr>::iterator cell_iter = mLocationCellMap[index].find(pCell);
+    std::set<CellPtr>& r_cells = rGetCellsAtLocation(index);
+    std::set<CellPtr>::iterator cell_iter = r_cells.find(pCell);
 
-    if (cell_iter == mLocationCellMap[index].end())
+    if (cell_iter == r_cells.end())
     {
         EXCEPTION("Tried to remove a cell which is not attached to the given location index");
     }
     else
     {
-        mLocationCellMap[index].erase(cell_iter);
+        r_cells.erase(cell_iter);
         mCellLocationMap.erase(pCell.get());
+
+        // Only locations with cells have entries in the hashed map
+        if (mUseHashedLocationCellMap && r_cells.empty())
+        {
+            mHashedLocationCellMap.erase(index);
+        }
     }
 }
 
@@ -410,9 +475,10 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetLocationIndexUsingCell(CellPtr pCell)
 {
     // Check the cell is in the map
-    assert(this->mCellLocationMap.find(pCell.get()) != this->mCellLocationMap.end());
+    std::unordered_map<Cell*, unsigned>::const_iterator it = mCellLocationMap.find(pCell.get());
+    assert(it != mCellLocationMap.end());
 
-    return mCellLocationMap[pCell.get()];
+    return it->second;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -41,6 +41,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <list>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 
@@ -52,6 +54,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include <boost/foreach.hpp>
 
@@ -80,23 +83,97 @@ private:
     friend class boost::serialization::access;
 
     /**
-     * Serialize the object and its member variables.
+     * Save the object and its member variables.
+     *
+     * The location maps are archived as ordered maps, as they were before they
+     * were stored in dense and hashed containers, so that older archives may
+     * still be loaded.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & mCells;
-        archive & mLocationCellMap;
-        archive & mCellLocationMap;
+
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        for (unsigned index=0; index<mLocationCellMap.size(); index++)
+        {
+            if (!mLocationCellMap[index].empty())
+            {
+                location_cell_map[index] = mLocationCellMap[index];
+            }
+        }
+        for (std::unordered_map<unsigned, std::set<CellPtr> >::const_iterator it = mHashedLocationCellMap.begin();
+             it != mHashedLocationCellMap.end();
+             ++it)
+        {
+            location_cell_map[it->first] = it->second;
+        }
+        archive & location_cell_map;
+
+        std::map<Cell*, unsigned> cell_location_map(mCellLocationMap.begin(), mCellLocationMap.end());
+        archive & cell_location_map;
+
+        archive & mpCellPropertyRegistry;
+        archive & mOutputResultsForChasteVisualizer;
+        archive & mCellWriters;
+        archive & mCellPopulationWriters;
+        archive & mCellPopulationCountWriters;
+    }
+
+    /**
+     * Load the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & mCells;
+
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        archive & location_cell_map;
+        ClearLocationCellMap();
+        for (std::map<unsigned, std::set<CellPtr> >::iterator it = location_cell_map.begin();
+             it != location_cell_map.end();
+             ++it)
+        {
+            rGetCellsAtLocation(it->first) = it->second;
+        }
+
+        std::map<Cell*, unsigned> cell_location_map;
+        archive & cell_location_map;
+        mCellLocationMap.clear();
+        mCellLocationMap.insert(cell_location_map.begin(), cell_location_map.end());
+
         archive & mpCellPropertyRegistry;
         archive & mOutputResultsForChasteVisualizer;
         archive & mCellWriters;
         archive & mCellPopulationWriters;
         archive & mCellPopulationCountWriters;
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    /**
+     * Get the set of cells attached to a given location index for modification,
+     * growing mLocationCellMap if the index lies beyond its current size (or adding
+     * an entry to mHashedLocationCellMap, if that is in use).
+     *
+     * @param index the location index
+     * @return reference to the set of cells at this location.
+     */
+    std::set<CellPtr>& rGetCellsAtLocation(unsigned index);
+
+    /**
+     * Find the set of cells attached to a given location index, without adding it.
+     *
+     * @param index the location index
+     * @return the set of cells at this location, or nullptr if there is none.
+     */
+    const std::set<CellPtr>* FindCellsAtLocation(unsigned index) const;
 
     /**
      * Open all files in mCellPopulationWriters and mCellWriters in append mode for writing.
@@ -119,11 +196,22 @@ private:
 
 protected:
 
-    /** Map location (node or VertexElement) indices back to cells. */
-    std::map<unsigned, std::set<CellPtr> > mLocationCellMap;
+    /**
+     * Map location (node or VertexElement) indices back to cells. This is a dense
+     * vector indexed by location index, so that lookups take constant time; it is
+     * grown on demand, and locations without cells hold an empty set. It is empty
+     * if mUseHashedLocationCellMap is set.
+     */
+    std::vector<std::set<CellPtr> > mLocationCellMap;
+
+    /**
+     * Map location indices back to cells, in place of mLocationCellMap, if
+     * mUseHashedLocationCellMap is set. Only locations with cells have entries.
+     */
+    std::unordered_map<unsigned, std::set<CellPtr> > mHashedLocationCellMap;
 
-    /** Map cells to location (node or VertexElement) indices. */
-    std::map<Cell*, unsigned> mCellLocationMap;
+    /** Map cells to location (node or VertexElement) indices, hashed for constant-time lookup. */
+    std::unordered_map<Cell*, unsigned> mCellLocationMap;
 
     /** Reference to the mesh. */
     AbstractMesh<ELEMENT_DIM, SPACE_DIM>& mrMesh;
@@ -152,6 +240,26 @@ protected:
     /** A list of cell population count writers. */
     std::vector<boost::shared_ptr<AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> > > mCellPopulationCountWriters;
 
+    /**
+     * Whether location indices are mapped back to cells by mHashedLocationCellMap rather
+     * than mLocationCellMap. Populations distributed between processes hold only some of
+     * the global location indices, so a dense vector would be sized by the largest of
+     * them on every process. Initialised to false in the constructor.
+     */
+    bool mUseHashedLocationCellMap;
+
+    /**
+     * Map location indices back to cells by mHashedLocationCellMap rather than
+     * mLocationCellMap from now on, moving any cells already mapped. To be called
+     * by populations that are distributed between processes.
+     */
+    void UseHashedLocationCellMap();
+
+    /**
+     * Remove every cell from the map from location indices to cells.
+     */
+    void ClearLocationCellMap();
+
     /**
      * Check consistency of our internal data structures.
      *
@@ -40,6 +40,10 @@ AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractOffLatticeCell
                                                                     std::vector<CellPtr>& rCells,
                                                                     const std::vector<unsigned> locationIndices)
     : AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>(rMesh, rCells, locationIndices),
+      mIsAccumulatingForces(false),
+      mpPairIncidenceList(nullptr),
+      mPairIncidenceNumPairs(0),
+      mDampingConstantsAreValid(false),
       mDampingConstantNormal(1.0),
       mDampingConstantMutant(1.0),
       mAbsoluteMovementThreshold(2.0)
@@ -48,7 +52,11 @@ AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractOffLatticeCell
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractOffLatticeCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
-    : AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>(rMesh)
+    : AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>(rMesh),
+      mIsAccumulatingForces(false),
+      mpPairIncidenceList(nullptr),
+      mPairIncidenceNumPairs(0),
+      mDampingConstantsAreValid(false)
 {
 }
 
@@ -66,6 +74,7 @@ void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetDampingConstan
 {
     assert(dampingConstantNormal > 0.0);
     mDampingConstantNormal = dampingConstantNormal;
+    InvalidateDampingConstants();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -73,6 +82,7 @@ void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetDampingConstan
 {
     assert(dampingConstantMutant > 0.0);
     mDampingConstantMutant = dampingConstantMutant;
+    InvalidateDampingConstants();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -99,6 +109,228 @@ double AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetAbsoluteMove
     return mAbsoluteMovementThreshold;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::CanCacheDampingConstants()
+{
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::CanMoveNodesInPlace()
+{
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::BeginForceAccumulation()
+{
+    /*
+     * Record the nodes in iterator order, noting whether they (or their indices) differ from
+     * those found last time, in which case the position map, pair incidence arrays and cached
+     * damping constants are out of date.
+     */
+    const unsigned old_num_nodes = mForceAccumulationNodes.size();
+    bool nodes_have_changed = false;
+    unsigned position = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mrMesh.GetNodeIteratorBegin();
+         node_iter != this->mrMesh.GetNodeIteratorEnd();
+         ++node_iter, ++position)
+    {
+        node_iter->ClearAppliedForce();
+
+        Node<SPACE_DIM>* p_node = &(*node_iter);
+        unsigned node_index = p_node->GetIndex();
+        if (position >= old_num_nodes)
+        {
+            nodes_have_changed = true;
+            mForceAccumulationNodes.push_back(p_node);
+        }
+        else if (mForceAccumulationNodes[position] != p_node
+                 || node_index >= mForceAccumulationPositions.size()
+                 || mForceAccumulationPositions[node_index] != position)
+        {
+            nodes_have_changed = true;
+            mForceAccumulationNodes[position] = p_node;
+        }
+    }
+    if (position != old_num_nodes)
+    {
+        nodes_have_changed = true;
+        mForceAccumulationNodes.resize(position);
+    }
+
+    if (nodes_have_changed)
+    {
+        mForceAccumulationPositions.assign(this->mrMesh.GetNumAllNodes(), UNSIGNED_UNSET);
+        for (unsigned k=0; k<mForceAccumulationNodes.size(); k++)
+        {
+            unsigned node_index = mForceAccumulationNodes[k]->GetIndex();
+            if (node_index >= mForceAccumulationPositions.size())
+            {
+                mForceAccumulationPositions.resize(node_index + 1, UNSIGNED_UNSET);
+            }
+            mForceAccumulationPositions[node_index] = k;
+        }
+        mpPairIncidenceList = nullptr;
+        mDampingConstantsAreValid = false;
+    }
+
+    mAppliedForceComponents.assign(SPACE_DIM*mForceAccumulationNodes.size(), 0.0);
+    mIsAccumulatingForces = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::EndForceAccumulation()
+{
+    assert(mIsAccumulatingForces);
+
+    const unsigned num_nodes = mForceAccumulationNodes.size();
+    for (unsigned k=0; k<num_nodes; k++)
+    {
+        c_vector<double, SPACE_DIM> accumulated_force;
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            accumulated_force[d] = mAppliedForceComponents[d*num_nodes + k];
+        }
+        mForceAccumulationNodes[k]->AddAppliedForceContribution(accumulated_force);
+    }
+
+    mIsAccumulatingForces = false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::EndForceAccumulation(std::vector<c_vector<double, SPACE_DIM> >& rForcesIncludingDamping)
+{
+    EndForceAccumulation();
+
+    const std::vector<double>& r_damping_constants = rGetDampingConstants();
+    const unsigned num_nodes = mForceAccumulationNodes.size();
+    rForcesIncludingDamping.resize(num_nodes);
+    for (unsigned k=0; k<num_nodes; k++)
+    {
+        rForcesIncludingDamping[k] = mForceAccumulationNodes[k]->rGetAppliedForce()/r_damping_constants[k];
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<double>& AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetDampingConstants()
+{
+    if (!mDampingConstantsAreValid || !CanCacheDampingConstants())
+    {
+        mDampingConstants.resize(mForceAccumulationNodes.size());
+        for (unsigned k=0; k<mForceAccumulationNodes.size(); k++)
+        {
+            mDampingConstants[k] = GetDampingConstant(mForceAccumulationNodes[k]->GetIndex());
+        }
+        mDampingConstantsAreValid = true;
+    }
+    return mDampingConstants;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::InvalidateDampingConstants()
+{
+    mDampingConstantsAreValid = false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Node<SPACE_DIM>* AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetForceAccumulationNode(unsigned position)
+{
+    assert(position < mForceAccumulationNodes.size());
+    return mForceAccumulationNodes[position];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsAccumulatingForces() const
+{
+    return mIsAccumulatingForces;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetNumForceAccumulationNodes() const
+{
+    return mForceAccumulationNodes.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetForceAccumulationPosition(unsigned nodeIndex) const
+{
+    if (nodeIndex < mForceAccumulationPositions.size())
+    {
+        return mForceAccumulationPositions[nodeIndex];
+    }
+    return UNSIGNED_UNSET;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double* AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetAppliedForceComponents(unsigned component)
+{
+    assert(component < SPACE_DIM);
+    return mAppliedForceComponents.data() + component*mForceAccumulationNodes.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::UpdatePairIncidence(const std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                                                                                  bool isPersistent)
+{
+    const unsigned num_pairs = rNodePairs.size();
+    if (isPersistent && mpPairIncidenceList == &rNodePairs && mPairIncidenceNumPairs == num_pairs)
+    {
+        return;
+    }
+
+    // A counting sort of the pair ends by the position of their node
+    const unsigned num_nodes = mForceAccumulationNodes.size();
+    std::vector<unsigned> end_positions(2*num_pairs);
+    mPairIncidenceOffsets.assign(num_nodes + 1, 0);
+    for (unsigned p=0; p<num_pairs; p++)
+    {
+        end_positions[2*p] = GetForceAccumulationPosition(rNodePairs[p].first->GetIndex());
+        end_positions[2*p + 1] = GetForceAccumulationPosition(rNodePairs[p].second->GetIndex());
+        for (unsigned end=2*p; end<2*p+2; end++)
+        {
+            if (end_positions[end] != UNSIGNED_UNSET)
+            {
+                mPairIncidenceOffsets[end_positions[end] + 1]++;
+            }
+        }
+    }
+    for (unsigned k=0; k<num_nodes; k++)
+    {
+        mPairIncidenceOffsets[k + 1] += mPairIncidenceOffsets[k];
+    }
+    mPairIncidenceEnds.resize(mPairIncidenceOffsets[num_nodes]);
+    std::vector<unsigned> next_slot(mPairIncidenceOffsets.begin(), mPairIncidenceOffsets.end() - 1);
+    for (unsigned end=0; end<2*num_pairs; end++)
+    {
+        if (end_positions[end] != UNSIGNED_UNSET)
+        {
+            mPairIncidenceEnds[next_slot[end_positions[end]]++] = end;
+        }
+    }
+
+    mpPairIncidenceList = isPersistent ? &rNodePairs : nullptr;
+    mPairIncidenceNumPairs = num_pairs;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::InvalidatePairIncidence()
+{
+    mpPairIncidenceList = nullptr;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<unsigned>& AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetPairIncidenceOffsets() const
+{
+    return mPairIncidenceOffsets;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<unsigned>& AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetPairIncidenceEnds() const
+{
+    return mPairIncidenceEnds;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractOffLatticeCellPopulation<ELEMENT_DIM, SPACE_DIM>::OutputCellPopulationParameters(out_stream& rParamsFile)
 {
@@ -64,6 +64,60 @@ private:
         archive & mAbsoluteMovementThreshold;
     }
 
+    /**
+     * Whether two-body forces may currently be accumulated in mAppliedForceComponents,
+     * between calls to BeginForceAccumulation() and EndForceAccumulation(). Not archived.
+     */
+    bool mIsAccumulatingForces;
+
+    /** The nodes whose applied forces are accumulated in mAppliedForceComponents, in node iterator order. */
+    std::vector<Node<SPACE_DIM>*> mForceAccumulationNodes;
+
+    /**
+     * The position of each node in mForceAccumulationNodes, indexed by global node index
+     * (UNSIGNED_UNSET for nodes that are not iterated over, such as halo nodes).
+     */
+    std::vector<unsigned> mForceAccumulationPositions;
+
+    /**
+     * The forces accumulated since BeginForceAccumulation(), stored as a structure of arrays:
+     * component d of the force on the node at position k in mForceAccumulationNodes is stored
+     * at d*N + k, where N is the number of nodes. These are added to the applied force stored
+     * by each node when EndForceAccumulation() is called.
+     */
+    std::vector<double> mAppliedForceComponents;
+
+    /**
+     * Where the pair ends incident to each node in mForceAccumulationNodes start in
+     * mPairIncidenceEnds; the ends incident to the node at position k run up to, but
+     * not including, mPairIncidenceOffsets[k+1].
+     */
+    std::vector<unsigned> mPairIncidenceOffsets;
+
+    /**
+     * The pair ends incident to each node, in pair order. End 2p is the first node of
+     * pair p and end 2p+1 is the second.
+     */
+    std::vector<unsigned> mPairIncidenceEnds;
+
+    /**
+     * The persistent list of node pairs described by mPairIncidenceOffsets and
+     * mPairIncidenceEnds, or nullptr if these must be rebuilt before they are next used.
+     */
+    const std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >* mpPairIncidenceList;
+
+    /** The number of pairs in *mpPairIncidenceList when the incidence arrays were built. */
+    unsigned mPairIncidenceNumPairs;
+
+    /** The damping constant of each node in mForceAccumulationNodes, if mDampingConstantsAreValid. */
+    std::vector<double> mDampingConstants;
+
+    /**
+     * Whether mDampingConstants is up to date. Reset whenever the nodes found by
+     * BeginForceAccumulation() differ from those found by the previous call.
+     */
+    bool mDampingConstantsAreValid;
+
 protected:
     /**
      * Damping constant for normal cells has units of kg s^-1
@@ -92,6 +146,14 @@ protected:
      */
     AbstractOffLatticeCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh);
 
+    /**
+     * @return whether the damping constant of each node may be cached until InvalidateDampingConstants()
+     * is called, which OffLatticeSimulation does at the start of each time step. This is only safe
+     * where the damping constants depend on nothing but the cells' mutation states. Returns false
+     * by default.
+     */
+    virtual bool CanCacheDampingConstants();
+
 public:
 
     /**
@@ -116,6 +178,16 @@ public:
      */
     virtual unsigned AddNode(Node<SPACE_DIM>* pNewNode)=0;
 
+    /**
+     * @return whether the nodes may be moved by adding displacements to their locations in
+     * place, as ForwardEulerNumericalMethod does on its fused path, rather than through
+     * SetNode() and CheckForStepSizeException(). This requires the population to be a
+     * subclass of AbstractCentreBasedCellPopulation that does not override
+     * CheckForStepSizeException(), and SetNode() to do nothing but move the node.
+     * Returns false by default.
+     */
+    virtual bool CanMoveNodesInPlace();
+
     /**
      * Move the node with a given index to a new point in space.
      *
@@ -202,6 +274,108 @@ public:
      */
     double GetDampingConstantMutant();
 
+    /**
+     * Clear the applied force on each node and zero contiguous arrays owned by the
+     * population, in which forces that support it (such as subclasses of
+     * AbstractTwoBodyInteractionForce) accumulate their contributions until
+     * EndForceAccumulation() is called. Until then, the applied force stored by each node
+     * holds only the contributions of other forces.
+     */
+    void BeginForceAccumulation();
+
+    /**
+     * Stop accumulating forces, and add the accumulated forces to the applied force on
+     * each node.
+     */
+    void EndForceAccumulation();
+
+    /**
+     * Stop accumulating forces, add the accumulated forces to the applied force on each
+     * node, and divide the total applied force on each node by its damping constant.
+     *
+     * @param rForcesIncludingDamping filled with the total applied force on each node divided
+     *     by its damping constant, in node iterator order
+     */
+    void EndForceAccumulation(std::vector<c_vector<double, SPACE_DIM> >& rForcesIncludingDamping);
+
+    /**
+     * @return the damping constant of each node, in node iterator order as at the last call to
+     * BeginForceAccumulation(). The damping constants are cached where CanCacheDampingConstants()
+     * allows it.
+     */
+    const std::vector<double>& rGetDampingConstants();
+
+    /**
+     * Discard any cached damping constants. This is done automatically when nodes are added or
+     * removed or when the damping constants are set, but must be called after any cell's mutation
+     * state is changed.
+     */
+    void InvalidateDampingConstants();
+
+    /**
+     * @param position the position of a node in the force accumulation arrays
+     * @return the node at this position
+     */
+    Node<SPACE_DIM>* GetForceAccumulationNode(unsigned position);
+
+    /**
+     * @return whether applied forces are being accumulated in the population's arrays.
+     */
+    bool IsAccumulatingForces() const;
+
+    /**
+     * @return the number of nodes whose applied forces are being accumulated.
+     */
+    unsigned GetNumForceAccumulationNodes() const;
+
+    /**
+     * @param nodeIndex the global index of a node
+     * @return the position of the node in the force accumulation arrays, or UNSIGNED_UNSET
+     * if its applied force is not accumulated (for example if it is a halo node).
+     */
+    unsigned GetForceAccumulationPosition(unsigned nodeIndex) const;
+
+    /**
+     * @param component a spatial component, less than SPACE_DIM
+     * @return a pointer to the contiguous array in which to accumulate this component of the
+     * force on each node, indexed by position as given by GetForceAccumulationPosition().
+     */
+    double* GetAppliedForceComponents(unsigned component);
+
+    /**
+     * List the pair ends incident to each node of the force accumulation arrays, in pair
+     * order, for rGetPairIncidenceOffsets() and rGetPairIncidenceEnds(). Pair ends at nodes
+     * whose forces are not accumulated (such as halo nodes) are left out.
+     *
+     * A persistent list is only listed again once InvalidatePairIncidence() has been called,
+     * its size has changed, or BeginForceAccumulation() has found different nodes.
+     *
+     * @param rNodePairs the pairs of interacting nodes
+     * @param isPersistent whether rNodePairs is kept between calls, as the population's own
+     *     node pairs are, rather than gathered afresh each time
+     */
+    void UpdatePairIncidence(const std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                             bool isPersistent);
+
+    /**
+     * Discard the pair incidence arrays of a persistent list of node pairs. Must be called
+     * whenever such a list is recalculated.
+     */
+    void InvalidatePairIncidence();
+
+    /**
+     * @return where the pair ends incident to the node at each position start in
+     * rGetPairIncidenceEnds(), with one more entry giving the total number of ends.
+     */
+    const std::vector<unsigned>& rGetPairIncidenceOffsets() const;
+
+    /**
+     * @return the pair ends incident to each node, in pair order, as listed by the last
+     * call to UpdatePairIncidence(). End 2p is the first node of pair p and end 2p+1 is
+     * the second.
+     */
+    const std::vector<unsigned>& rGetPairIncidenceEnds() const;
+
     /**
      * Overridden OutputCellPopulationParameters() method.
      *
@@ -60,6 +60,9 @@ void CellwiseDataGradient<DIM>::SetupGradients(AbstractCellPopulation<DIM>& rCel
     // The number of elements containing a given node (excl ghost elements)
     std::vector<unsigned> num_real_elems_for_node(num_nodes, 0);
 
+    // Look up the index of the item in CellData once, rather than by name for every node
+    unsigned item_index = CellDataRegistry::Instance()->GetIndex(rItemName);
+
     for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
     {
         Element<DIM,DIM>& r_elem = *(r_mesh.GetElement(elem_index));
@@ -89,7 +92,7 @@ void CellwiseDataGradient<DIM>::SetupGradients(AbstractCellPopulation<DIM>& rCel
 
             // If no ghost element, get PDE solution
             CellPtr p_cell = pCellPopulation->GetCellUsingLocationIndex(node_global_index);
-            double pde_solution = p_cell->GetCellData()->GetItem(rItemName);
+            double pde_solution = p_cell->GetCellData()->GetItem(item_index);
 
             // Interpolate gradient
             for (unsigned i=0; i<DIM; i++)
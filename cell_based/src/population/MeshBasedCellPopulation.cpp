@@ -124,6 +124,18 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetNode(unsigned nodeIndex,
     static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh)).SetNode(nodeIndex, rNewLocation, false);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::CanCacheDampingConstants()
+{
+    return !mUseAreaBasedDampingConstant;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::CanMoveNodesInPlace()
+{
+    return rGetMesh().CanMoveNodesInPlace();
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetDampingConstant(unsigned nodeIndex)
 {
@@ -328,10 +340,10 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
         UpdateGhostNodesAfterReMesh(node_map);
 
         // Update the mappings between cells and location indices
-        std::map<Cell*, unsigned> old_cell_location_map = this->mCellLocationMap;
+        std::unordered_map<Cell*, unsigned> old_cell_location_map = this->mCellLocationMap;
 
         // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
+        this->ClearLocationCellMap();
         this->mCellLocationMap.clear();
 
         for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
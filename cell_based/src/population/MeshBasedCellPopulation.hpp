@@ -156,6 +156,14 @@ protected:
      */
     virtual void Validate();
 
+    /**
+     * Overridden CanCacheDampingConstants() method.
+     *
+     * @return false if the damping constants depend on cell areas, true if they depend only on
+     *     the cells' mutation states.
+     */
+    bool CanCacheDampingConstants();
+
 public:
     /**
      * Create a new cell population facade from a mesh and collection of cells.
@@ -181,6 +189,13 @@ public:
      */
     MeshBasedCellPopulation(MutableMesh<ELEMENT_DIM, SPACE_DIM>& rMesh);
 
+    /**
+     * Overridden CanMoveNodesInPlace() method.
+     *
+     * @return whether the mesh allows it.
+     */
+    bool CanMoveNodesInPlace();
+
     /**
      * Destructor.
      */
@@ -34,6 +34,13 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "NodeBasedCellPopulation.hpp"
+
+#include <sstream>
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "CellDataRegistry.hpp"
+#include "CellLabel.hpp"
 #include "MathsCustomFunctions.hpp"
 #include "VtkMeshWriter.hpp"
 
@@ -47,10 +54,18 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh,
       mDeleteMesh(deleteMesh),
       mUseVariableRadii(false),
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mUseVerletLists(false),
+      mVerletSkin(0.0)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 
+    // In parallel each process holds only some of the global node indices
+    if (PetscTools::IsParallel())
+    {
+        this->UseHashedLocationCellMap();
+    }
+
     if (validate)
     {
         Validate();
@@ -63,9 +78,16 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh)
       mDeleteMesh(true),
       mUseVariableRadii(false), // will be set by serialize() method
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mUseVerletLists(false),
+      mVerletSkin(0.0)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
+
+    if (PetscTools::IsParallel())
+    {
+        this->UseHashedLocationCellMap();
+    }
 }
 
 template<unsigned DIM>
@@ -113,6 +135,7 @@ template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::Clear()
 {
     mNodePairs.clear();
+    this->InvalidatePairIncidence();
 }
 
 template<unsigned DIM>
@@ -145,12 +168,30 @@ void NodeBasedCellPopulation<DIM>::SetNode(unsigned nodeIndex, ChastePoint<DIM>&
     mpNodesOnlyMesh->SetNode(nodeIndex, rNewLocation, false);
 }
 
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::CanMoveNodesInPlace()
+{
+    return mpNodesOnlyMesh->CanMoveNodesInPlace();
+}
+
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::CanCacheDampingConstants()
+{
+    return true;
+}
+
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
     UpdateCellProcessLocation();
 
-    mpNodesOnlyMesh->UpdateBoxCollection();
+    // With Verlet lists, the boxes and node pairs are only recalculated once nodes have moved far enough
+    bool recalculate_node_pairs = !mUseVerletLists || NodePairsNeedRecalculating(hasHadBirthsOrDeaths);
+
+    if (recalculate_node_pairs)
+    {
+        mpNodesOnlyMesh->UpdateBoxCollection();
+    }
 
     if (mLoadBalanceMesh)
     {
@@ -166,11 +207,23 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 
     RefreshHaloCells();
 
-    mpNodesOnlyMesh->CalculateInteriorNodePairs(mNodePairs);
+    if (recalculate_node_pairs)
+    {
+        mpNodesOnlyMesh->CalculateInteriorNodePairs(mNodePairs);
+    }
 
     AddReceivedHaloCells();
 
-    mpNodesOnlyMesh->CalculateBoundaryNodePairs(mNodePairs);
+    if (recalculate_node_pairs)
+    {
+        mpNodesOnlyMesh->CalculateBoundaryNodePairs(mNodePairs);
+
+        if (mUseVerletLists)
+        {
+            SetUpVerletLists();
+        }
+        this->InvalidatePairIncidence();
+    }
 
     /*
      * Update cell radii based on CellData
@@ -191,6 +244,79 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     PetscTools::Barrier("Update");
 }
 
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::NodePairsNeedRecalculating(bool hasHadBirthsOrDeaths)
+{
+    if (hasHadBirthsOrDeaths
+        || PetscTools::IsParallel()
+        || mVerletReferenceLocations.size() != mpNodesOnlyMesh->GetNumNodes())
+    {
+        return true;
+    }
+
+    // Two nodes which have each moved less than half the skin are still paired if they are within the cut-off
+    double max_displacement_squared = 0.25*mVerletSkin*mVerletSkin;
+    unsigned i = 0;
+    for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter, ++i)
+    {
+        c_vector<double, DIM> displacement = mpNodesOnlyMesh->GetVectorFromAtoB(mVerletReferenceLocations[i], node_iter->rGetLocation());
+        if (inner_prod(displacement, displacement) > max_displacement_squared)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetUpVerletLists()
+{
+    // Only keep the pairs that can come within the cut-off length before the next recalculation
+    double list_radius = GetMechanicsCutOffLength() + mVerletSkin;
+    double cut_off_squared = list_radius*list_radius;
+    unsigned num_kept = 0;
+    for (unsigned i=0; i<mNodePairs.size(); i++)
+    {
+        c_vector<double, DIM> separation = mpNodesOnlyMesh->GetVectorFromAtoB(mNodePairs[i].first->rGetLocation(),
+                                                                              mNodePairs[i].second->rGetLocation());
+        if (inner_prod(separation, separation) <= cut_off_squared)
+        {
+            mNodePairs[num_kept++] = mNodePairs[i];
+        }
+    }
+    mNodePairs.resize(num_kept);
+
+    mVerletReferenceLocations.clear();
+    mVerletReferenceLocations.reserve(mpNodesOnlyMesh->GetNumNodes());
+    for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        mVerletReferenceLocations.push_back(node_iter->rGetLocation());
+    }
+}
+
+template<unsigned DIM>
+double NodeBasedCellPopulation<DIM>::GetActiveVerletSkin()
+{
+    // In parallel the node pairs are recalculated every time step, so the boxes are not widened
+    return (mUseVerletLists && PetscTools::IsSequential()) ? mVerletSkin : 0.0;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetMeshInteractionDistance(double cutOffLength)
+{
+    double interaction_distance = cutOffLength + GetActiveVerletSkin();
+    if (interaction_distance != mpNodesOnlyMesh->GetMaximumInteractionDistance())
+    {
+        // The next Update() puts the nodes back in the new boxes
+        mpNodesOnlyMesh->ResetBoxCollection(interaction_distance);
+    }
+    mVerletReferenceLocations.clear();
+}
+
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
 {
@@ -200,10 +326,10 @@ void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
 
         // Update the mappings between cells and location indices
         ///\todo we want to make mCellLocationMap private - we need to find a better way of doing this
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::unordered_map<Cell*, unsigned> old_map = this->mCellLocationMap;
 
         // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
+        this->ClearLocationCellMap();
         this->mCellLocationMap.clear();
 
         for (std::list<CellPtr>::iterator it = this->mCells.begin();
@@ -322,7 +448,8 @@ void NodeBasedCellPopulation<DIM>::AcceptCellWriter(boost::shared_ptr<AbstractCe
 template<unsigned DIM>
 double NodeBasedCellPopulation<DIM>::GetMechanicsCutOffLength()
 {
-    return mpNodesOnlyMesh->GetMaximumInteractionDistance();
+    // With Verlet lists the mesh's boxes are widened by the skin
+    return mpNodesOnlyMesh->GetMaximumInteractionDistance() - GetActiveVerletSkin();
 }
 
 template<unsigned DIM>
@@ -349,6 +476,38 @@ void NodeBasedCellPopulation<DIM>::SetLoadBalanceFrequency(unsigned loadBalanceF
     mLoadBalanceFrequency = loadBalanceFrequency;
 }
 
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetUseVerletLists(bool useVerletLists)
+{
+    double cut_off_length = GetMechanicsCutOffLength();
+    mUseVerletLists = useVerletLists;
+    SetMeshInteractionDistance(cut_off_length);
+}
+
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::GetUseVerletLists()
+{
+    return mUseVerletLists;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetVerletSkin(double verletSkin)
+{
+    if (verletSkin < 0.0)
+    {
+        EXCEPTION("The Verlet skin must be non-negative.");
+    }
+    double cut_off_length = GetMechanicsCutOffLength();
+    mVerletSkin = verletSkin;
+    SetMeshInteractionDistance(cut_off_length);
+}
+
+template<unsigned DIM>
+double NodeBasedCellPopulation<DIM>::GetVerletSkin()
+{
+    return mVerletSkin;
+}
+
 template<unsigned DIM>
 double NodeBasedCellPopulation<DIM>::GetWidth(const unsigned& rDimension)
 {
@@ -372,10 +531,14 @@ c_vector<double, DIM> NodeBasedCellPopulation<DIM>::GetSizeOfCellPopulation()
 template<unsigned DIM>
 std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNodesWithinNeighbourhoodRadius(unsigned index, double neighbourhoodRadius)
 {
-    // Check neighbourhoodRadius is less than the interaction radius. If not you wont return all the correct nodes
-    if (neighbourhoodRadius > mpNodesOnlyMesh->GetMaximumInteractionDistance())
+    /*
+     * Check neighbourhoodRadius is less than the interaction radius. If not you wont return all the correct nodes.
+     * With Verlet lists the neighbours were found within the cut-off plus the skin, but nodes may since have
+     * moved by up to half the skin each, so only the cut-off itself is safe.
+     */
+    if (neighbourhoodRadius > GetMechanicsCutOffLength())
     {
-        EXCEPTION("neighbourhoodRadius should be less than or equal to the  the maximum interaction radius defined on the NodesOnlyMesh");
+        EXCEPTION("neighbourhoodRadius should be less than or equal to the mechanics cut-off length of the population");
     }
 
     std::set<unsigned> neighbouring_node_indices;
@@ -441,8 +604,8 @@ std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNeighbouringNodeIndices(unsi
         EXCEPTION("mNodeNeighbours not set up. Call Update() before GetNeighbouringNodeIndices()");
     }
 
-    // Make sure that the max_interaction distance is smaller than or equal to the box collection size
-    if (!(radius_of_cell_i * 2.0 <= mpNodesOnlyMesh->GetMaximumInteractionDistance()))
+    // Make sure that the max_interaction distance is smaller than or equal to the box collection size (less any Verlet skin)
+    if (!(radius_of_cell_i * 2.0 <= GetMechanicsCutOffLength()))
     {
         EXCEPTION("mpNodesOnlyMesh::mMaxInteractionDistance is smaller than twice the radius of cell " << index << " (" << radius_of_cell_i << ") so interactions may be missed. Make the cut-off larger to avoid errors.");
     }
@@ -476,7 +639,7 @@ std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNeighbouringNodeIndices(unsi
             double max_interaction_distance = radius_of_cell_i + radius_of_cell_j;
 
             // Make sure that the max_interaction distance is smaller than or equal to the box collection size
-            if (!(max_interaction_distance <= mpNodesOnlyMesh->GetMaximumInteractionDistance()))
+            if (!(max_interaction_distance <= GetMechanicsCutOffLength()))
             {
                 EXCEPTION("mpNodesOnlyMesh::mMaxInteractionDistance is smaller than the sum of radius of cell " << index << " (" << radius_of_cell_i << ") and cell " << (*iter) << " (" << radius_of_cell_j <<"). Make the cut-off larger to avoid errors.");
             }
@@ -755,6 +918,37 @@ void NodeBasedCellPopulation<DIM>::SendCellsToNeighbourProcesses()
 {
     MPI_Status status;
 
+    if (mpNodesOnlyMesh->GetUseBlockDecomposition())
+    {
+        // Exchange cells in one direction at a time. Every process sends in the same direction and
+        // receives from the opposite one, so the blocking communication cannot deadlock.
+        mCellsRecvFromProcesses.clear();
+        unsigned num_directions = SmallPow(3u, DIM);
+        for (unsigned direction=0; direction<num_directions; direction++)
+        {
+            unsigned destination = mpNodesOnlyMesh->GetNeighbouringProcess(direction);
+            unsigned source = mpNodesOnlyMesh->GetNeighbouringProcess(num_directions - 1 - direction);
+
+            if (destination != UNSIGNED_UNSET)
+            {
+                boost::shared_ptr<std::vector<std::pair<CellPtr, Node<DIM>* > > > p_cells(&mCellsToSendToProcesses[destination], null_deleter());
+                if (source != UNSIGNED_UNSET)
+                {
+                    mCellsRecvFromProcesses[source] = rGetNeighbourCommunicator(source).SendRecvObject(p_cells, destination, mCellCommunicationTag, source, mCellCommunicationTag, status);
+                }
+                else
+                {
+                    rGetNeighbourCommunicator(destination).SendObject(p_cells, destination, mCellCommunicationTag);
+                }
+            }
+            else if (source != UNSIGNED_UNSET)
+            {
+                mCellsRecvFromProcesses[source] = rGetNeighbourCommunicator(source).RecvObject(source, mCellCommunicationTag, status);
+            }
+        }
+        return;
+    }
+
     if (!PetscTools::AmTopMost())
     {
         boost::shared_ptr<std::vector<std::pair<CellPtr, Node<DIM>* > > > p_cells_right(&mCellsToSendRight, null_deleter());
@@ -839,6 +1033,23 @@ void NodeBasedCellPopulation<DIM>::AddNodeAndCellToSendLeft(unsigned nodeIndex)
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::AddReceivedCells()
 {
+    if (mpNodesOnlyMesh->GetUseBlockDecomposition())
+    {
+        for (typename std::map<unsigned, boost::shared_ptr<std::vector<std::pair<CellPtr, Node<DIM>* > > > >::iterator process_iter = mCellsRecvFromProcesses.begin();
+             process_iter != mCellsRecvFromProcesses.end();
+             ++process_iter)
+        {
+            for (typename std::vector<std::pair<CellPtr, Node<DIM>* > >::iterator iter = process_iter->second->begin();
+                 iter != process_iter->second->end();
+                 ++iter)
+            {
+                boost::shared_ptr<Node<DIM> > p_node(iter->second);
+                AddMovedCell(iter->first, p_node);
+            }
+        }
+        return;
+    }
+
     if (!PetscTools::AmMaster())
     {
         for (typename std::vector<std::pair<CellPtr, Node<DIM>* > >::iterator iter = mpCellsRecvLeft->begin();
@@ -869,30 +1080,50 @@ void NodeBasedCellPopulation<DIM>::UpdateCellProcessLocation()
 
     mpNodesOnlyMesh->CalculateNodesOutsideLocalDomain();
 
-    std::vector<unsigned> nodes_to_send_right = mpNodesOnlyMesh->rGetNodesToSendRight();
-    AddCellsToSendRight(nodes_to_send_right);
+    if (mpNodesOnlyMesh->GetUseBlockDecomposition())
+    {
+        std::map<unsigned, std::vector<unsigned> > nodes_to_send = mpNodesOnlyMesh->rGetNodesToSendToProcesses();
+        AddCellsToSendToProcesses(nodes_to_send);
 
-    std::vector<unsigned> nodes_to_send_left = mpNodesOnlyMesh->rGetNodesToSendLeft();
-    AddCellsToSendLeft(nodes_to_send_left);
+        SendCellsToNeighbourProcesses();
 
-    // Post non-blocking send / receives so communication on both sides can start.
-    SendCellsToNeighbourProcesses();
+        for (std::map<unsigned, std::vector<unsigned> >::iterator process_iter = nodes_to_send.begin();
+             process_iter != nodes_to_send.end();
+             ++process_iter)
+        {
+            for (unsigned i=0; i<process_iter->second.size(); i++)
+            {
+                DeleteMovedCell(process_iter->second[i]);
+            }
+        }
+    }
+    else
+    {
+        std::vector<unsigned> nodes_to_send_right = mpNodesOnlyMesh->rGetNodesToSendRight();
+        AddCellsToSendRight(nodes_to_send_right);
 
-    // Post blocking receive calls that wait until communication complete.
-    //GetReceivedCells();
+        std::vector<unsigned> nodes_to_send_left = mpNodesOnlyMesh->rGetNodesToSendLeft();
+        AddCellsToSendLeft(nodes_to_send_left);
 
-    for (std::vector<unsigned>::iterator iter = nodes_to_send_right.begin();
-         iter != nodes_to_send_right.end();
-         ++iter)
-    {
-        DeleteMovedCell(*iter);
-    }
+        // Post non-blocking send / receives so communication on both sides can start.
+        SendCellsToNeighbourProcesses();
 
-    for (std::vector<unsigned>::iterator iter = nodes_to_send_left.begin();
-         iter != nodes_to_send_left.end();
-         ++iter)
-    {
-        DeleteMovedCell(*iter);
+        // Post blocking receive calls that wait until communication complete.
+        //GetReceivedCells();
+
+        for (std::vector<unsigned>::iterator iter = nodes_to_send_right.begin();
+             iter != nodes_to_send_right.end();
+             ++iter)
+        {
+            DeleteMovedCell(*iter);
+        }
+
+        for (std::vector<unsigned>::iterator iter = nodes_to_send_left.begin();
+             iter != nodes_to_send_left.end();
+             ++iter)
+        {
+            DeleteMovedCell(*iter);
+        }
     }
 
     AddReceivedCells();
@@ -911,13 +1142,266 @@ void NodeBasedCellPopulation<DIM>::RefreshHaloCells()
     mHaloCellLocationMap.clear();
     mLocationHaloCellMap.clear();
 
-    std::vector<unsigned> halos_to_send_right = mpNodesOnlyMesh->rGetHaloNodesToSendRight();
-    AddCellsToSendRight(halos_to_send_right);
+    std::vector<unsigned> processes = GetNeighbouringProcesses();
+    for (unsigned i=0; i<processes.size(); i++)
+    {
+        PackedDataBuffer& r_buffer = mHaloSendBuffers[processes[i]];
+        PackHaloCells(processes[i], rGetHaloCellsToSend(processes[i]), r_buffer);
 
-    std::vector<unsigned> halos_to_send_left = mpNodesOnlyMesh->rGetHaloNodesToSendLeft();
-    AddCellsToSendLeft(halos_to_send_left);
+        MPI_Request request;
+        MPI_Isend(r_buffer.GetData(), r_buffer.GetSize(), MPI_BYTE, processes[i], mHaloCommunicationTag, PetscTools::GetWorld(), &request);
+        mHaloSendRequests.push_back(request);
+    }
+}
 
-    NonBlockingSendCellsToNeighbourProcesses();
+template<unsigned DIM>
+std::vector<unsigned> NodeBasedCellPopulation<DIM>::GetNeighbouringProcesses()
+{
+    std::vector<unsigned> processes;
+    if (mpNodesOnlyMesh->GetUseBlockDecomposition())
+    {
+        unsigned num_directions = SmallPow(3u, DIM);
+        for (unsigned direction=0; direction<num_directions; direction++)
+        {
+            unsigned process = mpNodesOnlyMesh->GetNeighbouringProcess(direction);
+            if (process != UNSIGNED_UNSET)
+            {
+                processes.push_back(process);
+            }
+        }
+    }
+    else
+    {
+        if (!PetscTools::AmMaster())
+        {
+            processes.push_back(PetscTools::GetMyRank() - 1);
+        }
+        if (!PetscTools::AmTopMost())
+        {
+            processes.push_back(PetscTools::GetMyRank() + 1);
+        }
+    }
+    return processes;
+}
+
+template<unsigned DIM>
+std::vector<unsigned>& NodeBasedCellPopulation<DIM>::rGetHaloCellsToSend(unsigned process)
+{
+    if (mpNodesOnlyMesh->GetUseBlockDecomposition())
+    {
+        return mpNodesOnlyMesh->rGetHaloNodesToSendToProcesses()[process];
+    }
+    else if (process > PetscTools::GetMyRank())
+    {
+        return mpNodesOnlyMesh->rGetHaloNodesToSendRight();
+    }
+    else
+    {
+        return mpNodesOnlyMesh->rGetHaloNodesToSendLeft();
+    }
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::PackHaloCells(unsigned process, const std::vector<unsigned>& rLocationIndices, PackedDataBuffer& rBuffer)
+{
+    std::map<unsigned, std::pair<CellPtr, std::size_t> >& r_sent_cells = mHaloCellsSentToProcesses[process];
+    std::map<unsigned, std::pair<CellPtr, std::size_t> > sent_cells;
+    std::vector<CellPtr> cells_to_serialize;
+
+    rBuffer.Clear();
+
+    // The CellData names registered since the last halo exchange with this process
+    CellDataRegistry* p_registry = CellDataRegistry::Instance();
+    unsigned& r_num_names_sent = mHaloCellDataNamesSentToProcesses[process];
+    unsigned num_names = p_registry->GetNumNames();
+    rBuffer.Pack<unsigned>(num_names - r_num_names_sent);
+    for (unsigned name_index=r_num_names_sent; name_index<num_names; name_index++)
+    {
+        rBuffer.PackBytes(p_registry->rGetName(name_index));
+    }
+    r_num_names_sent = num_names;
+
+    rBuffer.Pack<unsigned>(rLocationIndices.size());
+    for (unsigned i=0; i<rLocationIndices.size(); i++)
+    {
+        unsigned index = rLocationIndices[i];
+        CellPtr p_cell = this->GetCellUsingLocationIndex(index);
+        Node<DIM>* p_node = this->GetNode(index);
+
+        // The receiving process still has this cell from last time unless it, or its state, has changed
+        std::size_t fingerprint = CalculateHaloCellFingerprint(p_cell);
+        typename std::map<unsigned, std::pair<CellPtr, std::size_t> >::iterator sent_iter = r_sent_cells.find(index);
+        bool send_state = (sent_iter == r_sent_cells.end())
+                          || (sent_iter->second.first != p_cell)
+                          || (sent_iter->second.second != fingerprint);
+        if (send_state)
+        {
+            cells_to_serialize.push_back(p_cell);
+        }
+        sent_cells[index] = std::make_pair(p_cell, fingerprint);
+
+        rBuffer.Pack(index);
+        rBuffer.Pack(send_state);
+        rBuffer.PackArray(&(p_node->rGetLocation()[0]), DIM);
+
+        bool has_attributes = p_node->HasNodeAttributes();
+        rBuffer.Pack(has_attributes);
+        if (has_attributes)
+        {
+            rBuffer.Pack(p_node->GetRadius());
+            std::vector<double>& r_attributes = p_node->rGetNodeAttributes();
+            rBuffer.Pack<unsigned>(r_attributes.size());
+            rBuffer.PackArray(r_attributes.data(), r_attributes.size());
+        }
+
+        // The registry indices and values of the CellData items
+        boost::shared_ptr<CellData> p_cell_data = p_cell->GetCellData();
+        std::vector<unsigned> data_indices = p_cell_data->GetIndices();
+        rBuffer.Pack<unsigned>(data_indices.size());
+        rBuffer.PackArray(data_indices.data(), data_indices.size());
+        for (unsigned k=0; k<data_indices.size(); k++)
+        {
+            rBuffer.Pack(p_cell_data->GetItem(data_indices[k]));
+        }
+    }
+    r_sent_cells.swap(sent_cells);
+
+    if (!cells_to_serialize.empty())
+    {
+        std::ostringstream ss(std::ios::binary);
+        {
+            boost::archive::binary_oarchive output_arch(ss);
+            const std::vector<CellPtr>& r_cells_to_serialize = cells_to_serialize;
+            output_arch << r_cells_to_serialize;
+        }
+        rBuffer.PackBytes(ss.str());
+    }
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::UnpackHaloCells(unsigned process, PackedDataBuffer& rBuffer)
+{
+    // Register any CellData names which the sending process has not sent before
+    std::vector<unsigned>& r_data_indices = mHaloCellDataIndicesRecvFromProcesses[process];
+    unsigned num_new_names = rBuffer.Unpack<unsigned>();
+    for (unsigned n=0; n<num_new_names; n++)
+    {
+        r_data_indices.push_back(CellDataRegistry::Instance()->GetIndex(rBuffer.UnpackBytes()));
+    }
+
+    unsigned num_cells = rBuffer.Unpack<unsigned>();
+
+    std::vector<unsigned> indices(num_cells);
+    std::vector<bool> has_state(num_cells);
+    std::vector<boost::shared_ptr<Node<DIM> > > nodes(num_cells);
+    std::vector<std::vector<unsigned> > cell_data_indices(num_cells);
+    std::vector<std::vector<double> > cell_data_values(num_cells);
+    bool any_state = false;
+
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        indices[i] = rBuffer.Unpack<unsigned>();
+        has_state[i] = rBuffer.Unpack<bool>();
+        any_state = any_state || has_state[i];
+
+        c_vector<double, DIM> location;
+        rBuffer.UnpackArray(&location[0], DIM);
+        nodes[i].reset(new Node<DIM>(indices[i], location));
+
+        if (rBuffer.Unpack<bool>())
+        {
+            nodes[i]->SetRadius(rBuffer.Unpack<double>());
+            unsigned num_attributes = rBuffer.Unpack<unsigned>();
+            for (unsigned a=0; a<num_attributes; a++)
+            {
+                nodes[i]->AddNodeAttribute(rBuffer.Unpack<double>());
+            }
+        }
+
+        unsigned num_items = rBuffer.Unpack<unsigned>();
+        cell_data_indices[i].resize(num_items);
+        rBuffer.UnpackArray(cell_data_indices[i].data(), num_items);
+        cell_data_values[i].resize(num_items);
+        rBuffer.UnpackArray(cell_data_values[i].data(), num_items);
+    }
+
+    std::vector<CellPtr> cells_with_state;
+    if (any_state)
+    {
+        std::istringstream ss(rBuffer.UnpackBytes(), std::ios::binary);
+        boost::archive::binary_iarchive input_arch(ss);
+        input_arch >> cells_with_state;
+    }
+    assert(rBuffer.IsFullyUnpacked());
+
+    std::map<unsigned, CellPtr>& r_recv_cells = mHaloCellsRecvFromProcesses[process];
+    std::map<unsigned, CellPtr> recv_cells;
+    unsigned num_with_state = 0;
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        CellPtr p_cell;
+        if (has_state[i])
+        {
+            p_cell = cells_with_state[num_with_state++];
+        }
+        else
+        {
+            // Reuse the copy of the cell received last time, and update its CellData values
+            assert(r_recv_cells.find(indices[i]) != r_recv_cells.end());
+            p_cell = r_recv_cells[indices[i]];
+
+            boost::shared_ptr<CellData> p_cell_data = p_cell->GetCellData();
+            assert(p_cell_data->GetNumItems() == cell_data_values[i].size());
+            for (unsigned k=0; k<cell_data_values[i].size(); k++)
+            {
+                assert(cell_data_indices[i][k] < r_data_indices.size());
+                p_cell_data->SetItem(r_data_indices[cell_data_indices[i][k]], cell_data_values[i][k]);
+            }
+        }
+        recv_cells[indices[i]] = p_cell;
+
+        AddHaloCell(p_cell, nodes[i]);
+    }
+    r_recv_cells.swap(recv_cells);
+}
+
+template<unsigned DIM>
+std::size_t NodeBasedCellPopulation<DIM>::CalculateHaloCellFingerprint(CellPtr pCell)
+{
+    std::size_t fingerprint = 0;
+    boost::hash_combine(fingerprint, pCell->GetCellId());
+    boost::hash_combine(fingerprint, pCell->GetBirthTime());
+    boost::hash_combine(fingerprint, pCell->GetAncestor());
+    boost::hash_combine(fingerprint, pCell->IsDead());
+    boost::hash_combine(fingerprint, pCell->HasApoptosisBegun());
+    if (pCell->HasApoptosisBegun())
+    {
+        boost::hash_combine(fingerprint, pCell->GetStartOfApoptosisTime());
+    }
+    boost::hash_combine(fingerprint, pCell->GetApoptosisTime());
+    boost::hash_combine(fingerprint, pCell->GetCellCycleModel()->GetIdentifier());
+    boost::hash_combine(fingerprint, pCell->GetSrnModel()->GetIdentifier());
+
+    CellPropertyCollection& r_properties = pCell->rGetCellPropertyCollection();
+    for (CellPropertyCollection::Iterator it = r_properties.Begin(); it != r_properties.End(); ++it)
+    {
+        boost::hash_combine(fingerprint, (*it)->GetIdentifier());
+
+        // Labels are the only properties whose instances of one class can differ
+        boost::shared_ptr<CellLabel> p_label = boost::dynamic_pointer_cast<CellLabel>(*it);
+        if (p_label)
+        {
+            boost::hash_combine(fingerprint, p_label->GetColour());
+        }
+    }
+
+    // Registry indices are only compared on this process, so needn't be turned into names
+    std::vector<unsigned> data_indices = pCell->GetCellData()->GetIndices();
+    for (unsigned k=0; k<data_indices.size(); k++)
+    {
+        boost::hash_combine(fingerprint, data_indices[k]);
+    }
+    return fingerprint;
 }
 
 template<unsigned DIM>
@@ -943,30 +1427,55 @@ void NodeBasedCellPopulation<DIM>::AddCellsToSendLeft(std::vector<unsigned>& cel
 }
 
 template<unsigned DIM>
-void NodeBasedCellPopulation<DIM>::AddReceivedHaloCells()
+void NodeBasedCellPopulation<DIM>::AddCellsToSendToProcesses(std::map<unsigned, std::vector<unsigned> >& rCellLocationIndices)
 {
-    GetReceivedCells();
+    mCellsToSendToProcesses.clear();
 
-    if (!PetscTools::AmMaster())
+    for (std::map<unsigned, std::vector<unsigned> >::iterator process_iter = rCellLocationIndices.begin();
+         process_iter != rCellLocationIndices.end();
+         ++process_iter)
     {
-        for (typename std::vector<std::pair<CellPtr, Node<DIM>* > >::iterator iter = mpCellsRecvLeft->begin();
-                iter != mpCellsRecvLeft->end();
-                ++iter)
+        std::vector<std::pair<CellPtr, Node<DIM>* > >& r_cells_to_send = mCellsToSendToProcesses[process_iter->first];
+        for (unsigned i=0; i < process_iter->second.size(); i++)
         {
-            boost::shared_ptr<Node<DIM> > p_node(iter->second);
-            AddHaloCell(iter->first, p_node);
-
+            r_cells_to_send.push_back(GetCellNodePair(process_iter->second[i]));
         }
     }
-    if (!PetscTools::AmTopMost())
+}
+
+template<unsigned DIM>
+ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > >& NodeBasedCellPopulation<DIM>::rGetNeighbourCommunicator(unsigned process)
+{
+    boost::shared_ptr<ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > > >& rp_communicator = mNeighbourCommunicators[process];
+    if (!rp_communicator)
     {
-        for (typename std::vector<std::pair<CellPtr, Node<DIM>* > >::iterator iter = mpCellsRecvRight->begin();
-                iter != mpCellsRecvRight->end();
-                ++iter)
-        {
-            boost::shared_ptr<Node<DIM> > p_node(iter->second);
-            AddHaloCell(iter->first, p_node);
-        }
+        rp_communicator.reset(new ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > >());
+    }
+    return *rp_communicator;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::AddReceivedHaloCells()
+{
+    std::vector<unsigned> processes = GetNeighbouringProcesses();
+    for (unsigned i=0; i<processes.size(); i++)
+    {
+        MPI_Status status;
+        MPI_Probe(processes[i], mHaloCommunicationTag, PetscTools::GetWorld(), &status);
+        int size;
+        MPI_Get_count(&status, MPI_BYTE, &size);
+
+        mHaloRecvBuffer.Resize(size);
+        MPI_Recv(mHaloRecvBuffer.GetData(), size, MPI_BYTE, processes[i], mHaloCommunicationTag, PetscTools::GetWorld(), &status);
+
+        UnpackHaloCells(processes[i], mHaloRecvBuffer);
+    }
+
+    // The send buffers may be reused once the sends are complete
+    if (!mHaloSendRequests.empty())
+    {
+        MPI_Waitall(mHaloSendRequests.size(), &mHaloSendRequests[0], MPI_STATUSES_IGNORE);
+        mHaloSendRequests.clear();
     }
 
     mpNodesOnlyMesh->AddHaloNodesToBoxes();
@@ -37,10 +37,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NODEBASEDCELLPOPULATION_HPP_
 
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include <boost/serialization/base_object.hpp>
 
 
 #include "ObjectCommunicator.hpp"
+#include "PackedDataBuffer.hpp"
 #include "AbstractCentreBasedCellPopulation.hpp"
 #include "NodesOnlyMesh.hpp"
 
@@ -94,9 +96,52 @@ private:
     /** A communicator to send cells to the left hand process */
     ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > > mLeftCommunicator;
 
+    /** The cells to send to each neighbouring process, when the mesh is split between processes in blocks */
+    std::map<unsigned, std::vector<std::pair<CellPtr, Node<DIM>* > > > mCellsToSendToProcesses;
+
+    /** The cells received from each neighbouring process, when the mesh is split between processes in blocks */
+    std::map<unsigned, boost::shared_ptr<std::vector<std::pair<CellPtr, Node<DIM>* > > > > mCellsRecvFromProcesses;
+
+    /** Communicators to exchange cells with each neighbouring process, when the mesh is split between processes in blocks */
+    std::map<unsigned, boost::shared_ptr<ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > > > > mNeighbourCommunicators;
+
     /** The tag used to send and recieve cell information */
     static const unsigned mCellCommunicationTag = 123;
 
+    /** The tag used to send and receive packed halo cells */
+    static const unsigned mHaloCommunicationTag = 124;
+
+    /**
+     * For each neighbouring process, the cell last sent as a halo from each location index, with
+     * a fingerprint of its state. A cell which is sent again with the same state is packed without
+     * its serialized state. See PackHaloCells().
+     */
+    std::map<unsigned, std::map<unsigned, std::pair<CellPtr, std::size_t> > > mHaloCellsSentToProcesses;
+
+    /** For each neighbouring process, the halo cell last received at each location index. See UnpackHaloCells(). */
+    std::map<unsigned, std::map<unsigned, CellPtr> > mHaloCellsRecvFromProcesses;
+
+    /**
+     * For each neighbouring process, the number of CellDataRegistry names already sent to it. Since
+     * names are never unregistered, only those registered since are sent. See PackHaloCells().
+     */
+    std::map<unsigned, unsigned> mHaloCellDataNamesSentToProcesses;
+
+    /**
+     * For each neighbouring process, the index in this process's CellDataRegistry of each CellData
+     * item, in the order of that process's registry. See UnpackHaloCells().
+     */
+    std::map<unsigned, std::vector<unsigned> > mHaloCellDataIndicesRecvFromProcesses;
+
+    /** The packed halo cells being sent to each neighbouring process, kept until the sends complete. */
+    std::map<unsigned, PackedDataBuffer> mHaloSendBuffers;
+
+    /** The requests for the halo sends in progress. */
+    std::vector<MPI_Request> mHaloSendRequests;
+
+    /** A buffer to receive packed halo cells into. */
+    PackedDataBuffer mHaloRecvBuffer;
+
     /** Pointers to halo cells */
     std::vector<CellPtr> mHaloCells;
 
@@ -112,6 +157,15 @@ private:
     /** The frequency at which the mesh is rebalanced */
     unsigned mLoadBalanceFrequency;
 
+    /** Whether to keep the node pairs between time steps (Verlet lists), defaults to false. */
+    bool mUseVerletLists;
+
+    /** The skin distance of the Verlet lists, see SetVerletSkin(). */
+    double mVerletSkin;
+
+    /** The location of each node (in node iterator order) when the node pairs were last calculated. */
+    std::vector<c_vector<double, DIM> > mVerletReferenceLocations;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -128,6 +182,11 @@ private:
     {
         archive & boost::serialization::base_object<AbstractCentreBasedCellPopulation<DIM> >(*this);
         archive & mUseVariableRadii;
+        if (version > 0)
+        {
+            archive & mUseVerletLists;
+            archive & mVerletSkin;
+        }
 
         this->Validate();
     }
@@ -156,7 +215,8 @@ private:
     void DeleteMovedCell(unsigned index);
 
     /**
-     * Send and receive halo nodes with neighbours and populate memory structures to store them
+     * Pack the halo cells for each neighbouring process and start sending them. The halo cells
+     * are received by AddReceivedHaloCells().
      */
     void RefreshHaloCells();
 
@@ -189,10 +249,73 @@ private:
     void AddCellsToSendLeft(std::vector<unsigned>& cellLocationIndices);
 
     /**
-     * Add halo cells to the halo structure on this process.
+     * Add collections of cells to send to each neighbouring process, when the mesh is split between processes in blocks.
+     * @param rCellLocationIndices the location indices of cells to send to each process.
+     */
+    void AddCellsToSendToProcesses(std::map<unsigned, std::vector<unsigned> >& rCellLocationIndices);
+
+    /**
+     * @param process the rank of a neighbouring process
+     * @return the communicator used to exchange cells with that process, which is created on first use.
+     */
+    ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > >& rGetNeighbourCommunicator(unsigned process);
+
+    /**
+     * Receive the halo cells posted by RefreshHaloCells() and add them to the halo structure on this process.
      */
     void AddReceivedHaloCells();
 
+    /**
+     * @return the processes which exchange halo cells with this process.
+     */
+    std::vector<unsigned> GetNeighbouringProcesses();
+
+    /**
+     * @param process a neighbouring process
+     * @return the location indices of the halo cells to send to that process.
+     */
+    std::vector<unsigned>& rGetHaloCellsToSend(unsigned process);
+
+    /**
+     * Pack the halo cells for a neighbouring process into a buffer. The buffer starts with any names
+     * registered in the CellDataRegistry since the last call for that process. Each cell is then packed
+     * as a fixed record of its location index, location, node radius and attributes, and the registry
+     * indices and values of its CellData items. Cells which were not sent to that process as halos last
+     * time, or whose state has changed since (see CalculateHaloCellFingerprint()), are also serialized
+     * in full at the end of the buffer.
+     *
+     * @param process the neighbouring process
+     * @param rLocationIndices the location indices of the cells to send
+     * @param rBuffer the buffer to pack the cells into
+     */
+    void PackHaloCells(unsigned process, const std::vector<unsigned>& rLocationIndices, PackedDataBuffer& rBuffer);
+
+    /**
+     * Unpack the halo cells received from a neighbouring process, reusing the cells received
+     * last time for those which were not sent in full, and add them to the halo structures. The
+     * CellData indices of the sending process are mapped to those of this process through the
+     * names it has sent.
+     *
+     * @param process the neighbouring process
+     * @param rBuffer the buffer packed by PackHaloCells() on that process
+     */
+    void UnpackHaloCells(unsigned process, PackedDataBuffer& rBuffer);
+
+    /**
+     * Calculate a fingerprint of the state of a cell which a halo copy of it must share. Only values
+     * are hashed, never addresses: the cell id, ancestor, birth time, apoptosis and death, the class
+     * of each property (including the mutation state and proliferative type) and the colour of any
+     * label, the classes of the cell-cycle and SRN models, and which CellData items are stored. The
+     * values of the CellData items are sent with every halo cell, so are not included. The internal
+     * state of the cell-cycle and SRN models is not kept in sync, and is only refreshed on the halo
+     * copy when one of the fingerprinted fields changes; forces and other halo consumers must not
+     * rely on it.
+     *
+     * @param pCell the cell
+     * @return the fingerprint
+     */
+    std::size_t CalculateHaloCellFingerprint(CellPtr pCell);
+
     /**
      * Add a single halo cell with its node to the halo structures on this process.
      * @param pCell the cell to add.
@@ -207,6 +330,38 @@ private:
      */
     void UpdateMapsAfterRemesh(NodeMap& map);
 
+    /**
+     * When using Verlet lists, decide whether the node pairs from the last time step
+     * can be kept.  They must be recalculated after births or deaths, in parallel
+     * (where the halo nodes are replaced every time step) and as soon as any node has
+     * moved more than half the skin distance.
+     *
+     * @param hasHadBirthsOrDeaths whether the population has had births or deaths
+     * @return whether the node pairs must be recalculated
+     */
+    bool NodePairsNeedRecalculating(bool hasHadBirthsOrDeaths);
+
+    /**
+     * When using Verlet lists, drop the node pairs further apart than the mechanics
+     * cut-off length plus the skin, and record where each node is.
+     */
+    void SetUpVerletLists();
+
+    /**
+     * @return the Verlet skin if the node pairs are kept between time steps, and zero
+     * otherwise.
+     */
+    double GetActiveVerletSkin();
+
+    /**
+     * Make the mesh's maximum interaction distance, and so the width of its boxes, the
+     * mechanics cut-off length plus GetActiveVerletSkin(), so that the boxes find every
+     * pair the Verlet lists must hold.
+     *
+     * @param cutOffLength the mechanics cut-off length
+     */
+    void SetMeshInteractionDistance(double cutOffLength);
+
 protected:
 
     /**
@@ -221,6 +376,13 @@ protected:
      */
     virtual void Validate();
 
+    /**
+     * Overridden CanCacheDampingConstants() method.
+     *
+     * @return true, since the damping constant of each node depends only on its cell's mutation state.
+     */
+    virtual bool CanCacheDampingConstants();
+
 private:
 
     /**
@@ -240,6 +402,13 @@ public:
      */
     void SetNode(unsigned nodeIndex, ChastePoint<DIM>& rNewLocation);
 
+    /**
+     * Overridden CanMoveNodesInPlace() method.
+     *
+     * @return whether the mesh allows it.
+     */
+    virtual bool CanMoveNodesInPlace();
+
     /**
      * Default constructor.
      *
@@ -379,7 +548,8 @@ public:
     virtual void AcceptCellWriter(boost::shared_ptr<AbstractCellWriter<DIM, DIM> > pCellWriter, CellPtr pCell);
 
     /**
-     * @return the maximum interaction distance between cells, defined in NodesOnlyMesh.
+     * @return the maximum interaction distance between cells, defined in NodesOnlyMesh
+     * (less the Verlet skin, if the node pairs are kept between time steps).
      */
     double GetMechanicsCutOffLength();
 
@@ -407,6 +577,38 @@ public:
      */
     void SetLoadBalanceFrequency(unsigned loadBalanceFrequency);
 
+    /**
+     * Set whether to keep the node pairs between time steps (Verlet lists).
+     *
+     * The pairs are then those closer than GetMechanicsCutOffLength() plus the skin
+     * distance when they are calculated, and are only recalculated once a node has
+     * moved more than half the skin distance, so they always include every pair
+     * closer than the mechanics cut-off length.  The mesh's boxes are widened by the
+     * skin to find these pairs.  AbstractTwoBodyInteractionForce ignores the pairs
+     * that are further apart than the mechanics cut-off length.  The pairs are only
+     * kept between time steps in sequential.
+     *
+     * @param useVerletLists whether to use Verlet lists
+     */
+    void SetUseVerletLists(bool useVerletLists=true);
+
+    /**
+     * @return mUseVerletLists
+     */
+    bool GetUseVerletLists();
+
+    /**
+     * Set the skin distance of the Verlet lists.
+     *
+     * @param verletSkin the skin distance, which must be non-negative
+     */
+    void SetVerletSkin(double verletSkin);
+
+    /**
+     * @return mVerletSkin
+     */
+    double GetVerletSkin();
+
     /**
      * Overridden GetWidth() method.
      *
@@ -432,7 +634,8 @@ public:
      *
      * @param index the node index
      * @param neighbourhoodRadius the radius to find neighbours in.
-     * Note must be less than the MaximumInteractionDistance in the NodesOnlyMesh
+     * Note must be less than GetMechanicsCutOffLength(), which is the MaximumInteractionDistance
+     * in the NodesOnlyMesh unless Verlet lists are used
      *
      * @return the set of neighbouring node indices within neighbourhoodRadius of the specified node.
      */
@@ -476,13 +679,18 @@ public:
     /**
      * Send the contents of #mCellsToSendRight/Left to
      * neighbouring processes and receive from them into
-     * #mpCellsRecvRight/Left.
+     * #mpCellsRecvRight/Left.  If the mesh is split between
+     * processes in blocks, #mCellsToSendToProcesses is exchanged
+     * with every neighbouring process instead, into
+     * #mCellsRecvFromProcesses.
      */
     void SendCellsToNeighbourProcesses();
 
     /**
      * Send the contents of #mCellsToSendRight/Left to
      * neighbouring processes using asynchronous communication.
+     * This is only used when the mesh is split between
+     * processes in slabs.
      * #mpCellsRecvLeft/Right will not be updated until the
      * equivalent GetReceivedCells() is called.
      */
@@ -503,7 +711,7 @@ public:
     std::pair<CellPtr, Node<DIM>* > GetCellNodePair(unsigned nodeIndex);
 
     /**
-     * Add the contents of mpCellsRecvRight and mpCellsRecvLeft to the local population.
+     * Add the contents of mpCellsRecvRight and mpCellsRecvLeft (or mCellsRecvFromProcesses) to the local population.
      */
     void AddReceivedCells();
 
@@ -547,6 +755,19 @@ inline void load_construct_data(
     // Invoke inplace constructor to initialise instance
     ::new(t)NodeBasedCellPopulation<DIM>(*p_mesh);
 }
+
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(NodeBasedCellPopulation, 1)
+ * with a templated class.
+ */
+template <unsigned DIM>
+struct version<NodeBasedCellPopulation<DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
 }
 } // namespace ...
 
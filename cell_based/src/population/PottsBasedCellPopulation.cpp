@@ -39,6 +39,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NodesOnlyMesh.hpp"
 #include "CellPopulationElementWriter.hpp"
 #include "CellIdWriter.hpp"
+#include "OpenMpTools.hpp"
 
 // Needed to convert mesh in order to write nodes to VTK (visualize as glyphs)
 #include "VtkMeshWriter.hpp"
@@ -81,7 +82,8 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh,
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseParallelSweeps(false)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
     // Check each element has only one cell associated with it
@@ -97,7 +99,8 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh)
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseParallelSweeps(false)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
 }
@@ -260,6 +263,15 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
         p_gen->Shuffle(this->mUpdateRuleCollection);
     }
 
+    if (mUseParallelSweeps)
+    {
+        for (unsigned sweep=0; sweep<mNumSweepsPerTimestep; sweep++)
+        {
+            PerformParallelSweep(sweep);
+        }
+        return;
+    }
+
     for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
     {
         unsigned node_index;
@@ -274,74 +286,258 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
             node_index = i%num_nodes;
         }
 
-        Node<DIM>* p_node = this->mrMesh.GetNode(node_index);
-
         // Each node in the mesh must be in at most one element
-        assert(p_node->GetNumContainingElements() <= 1);
+        assert(this->mrMesh.GetNode(node_index)->GetNumContainingElements() <= 1);
 
         // Find a random available neighbouring node to overwrite current site
-        std::set<unsigned> neighbouring_node_indices = mpPottsMesh->GetMooreNeighbouringNodeIndices(node_index);
-        unsigned neighbour_location_index;
+        const std::set<unsigned>& r_neighbouring_node_indices = mpPottsMesh->rGetMooreNeighbouringNodeIndices(node_index);
 
-        if (!neighbouring_node_indices.empty())
+        if (!r_neighbouring_node_indices.empty())
         {
-            unsigned num_neighbours = neighbouring_node_indices.size();
+            unsigned num_neighbours = r_neighbouring_node_indices.size();
             unsigned chosen_neighbour = p_gen->randMod(num_neighbours);
 
-            std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
+            std::set<unsigned>::const_iterator neighbour_iter = r_neighbouring_node_indices.begin();
             for (unsigned j=0; j<chosen_neighbour; j++)
             {
                 neighbour_iter++;
             }
 
-            neighbour_location_index = *neighbour_iter;
+            unsigned neighbour_location_index = *neighbour_iter;
 
-            std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
-            std::set<unsigned> neighbour_containing_elements = GetNode(neighbour_location_index)->rGetContainingElementIndices();
             // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
-            if ((!containing_elements.empty() && neighbour_containing_elements.empty())
-                || (containing_elements.empty() && !neighbour_containing_elements.empty())
-                || (!containing_elements.empty() && !neighbour_containing_elements.empty() && *containing_elements.begin() != *neighbour_containing_elements.begin()))
+            if (IsSwitchPossible(node_index, neighbour_location_index))
             {
-                double delta_H = 0.0; // This is H_1-H_0.
-
-                // Now add contributions to the Hamiltonian from each AbstractPottsUpdateRule
-                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
-                     iter != this->mUpdateRuleCollection.end();
-                     ++iter)
-                {
-                    // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
-                    double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbour_location_index, p_node->GetIndex(), *this);
-                    delta_H += dH;
-                }
+                double delta_H = EvaluateHamiltonianChange(node_index, neighbour_location_index);
 
                 // Generate a uniform random number to do the random motion
                 double random_number = p_gen->ranf();
 
-                double p = exp(-delta_H/mTemperature);
-                if (delta_H <= 0 || random_number < p)
+                // The Boltzmann factor is only needed (and only evaluated) for unfavourable switches
+                if (delta_H <= 0 || random_number < exp(-delta_H/mTemperature))
                 {
-                    // Do swap
+                    SwitchNode(node_index, neighbour_location_index);
+                }
+            }
+        }
+    }
+}
 
-                    // Remove the current node from any elements containing it (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = containing_elements.begin();
-                         iter != containing_elements.end();
-                         ++iter)
-                    {
-                        GetElement(*iter)->DeleteNode(GetElement(*iter)->GetNodeLocalIndex(node_index));
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::IsSwitchPossible(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    const std::set<unsigned>& r_containing_elements = this->mrMesh.GetNode(nodeIndex)->rGetContainingElementIndices();
+    const std::set<unsigned>& r_neighbour_containing_elements = this->mrMesh.GetNode(neighbourIndex)->rGetContainingElementIndices();
 
-                        ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
-                    }
+    return (!r_containing_elements.empty() && r_neighbour_containing_elements.empty())
+        || (r_containing_elements.empty() && !r_neighbour_containing_elements.empty())
+        || (!r_containing_elements.empty() && !r_neighbour_containing_elements.empty() && *r_containing_elements.begin() != *r_neighbour_containing_elements.begin());
+}
 
-                    // Next add the current node to any elements containing the neighbouring node (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = neighbour_containing_elements.begin();
-                         iter != neighbour_containing_elements.end();
-                         ++iter)
-                    {
-                        GetElement(*iter)->AddNode(this->mrMesh.GetNode(node_index));
-                    }
+template<unsigned DIM>
+double PottsBasedCellPopulation<DIM>::EvaluateHamiltonianChange(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    double delta_H = 0.0; // This is H_1-H_0.
+
+    // Add contributions to the Hamiltonian from each AbstractPottsUpdateRule
+    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
+         iter != this->mUpdateRuleCollection.end();
+         ++iter)
+    {
+        // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
+        delta_H += (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbourIndex, nodeIndex, *this);
+    }
+    return delta_H;
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SwitchNode(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    // Move the node into the element containing the neighbouring node (there should be at most one such element)
+    const std::set<unsigned>& r_neighbour_containing_elements = this->mrMesh.GetNode(neighbourIndex)->rGetContainingElementIndices();
+    unsigned new_element_index = r_neighbour_containing_elements.empty() ? UNSIGNED_UNSET : *(r_neighbour_containing_elements.begin());
+
+    ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
+    mpPottsMesh->MoveNodeToElement(nodeIndex, new_element_index);
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUpParallelSweepTables()
+{
+    unsigned num_nodes = this->mrMesh.GetNumNodes();
+
+    // Flatten the Moore neighbourhoods, keeping their (increasing) order so neighbour choices match the serial sweep
+    mSweepNeighbourOffsets.assign(1, 0);
+    mSweepNeighbourOffsets.reserve(num_nodes+1);
+    mSweepNeighbourIndices.clear();
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        const std::set<unsigned>& r_neighbours = mpPottsMesh->rGetMooreNeighbouringNodeIndices(node_index);
+        mSweepNeighbourIndices.insert(mSweepNeighbourIndices.end(), r_neighbours.begin(), r_neighbours.end());
+        mSweepNeighbourOffsets.push_back(mSweepNeighbourIndices.size());
+    }
+
+    // Greedily give each node the smallest colour not used by any of its lower-indexed neighbours
+    std::vector<unsigned> colours(num_nodes, UNSIGNED_UNSET);
+    std::vector<unsigned> colour_last_used_by(1, UNSIGNED_UNSET);
+    unsigned num_colours = 0;
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        for (unsigned k=mSweepNeighbourOffsets[node_index]; k<mSweepNeighbourOffsets[node_index+1]; k++)
+        {
+            unsigned neighbour_colour = colours[mSweepNeighbourIndices[k]];
+            if (neighbour_colour != UNSIGNED_UNSET)
+            {
+                colour_last_used_by[neighbour_colour] = node_index;
+            }
+        }
+        unsigned colour = 0;
+        while (colour < num_colours && colour_last_used_by[colour] == node_index)
+        {
+            colour++;
+        }
+        if (colour == num_colours)
+        {
+            num_colours++;
+            colour_last_used_by.resize(num_colours + 1, UNSIGNED_UNSET);
+        }
+        colours[node_index] = colour;
+    }
+
+    // Group the nodes by colour with a counting sort, which keeps them in index order within each colour
+    mSweepColourOffsets.assign(num_colours+1, 0);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mSweepColourOffsets[colours[node_index]+1]++;
+    }
+    for (unsigned colour=0; colour<num_colours; colour++)
+    {
+        mSweepColourOffsets[colour+1] += mSweepColourOffsets[colour];
+    }
+    mSweepSites.resize(num_nodes);
+    std::vector<unsigned> next_slot(mSweepColourOffsets.begin(), mSweepColourOffsets.end()-1);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mSweepSites[next_slot[colours[node_index]]++] = node_index;
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::PerformParallelSweep(unsigned sweep)
+{
+    // The Potts mesh is fixed, so the tables only need setting up once
+    if (mSweepNeighbourOffsets.size() != this->mrMesh.GetNumNodes()+1)
+    {
+        SetUpParallelSweepTables();
+    }
+
+    // The update rules may then read the element surface areas concurrently
+    mpPottsMesh->CacheSurfaceAreasOfElements();
+
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    unsigned num_colours = mSweepColourOffsets.size()-1;
+    uint64_t time_step = SimulationTime::Instance()->GetTimeStepsElapsed();
+
+    std::vector<unsigned> colour_order(num_colours);
+    for (unsigned colour=0; colour<num_colours; colour++)
+    {
+        colour_order[colour] = colour;
+    }
+    if (this->mUpdateNodesInRandomOrder)
+    {
+        p_gen->Shuffle(num_colours, colour_order);
+    }
+
+    // Exceptions can't propagate out of a parallel region, so each thread keeps its first failure
+    const unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+    std::vector<boost::shared_ptr<Exception> > thread_exceptions(num_threads);
+    std::vector<unsigned> thread_failed_sites(num_threads, UNSIGNED_UNSET);
+
+    std::vector<unsigned> chosen_neighbours;
+    std::vector<char> accepted;
+
+    for (unsigned c=0; c<num_colours; c++)
+    {
+        const unsigned colour = colour_order[c];
+        const unsigned first_site = mSweepColourOffsets[colour];
+        const unsigned num_sites = mSweepColourOffsets[colour+1] - first_site;
+
+        /*
+         * Each node draws from its own counter-based stream, keyed by the node index and
+         * a substream counting the colours updated so far, so the numbers do not depend on
+         * the number of threads and never repeat within a simulation.
+         */
+        const uint64_t substream_id = (time_step*mNumSweepsPerTimestep + sweep)*num_colours + colour;
+
+        // No two nodes of the same colour are neighbours, so the switches can be evaluated independently
+        chosen_neighbours.assign(num_sites, UNSIGNED_UNSET);
+        accepted.assign(num_sites, 0);
+        bool any_failed = false;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif // CHASTE_OPENMP
+        for (unsigned i=0; i<num_sites; i++)
+        {
+            bool stop;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+            stop = any_failed;
+            const unsigned node_index = mSweepSites[first_site + i];
+            const unsigned num_neighbours = mSweepNeighbourOffsets[node_index+1] - mSweepNeighbourOffsets[node_index];
+            if (stop || num_neighbours == 0)
+            {
+                continue;
+            }
+
+            try
+            {
+                RandomNumberStream stream = p_gen->GetStream(node_index, substream_id);
+                chosen_neighbours[i] = mSweepNeighbourIndices[mSweepNeighbourOffsets[node_index] + stream.randMod(num_neighbours)];
+
+                if (IsSwitchPossible(node_index, chosen_neighbours[i]))
+                {
+                    double delta_H = EvaluateHamiltonianChange(node_index, chosen_neighbours[i]);
+                    accepted[i] = (delta_H <= 0 || stream.ranf() < exp(-delta_H/mTemperature));
+                }
+            }
+            catch (Exception& e)
+            {
+                const unsigned thread = OpenMpTools::GetThreadNum();
+                if (node_index < thread_failed_sites[thread])
+                {
+                    thread_failed_sites[thread] = node_index;
+                    thread_exceptions[thread].reset(new Exception(e));
+                }
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+                any_failed = true;
+            }
+        }
+
+        if (any_failed)
+        {
+            unsigned failed_thread = 0;
+            for (unsigned thread=1; thread<num_threads; thread++)
+            {
+                if (thread_failed_sites[thread] < thread_failed_sites[failed_thread])
+                {
+                    failed_thread = thread;
                 }
             }
+            throw *(thread_exceptions[failed_thread]);
+        }
+
+        // Make the accepted switches in node order
+        for (unsigned i=0; i<num_sites; i++)
+        {
+            if (accepted[i])
+            {
+                assert(chosen_neighbours[i] != UNSIGNED_UNSET);
+                SwitchNode(mSweepSites[first_site + i], chosen_neighbours[i]);
+            }
         }
     }
 }
@@ -509,6 +705,18 @@ unsigned PottsBasedCellPopulation<DIM>::GetNumSweepsPerTimestep()
     return mNumSweepsPerTimestep;
 }
 
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUseParallelSweeps(bool useParallelSweeps)
+{
+    mUseParallelSweeps = useParallelSweeps;
+}
+
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::GetUseParallelSweeps()
+{
+    return mUseParallelSweeps;
+}
+
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirectory)
 {
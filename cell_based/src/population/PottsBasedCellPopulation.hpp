@@ -91,6 +91,27 @@ private:
      */
     unsigned mNumSweepsPerTimestep;
 
+    /** Whether to perform checkerboard-parallel Monte Carlo sweeps, defaults to false. */
+    bool mUseParallelSweeps;
+
+    /**
+     * Offsets into mSweepNeighbourIndices: the Moore neighbours of node i are
+     * mSweepNeighbourIndices[mSweepNeighbourOffsets[i]] to mSweepNeighbourIndices[mSweepNeighbourOffsets[i+1]-1].
+     */
+    std::vector<unsigned> mSweepNeighbourOffsets;
+
+    /** The Moore neighbours of every node, stored contiguously in increasing index order. */
+    std::vector<unsigned> mSweepNeighbourIndices;
+
+    /**
+     * Offsets into mSweepSites: the nodes of colour c are
+     * mSweepSites[mSweepColourOffsets[c]] to mSweepSites[mSweepColourOffsets[c+1]-1].
+     */
+    std::vector<unsigned> mSweepColourOffsets;
+
+    /** The node indices grouped by colour, in increasing index order within each colour. */
+    std::vector<unsigned> mSweepSites;
+
     friend class boost::serialization::access;
     /**
      * Serialize the object and its member variables.
@@ -125,6 +146,57 @@ private:
      */
     void Validate();
 
+    /**
+     * Set up the flat neighbour tables and the colouring of the mesh used by the
+     * parallel sweeps.
+     *
+     * The nodes are coloured greedily, in index order, so that no two Moore neighbours
+     * share a colour; on a regular lattice this gives the usual checkerboard of 2^DIM
+     * sublattices.
+     */
+    void SetUpParallelSweepTables();
+
+    /**
+     * Perform one checkerboard-parallel Monte Carlo sweep of the mesh.
+     *
+     * Each colour is updated in turn. The changes in the Hamiltonian are evaluated
+     * concurrently against the configuration at the start of the colour, with each node
+     * drawing its random numbers from its own RandomNumberStream, and accepted switches
+     * are made in node order. The results therefore depend only on the random seed and
+     * the time step, not on the number of threads.
+     *
+     * @param sweep the index of the sweep within the time step
+     */
+    void PerformParallelSweep(unsigned sweep);
+
+    /**
+     * Sum the contributions of all the update rules to the change in the Hamiltonian
+     * if the given node is switched to the element containing the neighbouring node.
+     *
+     * @param nodeIndex the index of the node to be switched
+     * @param neighbourIndex the index of the neighbouring node
+     * @return the change in the Hamiltonian, H_1-H_0
+     */
+    double EvaluateHamiltonianChange(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * @return whether the given node and neighbouring node are in different elements,
+     * or exactly one of them is in the medium, so that a switch would change the configuration.
+     *
+     * @param nodeIndex the index of the node
+     * @param neighbourIndex the index of the neighbouring node
+     */
+    bool IsSwitchPossible(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * Move a node into the element containing the neighbouring node, removing it from
+     * any element currently containing it.
+     *
+     * @param nodeIndex the index of the node to be switched
+     * @param neighbourIndex the index of the neighbouring node
+     */
+    void SwitchNode(unsigned nodeIndex, unsigned neighbourIndex);
+
     /**
      * Overridden WriteVtkResultsToFile() method.
      *
@@ -386,6 +458,27 @@ public:
      */
     unsigned GetNumSweepsPerTimestep();
 
+    /**
+     * Set whether to perform checkerboard-parallel Monte Carlo sweeps.
+     *
+     * The nodes are split into sets of which no two are Moore neighbours, and each
+     * sweep visits every node once, one set at a time, evaluating the update rules
+     * for a set concurrently when Chaste is compiled with OpenMP. Switches within a
+     * set see the element volumes and surface areas from the start of the set, as is
+     * usual for parallel Cellular Potts schemes. mUpdateNodesInRandomOrder then only
+     * randomises the order in which the sets are visited.
+     *
+     * This setting is not archived.
+     *
+     * @param useParallelSweeps whether to use parallel sweeps
+     */
+    void SetUseParallelSweeps(bool useParallelSweeps=true);
+
+    /**
+     * @return mUseParallelSweeps
+     */
+    bool GetUseParallelSweeps();
+
     /**
      * Create a Element tessellation of the mesh for use in visualising the mesh.
      */
@@ -48,6 +48,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexT3SwapLocationsWriter.hpp"
 #include "AbstractCellBasedSimulation.hpp"
 
+#include <algorithm>
+#include <cfloat>
+#include <boost/foreach.hpp>
+
 template<unsigned DIM>
 VertexBasedCellPopulation<DIM>::VertexBasedCellPopulation(MutableVertexMesh<DIM, DIM>& rMesh,
                                           std::vector<CellPtr>& rCells,
@@ -57,7 +61,11 @@ VertexBasedCellPopulation<DIM>::VertexBasedCellPopulation(MutableVertexMesh<DIM,
     : AbstractOffLatticeCellPopulation<DIM>(rMesh, rCells, locationIndices),
       mDeleteMesh(deleteMesh),
       mOutputCellRearrangementLocations(true),
-      mRestrictVertexMovement(true)
+      mRestrictVertexMovement(true),
+      mIsDistributed(false),
+      mNextGlobalNodeIndex(0),
+      mLoadBalanceRegions(true),
+      mLoadBalanceFrequency(100)
 {
     mpMutableVertexMesh = static_cast<MutableVertexMesh<DIM, DIM>* >(&(this->mrMesh));
     mpVertexBasedDivisionRule.reset(new ShortAxisVertexBasedDivisionRule<DIM>());
@@ -82,7 +90,11 @@ VertexBasedCellPopulation<DIM>::VertexBasedCellPopulation(MutableVertexMesh<DIM,
     : AbstractOffLatticeCellPopulation<DIM>(rMesh),
       mDeleteMesh(true),
       mOutputCellRearrangementLocations(true),
-      mRestrictVertexMovement(true)
+      mRestrictVertexMovement(true),
+      mIsDistributed(false),
+      mNextGlobalNodeIndex(0),
+      mLoadBalanceRegions(true),
+      mLoadBalanceFrequency(100)
 {
     mpMutableVertexMesh = static_cast<MutableVertexMesh<DIM, DIM>* >(&(this->mrMesh));
 }
@@ -96,6 +108,662 @@ VertexBasedCellPopulation<DIM>::~VertexBasedCellPopulation()
     }
 }
 
+template<unsigned DIM>
+template<class CLASS>
+void VertexBasedCellPopulation<DIM>::ExchangeWithNeighbourProcesses(CLASS& rSendLeft,
+                                                                    CLASS& rSendRight,
+                                                                    boost::shared_ptr<CLASS>& rpRecvLeft,
+                                                                    boost::shared_ptr<CLASS>& rpRecvRight)
+{
+    MPI_Status status;
+    ObjectCommunicator<CLASS> communicator;
+
+    if (!PetscTools::AmTopMost())
+    {
+        boost::shared_ptr<CLASS> p_send_right(&rSendRight, null_deleter());
+        rpRecvRight = communicator.SendRecvObject(p_send_right, PetscTools::GetMyRank() + 1, mElementCommunicationTag, PetscTools::GetMyRank() + 1, mElementCommunicationTag, status);
+    }
+    if (!PetscTools::AmMaster())
+    {
+        boost::shared_ptr<CLASS> p_send_left(&rSendLeft, null_deleter());
+        rpRecvLeft = communicator.SendRecvObject(p_send_left, PetscTools::GetMyRank() - 1, mElementCommunicationTag, PetscTools::GetMyRank() - 1, mElementCommunicationTag, status);
+    }
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::CalculateProcessRegionBoundaries()
+{
+    unsigned num_procs = PetscTools::GetNumProcs();
+
+    // Find the centroid of each owned element, and the maximum extent of any element, along the last coordinate direction
+    std::vector<double> local_centroids;
+    double max_element_extent = 0.0;
+    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = mpMutableVertexMesh->GetElementIteratorBegin();
+         elem_iter != mpMutableVertexMesh->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        if (!elem_iter->GetOwnership())
+        {
+            continue;
+        }
+        local_centroids.push_back(mpMutableVertexMesh->GetCentroidOfElement(elem_iter->GetIndex())[DIM-1]);
+
+        double min_coordinate = DBL_MAX;
+        double max_coordinate = -DBL_MAX;
+        for (unsigned local_index=0; local_index<elem_iter->GetNumNodes(); local_index++)
+        {
+            double coordinate = elem_iter->GetNode(local_index)->rGetLocation()[DIM-1];
+            min_coordinate = std::min(min_coordinate, coordinate);
+            max_coordinate = std::max(max_coordinate, coordinate);
+        }
+        max_element_extent = std::max(max_element_extent, max_coordinate - min_coordinate);
+    }
+
+    // Gather the centroids of all elements onto every process
+    std::vector<double> sorted_centroids = local_centroids;
+    if (PetscTools::IsParallel())
+    {
+        int local_size = local_centroids.size();
+        std::vector<int> sizes(num_procs);
+        MPI_Allgather(&local_size, 1, MPI_INT, &sizes[0], 1, MPI_INT, PetscTools::GetWorld());
+
+        std::vector<int> offsets(num_procs, 0);
+        for (unsigned process=1; process<num_procs; process++)
+        {
+            offsets[process] = offsets[process-1] + sizes[process-1];
+        }
+        sorted_centroids.resize(offsets[num_procs-1] + sizes[num_procs-1]);
+        MPI_Allgatherv(local_centroids.empty() ? NULL : &local_centroids[0], local_size, MPI_DOUBLE,
+                       sorted_centroids.empty() ? NULL : &sorted_centroids[0], &sizes[0], &offsets[0], MPI_DOUBLE, PetscTools::GetWorld());
+
+        double local_extent = max_element_extent;
+        MPI_Allreduce(&local_extent, &max_element_extent, 1, MPI_DOUBLE, MPI_MAX, PetscTools::GetWorld());
+    }
+
+    unsigned num_elements = sorted_centroids.size();
+    if (num_elements < num_procs)
+    {
+        EXCEPTION("Cannot distribute " << num_elements << " cells between " << num_procs << " processes");
+    }
+
+    // Place the boundaries between regions so that each region contains a similar number of elements
+    std::sort(sorted_centroids.begin(), sorted_centroids.end());
+    std::vector<double> boundaries;
+    for (unsigned process=1; process<num_procs; process++)
+    {
+        unsigned i = (process*num_elements)/num_procs;
+        boundaries.push_back(0.5*(sorted_centroids[i-1] + sorted_centroids[i]));
+    }
+
+    /*
+     * When rebalancing, each boundary may move at most as far as the previous positions of the
+     * neighbouring boundaries, so that no cell needs to migrate further than a neighbouring process.
+     */
+    if (!mProcessRegionBoundaries.empty())
+    {
+        for (unsigned k=0; k<boundaries.size(); k++)
+        {
+            if (k > 0)
+            {
+                boundaries[k] = std::max(boundaries[k], mProcessRegionBoundaries[k-1]);
+            }
+            if (k+1 < boundaries.size())
+            {
+                boundaries[k] = std::min(boundaries[k], mProcessRegionBoundaries[k+1]);
+            }
+        }
+    }
+
+    // Elements owned by processes that are not neighbours must never share a node
+    for (unsigned process=1; process+1<num_procs; process++)
+    {
+        if (boundaries[process] - boundaries[process-1] < 2.0*max_element_extent)
+        {
+            EXCEPTION("The region owned by process " << process << " is narrower than twice the extent of an element; use fewer processes");
+        }
+    }
+
+    mProcessRegionBoundaries = boundaries;
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::DistributeBetweenProcesses()
+{
+    // This method only works in 2D
+    assert(DIM == 2);    // LCOV_EXCL_LINE - code will be removed at compile time
+
+    if (mIsDistributed)
+    {
+        EXCEPTION("The cell population has already been distributed between processes");
+    }
+
+    bool is_misplaced = !PetscTools::AmMaster() && (mpMutableVertexMesh->GetNumAllElements() > 0);
+    if (PetscTools::ReplicateBool(is_misplaced))
+    {
+        EXCEPTION("Only the master process may construct the cell population from a non-empty mesh before it is distributed");
+    }
+
+    CalculateProcessRegionBoundaries();
+
+    // New global node indices must not clash with the indices of the nodes of the initial mesh
+    unsigned num_initial_nodes = mpMutableVertexMesh->GetNumAllNodes();
+    if (PetscTools::IsParallel())
+    {
+        MPI_Bcast(&num_initial_nodes, 1, MPI_UNSIGNED, 0, PetscTools::GetWorld());
+    }
+    unsigned my_rank = PetscTools::GetMyRank();
+    mNextGlobalNodeIndex = num_initial_nodes + my_rank;
+
+    ObjectCommunicator<ElementPacket> communicator;
+    if (PetscTools::AmMaster())
+    {
+        // Give global indices to the nodes shared between elements owned by different processes
+        for (unsigned node_index=0; node_index<mpMutableVertexMesh->GetNumAllNodes(); node_index++)
+        {
+            Node<DIM>* p_node = mpMutableVertexMesh->GetNode(node_index);
+            const std::set<unsigned>& r_containing_elements = p_node->rGetContainingElementIndices();
+
+            std::set<unsigned> owning_processes;
+            for (std::set<unsigned>::const_iterator iter = r_containing_elements.begin();
+                 iter != r_containing_elements.end();
+                 ++iter)
+            {
+                owning_processes.insert(GetProcessOwningLocation(mpMutableVertexMesh->GetCentroidOfElement(*iter)));
+            }
+            if (owning_processes.size() > 1)
+            {
+                mGlobalNodeIndices[p_node] = node_index;
+            }
+        }
+
+        // Remove the elements owned by other processes, and their cells, and send them to their owners
+        std::vector<ElementPacket> elements_to_send(PetscTools::GetNumProcs());
+        std::vector<std::map<Node<DIM>*, Node<DIM>*> > node_copies(PetscTools::GetNumProcs());
+        for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+             cell_iter != this->mCells.end();
+             )
+        {
+            unsigned elem_index = this->GetLocationIndexUsingCell(*cell_iter);
+            unsigned process = GetProcessOwningLocation(mpMutableVertexMesh->GetCentroidOfElement(elem_index));
+            if (process != my_rank)
+            {
+                PackElement(elem_index, *cell_iter, elements_to_send[process], node_copies[process]);
+                mpMutableVertexMesh->RemoveElementPriorToReMesh(elem_index);
+                this->RemoveCellUsingLocationIndex(elem_index, *cell_iter);
+                cell_iter = this->mCells.erase(cell_iter);
+            }
+            else
+            {
+                ++cell_iter;
+            }
+        }
+
+        for (unsigned process=1; process<PetscTools::GetNumProcs(); process++)
+        {
+            boost::shared_ptr<ElementPacket> p_packet(&elements_to_send[process], null_deleter());
+            communicator.SendObject(p_packet, process, mElementCommunicationTag);
+            ClearNodeCopies(node_copies[process]);
+        }
+    }
+    else
+    {
+        // Receive the elements owned by this process
+        MPI_Status status;
+        boost::shared_ptr<ElementPacket> p_packet = communicator.RecvObject(0, mElementCommunicationTag, status);
+        UnpackElements(*p_packet, 0, false);
+    }
+
+    // Each process now holds only some of the global element indices
+    mIsDistributed = true;
+    this->UseHashedLocationCellMap();
+
+    // Remesh, and receive the halo elements from the neighbouring processes
+    Update();
+}
+
+template<unsigned DIM>
+bool VertexBasedCellPopulation<DIM>::IsDistributed() const
+{
+    return mIsDistributed;
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::SetLoadBalanceRegions(bool loadBalanceRegions)
+{
+    mLoadBalanceRegions = loadBalanceRegions;
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::SetLoadBalanceFrequency(unsigned loadBalanceFrequency)
+{
+    mLoadBalanceFrequency = loadBalanceFrequency;
+}
+
+template<unsigned DIM>
+const std::vector<double>& VertexBasedCellPopulation<DIM>::rGetProcessRegionBoundaries() const
+{
+    return mProcessRegionBoundaries;
+}
+
+template<unsigned DIM>
+unsigned VertexBasedCellPopulation<DIM>::GetProcessOwningLocation(const c_vector<double, DIM>& rLocation)
+{
+    return std::upper_bound(mProcessRegionBoundaries.begin(), mProcessRegionBoundaries.end(), rLocation[DIM-1]) - mProcessRegionBoundaries.begin();
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::PackElement(unsigned elementIndex,
+                                                 CellPtr pCell,
+                                                 ElementPacket& rPacket,
+                                                 std::map<Node<DIM>*, Node<DIM>*>& rNodeCopies)
+{
+    VertexElement<DIM, DIM>* p_element = mpMutableVertexMesh->GetElement(elementIndex);
+
+    std::vector<Node<DIM>*> node_copies;
+    for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+    {
+        Node<DIM>* p_node = p_element->GetNode(local_index);
+
+        typename std::map<Node<DIM>*, Node<DIM>*>::iterator copy_iter = rNodeCopies.find(p_node);
+        if (copy_iter == rNodeCopies.end())
+        {
+            // Give the node a global index if it does not already have one
+            if (mGlobalNodeIndices.find(p_node) == mGlobalNodeIndices.end())
+            {
+                mGlobalNodeIndices[p_node] = mNextGlobalNodeIndex;
+                mNextGlobalNodeIndex += PetscTools::GetNumProcs();
+            }
+
+            Node<DIM>* p_copy = new Node<DIM>(mGlobalNodeIndices[p_node], p_node->rGetLocation(), p_node->IsBoundaryNode());
+            copy_iter = rNodeCopies.insert(std::make_pair(p_node, p_copy)).first;
+        }
+        node_copies.push_back(copy_iter->second);
+    }
+
+    rPacket.push_back(std::make_pair(pCell, node_copies));
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::UnpackElements(ElementPacket& rPacket, unsigned process, bool isHalo)
+{
+    // Find the nodes that may be shared with the sending process
+    std::map<unsigned, Node<DIM>*> nodes_by_global_index;
+    for (typename std::map<Node<DIM>*, unsigned>::iterator iter = mGlobalNodeIndices.begin();
+         iter != mGlobalNodeIndices.end();
+         ++iter)
+    {
+        nodes_by_global_index[iter->second] = iter->first;
+    }
+
+    std::set<Node<DIM>*> copies_to_delete;
+    for (typename ElementPacket::iterator packet_iter = rPacket.begin();
+         packet_iter != rPacket.end();
+         ++packet_iter)
+    {
+        std::vector<Node<DIM>*> element_nodes;
+        for (unsigned local_index=0; local_index<packet_iter->second.size(); local_index++)
+        {
+            Node<DIM>* p_copy = packet_iter->second[local_index];
+            unsigned global_index = p_copy->GetIndex();
+
+            typename std::map<unsigned, Node<DIM>*>::iterator node_iter = nodes_by_global_index.find(global_index);
+            if (node_iter == nodes_by_global_index.end())
+            {
+                // This node is not yet present on this process, so add it to the mesh
+                mpMutableVertexMesh->AddNode(p_copy);
+                mGlobalNodeIndices[p_copy] = global_index;
+                nodes_by_global_index[global_index] = p_copy;
+                element_nodes.push_back(p_copy);
+            }
+            else
+            {
+                if (node_iter->second != p_copy)
+                {
+                    // The lower ranked process is responsible for the position of a shared node
+                    if (process < PetscTools::GetMyRank())
+                    {
+                        node_iter->second->rGetModifiableLocation() = p_copy->rGetLocation();
+                    }
+                    copies_to_delete.insert(p_copy);
+                }
+                element_nodes.push_back(node_iter->second);
+            }
+        }
+
+        VertexElement<DIM, DIM>* p_element = new VertexElement<DIM, DIM>(mpMutableVertexMesh->GetNumAllElements(), element_nodes);
+        unsigned elem_index = mpMutableVertexMesh->AddElement(p_element);
+
+        if (isHalo)
+        {
+            p_element->SetOwnership(false);
+            mLocationHaloCellMap[elem_index] = packet_iter->first;
+            mHaloElementProcesses[elem_index] = process;
+        }
+        else
+        {
+            this->mCells.push_back(packet_iter->first);
+            this->AddCellUsingLocationIndex(elem_index, packet_iter->first);
+        }
+    }
+
+    for (typename std::set<Node<DIM>*>::iterator iter = copies_to_delete.begin();
+         iter != copies_to_delete.end();
+         ++iter)
+    {
+        delete *iter;
+    }
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::UpdateDistributedElements()
+{
+    unsigned my_rank = PetscTools::GetMyRank();
+
+    // Send requests for cells to the right process, and receive those of the left process
+    std::vector<unsigned> requests_to_send_left;
+    std::vector<unsigned> requests_to_send_right(mCellIdsToRequestFromRight.begin(), mCellIdsToRequestFromRight.end());
+    boost::shared_ptr<std::vector<unsigned> > p_requests_from_left;
+    boost::shared_ptr<std::vector<unsigned> > p_requests_from_right;
+    ExchangeWithNeighbourProcesses(requests_to_send_left, requests_to_send_right, p_requests_from_left, p_requests_from_right);
+    if (p_requests_from_left)
+    {
+        mCellIdsToSendLeft.insert(p_requests_from_left->begin(), p_requests_from_left->end());
+    }
+
+    // Remove the halo elements, which are replaced below
+    for (std::map<unsigned, unsigned>::iterator iter = mHaloElementProcesses.begin();
+         iter != mHaloElementProcesses.end();
+         ++iter)
+    {
+        mpMutableVertexMesh->RemoveElementPriorToReMesh(iter->first);
+    }
+    mLocationHaloCellMap.clear();
+    mHaloElementProcesses.clear();
+
+    // Periodically move the boundaries between regions so that each again contains a similar number of elements
+    if (mLoadBalanceRegions && SimulationTime::Instance()->IsEndTimeAndNumberOfTimeStepsSetUp())
+    {
+        unsigned time_steps_elapsed = SimulationTime::Instance()->GetTimeStepsElapsed();
+        if (time_steps_elapsed > 0 && (time_steps_elapsed % mLoadBalanceFrequency) == 0)
+        {
+            CalculateProcessRegionBoundaries();
+        }
+    }
+
+    /*
+     * Migrate the cells that another process has requested or needs, and the cells whose centroids
+     * have left the region owned by this process (unless they are needed here), with their elements.
+     */
+    ElementPacket elements_to_send_left;
+    ElementPacket elements_to_send_right;
+    std::map<Node<DIM>*, Node<DIM>*> node_copies_left;
+    std::map<Node<DIM>*, Node<DIM>*> node_copies_right;
+    for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+         cell_iter != this->mCells.end();
+         )
+    {
+        unsigned cell_id = (*cell_iter)->GetCellId();
+        unsigned process = my_rank;
+        if (!PetscTools::AmMaster() && mCellIdsToSendLeft.find(cell_id) != mCellIdsToSendLeft.end())
+        {
+            process = my_rank - 1;
+        }
+        else if (mCellIdsToKeep.find(cell_id) == mCellIdsToKeep.end())
+        {
+            process = GetProcessOwningLocation(GetLocationOfCellCentre(*cell_iter));
+        }
+
+        if (process != my_rank)
+        {
+            unsigned elem_index = this->GetLocationIndexUsingCell(*cell_iter);
+            if (process < my_rank)
+            {
+                PackElement(elem_index, *cell_iter, elements_to_send_left, node_copies_left);
+            }
+            else
+            {
+                PackElement(elem_index, *cell_iter, elements_to_send_right, node_copies_right);
+            }
+
+            mpMutableVertexMesh->RemoveElementPriorToReMesh(elem_index);
+            this->RemoveCellUsingLocationIndex(elem_index, *cell_iter);
+            cell_iter = this->mCells.erase(cell_iter);
+        }
+        else
+        {
+            ++cell_iter;
+        }
+    }
+    mCellIdsToSendLeft.clear();
+    mCellIdsToRequestFromRight.clear();
+    mCellIdsToKeep.clear();
+
+    boost::shared_ptr<ElementPacket> p_elements_from_left;
+    boost::shared_ptr<ElementPacket> p_elements_from_right;
+    ExchangeWithNeighbourProcesses(elements_to_send_left, elements_to_send_right, p_elements_from_left, p_elements_from_right);
+    ClearNodeCopies(node_copies_left);
+    ClearNodeCopies(node_copies_right);
+
+    // Forget the global indices of nodes that are no longer present on this process
+    for (typename std::map<Node<DIM>*, unsigned>::iterator iter = mGlobalNodeIndices.begin();
+         iter != mGlobalNodeIndices.end();
+         )
+    {
+        if (iter->first->IsDeleted())
+        {
+            mGlobalNodeIndices.erase(iter++);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    if (p_elements_from_left)
+    {
+        UnpackElements(*p_elements_from_left, my_rank - 1, false);
+    }
+    if (p_elements_from_right)
+    {
+        UnpackElements(*p_elements_from_right, my_rank + 1, false);
+    }
+
+    // Exchange the extents, along the last coordinate direction, of the regions covered by the owned elements
+    std::vector<double> owned_extent(2);
+    owned_extent[0] = DBL_MAX;
+    owned_extent[1] = -DBL_MAX;
+    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = mpMutableVertexMesh->GetElementIteratorBegin();
+         elem_iter != mpMutableVertexMesh->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        for (unsigned local_index=0; local_index<elem_iter->GetNumNodes(); local_index++)
+        {
+            double coordinate = elem_iter->GetNode(local_index)->rGetLocation()[DIM-1];
+            owned_extent[0] = std::min(owned_extent[0], coordinate);
+            owned_extent[1] = std::max(owned_extent[1], coordinate);
+        }
+    }
+    boost::shared_ptr<std::vector<double> > p_extent_left;
+    boost::shared_ptr<std::vector<double> > p_extent_right;
+    ExchangeWithNeighbourProcesses(owned_extent, owned_extent, p_extent_left, p_extent_right);
+
+    // Send copies of the owned elements that reach the region covered by each neighbouring process
+    double margin = mpMutableVertexMesh->GetCellRearrangementThreshold();
+    ElementPacket halo_elements_to_send_left;
+    ElementPacket halo_elements_to_send_right;
+    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = mpMutableVertexMesh->GetElementIteratorBegin();
+         elem_iter != mpMutableVertexMesh->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        double min_coordinate = DBL_MAX;
+        double max_coordinate = -DBL_MAX;
+        for (unsigned local_index=0; local_index<elem_iter->GetNumNodes(); local_index++)
+        {
+            double coordinate = elem_iter->GetNode(local_index)->rGetLocation()[DIM-1];
+            min_coordinate = std::min(min_coordinate, coordinate);
+            max_coordinate = std::max(max_coordinate, coordinate);
+        }
+
+        unsigned elem_index = elem_iter->GetIndex();
+        if (p_extent_left && min_coordinate <= (*p_extent_left)[1] + margin)
+        {
+            PackElement(elem_index, this->GetCellUsingLocationIndex(elem_index), halo_elements_to_send_left, node_copies_left);
+        }
+        if (p_extent_right && max_coordinate >= (*p_extent_right)[0] - margin)
+        {
+            PackElement(elem_index, this->GetCellUsingLocationIndex(elem_index), halo_elements_to_send_right, node_copies_right);
+        }
+    }
+
+    boost::shared_ptr<ElementPacket> p_halo_elements_from_left;
+    boost::shared_ptr<ElementPacket> p_halo_elements_from_right;
+    ExchangeWithNeighbourProcesses(halo_elements_to_send_left, halo_elements_to_send_right, p_halo_elements_from_left, p_halo_elements_from_right);
+    ClearNodeCopies(node_copies_left);
+    ClearNodeCopies(node_copies_right);
+
+    if (p_halo_elements_from_left)
+    {
+        UnpackElements(*p_halo_elements_from_left, my_rank - 1, true);
+    }
+    if (p_halo_elements_from_right)
+    {
+        UnpackElements(*p_halo_elements_from_right, my_rank + 1, true);
+    }
+
+    /*
+     * Only the nodes of halo elements need global indices until the next update. These nodes cannot
+     * be deleted by ReMesh(), since the elements around them are not all owned by this process.
+     */
+    std::map<Node<DIM>*, unsigned> halo_global_node_indices;
+    for (std::map<unsigned, unsigned>::iterator iter = mHaloElementProcesses.begin();
+         iter != mHaloElementProcesses.end();
+         ++iter)
+    {
+        VertexElement<DIM, DIM>* p_element = mpMutableVertexMesh->GetElement(iter->first);
+        for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            Node<DIM>* p_node = p_element->GetNode(local_index);
+            halo_global_node_indices[p_node] = mGlobalNodeIndices[p_node];
+        }
+    }
+    mGlobalNodeIndices = halo_global_node_indices;
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::ClearNodeCopies(std::map<Node<DIM>*, Node<DIM>*>& rNodeCopies)
+{
+    for (typename std::map<Node<DIM>*, Node<DIM>*>::iterator iter = rNodeCopies.begin();
+         iter != rNodeCopies.end();
+         ++iter)
+    {
+        delete iter->second;
+    }
+    rNodeCopies.clear();
+}
+
+template<unsigned DIM>
+bool VertexBasedCellPopulation<DIM>::CanRearrangeAroundElement(unsigned elementIndex)
+{
+    VertexElement<DIM, DIM>* p_element = mpMutableVertexMesh->GetElement(elementIndex);
+    for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+    {
+        if (!mpMutableVertexMesh->CanRearrangeAroundNode(p_element->GetNode(local_index)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::DeferRearrangementAroundElement(unsigned elementIndex)
+{
+    // Find the elements that must be owned by a single process for a rearrangement around this element
+    std::set<unsigned> involved_elements;
+    VertexElement<DIM, DIM>* p_element = mpMutableVertexMesh->GetElement(elementIndex);
+    for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+    {
+        const std::set<unsigned>& r_containing_elements = p_element->GetNode(local_index)->rGetContainingElementIndices();
+        for (std::set<unsigned>::const_iterator elem_iter = r_containing_elements.begin();
+             elem_iter != r_containing_elements.end();
+             ++elem_iter)
+        {
+            VertexElement<DIM, DIM>* p_containing_element = mpMutableVertexMesh->GetElement(*elem_iter);
+            for (unsigned i=0; i<p_containing_element->GetNumNodes(); i++)
+            {
+                const std::set<unsigned>& r_neighbouring_elements = p_containing_element->GetNode(i)->rGetContainingElementIndices();
+                involved_elements.insert(r_neighbouring_elements.begin(), r_neighbouring_elements.end());
+            }
+        }
+    }
+
+    // The lowest ranked process owning any of these elements will carry out the rearrangement
+    unsigned my_rank = PetscTools::GetMyRank();
+    unsigned target_process = my_rank;
+    for (std::set<unsigned>::iterator iter = involved_elements.begin();
+         iter != involved_elements.end();
+         ++iter)
+    {
+        std::map<unsigned, unsigned>::iterator halo_iter = mHaloElementProcesses.find(*iter);
+        if (halo_iter != mHaloElementProcesses.end())
+        {
+            target_process = std::min(target_process, halo_iter->second);
+        }
+    }
+
+    for (std::set<unsigned>::iterator iter = involved_elements.begin();
+         iter != involved_elements.end();
+         ++iter)
+    {
+        unsigned cell_id = this->GetCellUsingLocationIndex(*iter)->GetCellId();
+        if (mHaloElementProcesses.find(*iter) != mHaloElementProcesses.end())
+        {
+            if (target_process == my_rank)
+            {
+                mCellIdsToRequestFromRight.insert(cell_id);
+            }
+        }
+        else if (target_process < my_rank)
+        {
+            mCellIdsToSendLeft.insert(cell_id);
+        }
+        else
+        {
+            mCellIdsToKeep.insert(cell_id);
+        }
+    }
+}
+
+template<unsigned DIM>
+CellPtr VertexBasedCellPopulation<DIM>::GetCellUsingLocationIndex(unsigned index)
+{
+    std::map<unsigned, CellPtr>::iterator iter = mLocationHaloCellMap.find(index);
+    if (iter != mLocationHaloCellMap.end())
+    {
+        return iter->second;
+    }
+    else
+    {
+        return AbstractCellPopulation<DIM, DIM>::GetCellUsingLocationIndex(index);
+    }
+}
+
+template<unsigned DIM>
+bool VertexBasedCellPopulation<DIM>::IsRoomToDivide(CellPtr pCell)
+{
+    if (mIsDistributed)
+    {
+        unsigned elem_index = this->GetLocationIndexUsingCell(pCell);
+        if (!CanRearrangeAroundElement(elem_index))
+        {
+            // Division would change elements owned by another process, so must wait until they are migrated here
+            DeferRearrangementAroundElement(elem_index);
+            return false;
+        }
+    }
+    return AbstractOffLatticeCellPopulation<DIM>::IsRoomToDivide(pCell);
+}
+
 template<unsigned DIM>
 double VertexBasedCellPopulation<DIM>::GetDampingConstant(unsigned nodeIndex)
 {
@@ -158,7 +826,7 @@ unsigned VertexBasedCellPopulation<DIM>::GetNumNodes()
 template<unsigned DIM>
 c_vector<double, DIM> VertexBasedCellPopulation<DIM>::GetLocationOfCellCentre(CellPtr pCell)
 {
-    return mpMutableVertexMesh->GetCentroidOfElement(this->mCellLocationMap[pCell.get()]);
+    return mpMutableVertexMesh->GetCentroidOfElement(this->GetLocationIndexUsingCell(pCell));
 }
 
 template<unsigned DIM>
@@ -232,17 +900,26 @@ unsigned VertexBasedCellPopulation<DIM>::RemoveDeadCells()
     {
         if ((*it)->IsDead())
         {
+            unsigned elem_index = this->GetLocationIndexUsingCell((*it));
+            if (mIsDistributed && !(this->GetElement(elem_index)->IsDeleted()) && !CanRearrangeAroundElement(elem_index))
+            {
+                // Removing the element would change elements owned by another process, so must wait until they are migrated here
+                DeferRearrangementAroundElement(elem_index);
+                ++it;
+                continue;
+            }
+
             // Count the cell as dead
             num_removed++;
 
             // Remove the element from the mesh if it is not deleted yet
             ///\todo (#2489) this should cause an error - we should fix this!
-            if (!(this->GetElement(this->GetLocationIndexUsingCell((*it)))->IsDeleted()))
+            if (!(this->GetElement(elem_index)->IsDeleted()))
             {
                 // This warning relies on the fact that there is only one other possibility for
                 // vertex elements to be marked as deleted: a T2 swap
                 WARN_ONCE_ONLY("A Cell is removed without performing a T2 swap. This could leave a void in the mesh.");
-                mpMutableVertexMesh->DeleteElementPriorToReMesh(this->GetLocationIndexUsingCell((*it)));
+                mpMutableVertexMesh->DeleteElementPriorToReMesh(elem_index);
             }
 
             // Delete the cell
@@ -287,6 +964,11 @@ bool VertexBasedCellPopulation<DIM>::IsCellAssociatedWithADeletedLocation(CellPt
 template<unsigned DIM>
 void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
+    if (mIsDistributed)
+    {
+        UpdateDistributedElements();
+    }
+
     VertexElementMap element_map(mpMutableVertexMesh->GetNumAllElements());
     mpMutableVertexMesh->ReMesh(element_map);
 
@@ -294,10 +976,10 @@ void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     {
         // Fix up the mappings between CellPtrs and VertexElements
         ///\todo We want to make these maps private, so we need a better way of doing the code below.
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::unordered_map<Cell*, unsigned> old_map = this->mCellLocationMap;
 
         this->mCellLocationMap.clear();
-        this->mLocationCellMap.clear();
+        this->ClearLocationCellMap();
 
         for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
              cell_iter != this->mCells.end();
@@ -311,11 +993,40 @@ void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
             this->SetCellUsingLocationIndex(new_elem_index, *cell_iter);
         }
 
+        // Halo elements are never deleted or rearranged by ReMesh(), but may be renumbered
+        std::map<unsigned, CellPtr> old_halo_map = mLocationHaloCellMap;
+        std::map<unsigned, unsigned> old_halo_processes = mHaloElementProcesses;
+
+        mLocationHaloCellMap.clear();
+        mHaloElementProcesses.clear();
+
+        for (std::map<unsigned, CellPtr>::iterator iter = old_halo_map.begin();
+             iter != old_halo_map.end();
+             ++iter)
+        {
+            assert(!element_map.IsDeleted(iter->first));
+
+            unsigned new_elem_index = element_map.GetNewIndex(iter->first);
+            mLocationHaloCellMap[new_elem_index] = iter->second;
+            mHaloElementProcesses[new_elem_index] = old_halo_processes[iter->first];
+        }
+
         // Check that each VertexElement has only one CellPtr associated with it in the updated cell population
         Validate();
     }
 
     element_map.ResetToIdentity();
+
+    if (mIsDistributed)
+    {
+        // Arrange for any rearrangements that could not be carried out here to take place at the next update
+        std::vector<unsigned> elements_awaiting_rearrangement;
+        mpMutableVertexMesh->GetOwnedElementsAwaitingRearrangement(elements_awaiting_rearrangement);
+        for (unsigned i=0; i<elements_awaiting_rearrangement.size(); i++)
+        {
+            DeferRearrangementAroundElement(elements_awaiting_rearrangement[i]);
+        }
+    }
 }
 
 template<unsigned DIM>
@@ -333,7 +1044,8 @@ void VertexBasedCellPopulation<DIM>::Validate()
 
     for (unsigned i=0; i<validated_element.size(); i++)
     {
-        if (validated_element[i] == 0)
+        // Halo elements are associated with cells owned by other processes
+        if (validated_element[i] == 0 && mpMutableVertexMesh->GetElement(i)->GetOwnership())
         {
             EXCEPTION("At time " << SimulationTime::Instance()->GetTime() <<", Element " << i << " does not appear to have a cell associated with it");
         }
@@ -396,8 +1108,8 @@ void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rD
     // Create mesh writer for VTK output
     VertexMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results", false);
 
-    // Iterate over any cell writers that are present
-    unsigned num_cells = this->GetNumAllCells();
+    // Iterate over any cell writers that are present; halo elements are written with copies of their cells
+    unsigned num_cells = this->GetNumAllCells() + mLocationHaloCellMap.size();
     for (typename std::vector<boost::shared_ptr<AbstractCellWriter<DIM, DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
          cell_writer_iter != this->mCellWriters.end();
          ++cell_writer_iter)
@@ -425,8 +1137,13 @@ void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rD
     }
 
     // When outputting any CellData, we assume that the first cell is representative of all cells
-    unsigned num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
-    std::vector<std::string> cell_data_names = this->Begin()->GetCellData()->GetKeys();
+    unsigned num_cell_data_items = 0;
+    std::vector<std::string> cell_data_names;
+    if (!this->mCells.empty())
+    {
+        num_cell_data_items = this->Begin()->GetCellData()->GetNumItems();
+        cell_data_names = this->Begin()->GetCellData()->GetKeys();
+    }
 
     std::vector<std::vector<double> > cell_data;
     for (unsigned var=0; var<num_cell_data_items; var++)
@@ -498,7 +1215,107 @@ void VertexBasedCellPopulation<DIM>::OpenWritersFiles(OutputFileHandler& rOutput
         }
     }
 
-    AbstractCellPopulation<DIM>::OpenWritersFiles(rOutputFileHandler);
+    if (mIsDistributed)
+    {
+        // Only the master process creates directories, so every process takes part in making each one
+        std::string directory = rOutputFileHandler.GetRelativePath();
+        for (unsigned process=0; process<PetscTools::GetNumProcs(); process++)
+        {
+            OutputFileHandler process_file_handler(GetProcessOutputDirectory(directory, process), false);
+        }
+
+        OutputFileHandler process_file_handler(GetProcessOutputDirectory(directory, PetscTools::GetMyRank()), false);
+        AbstractCellPopulation<DIM>::OpenWritersFiles(process_file_handler);
+    }
+    else
+    {
+        AbstractCellPopulation<DIM>::OpenWritersFiles(rOutputFileHandler);
+    }
+}
+
+template<unsigned DIM>
+void VertexBasedCellPopulation<DIM>::WriteResultsToFiles(const std::string& rDirectory)
+{
+    if (!mIsDistributed)
+    {
+        AbstractCellPopulation<DIM>::WriteResultsToFiles(rDirectory);
+        return;
+    }
+
+    // Each process writes the elements and cells it holds to its own files, so no round robin is needed
+    std::string process_directory = GetProcessOutputDirectory(rDirectory, PetscTools::GetMyRank());
+    OutputFileHandler output_file_handler(process_directory, false);
+
+    if (!(this->mCellWriters.empty() && this->mCellPopulationWriters.empty() && this->mCellPopulationCountWriters.empty()))
+    {
+        // An ordering must be specified for cell mutation states and cell proliferative types
+        this->SetDefaultCellMutationStateAndProliferativeTypeOrdering();
+
+        typedef AbstractCellWriter<DIM, DIM> cell_writer_t;
+        typedef AbstractCellPopulationWriter<DIM, DIM> pop_writer_t;
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, this->mCellWriters)
+        {
+            p_cell_writer->OpenOutputFileForAppend(output_file_handler);
+            p_cell_writer->WriteTimeStamp();
+        }
+        BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, this->mCellPopulationWriters)
+        {
+            p_pop_writer->OpenOutputFileForAppend(output_file_handler);
+            p_pop_writer->WriteTimeStamp();
+            AcceptPopulationWriter(p_pop_writer);
+        }
+
+        this->AcceptCellWritersAcrossPopulation();
+
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, this->mCellWriters)
+        {
+            p_cell_writer->WriteNewline();
+            p_cell_writer->CloseFile();
+        }
+        BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, this->mCellPopulationWriters)
+        {
+            p_pop_writer->WriteNewline();
+            p_pop_writer->CloseFile();
+        }
+
+        // Population counts are totals over all processes, written by the master process
+        typedef AbstractCellPopulationCountWriter<DIM, DIM> count_writer_t;
+        if (PetscTools::AmMaster())
+        {
+            BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, this->mCellPopulationCountWriters)
+            {
+                p_count_writer->OpenOutputFileForAppend(output_file_handler);
+                p_count_writer->WriteTimeStamp();
+            }
+        }
+        BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, this->mCellPopulationCountWriters)
+        {
+            AcceptPopulationCountWriter(p_count_writer);
+        }
+        if (PetscTools::AmMaster())
+        {
+            BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, this->mCellPopulationCountWriters)
+            {
+                p_count_writer->WriteNewline();
+                p_count_writer->CloseFile();
+            }
+        }
+    }
+
+    WriteVtkResultsToFile(process_directory);
+}
+
+template<unsigned DIM>
+std::string VertexBasedCellPopulation<DIM>::GetProcessOutputDirectory(const std::string& rDirectory, unsigned process)
+{
+    std::stringstream process_directory;
+    process_directory << rDirectory;
+    if (*rDirectory.rbegin() != '/')
+    {
+        process_directory << "/";
+    }
+    process_directory << "process_" << process << "/";
+    return process_directory.str();
 }
 
 template<unsigned DIM>
@@ -38,10 +38,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOffLatticeCellPopulation.hpp"
 #include "MutableVertexMesh.hpp"
+#include "ObjectCommunicator.hpp"
 
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/set.hpp>
+#include <boost/serialization/utility.hpp>
 #include <boost/serialization/vector.hpp>
 
 template<unsigned DIM>
@@ -64,6 +66,11 @@ private:
      */
     friend class TestVertexBasedDivisionRules;
 
+    /**
+     * This test checks which rearrangements have been deferred to the next update.
+     */
+    friend class TestVertexBasedCellPopulationParallelMethods;
+
     /**
      * Whether to delete the mesh when we are destroyed.
      * Needed if this cell population has been de-serialized.
@@ -101,6 +108,51 @@ private:
      */
     bool mRestrictVertexMovement;
 
+    /**
+     * The elements sent between processes when the population is distributed: each cell is paired
+     * with copies of the nodes of its element, whose indices are global node indices.
+     */
+    typedef std::vector<std::pair<CellPtr, std::vector<Node<DIM>*> > > ElementPacket;
+
+    /** Whether the population has been distributed between processes by DistributeBetweenProcesses(). */
+    bool mIsDistributed;
+
+    /**
+     * The boundaries between the regions owned by each process, along the last coordinate direction.
+     * Process i owns the cells whose centroids lie between boundaries i-1 and i.
+     */
+    std::vector<double> mProcessRegionBoundaries;
+
+    /** Map location indices of halo elements to copies of the cells owned by neighbouring processes. */
+    std::map<unsigned, CellPtr> mLocationHaloCellMap;
+
+    /** Map location indices of halo elements to the processes that own them. */
+    std::map<unsigned, unsigned> mHaloElementProcesses;
+
+    /** Global indices of the nodes that are shared with neighbouring processes. */
+    std::map<Node<DIM>*, unsigned> mGlobalNodeIndices;
+
+    /** The next global index to give a node sent to another process; incremented by the number of processes. */
+    unsigned mNextGlobalNodeIndex;
+
+    /** Ids of owned cells to send to the left process at the next Update(), so it may rearrange the elements around them. */
+    std::set<unsigned> mCellIdsToSendLeft;
+
+    /** Ids of cells owned by the right process to request at the next Update(), so this process may rearrange the elements around them. */
+    std::set<unsigned> mCellIdsToRequestFromRight;
+
+    /** Ids of owned cells to keep at the next Update(), so this process may rearrange the elements around them. */
+    std::set<unsigned> mCellIdsToKeep;
+
+    /** Whether to move the boundaries between the regions owned by each process so that each contains a similar number of elements. */
+    bool mLoadBalanceRegions;
+
+    /** The frequency, in number of time steps, at which the boundaries between regions are moved. */
+    unsigned mLoadBalanceFrequency;
+
+    /** The tag used to send and receive elements. */
+    static const unsigned mElementCommunicationTag = 125;
+
     /**
      * Overridden WriteVtkResultsToFile() method.
      *
@@ -131,10 +183,108 @@ private:
 
     /**
      * Check the consistency of internal data structures.
-     * Each VertexElement must have a CellPtr associated with it.
+     * Each VertexElement must have a CellPtr associated with it, apart from halo elements
+     * when the population is distributed.
      */
     void Validate();
 
+    /**
+     * Send objects to, and receive objects from, the neighbouring processes.
+     *
+     * @param rSendLeft the object to send to the left process
+     * @param rSendRight the object to send to the right process
+     * @param rpRecvLeft filled with the object received from the left process, if there is one
+     * @param rpRecvRight filled with the object received from the right process, if there is one
+     */
+    template<class CLASS>
+    void ExchangeWithNeighbourProcesses(CLASS& rSendLeft,
+                                        CLASS& rSendRight,
+                                        boost::shared_ptr<CLASS>& rpRecvLeft,
+                                        boost::shared_ptr<CLASS>& rpRecvRight);
+
+    /**
+     * Set #mProcessRegionBoundaries so that each region contains a similar number of the elements
+     * owned by all processes. If the boundaries have already been set, each may move no further than
+     * the previous positions of its neighbouring boundaries, so that cells need only migrate to a
+     * neighbouring process. Throws an exception if any region other than the first and last is narrower
+     * than twice the extent of an element, as elements owned by processes that are not neighbours
+     * could then share a node.
+     */
+    void CalculateProcessRegionBoundaries();
+
+    /**
+     * @return the process owning the region that contains a given position.
+     *
+     * @param rLocation the position
+     */
+    unsigned GetProcessOwningLocation(const c_vector<double, DIM>& rLocation);
+
+    /**
+     * Add a cell and copies of the nodes of its element to a packet to be sent to another process,
+     * giving each node a global index if it does not already have one.
+     *
+     * @param elementIndex the index of the element
+     * @param pCell the cell associated with the element
+     * @param rPacket the packet
+     * @param rNodeCopies the copies of nodes already in the packet, which are reused for nodes shared between elements
+     */
+    void PackElement(unsigned elementIndex,
+                     CellPtr pCell,
+                     ElementPacket& rPacket,
+                     std::map<Node<DIM>*, Node<DIM>*>& rNodeCopies);
+
+    /**
+     * Add the elements in a packet received from another process to the mesh. Nodes whose global
+     * indices match those of existing nodes are replaced by the existing nodes, whose positions are
+     * updated if the sending process is the lower ranked one.
+     *
+     * @param rPacket the packet
+     * @param process the rank of the sending process
+     * @param isHalo whether the elements are copies of elements owned by the sending process (halo elements),
+     *     rather than elements migrating to this process
+     */
+    void UnpackElements(ElementPacket& rPacket, unsigned process, bool isHalo);
+
+    /**
+     * Delete the node copies made by PackElement() once they have been sent.
+     *
+     * @param rNodeCopies the copies of nodes, which is cleared
+     */
+    void ClearNodeCopies(std::map<Node<DIM>*, Node<DIM>*>& rNodeCopies);
+
+    /**
+     * Exchange requests for cells, migrate cells whose elements need to be rearranged by another
+     * process or whose centroids have left the region owned by this process, and replace the halo
+     * elements. Called by Update() before the mesh is remeshed, when the population is distributed.
+     */
+    void UpdateDistributedElements();
+
+    /**
+     * Note that the elements around a given owned element cannot be rearranged by this process,
+     * and arrange for them all to be owned by one process at the next Update(). Of the processes
+     * owning these elements, the lowest ranked process receives them.
+     *
+     * @param elementIndex the index of the element
+     */
+    void DeferRearrangementAroundElement(unsigned elementIndex);
+
+    /**
+     * @return whether the elements around a given element may be rearranged by this process
+     * (see MutableVertexMesh::CanRearrangeAroundNode()).
+     *
+     * @param elementIndex the index of the element
+     */
+    bool CanRearrangeAroundElement(unsigned elementIndex);
+
+    /**
+     * @return the subdirectory of a given output directory to which a given process writes its
+     * results when the population is distributed.
+     *
+     * @param rDirectory the output directory, relative to where Chaste output is stored
+     * @param process the rank of the process
+     */
+    std::string GetProcessOutputDirectory(const std::string& rDirectory, unsigned process);
+
 public:
 
     /**
@@ -162,6 +312,69 @@ public:
      */
     VertexBasedCellPopulation(MutableVertexMesh<DIM, DIM>& rMesh);
 
+    /**
+     * Distribute the cell population between processes. Only the master process constructs the
+     * population from the initial mesh and cells; the other processes construct it from empty meshes,
+     * with the same parameters, and receive only their own elements. The domain is split into slabs
+     * along the last coordinate direction, each containing a similar number of elements, and each
+     * process owns the elements whose centroids lie in its slab. Copies of the elements of neighbouring
+     * processes near the slab boundaries (halo elements) are exchanged at each Update(), when cells whose
+     * centroids have left the slab are also migrated, and the slabs are rebalanced every
+     * #mLoadBalanceFrequency time steps (see SetLoadBalanceRegions()). Rearrangements involving elements
+     * owned by more than one process are carried out at the following Update(), once the elements
+     * involved have been migrated to a single process.
+     *
+     * Only implemented in 2D. Once distributed, each process writes its results to a subdirectory
+     * process_<rank> of the output directory (see WriteResultsToFiles()), and the population may
+     * not be archived.
+     */
+    void DistributeBetweenProcesses();
+
+    /**
+     * @return whether the cell population has been distributed between processes.
+     */
+    bool IsDistributed() const;
+
+    /**
+     * Set whether to move the boundaries between the regions owned by each process when the
+     * population is updated, so that each contains a similar number of elements. Defaults to true.
+     *
+     * @param loadBalanceRegions whether to rebalance the regions.
+     */
+    void SetLoadBalanceRegions(bool loadBalanceRegions);
+
+    /**
+     * Set the frequency, in number of time steps, with which the regions are rebalanced. Defaults to 100.
+     *
+     * @param loadBalanceFrequency the frequency for load balancing.
+     */
+    void SetLoadBalanceFrequency(unsigned loadBalanceFrequency);
+
+    /**
+     * @return the boundaries between the regions owned by each process.
+     */
+    const std::vector<double>& rGetProcessRegionBoundaries() const;
+
+    /**
+     * Overridden GetCellUsingLocationIndex() method, so that the cells associated with halo
+     * elements may also be accessed.
+     *
+     * @param index the index of an element
+     * @return the cell associated with the element.
+     */
+    virtual CellPtr GetCellUsingLocationIndex(unsigned index);
+
+    /**
+     * Overridden IsRoomToDivide() method.
+     *
+     * When the population is distributed, a cell may only divide if the elements around it are
+     * owned by this process; otherwise its division is deferred (see DeferRearrangementAroundElement()).
+     *
+     * @param pCell pointer to a cell
+     * @return whether the cell may divide.
+     */
+    virtual bool IsRoomToDivide(CellPtr pCell);
+
     /**
      * Destructor, which frees any memory allocated by the constructor.
      */
@@ -296,6 +509,9 @@ public:
      * the equivalent of a 'remesh' is performed! So don't try iterating over cells or anything
      * like that.
      *
+     * When the population is distributed, a dead cell whose element is near elements owned by another
+     * process is only removed once these have been migrated to a single process.
+     *
      * @return number of cells removed
      */
     unsigned RemoveDeadCells();
@@ -327,6 +543,17 @@ public:
     */
     virtual void OpenWritersFiles(OutputFileHandler& rOutputFileHandler);
 
+    /**
+     * Overridden WriteResultsToFiles() method.
+     *
+     * When the population is distributed, each process writes the elements it holds, including its
+     * halo elements, and its cells to files in the subdirectory process_<rank> of rDirectory.
+     * Population counts are totals over all processes and are written by the master process.
+     *
+     * @param rDirectory  pathname of the output directory, relative to where Chaste output is stored
+     */
+    virtual void WriteResultsToFiles(const std::string& rDirectory);
+
     /**
      * A virtual method to accept a cell population writer so it can
      * write data from this object to file.
@@ -561,6 +788,11 @@ inline void save_construct_data(
     Archive & ar, const VertexBasedCellPopulation<DIM> * t, const unsigned int file_version)
 {
     // Save data required to construct instance
+    if (t->IsDistributed())
+    {
+        EXCEPTION("Archiving a VertexBasedCellPopulation that has been distributed between processes is not supported");
+    }
+
     const MutableVertexMesh<DIM,DIM>* p_mesh = &(t->rGetMesh());
     ar & p_mesh;
 }
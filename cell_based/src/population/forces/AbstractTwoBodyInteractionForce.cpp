@@ -34,12 +34,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractTwoBodyInteractionForce.hpp"
+#include "OpenMpTools.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AbstractTwoBodyInteractionForce()
    : AbstractForce<ELEMENT_DIM,SPACE_DIM>(),
      mUseCutOffLength(false),
-     mMechanicsCutOffLength(DBL_MAX)
+     mMechanicsCutOffLength(DBL_MAX),
+     mUseParallelForceCalculation(false)
 {
 }
 
@@ -63,6 +65,141 @@ double AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetCutOffLength()
     return mMechanicsCutOffLength;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::SetUseParallelForceCalculation(bool useParallelForceCalculation)
+{
+    mUseParallelForceCalculation = useParallelForceCalculation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetUseParallelForceCalculation()
+{
+    return mUseParallelForceCalculation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::CalculatePairForces(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                                                                                std::vector<c_vector<double, SPACE_DIM> >& rPairForces,
+                                                                                AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                                double interactionDistance)
+{
+    const unsigned num_pairs = rNodePairs.size();
+    rPairForces.resize(num_pairs);
+
+    // Exceptions can't propagate out of a parallel region, so each thread keeps its first failure
+    const unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+    std::vector<boost::shared_ptr<Exception> > thread_exceptions(num_threads);
+    std::vector<unsigned> thread_failed_pairs(num_threads, UNSIGNED_UNSET);
+    bool any_failed = false;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (mUseParallelForceCalculation)
+#endif // CHASTE_OPENMP
+    for (unsigned p=0; p<num_pairs; p++)
+    {
+        bool stop;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+        stop = any_failed;
+        if (stop)
+        {
+            continue;
+        }
+
+        try
+        {
+            if (interactionDistance < DBL_MAX)
+            {
+                c_vector<double, SPACE_DIM> separation = rCellPopulation.rGetMesh().GetVectorFromAtoB(rNodePairs[p].first->rGetLocation(),
+                                                                                                      rNodePairs[p].second->rGetLocation());
+                if (inner_prod(separation, separation) >= interactionDistance*interactionDistance)
+                {
+                    rPairForces[p] = zero_vector<double>(SPACE_DIM);
+                    continue;
+                }
+            }
+
+            rPairForces[p] = CalculateForceBetweenNodes(rNodePairs[p].first->GetIndex(), rNodePairs[p].second->GetIndex(), rCellPopulation);
+            for (unsigned j=0; j<SPACE_DIM; j++)
+            {
+                assert(!std::isnan(rPairForces[p][j]));
+            }
+        }
+        catch (Exception& e)
+        {
+            const unsigned thread = OpenMpTools::GetThreadNum();
+            if (p < thread_failed_pairs[thread])
+            {
+                thread_failed_pairs[thread] = p;
+                thread_exceptions[thread].reset(new Exception(e));
+            }
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+            any_failed = true;
+        }
+    }
+
+    if (any_failed)
+    {
+        unsigned failed_thread = 0;
+        for (unsigned thread=1; thread<num_threads; thread++)
+        {
+            if (thread_failed_pairs[thread] < thread_failed_pairs[failed_thread])
+            {
+                failed_thread = thread;
+            }
+        }
+        throw *(thread_exceptions[failed_thread]);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AccumulatePairForces(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                                                                                 std::vector<c_vector<double, SPACE_DIM> >& rPairForces,
+                                                                                 AbstractOffLatticeCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                                 bool pairsArePersistent)
+{
+    assert(rCellPopulation.IsAccumulatingForces());
+    const unsigned num_nodes = rCellPopulation.GetNumForceAccumulationNodes();
+
+    // List the pair ends incident to each node; for the population's own node pairs this is kept until they are recalculated
+    rCellPopulation.UpdatePairIncidence(rNodePairs, pairsArePersistent);
+    const std::vector<unsigned>& r_incident_offsets = rCellPopulation.rGetPairIncidenceOffsets();
+    const std::vector<unsigned>& r_incident_ends = rCellPopulation.rGetPairIncidenceEnds();
+
+    double* p_components[SPACE_DIM];
+    for (unsigned d=0; d<SPACE_DIM; d++)
+    {
+        p_components[d] = rCellPopulation.GetAppliedForceComponents(d);
+    }
+
+    // Each node is written by exactly one thread, in pair order, so no atomics are needed
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (mUseParallelForceCalculation)
+#endif // CHASTE_OPENMP
+    for (unsigned k=0; k<num_nodes; k++)
+    {
+        for (unsigned i=r_incident_offsets[k]; i<r_incident_offsets[k+1]; i++)
+        {
+            const unsigned end = r_incident_ends[i];
+            const c_vector<double, SPACE_DIM>& r_force = rPairForces[end/2];
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                if (end%2 == 0)
+                {
+                    p_components[d][k] += r_force[d];
+                }
+                else
+                {
+                    p_components[d][k] -= r_force[d];
+                }
+            }
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContribution(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
 {
@@ -71,55 +208,60 @@ void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributio
     {
         EXCEPTION("Subclasses of AbstractTwoBodyInteractionForce are to be used with subclasses of AbstractCentreBasedCellPopulation only");
     }
+    AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
+
+    // Gather the pairs of interacting nodes
+    std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > > spring_pairs;
+    std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >* p_node_pairs = &spring_pairs;
+    bool pairs_are_persistent = false;
+    double interaction_distance = DBL_MAX;
 
     ///\todo this could be tidied by using the rGetNodePairs for all populations and moving the below calculation into the MutableMesh.
     if (bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation)))
     {
-        MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
+        MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_mesh_based_population = static_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
-        // Iterate over all springs and add force contributions
-        for (typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator spring_iterator = p_static_cast_cell_population->SpringsBegin();
-             spring_iterator != p_static_cast_cell_population->SpringsEnd();
+        // Iterate over all springs
+        for (typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator spring_iterator = p_mesh_based_population->SpringsBegin();
+             spring_iterator != p_mesh_based_population->SpringsEnd();
              ++spring_iterator)
         {
-            unsigned nodeA_global_index = spring_iterator.GetNodeA()->GetIndex();
-            unsigned nodeB_global_index = spring_iterator.GetNodeB()->GetIndex();
-
-            // Calculate the force between nodes
-            c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(nodeA_global_index, nodeB_global_index, rCellPopulation);
-
-            // Add the force contribution to each node
-            c_vector<double, SPACE_DIM> negative_force = -1.0*force;
-            spring_iterator.GetNodeB()->AddAppliedForceContribution(negative_force);
-            spring_iterator.GetNodeA()->AddAppliedForceContribution(force);
+            spring_pairs.push_back(std::make_pair(spring_iterator.GetNodeA(), spring_iterator.GetNodeB()));
         }
     }
     else    // This is a NodeBasedCellPopulation
     {
-        AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
-
-        std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >& r_node_pairs = p_static_cast_cell_population->rGetNodePairs();
+        p_node_pairs = &(p_static_cast_cell_population->rGetNodePairs());
+        pairs_are_persistent = true;
 
-        for (typename std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >::iterator iter = r_node_pairs.begin();
-            iter != r_node_pairs.end();
-            iter++)
+        /*
+         * Verlet lists also hold pairs within the skin beyond the population's cut-off length,
+         * which do not interact. These are given zero force rather than filtered out, so that
+         * the list (and its incidence arrays) can be kept until it is recalculated.
+         */
+        NodeBasedCellPopulation<SPACE_DIM>* p_node_based_population = dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(&rCellPopulation);
+        if (p_node_based_population && p_node_based_population->GetUseVerletLists())
         {
-            std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > pair = *iter;
-
-            unsigned node_a_index = pair.first->GetIndex();
-            unsigned node_b_index = pair.second->GetIndex();
+            interaction_distance = p_node_based_population->GetMechanicsCutOffLength();
+        }
+    }
 
-            // Calculate the force between nodes
-            c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(node_a_index, node_b_index, rCellPopulation);
-            for (unsigned j=0; j<SPACE_DIM; j++)
-            {
-                assert(!std::isnan(force[j]));
-            }
+    // Calculate the force between each pair of nodes
+    std::vector<c_vector<double, SPACE_DIM> > pair_forces;
+    CalculatePairForces(*p_node_pairs, pair_forces, rCellPopulation, interaction_distance);
 
-            // Add the force contribution to each node
-            c_vector<double, SPACE_DIM> negative_force = -1.0*force;
-            pair.first->AddAppliedForceContribution(force);
-            pair.second->AddAppliedForceContribution(negative_force);
+    if (p_static_cast_cell_population->IsAccumulatingForces())
+    {
+        AccumulatePairForces(*p_node_pairs, pair_forces, *p_static_cast_cell_population, pairs_are_persistent);
+    }
+    else
+    {
+        // Add the force contribution to each node
+        for (unsigned p=0; p<p_node_pairs->size(); p++)
+        {
+            c_vector<double, SPACE_DIM> negative_force = -1.0*pair_forces[p];
+            (*p_node_pairs)[p].first->AddAppliedForceContribution(pair_forces[p]);
+            (*p_node_pairs)[p].second->AddAppliedForceContribution(negative_force);
         }
     }
 }
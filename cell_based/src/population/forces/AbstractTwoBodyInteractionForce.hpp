@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ABSTRACTTWOBODYINTERACTIONFORCE_HPP_
 #define ABSTRACTTWOBODYINTERACTIONFORCE_HPP_
 
+#include "ChasteSerializationVersion.hpp"
 #include "AbstractForce.hpp"
 #include "MeshBasedCellPopulation.hpp"
 #include "NodeBasedCellPopulation.hpp"
@@ -61,6 +62,10 @@ private:
         archive & boost::serialization::base_object<AbstractForce<ELEMENT_DIM,SPACE_DIM> >(*this);
         archive & mUseCutOffLength;
         archive & mMechanicsCutOffLength;
+        if (version > 0)
+        {
+            archive & mUseParallelForceCalculation;
+        }
     }
 
 protected:
@@ -71,6 +76,45 @@ protected:
     /** Mechanics cut off length. */
     double mMechanicsCutOffLength;
 
+    /**
+     * Whether to calculate and accumulate the pairwise forces on several threads
+     * (when Chaste is built with OpenMP). Initialised to false in the constructor.
+     */
+    bool mUseParallelForceCalculation;
+
+    /**
+     * Calculate the force between each pair of interacting nodes, using several threads
+     * if mUseParallelForceCalculation is set.
+     *
+     * @param rNodePairs the pairs of interacting nodes
+     * @param rPairForces filled with the force exerted on the first node of each pair by the second
+     * @param rCellPopulation the cell population
+     * @param interactionDistance pairs at least this far apart are given zero force (defaults to DBL_MAX)
+     */
+    void CalculatePairForces(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                             std::vector<c_vector<double, SPACE_DIM> >& rPairForces,
+                             AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                             double interactionDistance=DBL_MAX);
+
+    /**
+     * Add the pairwise forces to the force accumulation arrays of the cell population, which
+     * adds them to the applied force on each node when it stops accumulating forces.
+     *
+     * The population lists the pair ends incident to each node in pair order, and keeps this
+     * list for its own node pairs until they are recalculated. Each node's sum is formed by a
+     * single thread in that order, so threads never write to the same node and the result does
+     * not depend on the number of threads.
+     *
+     * @param rNodePairs the pairs of interacting nodes
+     * @param rPairForces the force exerted on the first node of each pair by the second
+     * @param rCellPopulation the cell population, which must be accumulating forces
+     * @param pairsArePersistent whether rNodePairs is the population's own list of node pairs
+     */
+    void AccumulatePairForces(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                              std::vector<c_vector<double, SPACE_DIM> >& rPairForces,
+                              AbstractOffLatticeCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                              bool pairsArePersistent);
+
 public:
 
     /**
@@ -100,6 +144,21 @@ public:
      */
     double GetCutOffLength();
 
+    /**
+     * Set whether to calculate and accumulate the pairwise forces on several threads.
+     * This requires CalculateForceBetweenNodes() to be safe to call concurrently, as it
+     * is for the force laws in Chaste. While the population is accumulating forces, the
+     * applied forces do not depend on the number of threads used.
+     *
+     * @param useParallelForceCalculation whether to use several threads
+     */
+    void SetUseParallelForceCalculation(bool useParallelForceCalculation=true);
+
+    /**
+     * @return mUseParallelForceCalculation
+     */
+    bool GetUseParallelForceCalculation();
+
     /**
      * Calculates the force between two nodes.
      *
@@ -140,4 +199,21 @@ public:
     virtual void WriteDataToVisualizerSetupFile(out_stream& pVizSetupFile);
 };
 
+namespace boost {
+namespace serialization {
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(AbstractTwoBodyInteractionForce, 1)
+ * with a templated class.
+ */
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+struct version<AbstractTwoBodyInteractionForce<ELEMENT_DIM, SPACE_DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+} // namespace serialization
+} // namespace boost
+
 #endif /*ABSTRACTTWOBODYINTERACTIONFORCE_HPP_*/
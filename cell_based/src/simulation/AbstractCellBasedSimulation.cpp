@@ -43,6 +43,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LogFile.hpp"
 #include "ExecutableSupport.hpp"
 #include "AbstractPdeModifier.hpp"
+#include "Exception.hpp"
+#include "OpenMpTools.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
@@ -54,6 +56,8 @@ AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(
       mDeleteCellPopulationInDestructor(deleteCellPopulationInDestructor),
       mInitialiseCells(initialiseCells),
       mNoBirth(false),
+      mUseParallelCellCycleUpdate(false),
+      mNumCellsUpdatedInParallel(0),
       mUpdateCellPopulation(true),
       mOutputDirectory(""),
       mSimulationOutputDirectory(mOutputDirectory),
@@ -97,68 +101,161 @@ unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellBirth()
 
     unsigned num_births_this_step = 0;
 
-    // Iterate over all cells, seeing if each one can be divided
+    // Collect the cells that may divide, in the order in which any divisions are carried out
+    std::vector<CellPtr> cells;
     for (typename AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>::Iterator cell_iter = mrCellPopulation.Begin();
          cell_iter != mrCellPopulation.End();
          ++cell_iter)
     {
+        if (cell_iter->GetAge() > 0.0)
+        {
+            cells.push_back(*cell_iter);
+        }
+    }
+
+    /*
+     * If required, first update the cell-cycle and SRN models on several threads. Threads
+     * write to neighbouring entries of these vectors, so std::vector<bool> is not used.
+     */
+    std::vector<char> is_updated(cells.size(), false);
+    std::vector<char> is_ready_to_divide(cells.size(), false);
+    if (mUseParallelCellCycleUpdate)
+    {
+        UpdateCellCycleModelsInParallel(cells, is_updated, is_ready_to_divide);
+    }
+
+    // Divide the cells that are ready to, one at a time
+    for (unsigned i=0; i<cells.size(); i++)
+    {
+        CellPtr p_cell = cells[i];
+        double cell_age = p_cell->GetAge();
+
         // Check if this cell is ready to divide
-        double cell_age = cell_iter->GetAge();
-        if (cell_age > 0.0)
+        bool ready_to_divide = is_updated[i] ? is_ready_to_divide[i] : p_cell->ReadyToDivide();
+        if (ready_to_divide)
         {
-            if (cell_iter->ReadyToDivide())
+            // Check if there is room into which the cell may divide
+            if (mrCellPopulation.IsRoomToDivide(p_cell))
             {
-                // Check if there is room into which the cell may divide
-                if (mrCellPopulation.IsRoomToDivide(*cell_iter))
+                // Store parent ID for output if required
+                unsigned parent_cell_id = p_cell->GetCellId();
+
+                // Create a new cell
+                CellPtr p_new_cell = p_cell->Divide();
+
+                /**
+                 * If required, output this location to file
+                 *
+                 * \todo (#2578)
+                 *
+                 * For consistency with the rest of the output code, consider removing the
+                 * AbstractCellBasedSimulation member mOutputDivisionLocations, adding a new
+                 * member mAgesAndLocationsOfDividingCells to AbstractCellPopulation, adding
+                 * a new class CellDivisionLocationsWriter to the CellPopulationWriter hierarchy
+                 * to output the content of mAgesAndLocationsOfDividingCells to file (remembering
+                 * to clear mAgesAndLocationsOfDividingCells at each timestep), and replacing the
+                 * following conditional statement with something like
+                 *
+                 * if (mrCellPopulation.HasWriter<CellDivisionLocationsWriter>())
+                 * {
+                 *     mCellDivisionLocations.push_back(new_location);
+                 * }
+                 */
+                if (mOutputDivisionLocations)
                 {
-                    // Store parent ID for output if required
-                    unsigned parent_cell_id = cell_iter->GetCellId();
-
-                    // Create a new cell
-                    CellPtr p_new_cell = cell_iter->Divide();
-
-                    /**
-                     * If required, output this location to file
-                     *
-                     * \todo (#2578)
-                     *
-                     * For consistency with the rest of the output code, consider removing the
-                     * AbstractCellBasedSimulation member mOutputDivisionLocations, adding a new
-                     * member mAgesAndLocationsOfDividingCells to AbstractCellPopulation, adding
-                     * a new class CellDivisionLocationsWriter to the CellPopulationWriter hierarchy
-                     * to output the content of mAgesAndLocationsOfDividingCells to file (remembering
-                     * to clear mAgesAndLocationsOfDividingCells at each timestep), and replacing the
-                     * following conditional statement with something like
-                     *
-                     * if (mrCellPopulation.HasWriter<CellDivisionLocationsWriter>())
-                     * {
-                     *     mCellDivisionLocations.push_back(new_location);
-                     * }
-                     */
-                    if (mOutputDivisionLocations)
+                    c_vector<double, SPACE_DIM> cell_location = mrCellPopulation.GetLocationOfCellCentre(p_cell);
+
+                    *mpDivisionLocationFile << SimulationTime::Instance()->GetTime() << "\t";
+                    for (unsigned d=0; d<SPACE_DIM; d++)
                     {
-                        c_vector<double, SPACE_DIM> cell_location = mrCellPopulation.GetLocationOfCellCentre(*cell_iter);
-
-                        *mpDivisionLocationFile << SimulationTime::Instance()->GetTime() << "\t";
-                        for (unsigned i=0; i<SPACE_DIM; i++)
-                        {
-                            *mpDivisionLocationFile << cell_location[i] << "\t";
-                        }
-                        *mpDivisionLocationFile << "\t" << cell_age << "\t" << parent_cell_id << "\t" << cell_iter->GetCellId() << "\t" << p_new_cell->GetCellId() << "\n";
+                        *mpDivisionLocationFile << cell_location[d] << "\t";
                     }
+                    *mpDivisionLocationFile << "\t" << cell_age << "\t" << parent_cell_id << "\t" << p_cell->GetCellId() << "\t" << p_new_cell->GetCellId() << "\n";
+                }
 
-                    // Add the new cell to the cell population
-                    mrCellPopulation.AddCell(p_new_cell, *cell_iter);
+                // Add the new cell to the cell population
+                mrCellPopulation.AddCell(p_new_cell, p_cell);
 
-                    // Update counter
-                    num_births_this_step++;
-                }
+                // Update counter
+                num_births_this_step++;
             }
         }
     }
     return num_births_this_step;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellCycleModelsInParallel(std::vector<CellPtr>& rCells,
+                                                                                        std::vector<char>& rIsUpdated,
+                                                                                        std::vector<char>& rIsReadyToDivide)
+{
+    const unsigned num_cells = rCells.size();
+    unsigned num_updated = 0;
+    assert(rIsUpdated.size() == num_cells);
+    assert(rIsReadyToDivide.size() == num_cells);
+
+    // Exceptions can't propagate out of a parallel region, so each thread keeps its first failure
+    const unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+    std::vector<boost::shared_ptr<Exception> > thread_exceptions(num_threads);
+    std::vector<unsigned> thread_failed_cells(num_threads, UNSIGNED_UNSET);
+    bool any_failed = false;
+
+    // The cost of updating a cell varies a lot between models and phases, so cells are handed out dynamically
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) reduction(+:num_updated)
+#endif // CHASTE_OPENMP
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        bool stop;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+        stop = any_failed;
+        if (stop)
+        {
+            continue;
+        }
+
+        Cell* p_cell = rCells[i].get();
+        if (p_cell->GetCellCycleModel()->CanUpdateConcurrently() && p_cell->GetSrnModel()->CanUpdateConcurrently())
+        {
+            try
+            {
+                rIsReadyToDivide[i] = p_cell->ReadyToDivide();
+                rIsUpdated[i] = true;
+                num_updated++;
+            }
+            catch (Exception& e)
+            {
+                const unsigned thread = OpenMpTools::GetThreadNum();
+                if (i < thread_failed_cells[thread])
+                {
+                    thread_failed_cells[thread] = i;
+                    thread_exceptions[thread].reset(new Exception(e));
+                }
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+                any_failed = true;
+            }
+        }
+    }
+    mNumCellsUpdatedInParallel += num_updated;
+
+    if (any_failed)
+    {
+        unsigned failed_thread = 0;
+        for (unsigned thread=1; thread<num_threads; thread++)
+        {
+            if (thread_failed_cells[thread] < thread_failed_cells[failed_thread])
+            {
+                failed_thread = thread;
+            }
+        }
+        throw *(thread_exceptions[failed_thread]);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellRemoval()
 {
@@ -262,6 +359,24 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetNoBirth(bool noBirth
     mNoBirth = noBirth;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetUseParallelCellCycleUpdate(bool useParallelCellCycleUpdate)
+{
+    mUseParallelCellCycleUpdate = useParallelCellCycleUpdate;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetUseParallelCellCycleUpdate()
+{
+    return mUseParallelCellCycleUpdate;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetNumCellsUpdatedInParallel()
+{
+    return mNumCellsUpdatedInParallel;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AddCellKiller(boost::shared_ptr<AbstractCellKiller<SPACE_DIM> > pCellKiller)
 {
@@ -126,6 +126,19 @@ protected:
     /** Whether to run the simulation with no birth (defaults to false). */
     bool mNoBirth;
 
+    /**
+     * Whether DoCellBirth() should update the cell-cycle and SRN models of the cells on
+     * several threads (when Chaste is built with OpenMP) before dividing them. Defaults
+     * to false. Not archived.
+     */
+    bool mUseParallelCellCycleUpdate;
+
+    /**
+     * The number of times a cell has had its models updated by UpdateCellCycleModelsInParallel(),
+     * rather than serially. Not archived.
+     */
+    unsigned mNumCellsUpdatedInParallel;
+
     /** Whether to update the topology of the cell population at each time step (defaults to true).*/
     bool mUpdateCellPopulation;
 
@@ -195,6 +208,20 @@ protected:
      */
     virtual unsigned DoCellBirth();
 
+    /**
+     * Update the cell-cycle and SRN models of the given cells to the current time on several
+     * threads, by calling ReadyToDivide() on each cell whose models can be updated concurrently
+     * (see AbstractCellCycleModel::CanUpdateConcurrently()). Used by DoCellBirth() when
+     * mUseParallelCellCycleUpdate is set.
+     *
+     * @param rCells the cells to update
+     * @param rIsUpdated filled with whether each cell was updated
+     * @param rIsReadyToDivide filled with whether each updated cell is ready to divide
+     */
+    void UpdateCellCycleModelsInParallel(std::vector<CellPtr>& rCells,
+                                         std::vector<char>& rIsUpdated,
+                                         std::vector<char>& rIsReadyToDivide);
+
     /**
      * During a simulation time step, process any cell sloughing or death
      *
@@ -341,6 +368,26 @@ public:
      */
     void SetNoBirth(bool noBirth);
 
+    /**
+     * Set whether to update the cell-cycle and SRN models of the cells on several threads
+     * at each time step, before the cells that are ready to divide are divided in turn.
+     * Cells whose models cannot be updated concurrently, and all divisions, are still
+     * handled on a single thread, so the results are identical to those of the serial update.
+     *
+     * @param useParallelCellCycleUpdate whether to use several threads
+     */
+    void SetUseParallelCellCycleUpdate(bool useParallelCellCycleUpdate=true);
+
+    /**
+     * @return mUseParallelCellCycleUpdate
+     */
+    bool GetUseParallelCellCycleUpdate();
+
+    /**
+     * @return mNumCellsUpdatedInParallel
+     */
+    unsigned GetNumCellsUpdatedInParallel();
+
     /**
      * Set whether to update the topology of the cell population at each time step.
      *
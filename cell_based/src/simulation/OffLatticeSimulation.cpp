@@ -100,6 +100,9 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellLocationsAndTopology
 {
     CellBasedEventHandler::BeginEvent(CellBasedEventHandler::POSITION);
 
+    // Cell mutation states may have been changed since the damping constants were last cached
+    static_cast<AbstractOffLatticeCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&(this->mrCellPopulation))->InvalidateDampingConstants();
+
     double time_advanced_so_far = 0;
     double target_time_step  = this->mDt;
     double present_time_step = this->mDt;
@@ -125,12 +128,10 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellLocationsAndTopology
             // Successful time step! Update time_advanced_so_far
             time_advanced_so_far += present_time_step;
 
-            // If using adaptive timestep, then increase the present_time_step (by 1% for now)
+            // If using adaptive timestep, then let the numerical method choose the next step
             if (mpNumericalMethod->HasAdaptiveTimestep())
             {
-                ///\todo #2087 Make this a settable member variable
-                double timestep_increase = 0.01;
-                present_time_step = std::min((1+timestep_increase)*present_time_step, target_time_step - time_advanced_so_far);
+                present_time_step = std::min(mpNumericalMethod->GetNextTimeStep(present_time_step), target_time_step - time_advanced_so_far);
             }
 
         }
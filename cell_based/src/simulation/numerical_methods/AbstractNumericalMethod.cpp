@@ -98,15 +98,15 @@ bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::HasAdaptiveTimestep()
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ComputeForcesIncludingDamping()
+const std::vector<c_vector<double, SPACE_DIM> >& AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::rComputeForcesIncludingDamping()
 {
     CellBasedEventHandler::BeginEvent(CellBasedEventHandler::FORCE);
 
-    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
-         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd(); ++node_iter)
-    {
-        node_iter->ClearAppliedForce();
-    }
+    /*
+     * Clear the applied forces, and let forces that support it (such as two-body interaction
+     * forces) accumulate their contributions in contiguous arrays owned by the population.
+     */
+    mpCellPopulation->BeginForceAccumulation();
 
     for (typename std::vector<boost::shared_ptr<AbstractForce<ELEMENT_DIM, SPACE_DIM> > >::iterator iter = mpForceCollection->begin();
         iter != mpForceCollection->end(); ++iter)
@@ -125,20 +125,18 @@ std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SP
         dynamic_cast<MeshBasedCellPopulationWithGhostNodes<SPACE_DIM>*>(mpCellPopulation)->ApplyGhostForces();
     }
 
-    // Store applied forces in a vector
-    std::vector<c_vector<double, SPACE_DIM> > forces_as_vector;
-    forces_as_vector.reserve(mpCellPopulation->GetNumNodes());
-
-    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
-         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd(); ++node_iter)
-    {
-        double damping = mpCellPopulation->GetDampingConstant(node_iter->GetIndex());
-        forces_as_vector.push_back(node_iter->rGetAppliedForce()/damping);
-    }
+    // Add the accumulated contributions to the applied force on each node, and divide by the damping constants
+    mpCellPopulation->EndForceAccumulation(mForcesIncludingDamping);
 
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::FORCE);
 
-    return forces_as_vector;
+    return mForcesIncludingDamping;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ComputeForcesIncludingDamping()
+{
+    return rComputeForcesIncludingDamping();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -189,6 +187,21 @@ void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::DetectStepSizeExceptions(un
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetIntermediateLocations(const std::vector<c_vector<double, SPACE_DIM> >& rInitialLocations,
+                                                                             const std::vector<c_vector<double, SPACE_DIM> >& rVelocities,
+                                                                             double dt)
+{
+    unsigned index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        c_vector<double, SPACE_DIM> new_location = rInitialLocations[index] + dt*rVelocities[index];
+        SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetUseUpdateNodeLocation(bool useUpdateNodeLocation)
 {
@@ -201,6 +214,14 @@ bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetUseUpdateNodeLocation()
     return mUseUpdateNodeLocation;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetNextTimeStep(double currentTimeStep)
+{
+    ///\todo #2087 Make this a settable member variable
+    double timestep_increase = 0.01;
+    return (1.0 + timestep_increase)*currentTimeStep;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodInfo(out_stream& rParamsFile)
 {
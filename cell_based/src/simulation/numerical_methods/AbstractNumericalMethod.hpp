@@ -106,6 +106,20 @@ protected:
      */
     bool mGhostNodeForcesEnabled;
 
+    /**
+     * The force on each node divided by its damping constant, as last computed by
+     * rComputeForcesIncludingDamping(). Kept between time steps to avoid reallocation.
+     */
+    std::vector<c_vector<double, SPACE_DIM> > mForcesIncludingDamping;
+
+    /**
+     * Computes the force on each node, including the damping factor.
+     *
+     * @return A reference to the applied forces, in node iterator order, which is
+     *     overwritten by the next call to this method
+     */
+    const std::vector<c_vector<double, SPACE_DIM> >& rComputeForcesIncludingDamping();
+
     /**
      * Computes and returns the force on each node, including the damping factor
      * @return A vector of applied forces
@@ -137,6 +151,19 @@ protected:
      */
     void DetectStepSizeExceptions(unsigned nodeIndex, c_vector<double,SPACE_DIM>& displacement, double dt);
 
+    /**
+     * Moves each node to the intermediate location r_i + dt*v_i, as required when evaluating
+     * the stages of a multi-stage method. No step size checks are made, since only the final
+     * displacement of each node is subject to these.
+     *
+     * @param rInitialLocations the locations r_i of the nodes, in node iterator order
+     * @param rVelocities the velocities v_i of the nodes, in node iterator order
+     * @param dt the increment in time
+     */
+    void SetIntermediateLocations(const std::vector<c_vector<double, SPACE_DIM> >& rInitialLocations,
+                                  const std::vector<c_vector<double, SPACE_DIM> >& rVelocities,
+                                  double dt);
+
 public:
 
     /**
@@ -202,6 +229,18 @@ public:
      */
     virtual void UpdateAllNodePositions(double dt)=0;
 
+    /**
+     * Suggest the size of the next time step following a successful call to
+     * UpdateAllNodePositions(). Only used when the time step is adaptive.
+     *
+     * By default the step is increased by 1%. Methods with an embedded error
+     * estimate may override this to choose a step from that estimate.
+     *
+     * @param currentTimeStep the size of the step that has just been taken
+     * @return the suggested size of the next time step
+     */
+    virtual double GetNextTimeStep(double currentTimeStep);
+
     /**
      * Saves the name of the numerical method to the parameters file
      *
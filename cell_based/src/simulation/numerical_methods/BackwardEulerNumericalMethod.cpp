@@ -0,0 +1,337 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BackwardEulerNumericalMethod.hpp"
+#include <algorithm>
+#include <cfloat>
+#include "Exception.hpp"
+#include "LinearSystem.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "PetscTools.hpp"
+#include "ReplicatableVector.hpp"
+#include "VertexBasedCellPopulation.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::BackwardEulerNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~BackwardEulerNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetUpJacobianSparsityPattern()
+{
+    AbstractMesh<ELEMENT_DIM, SPACE_DIM>& r_mesh = this->mpCellPopulation->rGetMesh();
+
+    // Map each node's global index to its position in the node iterator
+    std::vector<unsigned> positions;
+    unsigned num_nodes = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = r_mesh.GetNodeIteratorBegin();
+         node_iter != r_mesh.GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        unsigned node_index = node_iter->GetIndex();
+        if (node_index >= positions.size())
+        {
+            positions.resize(node_index + 1, UNSIGNED_UNSET);
+        }
+        positions[node_index] = num_nodes++;
+    }
+
+    // Find the pairs of nodes between which forces may act
+    std::vector<std::pair<unsigned, unsigned> > index_pairs;
+    if (MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_mesh_population = dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(this->mpCellPopulation))
+    {
+        // Edges between ghost nodes are included, since ghost nodes are moved too
+        MutableMesh<ELEMENT_DIM,SPACE_DIM>& r_mutable_mesh = p_mesh_population->rGetMesh();
+        for (typename MutableMesh<ELEMENT_DIM,SPACE_DIM>::EdgeIterator edge_iter = r_mutable_mesh.EdgesBegin();
+             edge_iter != r_mutable_mesh.EdgesEnd();
+             ++edge_iter)
+        {
+            index_pairs.push_back(std::make_pair(edge_iter.GetNodeA()->GetIndex(), edge_iter.GetNodeB()->GetIndex()));
+        }
+    }
+    else if (NodeBasedCellPopulation<SPACE_DIM>* p_node_population = dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(this->mpCellPopulation))
+    {
+        std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& r_node_pairs = p_node_population->rGetNodePairs();
+        for (unsigned i=0; i<r_node_pairs.size(); i++)
+        {
+            index_pairs.push_back(std::make_pair(r_node_pairs[i].first->GetIndex(), r_node_pairs[i].second->GetIndex()));
+        }
+    }
+    else if (VertexBasedCellPopulation<SPACE_DIM>* p_vertex_population = dynamic_cast<VertexBasedCellPopulation<SPACE_DIM>*>(this->mpCellPopulation))
+    {
+        // The force on a vertex may depend on every vertex of each element containing it
+        MutableVertexMesh<SPACE_DIM,SPACE_DIM>& r_vertex_mesh = p_vertex_population->rGetMesh();
+        for (typename VertexMesh<SPACE_DIM,SPACE_DIM>::VertexElementIterator elem_iter = r_vertex_mesh.GetElementIteratorBegin();
+             elem_iter != r_vertex_mesh.GetElementIteratorEnd();
+             ++elem_iter)
+        {
+            unsigned num_nodes_in_element = elem_iter->GetNumNodes();
+            for (unsigned a=0; a<num_nodes_in_element; a++)
+            {
+                for (unsigned b=a+1; b<num_nodes_in_element; b++)
+                {
+                    index_pairs.push_back(std::make_pair(elem_iter->GetNodeGlobalIndex(a), elem_iter->GetNodeGlobalIndex(b)));
+                }
+            }
+        }
+    }
+    else
+    {
+        // All off-lattice cell populations are mesh-based, node-based or vertex-based
+        NEVER_REACHED;
+    }
+
+    // Convert the pairs into sorted, duplicate-free neighbour lists
+    std::vector<std::vector<unsigned> > neighbours(num_nodes);
+    for (unsigned i=0; i<index_pairs.size(); i++)
+    {
+        unsigned node_a = index_pairs[i].first;
+        unsigned node_b = index_pairs[i].second;
+        if (node_a < positions.size() && node_b < positions.size()
+            && positions[node_a] != UNSIGNED_UNSET && positions[node_b] != UNSIGNED_UNSET
+            && node_a != node_b)
+        {
+            neighbours[positions[node_a]].push_back(positions[node_b]);
+            neighbours[positions[node_b]].push_back(positions[node_a]);
+        }
+    }
+
+    mNeighbourOffsets.assign(1, 0);
+    mNeighbourPositions.clear();
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        std::sort(neighbours[i].begin(), neighbours[i].end());
+        neighbours[i].erase(std::unique(neighbours[i].begin(), neighbours[i].end()), neighbours[i].end());
+        mNeighbourPositions.insert(mNeighbourPositions.end(), neighbours[i].begin(), neighbours[i].end());
+        mNeighbourOffsets.push_back(mNeighbourPositions.size());
+    }
+
+    /*
+     * Colour the nodes greedily, so that no two nodes of the same colour are neighbours
+     * or share a neighbour. Colour c is forbidden for node i if forbidden_by[c] == i.
+     */
+    std::vector<unsigned> colours(num_nodes, UNSIGNED_UNSET);
+    std::vector<unsigned> forbidden_by;
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        for (unsigned n=mNeighbourOffsets[i]; n<mNeighbourOffsets[i+1]; n++)
+        {
+            unsigned neighbour = mNeighbourPositions[n];
+            if (colours[neighbour] != UNSIGNED_UNSET)
+            {
+                forbidden_by[colours[neighbour]] = i;
+            }
+            for (unsigned m=mNeighbourOffsets[neighbour]; m<mNeighbourOffsets[neighbour+1]; m++)
+            {
+                unsigned second_neighbour = mNeighbourPositions[m];
+                if (colours[second_neighbour] != UNSIGNED_UNSET)
+                {
+                    forbidden_by[colours[second_neighbour]] = i;
+                }
+            }
+        }
+
+        unsigned colour = 0;
+        while (colour < forbidden_by.size() && forbidden_by[colour] == i)
+        {
+            colour++;
+        }
+        if (colour == forbidden_by.size())
+        {
+            forbidden_by.push_back(UNSIGNED_UNSET);
+        }
+        colours[i] = colour;
+    }
+
+    // Sort the nodes by colour
+    unsigned num_colours = forbidden_by.size();
+    mColourOffsets.assign(num_colours + 1, 0);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        mColourOffsets[colours[i] + 1]++;
+    }
+    for (unsigned c=0; c<num_colours; c++)
+    {
+        mColourOffsets[c + 1] += mColourOffsets[c];
+    }
+    mColouredPositions.resize(num_nodes);
+    std::vector<unsigned> next_slot(mColourOffsets.begin(), mColourOffsets.end() - 1);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        mColouredPositions[next_slot[colours[i]]++] = i;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        if (PetscTools::IsParallel())
+        {
+            EXCEPTION("BackwardEulerNumericalMethod is not yet implemented in parallel.");
+        }
+
+        std::vector<c_vector<double, SPACE_DIM> > forces = this->ComputeForcesIncludingDamping();
+
+        std::vector<Node<SPACE_DIM>*> nodes;
+        nodes.reserve(forces.size());
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter)
+        {
+            nodes.push_back(&(*node_iter));
+        }
+        unsigned num_nodes = nodes.size();
+
+        SetUpJacobianSparsityPattern();
+
+        unsigned max_num_neighbours = 0;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            max_num_neighbours = std::max(max_num_neighbours, mNeighbourOffsets[i+1] - mNeighbourOffsets[i]);
+        }
+        LinearSystem linear_system(SPACE_DIM*num_nodes, SPACE_DIM*(max_num_neighbours + 1));
+        linear_system.SetRelativeTolerance(1e-10);
+
+        /*
+         * Assemble I - dt J column by column. Perturbing the d-th coordinate of every node
+         * of one colour at once gives, for each such node i, the d-th column of the blocks
+         * of J coupling node i to itself and to its neighbours.
+         */
+        const double relative_perturbation = sqrt(DBL_EPSILON);
+        std::vector<double> perturbations(num_nodes);
+        std::vector<double> unperturbed_coordinates(num_nodes);
+        for (unsigned colour=0; colour+1<mColourOffsets.size(); colour++)
+        {
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                for (unsigned k=mColourOffsets[colour]; k<mColourOffsets[colour+1]; k++)
+                {
+                    unsigned i = mColouredPositions[k];
+                    double& r_coordinate = nodes[i]->rGetModifiableLocation()[d];
+                    unperturbed_coordinates[i] = r_coordinate;
+                    r_coordinate += relative_perturbation*std::max(1.0, fabs(r_coordinate));
+
+                    // Use the step actually taken, which may differ slightly due to rounding
+                    perturbations[i] = r_coordinate - unperturbed_coordinates[i];
+                }
+
+                const std::vector<c_vector<double, SPACE_DIM> >& r_perturbed_forces = this->rComputeForcesIncludingDamping();
+
+                for (unsigned k=mColourOffsets[colour]; k<mColourOffsets[colour+1]; k++)
+                {
+                    unsigned i = mColouredPositions[k];
+                    nodes[i]->rGetModifiableLocation()[d] = unperturbed_coordinates[i];
+
+                    unsigned column = SPACE_DIM*i + d;
+                    for (unsigned e=0; e<SPACE_DIM; e++)
+                    {
+                        double derivative = (r_perturbed_forces[i][e] - forces[i][e])/perturbations[i];
+                        linear_system.SetMatrixElement(SPACE_DIM*i + e, column, (e == d ? 1.0 : 0.0) - dt*derivative);
+                    }
+                    for (unsigned n=mNeighbourOffsets[i]; n<mNeighbourOffsets[i+1]; n++)
+                    {
+                        unsigned j = mNeighbourPositions[n];
+                        for (unsigned e=0; e<SPACE_DIM; e++)
+                        {
+                            double derivative = (r_perturbed_forces[j][e] - forces[j][e])/perturbations[i];
+                            linear_system.SetMatrixElement(SPACE_DIM*j + e, column, -dt*derivative);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            for (unsigned e=0; e<SPACE_DIM; e++)
+            {
+                linear_system.SetRhsVectorElement(SPACE_DIM*i + e, dt*forces[i][e]);
+            }
+        }
+        linear_system.AssembleFinalLinearSystem();
+
+        Vec solution = linear_system.Solve();
+        ReplicatableVector solution_repl(solution);
+        PetscTools::Destroy(solution);
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            c_vector<double, SPACE_DIM> displacement;
+            for (unsigned e=0; e<SPACE_DIM; e++)
+            {
+                displacement[e] = solution_repl[SPACE_DIM*i + e];
+            }
+
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(nodes[i]->GetIndex(), displacement, dt);
+
+            c_vector<double, SPACE_DIM> new_location = nodes[i]->rGetLocation() + displacement;
+            this->SafeNodePositionUpdate(nodes[i]->GetIndex(), new_location);
+        }
+    }
+    else
+    {
+        // Delegate updating node positions to the population itself (only for NodeBasedCellPopulationWithBuskeUpdates)
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    // No new parameters to output, so just call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BackwardEulerNumericalMethod<1,1>;
+template class BackwardEulerNumericalMethod<1,2>;
+template class BackwardEulerNumericalMethod<2,2>;
+template class BackwardEulerNumericalMethod<1,3>;
+template class BackwardEulerNumericalMethod<2,3>;
+template class BackwardEulerNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
@@ -0,0 +1,148 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BACKWARDEULERNUMERICALMETHOD_HPP_
+#define BACKWARDEULERNUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements a linearly implicit (semi-implicit) backward Euler method.
+ *
+ * Solves the equations of motion dr/dt = F(r)
+ * Using a single Newton iteration of the backward Euler scheme
+ * r^(t+1) = r^t + dt F^(t+1), that is
+ *
+ * (I - dt J) (r^(t+1) - r^t) = dt F^t,
+ *
+ * where J = dF/dr is evaluated at r^t. This is exact for forces that are linear
+ * in the node locations, and remains stable for much larger time steps than the
+ * explicit methods when spring forces are stiff.
+ *
+ * The Jacobian is approximated by finite differences. Since the force on a node is
+ * assumed to depend only on the node itself and its neighbours (the node pairs of a
+ * node-based population, the edges of a mesh-based population, or the nodes sharing
+ * an element in a vertex-based population), J is sparse, and nodes are coloured so
+ * that no two nodes of the same colour are within two neighbour relations of each
+ * other. All columns belonging to one colour can then be recovered from a single
+ * perturbed force evaluation (Curtis, Powell and Reid, 1974), so each step costs
+ * SPACE_DIM times the number of colours force evaluations plus one sparse solve.
+ *
+ * The linear system is solved with PETSc via LinearSystem. The method is not yet
+ * implemented for populations distributed over more than one process.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class BackwardEulerNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+    friend class TestNumericalMethods;
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+    }
+
+    /**
+     * Offsets into mNeighbourPositions, so that the neighbours of the node at position i
+     * in the node iterator are stored between mNeighbourOffsets[i] and mNeighbourOffsets[i+1].
+     */
+    std::vector<unsigned> mNeighbourOffsets;
+
+    /** The node iterator positions of the neighbours of each node, indexed by mNeighbourOffsets. */
+    std::vector<unsigned> mNeighbourPositions;
+
+    /**
+     * Offsets into mColouredPositions, so that the nodes of colour c are stored between
+     * mColourOffsets[c] and mColourOffsets[c+1].
+     */
+    std::vector<unsigned> mColourOffsets;
+
+    /** The node iterator positions of all nodes, sorted by colour. */
+    std::vector<unsigned> mColouredPositions;
+
+    /**
+     * Set up the sparsity pattern of the Jacobian from the neighbour relations of the
+     * cell population, and colour the nodes so that nodes of the same colour share no
+     * neighbours. The pattern is recomputed at each step, since it changes as cells move
+     * and divide.
+     */
+    void SetUpJacobianSparsityPattern();
+
+public:
+
+    /**
+     * Constructor.
+     */
+    BackwardEulerNumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~BackwardEulerNumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
+
+#endif /*BACKWARDEULERNUMERICALMETHOD_HPP_*/
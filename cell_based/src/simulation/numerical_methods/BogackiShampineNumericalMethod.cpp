@@ -0,0 +1,212 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BogackiShampineNumericalMethod.hpp"
+#include "StepSizeException.hpp"
+#include "Exception.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::BogackiShampineNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mTolerance(1e-3),
+      mNextTimeStepFactor(1.0)
+{
+    this->mUseAdaptiveTimestep = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~BogackiShampineNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (!this->mUseUpdateNodeLocation)
+    {
+        std::vector<c_vector<double, SPACE_DIM> > initial_locations = this->SaveCurrentLocations();
+        unsigned num_nodes = initial_locations.size();
+
+        // Reuse K1 of a rejected attempt at this step if we are retrying it from the same locations
+        std::vector<c_vector<double, SPACE_DIM> > K1;
+        if (CanReuseLastStage(initial_locations))
+        {
+            K1.swap(mLastStageForces);
+        }
+        else
+        {
+            K1 = this->ComputeForcesIncludingDamping();
+        }
+        mLastStageForces.clear();
+        mLastStageLocations.clear();
+
+        this->SetIntermediateLocations(initial_locations, K1, 0.5*dt);
+        std::vector<c_vector<double, SPACE_DIM> > K2 = this->ComputeForcesIncludingDamping();
+        this->SetIntermediateLocations(initial_locations, K2, 0.75*dt);
+        std::vector<c_vector<double, SPACE_DIM> > K3 = this->ComputeForcesIncludingDamping();
+
+        // The third-order solution, where the last stage is evaluated for the error estimate
+        std::vector<c_vector<double, SPACE_DIM> > effective_forces(num_nodes);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            effective_forces[i] = (2.0/9.0)*K1[i] + (1.0/3.0)*K2[i] + (4.0/9.0)*K3[i];
+        }
+        this->SetIntermediateLocations(initial_locations, effective_forces, dt);
+        std::vector<c_vector<double, SPACE_DIM> > K4 = this->ComputeForcesIncludingDamping();
+
+        // Estimate the local error from the difference between the third- and second-order solutions
+        double max_error = 0.0;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            c_vector<double, SPACE_DIM> error = dt*((-5.0/72.0)*K1[i] + (1.0/12.0)*K2[i] + (1.0/9.0)*K3[i] - 0.125*K4[i]);
+            max_error = std::max(max_error, norm_2(error));
+        }
+
+        /*
+         * Choose the factor by which to change the step using the usual third-order
+         * controller, with a safety factor of 0.9 and limits on how quickly the
+         * step may shrink or grow.
+         */
+        double factor = 5.0;
+        if (max_error > 0.0)
+        {
+            factor = 0.9*pow(mTolerance/max_error, 1.0/3.0);
+        }
+
+        /*
+         * If the step is rejected it will be retried from the initial locations before the
+         * population is updated, so K1 still holds. K4 is not reused for the next accepted
+         * step, since births, deaths, remeshing, cell ageing and so on may change the forces
+         * between steps without moving any node.
+         */
+        mLastStageForces.swap(K1);
+        mLastStageLocations.swap(initial_locations);
+
+        if (max_error > mTolerance && this->mUseAdaptiveTimestep)
+        {
+            std::stringstream message;
+            message << "Local error estimate " << max_error << " exceeds the tolerance " << mTolerance << ". ";
+            message << "Reducing the time step.";
+            throw StepSizeException(dt*std::max(0.2, factor), message.str(), false);
+        }
+        mNextTimeStepFactor = std::min(5.0, factor);
+
+        unsigned index = 0;
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            c_vector<double, SPACE_DIM> displacement = dt * effective_forces[index];
+
+            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
+
+            c_vector<double, SPACE_DIM> new_location = mLastStageLocations[index] + displacement;
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+
+        // The step has been accepted
+        mLastStageForces.clear();
+        mLastStageLocations.clear();
+    }
+    else
+    {
+        // Delegate updating node positions to the population itself (only for NodeBasedCellPopulationWithBuskeUpdates)
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::CanReuseLastStage(const std::vector<c_vector<double, SPACE_DIM> >& rInitialLocations) const
+{
+    if (mLastStageForces.size() != rInitialLocations.size() || mLastStageLocations.size() != rInitialLocations.size())
+    {
+        return false;
+    }
+    for (unsigned i=0; i<rInitialLocations.size(); i++)
+    {
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            if (mLastStageLocations[i][d] != rInitialLocations[i][d])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetNextTimeStep(double currentTimeStep)
+{
+    return mNextTimeStepFactor*currentTimeStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetTolerance()
+{
+    return mTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BogackiShampineNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetTolerance(double tolerance)
+{
+    if (tolerance <= 0.0)
+    {
+        EXCEPTION("The tolerance must be positive.");
+    }
+    mTolerance = tolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BogackiShampineNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<Tolerance>" << mTolerance << "</Tolerance> \n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BogackiShampineNumericalMethod<1,1>;
+template class BogackiShampineNumericalMethod<1,2>;
+template class BogackiShampineNumericalMethod<2,2>;
+template class BogackiShampineNumericalMethod<1,3>;
+template class BogackiShampineNumericalMethod<2,3>;
+template class BogackiShampineNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BogackiShampineNumericalMethod)
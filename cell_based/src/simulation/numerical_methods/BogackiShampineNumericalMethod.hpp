@@ -0,0 +1,171 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BOGACKISHAMPINENUMERICALMETHOD_HPP_
+#define BOGACKISHAMPINENUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements the adaptive third-order Runge-Kutta method of Bogacki and Shampine,
+ * which has an embedded second-order error estimate.
+ *
+ * Solves the equations of motion dr/dt = F(r)
+ * Using the scheme
+ *
+ * K1 = F(r^t),
+ * K2 = F(r^t + (dt/2) K1),
+ * K3 = F(r^t + (3dt/4) K2),
+ * r^(t+1) = r^t + dt ((2/9) K1 + (1/3) K2 + (4/9) K3),
+ * K4 = F(r^(t+1)),
+ *
+ * and estimates the local error as the difference between r^(t+1) and the
+ * second-order solution r^t + dt ((7/24) K1 + (1/4) K2 + (1/3) K3 + (1/8) K4).
+ * K4 is not reused as K1 of the next step, since the population may change the
+ * forces between steps without moving any node; only a rejected step keeps its K1,
+ * for the retry from the same locations.
+ *
+ * The time step is adaptive by default. If the largest error over all nodes
+ * exceeds the tolerance, a StepSizeException is thrown suggesting a smaller
+ * step; otherwise, the size of the next step is chosen from the error estimate.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class BogackiShampineNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+    friend class TestNumericalMethods;
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mTolerance;
+    }
+
+    /**
+     * The largest permitted local error in the location of any node over one step.
+     * Initialized to 1e-3 in the constructor.
+     */
+    double mTolerance;
+
+    /**
+     * The factor by which to multiply the step size for the next step,
+     * computed from the error estimate of the last successful step.
+     */
+    double mNextTimeStepFactor;
+
+    /**
+     * The force K1 of the last rejected step, to be reused when the step is retried
+     * with a smaller time step. Empty once a step has been accepted. Not archived,
+     * so it is recomputed after loading.
+     */
+    std::vector<c_vector<double, SPACE_DIM> > mLastStageForces;
+
+    /** The node locations at which mLastStageForces were evaluated. */
+    std::vector<c_vector<double, SPACE_DIM> > mLastStageLocations;
+
+    /**
+     * @return whether mLastStageForces may be used as K1 of a step from the given
+     * locations, i.e. whether they were evaluated at exactly these locations.
+     *
+     * @param rInitialLocations the node locations at the start of the step
+     */
+    bool CanReuseLastStage(const std::vector<c_vector<double, SPACE_DIM> >& rInitialLocations) const;
+
+public:
+
+    /**
+     * Constructor.
+     */
+    BogackiShampineNumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~BogackiShampineNumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Overridden GetNextTimeStep() method.
+     *
+     * @param currentTimeStep the size of the step that has just been taken
+     * @return the size of the next time step, chosen from the last error estimate
+     */
+    virtual double GetNextTimeStep(double currentTimeStep);
+
+    /**
+     * @return mTolerance.
+     */
+    double GetTolerance();
+
+    /**
+     * Set mTolerance.
+     *
+     * @param tolerance the largest permitted local error in any node location over one step
+     */
+    void SetTolerance(double tolerance);
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BogackiShampineNumericalMethod)
+
+#endif /*BOGACKISHAMPINENUMERICALMETHOD_HPP_*/
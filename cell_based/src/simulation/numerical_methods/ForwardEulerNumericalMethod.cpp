@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ForwardEulerNumericalMethod.hpp"
+#include "AbstractCentreBasedCellPopulation.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ForwardEulerNumericalMethod()
@@ -49,10 +50,14 @@ ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~ForwardEulerNumericalMethod
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
 {
-    if (!this->mUseUpdateNodeLocation)
+    if (!this->mUseUpdateNodeLocation && CanUseFusedUpdate())
+    {
+        FusedUpdateAllNodePositions(dt);
+    }
+    else if (!this->mUseUpdateNodeLocation)
     {
         // Apply forces to each cell, and save a vector of net forces F
-        std::vector<c_vector<double, SPACE_DIM> > forces = this->ComputeForcesIncludingDamping();
+        const std::vector<c_vector<double, SPACE_DIM> >& r_forces = this->rComputeForcesIncludingDamping();
 
         unsigned index = 0;
         for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
@@ -61,7 +66,7 @@ void ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(
         {
             // Get the current node location and calculate the new location according to the forward Euler method
             const c_vector<double, SPACE_DIM>& r_old_location = node_iter->rGetLocation();
-            c_vector<double, SPACE_DIM> displacement = dt * forces[index];
+            c_vector<double, SPACE_DIM> displacement = dt * r_forces[index];
 
             // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
             this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
@@ -82,6 +87,35 @@ void ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::CanUseFusedUpdate()
+{
+    return this->mpCellPopulation->CanMoveNodesInPlace();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::FusedUpdateAllNodePositions(double dt)
+{
+    // Only centre-based populations allow their nodes to be moved in place
+    assert((dynamic_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>*>(this->mpCellPopulation)));
+    AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* p_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>*>(this->mpCellPopulation);
+
+    // Evaluate the forces; these are stored in the order of the population's force accumulation arrays
+    const std::vector<c_vector<double, SPACE_DIM> >& r_forces = this->rComputeForcesIncludingDamping();
+
+    for (unsigned k=0; k<r_forces.size(); k++)
+    {
+        Node<SPACE_DIM>* p_node = p_population->GetForceAccumulationNode(k);
+        c_vector<double, SPACE_DIM> displacement = dt * r_forces[k];
+
+        // Centre-based step size exceptions are always terminal, so need no handling here
+        p_population->AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>::CheckForStepSizeException(p_node->GetIndex(), displacement, dt);
+
+        // Equivalent to SetNode(), as the population allows its nodes to be moved in place
+        noalias(p_node->rGetModifiableLocation()) += displacement;
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void ForwardEulerNumericalMethod<ELEMENT_DIM, SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
 {
@@ -52,6 +52,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
 class ForwardEulerNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
 
+    friend class TestNumericalMethods;
+
 private:
 
     /** Needed for serialization. */
@@ -69,6 +71,22 @@ private:
         archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
     }
 
+    /**
+     * @return whether FusedUpdateAllNodePositions() is equivalent to the general update, i.e.
+     * whether the population allows its nodes to be moved in place, as reported by
+     * AbstractOffLatticeCellPopulation::CanMoveNodesInPlace().
+     */
+    bool CanUseFusedUpdate();
+
+    /**
+     * Update node positions for the populations identified by CanUseFusedUpdate(). Each node is
+     * moved in a single pass over the population's force accumulation arrays, using cached damping
+     * constants and without virtual calls to check step sizes or move nodes.
+     *
+     * @param dt Time step size
+     */
+    void FusedUpdateAllNodePositions(double dt);
+
 public:
 
     /**
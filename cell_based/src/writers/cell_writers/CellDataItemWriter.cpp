@@ -39,7 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::CellDataItemWriter(std::string cellDataVariableName)
     : AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>("celldata_"+cellDataVariableName+".dat"),
-      mCellDataVariableName(cellDataVariableName)
+      mCellDataVariableName(cellDataVariableName),
+      mCellDataIndex(CellDataRegistry::Instance()->GetIndex(cellDataVariableName))
 {
     this->mVtkCellDataName = "CellData " + mCellDataVariableName;
 }
@@ -47,7 +48,7 @@ CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::CellDataItemWriter(std::string cellD
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::GetCellDataForVtkOutput(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
-    double value = pCell->GetCellData()->GetItem(mCellDataVariableName);
+    double value = pCell->GetCellData()->GetItem(mCellDataIndex);
     return value;
 }
 
@@ -70,7 +71,7 @@ void CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, Abstra
     }
 
     // Output this cell's level of mCellDataVariableName
-    double value = pCell->GetCellData()->GetItem(mCellDataVariableName);
+    double value = pCell->GetCellData()->GetItem(mCellDataIndex);
     *this->mpOutStream << value << " ";
 }
 
@@ -75,6 +75,11 @@ private:
      */
     std::string mCellDataVariableName;
 
+    /**
+     * The index of the item in the CellDataRegistry, so that it is not looked up by name for every cell.
+     */
+    unsigned mCellDataIndex;
+
 public:
 
     /**
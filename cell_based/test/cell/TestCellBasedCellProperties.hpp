@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellId.hpp"
 #include "CellData.hpp"
+#include "CellDataRegistry.hpp"
 
 #include "CellPropertyRegistry.hpp"
 
@@ -128,6 +129,13 @@ public:
     {
         MAKE_PTR(CellData, p_cell_data);
 
+        // Looking up an unknown item doesn't register its name
+        CellDataRegistry* p_registry = CellDataRegistry::Instance();
+        unsigned num_names = p_registry->GetNumNames();
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem("unknown_thing"), "The item unknown_thing is not stored");
+        TS_ASSERT_EQUALS(p_registry->FindIndex("unknown_thing"), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(p_registry->GetNumNames(), num_names);
+
         TS_ASSERT_THROWS_THIS(p_cell_data->GetItem("thing1"), "The item thing1 is not stored");
 
         p_cell_data->SetItem("thing1", 1.0);
@@ -138,6 +146,53 @@ public:
         TS_ASSERT_DELTA(p_cell_data->GetItem("thing2"), 2.0, 1e-8);
         TS_ASSERT_DELTA(p_cell_data->GetItem("thing3"), 3.0, 1e-8);
         TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
+
+        // Items may also be accessed by their index in the registry
+        unsigned index2 = p_registry->GetIndex("thing2");
+        TS_ASSERT_EQUALS(p_registry->GetIndex("thing2"), index2);
+        TS_ASSERT_EQUALS(p_registry->FindIndex("thing2"), index2);
+        TS_ASSERT_EQUALS(p_registry->rGetName(index2), "thing2");
+        TS_ASSERT_LESS_THAN(index2, p_registry->GetNumNames());
+
+        TS_ASSERT(p_cell_data->HasItem(index2));
+        TS_ASSERT_DELTA(p_cell_data->GetItem(index2), 2.0, 1e-8);
+        p_cell_data->SetItem(index2, 4.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("thing2"), 4.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
+
+        // An item registered after the others is still listed in alphabetical order
+        unsigned index0 = p_registry->GetIndex("thing0");
+        TS_ASSERT(!p_cell_data->HasItem(index0));
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem(index0), "The item thing0 is not stored");
+        p_cell_data->SetItem(index0, 0.5);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 4u);
+
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        TS_ASSERT_EQUALS(keys.size(), 4u);
+        TS_ASSERT_EQUALS(keys[0], "thing0");
+        TS_ASSERT_EQUALS(keys[1], "thing1");
+        TS_ASSERT_EQUALS(keys[2], "thing2");
+        TS_ASSERT_EQUALS(keys[3], "thing3");
+
+        // Indices are listed in the order of the registry
+        std::vector<unsigned> indices = p_cell_data->GetIndices();
+        TS_ASSERT_EQUALS(indices.size(), 4u);
+        for (unsigned k=0; k<indices.size(); k++)
+        {
+            TS_ASSERT(p_cell_data->HasItem(indices[k]));
+            if (k > 0)
+            {
+                TS_ASSERT_LESS_THAN(indices[k-1], indices[k]);
+            }
+        }
+        TS_ASSERT_EQUALS(indices.back(), index0);
+
+        // Copies have their own values
+        CellData cell_data_copy(*p_cell_data);
+        cell_data_copy.SetItem(index0, 1.5);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(index0), 0.5, 1e-8);
+        TS_ASSERT_DELTA(cell_data_copy.GetItem(index0), 1.5, 1e-8);
+        TS_ASSERT_EQUALS(cell_data_copy.GetNumItems(), 4u);
     }
 
     void TestArchiveCellData()
@@ -233,7 +233,15 @@ public:
 
         TS_ASSERT_THROWS_NOTHING(p_solver->CheckForStoppingEvents());
         TS_ASSERT_THROWS_NOTHING(p_solver->SetMaxSteps(1000));
-        TS_ASSERT_THROWS_NOTHING(p_solver->SetTolerances(1e-5, 1e-5));
+        TS_ASSERT_THROWS_NOTHING(p_solver->SetTolerances(1e-5, 1e-6));
+
+        // The solvers used by other threads have the same settings
+        boost::shared_ptr<CvodeAdaptor> p_thread_solver = boost::dynamic_pointer_cast<CvodeAdaptor>(p_solver->CreateOdeSolverForThread());
+        TS_ASSERT(p_thread_solver);
+        TS_ASSERT_DELTA(p_thread_solver->GetRelativeTolerance(), 1e-5, 1e-12);
+        TS_ASSERT_DELTA(p_thread_solver->GetAbsoluteTolerance(), 1e-6, 1e-12);
+        TS_ASSERT_EQUALS(p_thread_solver->GetMaxSteps(), 1000);
+        TS_ASSERT_EQUALS(p_thread_solver->GetCheckForStoppingEvents(), true);
 #else
         std::cout << "CVODE is not enabled. " << std::endl;
         std::cout << "If required please install and alter your hostconfig settings to switch on chaste support." << std::endl;
@@ -87,6 +87,9 @@ public:
 
         TS_ASSERT_EQUALS(p_cell_model->CanCellTerminallyDifferentiate(), false);
 
+        // Each thread has its own copy of the ODE solver, whether or not it is CVODE
+        TS_ASSERT_EQUALS(p_cell_model->CanUpdateConcurrently(), true);
+
         MAKE_PTR(WildTypeCellMutationState, p_healthy_state);
         MAKE_PTR(StemCellProliferativeType, p_stem_type);
 
@@ -339,6 +339,7 @@ public:
             NullSrnModel srn_model;
 
             TS_ASSERT_EQUALS(srn_model.GetIdentifier(), "NullSrnModel");
+            TS_ASSERT_EQUALS(srn_model.CanUpdateConcurrently(), true);
 
             out_stream parameter_file = output_file_handler.OpenOutputFile("null_srn_results.parameters");
             srn_model.OutputSrnModelParameters(parameter_file);
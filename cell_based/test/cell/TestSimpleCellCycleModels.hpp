@@ -87,6 +87,7 @@ public:
         TS_ASSERT_DELTA(p_model->GetAverageStemCellCycleTime(), DBL_MAX, 1e-6);
         TS_ASSERT_DELTA(p_model->GetAverageTransitCellCycleTime(), DBL_MAX, 1e-6);
         TS_ASSERT_EQUALS(p_model->ReadyToDivide(), false);
+        TS_ASSERT_EQUALS(p_model->CanUpdateConcurrently(), true);
 
         // Test the cell-cycle model works correctly with a cell
         MAKE_PTR(WildTypeCellMutationState, p_healthy_state);
@@ -347,6 +348,9 @@ public:
         TS_ASSERT_DELTA(p_transit_model->GetDivisionProbability(), 0.1, 1e-9);
         TS_ASSERT_DELTA(p_transit_model->GetMinimumDivisionAge(), 1.0, 1e-9);
 
+        // This model draws from the global random number generator, so must be updated serially
+        TS_ASSERT_EQUALS(p_transit_model->CanUpdateConcurrently(), false);
+
         // Change parameters for this model
         p_transit_model->SetDivisionProbability(0.5);
         p_transit_model->SetMinimumDivisionAge(0.1);
@@ -97,6 +97,9 @@ public:
         // Coverage of some set and methods
         p_pde_modifier->SetBcsOnBoxBoundary(false);
         TS_ASSERT_EQUALS(p_pde_modifier->AreBcsSetOnBoxBoundary(), false);
+        TS_ASSERT_EQUALS(p_pde_modifier->AreOperatorsAssembledOnce(), false);
+        p_pde_modifier->SetAssembleOperatorsOnce(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->AreOperatorsAssembledOnce(), true);
 
         // Check that the finite element mesh is correct
         TS_ASSERT_EQUALS(p_pde_modifier->mpFeMesh->GetNumNodes(), 121u);
@@ -143,6 +146,7 @@ public:
             Vec vector = PetscTools::CreateVec(data);
             EllipticBoxDomainPdeModifier<2> modifier(p_pde, p_bc, false, p_cuboid, 2.0, vector);
             modifier.SetDependentVariableName("averaged quantity");
+            modifier.SetAssembleOperatorsOnce(true);
 
             // Create an output archive
             std::ofstream ofs(archive_filename.c_str());
@@ -167,6 +171,7 @@ public:
             TS_ASSERT_EQUALS((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->rGetDependentVariableName(), "averaged quantity");
             TS_ASSERT_DELTA((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->GetStepSize(), 2.0, 1e-5);
             TS_ASSERT_EQUALS((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->AreBcsSetOnBoxBoundary(), true);
+            TS_ASSERT_EQUALS((static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->AreOperatorsAssembledOnce(), true);
 
             Vec solution = (static_cast<EllipticBoxDomainPdeModifier<2>*>(p_modifier2))->GetSolution();
             ReplicatableVector solution_repl(solution);
@@ -466,6 +471,105 @@ public:
         TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8513, 1e-4); // Testing against on-lattice models
     }
 
+    void TestAssembleOperatorsOnce()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            if (p_mesh->GetNode(i)->rGetLocation()[0] < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 2);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceEllipticPde<2>, p_pde, (cell_population, -0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Create two PDE modifiers, one of which only assembles the stiffness matrix once
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        p_pde_modifier->SetupSolve(cell_population, "TestEllipticBoxDomainPdeModifierAssembleOperatorsOnce");
+
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_cached_pde_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_cached_pde_modifier->SetDependentVariableName("cached_variable");
+        p_cached_pde_modifier->SetAssembleOperatorsOnce(true);
+        p_cached_pde_modifier->SetupSolve(cell_population, "TestEllipticBoxDomainPdeModifierAssembleOperatorsOnce");
+
+        TS_ASSERT(p_cached_pde_modifier->mpCachedOperatorSolver);
+        TS_ASSERT(p_cached_pde_modifier->mpCachedOperatorSolver->IsStiffnessMatrixAssembled());
+
+        // The solutions should agree (up to the tolerance of the linear solver)
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("cached_variable"),
+                            cell_iter->GetCellData()->GetItem("variable"), 1e-4);
+        }
+
+        // Now make all cells with x<2.0 non-apoptotic and move some cells, so the source terms change
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            c_vector<double,2>& r_location = p_mesh->GetNode(i)->rGetModifiableLocation();
+            if (r_location[0] < 2.0)
+            {
+                cells[i]->RemoveCellProperty<ApoptoticCellProperty>();
+            }
+            r_location[1] += 0.1*r_location[0];
+        }
+
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+
+        CachedOperatorEllipticPdeSolver<2>* p_solver = p_cached_pde_modifier->mpCachedOperatorSolver.get();
+        p_cached_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+
+        // The same solver is used, with the solution now reflecting the new source terms
+        TS_ASSERT_EQUALS(p_cached_pde_modifier->mpCachedOperatorSolver.get(), p_solver);
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("cached_variable"),
+                            cell_iter->GetCellData()->GetItem("variable"), 1e-4);
+        }
+
+        // Check the boundary conditions may also be imposed on the cell population boundary
+        p_pde_modifier->SetBcsOnBoxBoundary(false);
+        p_cached_pde_modifier->SetBcsOnBoxBoundary(false);
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        p_cached_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("cached_variable"),
+                            cell_iter->GetCellData()->GetItem("variable"), 1e-4);
+        }
+    }
+
     void TestEllipticBoxDomainPdeModifierIn1d()
     {
         // Create mesh
@@ -92,6 +92,9 @@ public:
 
         // Test that member variables are initialised correctly
         TS_ASSERT_EQUALS(p_pde_modifier->rGetDependentVariableName(), "averaged quantity");
+        TS_ASSERT_EQUALS(p_pde_modifier->AreOperatorsAssembledOnce(), false);
+        p_pde_modifier->SetAssembleOperatorsOnce(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->AreOperatorsAssembledOnce(), true);
 
         // Check mesh
         TS_ASSERT_EQUALS(p_pde_modifier->mpFeMesh->GetNumNodes(),121u);
@@ -317,6 +320,99 @@ public:
         TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_y"), -0.2981, 1e-4);
     }
 
+    void TestAssembleOperatorsOnce()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                       cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            if (p_mesh->GetNode(i)->rGetLocation()[0] < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+            // Set initial condition for both PDEs
+            cells[i]->GetCellData()->SetItem("variable", 1.0);
+            cells[i]->GetCellData()->SetItem("cached_variable", 1.0);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceParabolicPde<2>, p_pde, (cell_population, 0.1, 1.0, -1.0));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Create two PDE modifiers, one of which only assembles the LHS matrix once
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        p_pde_modifier->SetupSolve(cell_population, "TestParabolicBoxDomainPdeModifierAssembleOperatorsOnce");
+
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_cached_pde_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_cached_pde_modifier->SetDependentVariableName("cached_variable");
+        p_cached_pde_modifier->SetAssembleOperatorsOnce(true);
+        p_cached_pde_modifier->SetupSolve(cell_population, "TestParabolicBoxDomainPdeModifierAssembleOperatorsOnce");
+
+        // Run for 10 time steps, moving the cells so that the source terms change
+        for (unsigned i=0; i<10; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            for (unsigned j=0; j<p_mesh->GetNumNodes(); j++)
+            {
+                p_mesh->GetNode(j)->rGetModifiableLocation()[0] += 0.1;
+            }
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+            p_cached_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        }
+
+        // The same solver is used throughout
+        TS_ASSERT(p_cached_pde_modifier->mpCachedOperatorSolver);
+        SimpleLinearParabolicSolver<2,2>* p_solver = p_cached_pde_modifier->mpCachedOperatorSolver.get();
+
+        // The solutions should agree (up to the tolerance of the linear solver)
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("cached_variable"),
+                            cell_iter->GetCellData()->GetItem("variable"), 1e-4);
+        }
+
+        // Halve the time step, so the LHS matrix must be reassembled
+        SimulationTime::Instance()->ResetEndTimeAndNumberOfTimeSteps(2.0, 20);
+        for (unsigned i=0; i<20; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+            p_cached_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        }
+        TS_ASSERT_EQUALS(p_cached_pde_modifier->mpCachedOperatorSolver.get(), p_solver);
+        TS_ASSERT_DELTA(p_cached_pde_modifier->mCachedOperatorTimeStep, 0.05, 1e-9);
+
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("cached_variable"),
+                            cell_iter->GetCellData()->GetItem("variable"), 1e-4);
+        }
+    }
+
     void TestNodeBasedSquareMonolayer()
     {
         HoneycombMeshGenerator generator(10,10,0);
@@ -45,6 +45,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PottsMesh.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "ArchiveOpener.hpp"
+#include "RandomNumberGenerator.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -1778,6 +1779,62 @@ public:
         TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), 2u);
     }
 
+    void TestMoveNodeToElement()
+    {
+        // Create a 2D mesh with four 4x4 elements and a 3D mesh with eight 2x2x2 elements
+        PottsMeshGenerator<2> generator_2d(8, 2, 4, 8, 2, 4);
+        PottsMesh<2>* p_mesh_2d = generator_2d.GetMesh();
+        PottsMeshGenerator<3> generator_3d(4, 2, 2, 4, 2, 2, 4, 2, 2);
+        PottsMesh<3>* p_mesh_3d = generator_3d.GetMesh();
+
+        TS_ASSERT_EQUALS(p_mesh_2d->GetElement(0)->IsSurfaceAreaCached(), false);
+        p_mesh_2d->CacheSurfaceAreasOfElements();
+        p_mesh_3d->CacheSurfaceAreasOfElements();
+        for (unsigned elem_index=0; elem_index<4; elem_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh_2d->GetElement(elem_index)->IsSurfaceAreaCached(), true);
+            TS_ASSERT_DELTA(p_mesh_2d->GetSurfaceAreaOfElement(elem_index), 16.0, 1e-12);
+        }
+        for (unsigned elem_index=0; elem_index<8; elem_index++)
+        {
+            TS_ASSERT_DELTA(p_mesh_3d->GetSurfaceAreaOfElement(elem_index), 24.0, 1e-12);
+        }
+
+        // Move nodes between elements and into and out of the medium: the cached surface areas must stay correct
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        for (unsigned i=0; i<200; i++)
+        {
+            unsigned node_index = p_gen->randMod(p_mesh_2d->GetNumNodes());
+            unsigned elem_index = p_gen->randMod(5);
+            p_mesh_2d->MoveNodeToElement(node_index, (elem_index == 4) ? UNSIGNED_UNSET : elem_index);
+            TS_ASSERT_LESS_THAN_EQUALS(p_mesh_2d->GetNode(node_index)->GetNumContainingElements(), 1u);
+
+            node_index = p_gen->randMod(p_mesh_3d->GetNumNodes());
+            elem_index = p_gen->randMod(9);
+            p_mesh_3d->MoveNodeToElement(node_index, (elem_index == 8) ? UNSIGNED_UNSET : elem_index);
+        }
+        for (unsigned elem_index=0; elem_index<4; elem_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh_2d->GetElement(elem_index)->IsSurfaceAreaCached(), true);
+            TS_ASSERT_DELTA(p_mesh_2d->GetSurfaceAreaOfElement(elem_index), p_mesh_2d->CalculateSurfaceAreaOfElement(elem_index), 1e-12);
+        }
+        for (unsigned elem_index=0; elem_index<8; elem_index++)
+        {
+            TS_ASSERT_DELTA(p_mesh_3d->GetSurfaceAreaOfElement(elem_index), p_mesh_3d->CalculateSurfaceAreaOfElement(elem_index), 1e-12);
+        }
+
+        // Changing an element directly resets its cached surface area
+        PottsElement<2>* p_element = p_mesh_2d->GetElement(0);
+        Node<2>* p_node = p_element->GetNode(0);
+        p_element->DeleteNode(0);
+        TS_ASSERT_EQUALS(p_element->IsSurfaceAreaCached(), false);
+        p_mesh_2d->GetSurfaceAreaOfElement(0);
+        TS_ASSERT_EQUALS(p_element->IsSurfaceAreaCached(), true);
+        p_element->AddNode(p_node);
+        TS_ASSERT_EQUALS(p_element->IsSurfaceAreaCached(), false);
+        TS_ASSERT_DELTA(p_mesh_2d->GetSurfaceAreaOfElement(0), p_mesh_2d->CalculateSurfaceAreaOfElement(0), 1e-12);
+    }
+
     void TestArchive2dPottsMesh()
     {
         EXIT_IF_PARALLEL;
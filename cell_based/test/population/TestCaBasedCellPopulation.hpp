@@ -236,6 +236,14 @@ public:
             "Location index input argument does not correspond to a Cell");
         TS_ASSERT_THROWS_NOTHING(cell_population.GetCellUsingLocationIndex(3));
 
+        // Location indices beyond any that have been assigned a cell have no cells attached
+        TS_ASSERT(!cell_population.IsCellAttachedToLocationIndex(24));
+        TS_ASSERT(cell_population.GetCellsUsingLocationIndex(24).empty());
+        TS_ASSERT_THROWS_THIS(cell_population.GetCellUsingLocationIndex(24),
+            "Location index input argument does not correspond to a Cell");
+        TS_ASSERT_THROWS_THIS(cell_population.RemoveCellUsingLocationIndex(24, *(cell_population.rGetCells().begin())),
+            "Tried to remove a cell which is not attached to the given location index");
+
         // Now remove first cell from lattice 0 and move it to lattice 3
         cells.resize(cell_population.rGetCells().size()); // Since the vector gets cleared by the population constructor
         std::copy(cell_population.rGetCells().begin(), cell_population.rGetCells().end(), cells.begin());
@@ -0,0 +1,168 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLPOPULATIONITERATIONPERFORMANCE_HPP_
+#define TESTCELLPOPULATIONITERATIONPERFORMANCE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <map>
+#include <set>
+
+#include "AbstractCellBasedWithTimingsTestSuite.hpp"
+#include "CellsGenerator.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "NodesOnlyMesh.hpp"
+#include "SmartPointers.hpp"
+#include "Timer.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * Profiles iterating over the cells of a population of a million cells and
+ * mapping between cells and location indices, which is done many times per
+ * time step by forces, modifiers and writers.
+ */
+class TestCellPopulationIterationPerformance : public AbstractCellBasedWithTimingsTestSuite
+{
+public:
+
+    void TestIterateOverMillionCells()
+    {
+        // A 100x100x100 grid of cells
+        unsigned cells_across = 100;
+        std::vector<Node<3>*> nodes;
+        nodes.reserve(cells_across*cells_across*cells_across);
+        for (unsigned i=0; i<cells_across; i++)
+        {
+            for (unsigned j=0; j<cells_across; j++)
+            {
+                for (unsigned k=0; k<cells_across; k++)
+                {
+                    nodes.push_back(new Node<3>(nodes.size(), false, (double) i, (double) j, (double) k));
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        CellsGenerator<UniformCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_transit_type);
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        Timer::PrintAndReset("Set up 10^6 cells");
+
+        // Iterating over the population looks up the location of each cell to skip deleted nodes
+        unsigned num_sweeps = 10;
+        unsigned num_cells_visited = 0;
+        for (unsigned sweep=0; sweep<num_sweeps; sweep++)
+        {
+            for (AbstractCellPopulation<3>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                if (!cell_iter->IsDead())
+                {
+                    num_cells_visited++;
+                }
+            }
+        }
+        Timer::PrintAndReset("10 iterations over 10^6 cells");
+        TS_ASSERT_EQUALS(num_cells_visited, num_sweeps*cells_across*cells_across*cells_across);
+
+        // Map each cell to its location index and back again
+        unsigned num_mismatches = 0;
+        for (unsigned sweep=0; sweep<num_sweeps; sweep++)
+        {
+            for (AbstractCellPopulation<3>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                unsigned node_index = cell_population.GetLocationIndexUsingCell(*cell_iter);
+                if (cell_population.GetCellUsingLocationIndex(node_index) != *cell_iter)
+                {
+                    num_mismatches++;
+                }
+            }
+        }
+        double population_time = Timer::GetElapsedTime();
+        Timer::PrintAndReset("10 round trips between 10^6 cells and location indices");
+        TS_ASSERT_EQUALS(num_mismatches, 0u);
+
+        // The baseline: the same round trips through the ordered maps the population used to hold
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+        for (AbstractCellPopulation<3>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            unsigned node_index = cell_population.GetLocationIndexUsingCell(*cell_iter);
+            location_cell_map[node_index].insert(*cell_iter);
+            cell_location_map[(*cell_iter).get()] = node_index;
+        }
+        Timer::Reset();
+        for (unsigned sweep=0; sweep<num_sweeps; sweep++)
+        {
+            for (AbstractCellPopulation<3>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                unsigned node_index = cell_location_map[(*cell_iter).get()];
+                if (*(location_cell_map[node_index].begin()) != *cell_iter)
+                {
+                    num_mismatches++;
+                }
+            }
+        }
+        double ordered_map_time = Timer::GetElapsedTime();
+        Timer::PrintAndReset("10 round trips through ordered maps");
+        TS_ASSERT_EQUALS(num_mismatches, 0u);
+        TS_ASSERT_LESS_THAN(population_time, ordered_map_time);
+
+        TS_ASSERT_EQUALS(cell_population.GetNumRealCells(), cells_across*cells_across*cells_across);
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+};
+
+#endif /*TESTCELLPOPULATIONITERATIONPERFORMANCE_HPP_*/
@@ -66,6 +66,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "SimpleTargetAreaModifier.hpp"
 #include "OffLatticeSimulation.hpp"
+#include "OpenMpTools.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -413,6 +414,182 @@ public:
         }
     }
 
+    void TestParallelForceAccumulation()
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel
+
+        unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+        OpenMpTools::SetNumThreads(4);
+
+        // Node-based population on a jittered lattice, with repulsion and spring forces
+        {
+            std::vector<Node<3>*> nodes;
+            for (unsigned i=0; i<6; i++)
+            {
+                for (unsigned j=0; j<6; j++)
+                {
+                    for (unsigned k=0; k<6; k++)
+                    {
+                        double x = i + 0.2*RandomNumberGenerator::Instance()->ranf();
+                        double y = j + 0.2*RandomNumberGenerator::Instance()->ranf();
+                        double z = k + 0.2*RandomNumberGenerator::Instance()->ranf();
+                        nodes.push_back(new Node<3>(nodes.size(), false, x, y, z));
+                    }
+                }
+            }
+            NodesOnlyMesh<3> mesh;
+            mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 3> cells_generator;
+            cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+            NodeBasedCellPopulation<3> cell_population(mesh, cells);
+            cell_population.Update();
+            TS_ASSERT(!cell_population.rGetNodePairs().empty());
+
+            GeneralisedLinearSpringForce<3> spring_force;
+            spring_force.SetCutOffLength(1.5);
+            RepulsionForce<3> repulsion_force;
+
+            // A contribution added directly to each node, as forces other than two-body forces do
+            std::vector<c_vector<double, 3> > other_forces;
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                c_vector<double, 3> other_force;
+                for (unsigned d=0; d<3; d++)
+                {
+                    other_force[d] = 0.1*RandomNumberGenerator::Instance()->ranf();
+                }
+                other_forces.push_back(other_force);
+            }
+
+            // Add the forces to each node in turn
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                mesh.GetNode(i)->ClearAppliedForce();
+            }
+            spring_force.AddForceContribution(cell_population);
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                mesh.GetNode(i)->AddAppliedForceContribution(other_forces[i]);
+            }
+            repulsion_force.AddForceContribution(cell_population);
+
+            std::vector<c_vector<double, 3> > serial_forces;
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                serial_forces.push_back(mesh.GetNode(i)->rGetAppliedForce());
+            }
+
+            // Accumulate the two-body forces in the population's arrays, on one thread
+            cell_population.BeginForceAccumulation();
+            TS_ASSERT(cell_population.IsAccumulatingForces());
+            TS_ASSERT_EQUALS(cell_population.GetNumForceAccumulationNodes(), mesh.GetNumNodes());
+            spring_force.AddForceContribution(cell_population);
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                mesh.GetNode(i)->AddAppliedForceContribution(other_forces[i]);
+            }
+            repulsion_force.AddForceContribution(cell_population);
+            cell_population.EndForceAccumulation();
+            TS_ASSERT(!cell_population.IsAccumulatingForces());
+
+            // Every end of every pair is listed, as there are no halo nodes
+            TS_ASSERT_EQUALS(cell_population.rGetPairIncidenceOffsets().size(), mesh.GetNumNodes() + 1);
+            TS_ASSERT_EQUALS(cell_population.rGetPairIncidenceEnds().size(), 2*cell_population.rGetNodePairs().size());
+
+            // The accumulated forces are only added to the nodes at the end, so agree to rounding
+            std::vector<c_vector<double, 3> > accumulated_forces;
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                accumulated_forces.push_back(mesh.GetNode(i)->rGetAppliedForce());
+                for (unsigned d=0; d<3; d++)
+                {
+                    TS_ASSERT_DELTA(accumulated_forces[i][d], serial_forces[i][d], 1e-12);
+                }
+            }
+
+            // Accumulate the forces again on several threads, reusing the population's pair incidence arrays
+            TS_ASSERT(!spring_force.GetUseParallelForceCalculation());
+            spring_force.SetUseParallelForceCalculation();
+            repulsion_force.SetUseParallelForceCalculation();
+            TS_ASSERT(spring_force.GetUseParallelForceCalculation());
+
+            cell_population.BeginForceAccumulation();
+            spring_force.AddForceContribution(cell_population);
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                mesh.GetNode(i)->AddAppliedForceContribution(other_forces[i]);
+            }
+            repulsion_force.AddForceContribution(cell_population);
+            cell_population.EndForceAccumulation();
+
+            // The results are identical, not just close, as each node's sum is formed in the same order whatever the number of threads
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                for (unsigned d=0; d<3; d++)
+                {
+                    TS_ASSERT_EQUALS(mesh.GetNode(i)->rGetAppliedForce()[d], accumulated_forces[i][d]);
+                }
+            }
+
+            for (unsigned i=0; i<nodes.size(); i++)
+            {
+                delete nodes[i];
+            }
+        }
+
+        // Mesh-based population with ghost nodes, where the pairs are the springs
+        {
+            HoneycombMeshGenerator generator(6, 6, 2);
+            MutableMesh<2,2>* p_mesh = generator.GetMesh();
+            std::vector<unsigned> location_indices = generator.GetCellLocationIndices();
+
+            // Perturb the nodes so that the springs are not at their rest lengths
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                p_mesh->GetNode(i)->rGetModifiableLocation()[0] += 0.1*RandomNumberGenerator::Instance()->ranf();
+            }
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, location_indices.size());
+
+            MeshBasedCellPopulationWithGhostNodes<2> cell_population(*p_mesh, cells, location_indices);
+
+            GeneralisedLinearSpringForce<2> spring_force;
+
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                p_mesh->GetNode(i)->ClearAppliedForce();
+            }
+            spring_force.AddForceContribution(cell_population);
+
+            std::vector<c_vector<double, 2> > serial_forces;
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                serial_forces.push_back(p_mesh->GetNode(i)->rGetAppliedForce());
+            }
+
+            spring_force.SetUseParallelForceCalculation();
+            cell_population.BeginForceAccumulation();
+            spring_force.AddForceContribution(cell_population);
+            cell_population.EndForceAccumulation();
+
+            // With a single two-body force each node's sum is formed in the serial order, so the results are identical
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                for (unsigned d=0; d<2; d++)
+                {
+                    TS_ASSERT_EQUALS(p_mesh->GetNode(i)->rGetAppliedForce()[d], serial_forces[i][d]);
+                }
+            }
+        }
+
+        OpenMpTools::SetNumThreads(num_threads);
+    }
+
     void TestDifferentialAdhesionGeneralisedLinearSpringForceMethods()
     {
         EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel.
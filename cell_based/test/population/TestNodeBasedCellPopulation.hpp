@@ -58,6 +58,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "FixedCentreBasedDivisionRule.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
+#include "GeneralisedLinearSpringForce.hpp"
 #include "NodeBasedCellPopulation.hpp"
 #include "SmartPointers.hpp"
 #include "TetrahedralMesh.hpp"
@@ -947,7 +948,7 @@ public:
             TS_ASSERT_EQUALS(node_4_neighbours.size(), 4u);
             TS_ASSERT_EQUALS(node_4_neighbours, expected_node_4_neighbours);
 
-            TS_ASSERT_THROWS_THIS(node_based_cell_population.GetNodesWithinNeighbourhoodRadius(0,2.0), "neighbourhoodRadius should be less than or equal to the  the maximum interaction radius defined on the NodesOnlyMesh");
+            TS_ASSERT_THROWS_THIS(node_based_cell_population.GetNodesWithinNeighbourhoodRadius(0,2.0), "neighbourhoodRadius should be less than or equal to the mechanics cut-off length of the population");
 
         }
 
@@ -1698,6 +1699,85 @@ public:
         // Coverage of GetOutputResultsForChasteVisualizer()
         TS_ASSERT_EQUALS(cell_population.GetOutputResultsForChasteVisualizer(), true);
     }
+
+    void TestVerletLists()
+    {
+        EXIT_IF_PARALLEL;    // Verlet lists are only kept in sequential
+
+        // Four nodes in a row
+        std::vector<Node<2>*> nodes;
+        for (unsigned i=0; i<4; i++)
+        {
+            nodes.push_back(new Node<2>(i, false, (double) i, 0.0));
+        }
+
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+        TS_ASSERT_EQUALS(cell_population.GetUseVerletLists(), false);
+        TS_ASSERT_THROWS_THIS(cell_population.SetVerletSkin(-0.1),
+                              "The Verlet skin must be non-negative.");
+
+        // The boxes are widened by the skin, keeping the mechanics cut-off length
+        cell_population.SetUseVerletLists();
+        cell_population.SetVerletSkin(0.4);
+        TS_ASSERT_EQUALS(cell_population.GetUseVerletLists(), true);
+        TS_ASSERT_DELTA(cell_population.GetVerletSkin(), 0.4, 1e-12);
+        TS_ASSERT_DELTA(cell_population.GetMechanicsCutOffLength(), 1.5, 1e-12);
+        TS_ASSERT_DELTA(mesh.GetMaximumInteractionDistance(), 1.9, 1e-12);
+
+        // Only the pairs within the cut-off plus the skin are kept
+        cell_population.Update();
+        TS_ASSERT_EQUALS(cell_population.rGetNodePairs().size(), 3u);
+        TS_ASSERT_EQUALS(cell_population.mVerletReferenceLocations.size(), 4u);
+
+        // A small move keeps the pairs
+        cell_population.GetNode(3)->rGetModifiableLocation()[0] = 2.85;
+        cell_population.Update(false);
+        TS_ASSERT_EQUALS(cell_population.rGetNodePairs().size(), 3u);
+        TS_ASSERT_DELTA(cell_population.mVerletReferenceLocations[3][0], 3.0, 1e-12);
+
+        // A move of more than half the skin recalculates them, picking up the pair (1,3)
+        cell_population.GetNode(3)->rGetModifiableLocation()[0] = 2.4;
+        cell_population.Update(false);
+        TS_ASSERT_EQUALS(cell_population.rGetNodePairs().size(), 4u);
+        TS_ASSERT_DELTA(cell_population.mVerletReferenceLocations[3][0], 2.4, 1e-12);
+
+        // Births or deaths always recalculate them; the pair (1,3) is now within the skin
+        cell_population.GetNode(3)->rGetModifiableLocation()[0] = 2.7;
+        cell_population.Update(true);
+        TS_ASSERT_EQUALS(cell_population.rGetNodePairs().size(), 4u);
+        TS_ASSERT_DELTA(cell_population.mVerletReferenceLocations[3][0], 2.7, 1e-12);
+
+        // Forces ignore the pairs beyond the mechanics cut-off length, whatever their own cut-off
+        GeneralisedLinearSpringForce<2> force;
+        TS_ASSERT_THROWS_NOTHING(force.AddForceContribution(cell_population));
+        TS_ASSERT_DELTA(cell_population.GetNode(1)->rGetAppliedForce()[0], 0.0, 1e-12);
+        TS_ASSERT_DELTA(cell_population.GetNode(3)->rGetAppliedForce()[0],
+                        -cell_population.GetNode(2)->rGetAppliedForce()[0], 1e-12);
+        TS_ASSERT_LESS_THAN(0.0, cell_population.GetNode(3)->rGetAppliedForce()[0]);
+
+        // Neighbourhoods are only complete up to the mechanics cut-off length, as nodes may have moved since the lists were made
+        std::set<unsigned> neighbours = cell_population.GetNodesWithinNeighbourhoodRadius(1, 1.5);
+        TS_ASSERT_EQUALS(neighbours.size(), 2u);
+        TS_ASSERT_THROWS_THIS(cell_population.GetNodesWithinNeighbourhoodRadius(1, 1.7),
+                              "neighbourhoodRadius should be less than or equal to the mechanics cut-off length of the population");
+
+        // Turning the lists off restores the boxes
+        cell_population.SetUseVerletLists(false);
+        TS_ASSERT_DELTA(mesh.GetMaximumInteractionDistance(), 1.5, 1e-12);
+        TS_ASSERT_DELTA(cell_population.GetMechanicsCutOffLength(), 1.5, 1e-12);
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
 };
 
 #endif /*TESTNODEBASEDCELLPOPULATION_HPP_*/
@@ -119,6 +119,16 @@ public:
 
         CellPtr p_returned_cell = pair.first;
         TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetLocationIndexUsingCell(p_returned_cell), node_index);
+
+        // In parallel each process holds only some of the global node indices, so these are mapped to cells by hashing
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mUseHashedLocationCellMap, PetscTools::IsParallel());
+        if (PetscTools::IsParallel())
+        {
+            TS_ASSERT(mpNodeBasedCellPopulation->mLocationCellMap.empty());
+            TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHashedLocationCellMap.size(), mpNodesOnlyMesh->GetNumNodes());
+            TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetCellUsingLocationIndex(node_index), p_returned_cell);
+            TS_ASSERT(!mpNodeBasedCellPopulation->IsCellAttachedToLocationIndex(UINT_MAX - 1));
+        }
     }
 
     void TestAddNodeAndCellsToSend()
@@ -257,6 +267,99 @@ public:
         }
     }
 
+    void TestPackAndUnpackHaloCells()
+    {
+        // Pack the cells on this process as halos for process 0, and unpack them as if they had come from there
+        std::vector<unsigned> location_indices;
+        for (AbstractMesh<3,3>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+             node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+             ++node_iter)
+        {
+            location_indices.push_back(node_iter->GetIndex());
+        }
+        TS_ASSERT_EQUALS(location_indices.size(), 1u);
+
+        CellPtr p_cell = mpNodeBasedCellPopulation->GetCellUsingLocationIndex(location_indices[0]);
+        p_cell->GetCellData()->SetItem("oxygen", 1.0);
+
+        PackedDataBuffer buffer;
+        mpNodeBasedCellPopulation->PackHaloCells(0, location_indices, buffer);
+        unsigned full_size = buffer.GetSize();
+        mpNodeBasedCellPopulation->UnpackHaloCells(0, buffer);
+
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells.size(), 1u);
+        CellPtr p_halo_cell = mpNodeBasedCellPopulation->mHaloCells[0];
+        TS_ASSERT(p_halo_cell != p_cell);
+        TS_ASSERT_EQUALS(p_halo_cell->GetCellId(), p_cell->GetCellId());
+        TS_ASSERT_DELTA(p_halo_cell->GetCellData()->GetItem("oxygen"), 1.0, 1e-12);
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCellLocationMap[p_halo_cell], location_indices[0]);
+
+        // The CellData names have been sent, and map to the same indices when sent from this process
+        unsigned num_names = CellDataRegistry::Instance()->GetNumNames();
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCellDataNamesSentToProcesses[0], num_names);
+        std::vector<unsigned>& r_data_indices = mpNodeBasedCellPopulation->mHaloCellDataIndicesRecvFromProcesses[0];
+        TS_ASSERT_EQUALS(r_data_indices.size(), num_names);
+        for (unsigned n=0; n<num_names; n++)
+        {
+            TS_ASSERT_EQUALS(r_data_indices[n], n);
+        }
+
+        // A cell whose state has not changed is sent without it or the names, and its halo copy is reused
+        p_cell->GetCellData()->SetItem("oxygen", 2.0);
+        mpNodeBasedCellPopulation->mHaloCells.clear();
+        mpNodesOnlyMesh->ClearHaloNodes();
+
+        mpNodeBasedCellPopulation->PackHaloCells(0, location_indices, buffer);
+        TS_ASSERT_LESS_THAN(buffer.GetSize(), full_size);
+        TS_ASSERT_EQUALS(buffer.Unpack<unsigned>(), 0u);
+        buffer.Resize(buffer.GetSize()); // rewind before unpacking
+        mpNodeBasedCellPopulation->UnpackHaloCells(0, buffer);
+
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells.size(), 1u);
+        TS_ASSERT(mpNodeBasedCellPopulation->mHaloCells[0] == p_halo_cell);
+        TS_ASSERT_DELTA(p_halo_cell->GetCellData()->GetItem("oxygen"), 2.0, 1e-12);
+
+        // A change of state sends the whole cell again
+        MAKE_PTR(CellLabel, p_label);
+        p_cell->AddCellProperty(p_label);
+        mpNodeBasedCellPopulation->mHaloCells.clear();
+        mpNodesOnlyMesh->ClearHaloNodes();
+
+        mpNodeBasedCellPopulation->PackHaloCells(0, location_indices, buffer);
+        mpNodeBasedCellPopulation->UnpackHaloCells(0, buffer);
+
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells.size(), 1u);
+        TS_ASSERT(mpNodeBasedCellPopulation->mHaloCells[0] != p_halo_cell);
+        TS_ASSERT(mpNodeBasedCellPopulation->mHaloCells[0]->HasCellProperty<CellLabel>());
+    }
+
+    void TestCalculateHaloCellFingerprint()
+    {
+        CellPtr p_cell = mpNodeBasedCellPopulation->GetCellUsingLocationIndex(mpNodesOnlyMesh->GetNodeIteratorBegin()->GetIndex());
+        std::size_t fingerprint = mpNodeBasedCellPopulation->CalculateHaloCellFingerprint(p_cell);
+
+        // The fingerprint depends on the class of each property, not on which instance the cell holds
+        MAKE_PTR(BetaCateninOneHitCellMutationState, p_state);
+        p_cell->SetMutationState(p_state);
+        std::size_t mutated_fingerprint = mpNodeBasedCellPopulation->CalculateHaloCellFingerprint(p_cell);
+        TS_ASSERT_DIFFERS(mutated_fingerprint, fingerprint);
+
+        MAKE_PTR(BetaCateninOneHitCellMutationState, p_other_state);
+        p_cell->SetMutationState(p_other_state);
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->CalculateHaloCellFingerprint(p_cell), mutated_fingerprint);
+
+        // Labels of different colours are distinguished
+        MAKE_PTR_ARGS(CellLabel, p_label, (3));
+        p_cell->AddCellProperty(p_label);
+        std::size_t labelled_fingerprint = mpNodeBasedCellPopulation->CalculateHaloCellFingerprint(p_cell);
+        TS_ASSERT_DIFFERS(labelled_fingerprint, mutated_fingerprint);
+
+        p_cell->RemoveCellProperty<CellLabel>();
+        MAKE_PTR_ARGS(CellLabel, p_other_label, (4));
+        p_cell->AddCellProperty(p_other_label);
+        TS_ASSERT_DIFFERS(mpNodeBasedCellPopulation->CalculateHaloCellFingerprint(p_cell), labelled_fingerprint);
+    }
+
     void TestUpdateWithLoadBalanceDoesntThrow()
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -393,6 +496,53 @@ public:
             delete nodes[i];
         }
     }
+
+    void TestBlockDecompositionUpdateAndHaloCells()
+    {
+        std::vector<Node<3>* > nodes;
+        for (unsigned i=0; i<64; i++)
+        {
+            nodes.push_back(new Node<3>(i, false, 0.5 + (i%4), 0.5 + ((i/4)%4), 0.5 + (i/16)));
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.SetUseBlockDecomposition();
+        mesh.ConstructNodesWithoutMesh(nodes, 1.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        cell_population.Update();
+
+        // Moving cells between blocks keeps every cell on exactly one process
+        cell_population.UpdateCellProcessLocation();
+        unsigned num_local_cells = cell_population.GetNumRealCells();
+        unsigned total_num_cells = 0;
+        MPI_Allreduce(&num_local_cells, &total_num_cells, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_num_cells, 64u);
+
+        // Halo cells come from the neighbouring blocks, including across edges and corners
+        cell_population.RefreshHaloCells();
+        cell_population.AddReceivedHaloCells();
+
+        for (unsigned i=0; i<cell_population.mHaloCells.size(); i++)
+        {
+            unsigned node_index = cell_population.mHaloCellLocationMap[cell_population.mHaloCells[i]];
+            c_vector<double, 3> location = mesh.GetNodeOrHaloNode(node_index)->rGetLocation();
+            TS_ASSERT(!mesh.IsOwned(location));
+        }
+        if (PetscTools::IsSequential())
+        {
+            TS_ASSERT(cell_population.mHaloCells.empty());
+        }
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
 };
 
 #endif /*TESTNODEBASEDCELLPOPULATIONPARALLELMETHODS_HPP_*/
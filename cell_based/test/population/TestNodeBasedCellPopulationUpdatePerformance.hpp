@@ -0,0 +1,105 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTNODEBASEDCELLPOPULATIONUPDATEPERFORMANCE_HPP_
+#define TESTNODEBASEDCELLPOPULATIONUPDATEPERFORMANCE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbstractCellBasedWithTimingsTestSuite.hpp"
+#include "CellsGenerator.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "NodesOnlyMesh.hpp"
+#include "SmartPointers.hpp"
+#include "Timer.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * Profiles rebuilding the box collection and node pairs of a NodeBasedCellPopulation
+ * of a million cells, which is done every time step of a simulation.
+ */
+class TestNodeBasedCellPopulationUpdatePerformance : public AbstractCellBasedWithTimingsTestSuite
+{
+public:
+
+    void TestUpdateMillionCells()
+    {
+        // A 100x100x100 grid of cells
+        unsigned cells_across = 100;
+        std::vector<Node<3>*> nodes;
+        nodes.reserve(cells_across*cells_across*cells_across);
+        for (unsigned i=0; i<cells_across; i++)
+        {
+            for (unsigned j=0; j<cells_across; j++)
+            {
+                for (unsigned k=0; k<cells_across; k++)
+                {
+                    nodes.push_back(new Node<3>(nodes.size(), false, (double) i, (double) j, (double) k));
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        CellsGenerator<UniformCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_transit_type);
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        Timer::PrintAndReset("Set up 10^6 cells");
+
+        unsigned num_updates = 10;
+        for (unsigned i=0; i<num_updates; i++)
+        {
+            cell_population.Update();
+        }
+        Timer::PrintAndReset("10 updates of 10^6 cells");
+
+        TS_ASSERT_EQUALS(cell_population.GetNumRealCells(), cells_across*cells_across*cells_across);
+        TS_ASSERT(!cell_population.rGetNodePairs().empty());
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+};
+
+#endif /*TESTNODEBASEDCELLPOPULATIONUPDATEPERFORMANCE_HPP_*/
@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellsGenerator.hpp"
 #include "PottsBasedCellPopulation.hpp"
+#include "OpenMpTools.hpp"
 #include "VolumeConstraintPottsUpdateRule.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
@@ -421,6 +422,92 @@ public:
         TS_ASSERT_EQUALS(cell_population.rGetMesh().GetElement(1)->GetNumNodes(), 4u);
     }
 
+    void TestUpdateCellLocationsWithParallelSweeps()
+    {
+        // Create two identical 2D PottsMeshes with four cells each, to update with different numbers of threads
+        PottsMeshGenerator<2> generator(8, 2, 4, 8, 2, 4);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+        PottsMeshGenerator<2> other_generator(8, 2, 4, 8, 2, 4);
+        PottsMesh<2>* p_other_mesh = other_generator.GetMesh();
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        std::vector<CellPtr> other_cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+        cells_generator.GenerateBasic(other_cells, p_other_mesh->GetNumElements());
+
+        // Create cell populations
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        PottsBasedCellPopulation<2> other_cell_population(*p_other_mesh, other_cells);
+
+        TS_ASSERT_EQUALS(cell_population.GetUseParallelSweeps(), false);
+        cell_population.SetUseParallelSweeps();
+        other_cell_population.SetUseParallelSweeps(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseParallelSweeps(), true);
+
+        // On a regular lattice the Moore neighbourhood gives a checkerboard of four colours
+        cell_population.SetUpParallelSweepTables();
+        TS_ASSERT_EQUALS(cell_population.mSweepColourOffsets.size(), 5u);
+        TS_ASSERT_EQUALS(cell_population.mSweepSites.size(), 64u);
+        for (unsigned colour=0; colour<4; colour++)
+        {
+            TS_ASSERT_EQUALS(cell_population.mSweepColourOffsets[colour+1] - cell_population.mSweepColourOffsets[colour], 16u);
+
+            // No two nodes of the same colour are neighbours
+            std::set<unsigned> sites(cell_population.mSweepSites.begin() + cell_population.mSweepColourOffsets[colour],
+                                     cell_population.mSweepSites.begin() + cell_population.mSweepColourOffsets[colour+1]);
+            for (std::set<unsigned>::iterator iter = sites.begin(); iter != sites.end(); ++iter)
+            {
+                std::set<unsigned> neighbours = p_mesh->GetMooreNeighbouringNodeIndices(*iter);
+                for (std::set<unsigned>::iterator neighbour_iter = neighbours.begin(); neighbour_iter != neighbours.end(); ++neighbour_iter)
+                {
+                    TS_ASSERT_EQUALS(sites.count(*neighbour_iter), 0u);
+                }
+            }
+        }
+
+        // Increase temperature: allows swaps to be more likely
+        cell_population.SetTemperature(10.0);
+        other_cell_population.SetTemperature(10.0);
+        cell_population.SetNumSweepsPerTimestep(3);
+        other_cell_population.SetNumSweepsPerTimestep(3);
+
+        MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+        cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+        other_cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+
+        // The same seed gives the same configuration, with one thread or several
+        unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+        OpenMpTools::SetNumThreads(1);
+        RandomNumberGenerator::Instance()->Reseed(0);
+        cell_population.UpdateCellLocations(1.0);
+        OpenMpTools::SetNumThreads(4);
+        RandomNumberGenerator::Instance()->Reseed(0);
+        other_cell_population.UpdateCellLocations(1.0);
+        OpenMpTools::SetNumThreads(num_threads);
+
+        unsigned num_nodes_in_elements = 0;
+        for (unsigned elem_index=0; elem_index<4; elem_index++)
+        {
+            PottsElement<2>* p_element = cell_population.GetElement(elem_index);
+            PottsElement<2>* p_other_element = other_cell_population.GetElement(elem_index);
+            TS_ASSERT_EQUALS(p_element->GetNumNodes(), p_other_element->GetNumNodes());
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                TS_ASSERT_EQUALS(p_element->GetNodeGlobalIndex(local_index), p_other_element->GetNodeGlobalIndex(local_index));
+            }
+            num_nodes_in_elements += p_element->GetNumNodes();
+        }
+
+        // Every node is still in exactly one element
+        TS_ASSERT_EQUALS(num_nodes_in_elements, 64u);
+        for (unsigned node_index=0; node_index<64; node_index++)
+        {
+            TS_ASSERT_EQUALS(cell_population.GetNode(node_index)->GetNumContainingElements(), 1u);
+        }
+    }
+
     ///\todo implement this test (#1666)
 //    void TestVoronoiMethods()
 //    {
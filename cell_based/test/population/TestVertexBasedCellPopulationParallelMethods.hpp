@@ -0,0 +1,725 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXBASEDCELLPOPULATIONPARALLELMETHODS_HPP_
+#define TESTVERTEXBASEDCELLPOPULATIONPARALLELMETHODS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include "CheckpointArchiveTypes.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <boost/scoped_ptr.hpp>
+
+#include "VertexBasedCellPopulation.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "T2SwapCellKiller.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "SmartPointers.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "FileFinder.hpp"
+#include "ShortAxisVertexBasedDivisionRule.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestVertexBasedCellPopulationParallelMethods : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Construct a honeycomb mesh on the master process, and an empty mesh on the other processes,
+     * which receive their elements when the cell population is distributed.
+     *
+     * @param numElementsAcross the number of elements across the mesh
+     * @param numElementsUp the number of elements up the mesh
+     * @param triangleNodeIndex the index of a node of the honeycomb mesh to replace by a small
+     *     triangular element, which is added after the other elements (defaults to none)
+     * @return the mesh
+     */
+    MutableVertexMesh<2,2>* ConstructMesh(unsigned numElementsAcross, unsigned numElementsUp, unsigned triangleNodeIndex=UINT_MAX)
+    {
+        std::vector<Node<2>*> nodes;
+        std::vector<VertexElement<2,2>*> elements;
+
+        if (PetscTools::AmMaster())
+        {
+            HoneycombVertexMeshGenerator generator(numElementsAcross, numElementsUp);
+            MutableVertexMesh<2,2>* p_honeycomb_mesh = generator.GetMesh();
+
+            // Copy the nodes, apart from any that is replaced by a triangular element
+            std::vector<Node<2>*> node_copies(p_honeycomb_mesh->GetNumNodes(), NULL);
+            for (unsigned i=0; i<p_honeycomb_mesh->GetNumNodes(); i++)
+            {
+                if (i != triangleNodeIndex)
+                {
+                    Node<2>* p_node = p_honeycomb_mesh->GetNode(i);
+                    node_copies[i] = new Node<2>(nodes.size(), p_node->rGetLocation(), p_node->IsBoundaryNode());
+                    nodes.push_back(node_copies[i]);
+                }
+            }
+
+            // The triangle has a vertex on each edge meeting at the replaced node, indexed by the other node of the edge
+            std::map<unsigned, Node<2>*> triangle_nodes;
+            if (triangleNodeIndex != UINT_MAX)
+            {
+                Node<2>* p_centre = p_honeycomb_mesh->GetNode(triangleNodeIndex);
+                const std::set<unsigned>& r_containing_elements = p_centre->rGetContainingElementIndices();
+                for (std::set<unsigned>::const_iterator iter = r_containing_elements.begin();
+                     iter != r_containing_elements.end();
+                     ++iter)
+                {
+                    VertexElement<2,2>* p_element = p_honeycomb_mesh->GetElement(*iter);
+                    unsigned num_nodes = p_element->GetNumNodes();
+                    unsigned local_index = p_element->GetNodeLocalIndex(triangleNodeIndex);
+                    unsigned neighbours[2] = {p_element->GetNodeGlobalIndex((local_index + num_nodes - 1)%num_nodes),
+                                              p_element->GetNodeGlobalIndex((local_index + 1)%num_nodes)};
+                    for (unsigned k=0; k<2; k++)
+                    {
+                        if (triangle_nodes.find(neighbours[k]) == triangle_nodes.end())
+                        {
+                            c_vector<double, 2> direction = p_honeycomb_mesh->GetNode(neighbours[k])->rGetLocation() - p_centre->rGetLocation();
+                            c_vector<double, 2> location = p_centre->rGetLocation() + 0.1*direction/norm_2(direction);
+                            triangle_nodes[neighbours[k]] = new Node<2>(nodes.size(), location, p_centre->IsBoundaryNode());
+                            nodes.push_back(triangle_nodes[neighbours[k]]);
+                        }
+                    }
+                }
+            }
+
+            // Copy the elements, replacing the replaced node by the two vertices of the triangle on its edges
+            for (unsigned elem_index=0; elem_index<p_honeycomb_mesh->GetNumElements(); elem_index++)
+            {
+                VertexElement<2,2>* p_element = p_honeycomb_mesh->GetElement(elem_index);
+                unsigned num_nodes = p_element->GetNumNodes();
+                std::vector<Node<2>*> element_nodes;
+                for (unsigned local_index=0; local_index<num_nodes; local_index++)
+                {
+                    unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+                    if (node_index == triangleNodeIndex)
+                    {
+                        element_nodes.push_back(triangle_nodes[p_element->GetNodeGlobalIndex((local_index + num_nodes - 1)%num_nodes)]);
+                        element_nodes.push_back(triangle_nodes[p_element->GetNodeGlobalIndex((local_index + 1)%num_nodes)]);
+                    }
+                    else
+                    {
+                        element_nodes.push_back(node_copies[node_index]);
+                    }
+                }
+                elements.push_back(new VertexElement<2,2>(elem_index, element_nodes));
+            }
+
+            // Order the vertices of the triangle anticlockwise
+            if (!triangle_nodes.empty())
+            {
+                c_vector<double, 2> centre = p_honeycomb_mesh->GetNode(triangleNodeIndex)->rGetLocation();
+                std::vector<std::pair<double, Node<2>*> > angles;
+                for (std::map<unsigned, Node<2>*>::iterator iter = triangle_nodes.begin();
+                     iter != triangle_nodes.end();
+                     ++iter)
+                {
+                    c_vector<double, 2> direction = iter->second->rGetLocation() - centre;
+                    angles.push_back(std::make_pair(atan2(direction[1], direction[0]), iter->second));
+                }
+                std::sort(angles.begin(), angles.end());
+
+                std::vector<Node<2>*> element_nodes;
+                for (unsigned k=0; k<angles.size(); k++)
+                {
+                    element_nodes.push_back(angles[k].second);
+                }
+                elements.push_back(new VertexElement<2,2>(elements.size(), element_nodes));
+            }
+        }
+
+        return new MutableVertexMesh<2,2>(nodes, elements);
+    }
+
+    /**
+     * Construct a cell population, to be distributed, from a mesh constructed by ConstructMesh().
+     *
+     * @param pMesh the mesh, which is deleted by the cell population
+     * @return the cell population
+     */
+    VertexBasedCellPopulation<2>* ConstructCellPopulation(MutableVertexMesh<2,2>* pMesh)
+    {
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, pMesh->GetNumElements());
+
+        return new VertexBasedCellPopulation<2>(*pMesh, cells, true);
+    }
+
+    /**
+     * @return the locations of the nodes of an element of the mesh on the master process, on every process.
+     *
+     * @param rMesh the mesh, before the cell population is distributed
+     * @param elemIndex the index of the element on the master process
+     */
+    std::vector<c_vector<double, 2> > GetElementNodeLocationsOnMaster(MutableVertexMesh<2,2>& rMesh, unsigned elemIndex)
+    {
+        unsigned num_nodes = PetscTools::AmMaster() ? rMesh.GetElement(elemIndex)->GetNumNodes() : 0;
+        MPI_Bcast(&num_nodes, 1, MPI_UNSIGNED, 0, PetscTools::GetWorld());
+
+        std::vector<double> coordinates(2*num_nodes);
+        if (PetscTools::AmMaster())
+        {
+            for (unsigned local_index=0; local_index<num_nodes; local_index++)
+            {
+                coordinates[2*local_index] = rMesh.GetElement(elemIndex)->GetNode(local_index)->rGetLocation()[0];
+                coordinates[2*local_index + 1] = rMesh.GetElement(elemIndex)->GetNode(local_index)->rGetLocation()[1];
+            }
+        }
+        MPI_Bcast(&coordinates[0], 2*num_nodes, MPI_DOUBLE, 0, PetscTools::GetWorld());
+
+        std::vector<c_vector<double, 2> > locations(num_nodes);
+        for (unsigned local_index=0; local_index<num_nodes; local_index++)
+        {
+            locations[local_index][0] = coordinates[2*local_index];
+            locations[local_index][1] = coordinates[2*local_index + 1];
+        }
+        return locations;
+    }
+
+    /**
+     * @return the id of the cell associated with an element on the master process, on every process.
+     *
+     * @param rCellPopulation the cell population, before it is distributed
+     * @param elemIndex the index of the element on the master process
+     */
+    unsigned GetCellIdOnMaster(VertexBasedCellPopulation<2>& rCellPopulation, unsigned elemIndex)
+    {
+        unsigned cell_id = PetscTools::AmMaster() ? rCellPopulation.GetCellUsingLocationIndex(elemIndex)->GetCellId() : 0;
+        MPI_Bcast(&cell_id, 1, MPI_UNSIGNED, 0, PetscTools::GetWorld());
+        return cell_id;
+    }
+
+    /**
+     * @return the cell with a given id, if it is owned by this process, or a null pointer.
+     *
+     * @param rCellPopulation the cell population
+     * @param cellId the id of the cell
+     */
+    CellPtr GetOwnedCell(VertexBasedCellPopulation<2>& rCellPopulation, unsigned cellId)
+    {
+        for (AbstractCellPopulation<2>::Iterator cell_iter = rCellPopulation.Begin();
+             cell_iter != rCellPopulation.End();
+             ++cell_iter)
+        {
+            if (cell_iter->GetCellId() == cellId)
+            {
+                return *cell_iter;
+            }
+        }
+        return CellPtr();
+    }
+
+    /**
+     * Move the node at a given location, on each process that has a copy of it.
+     *
+     * @param rMesh the mesh
+     * @param rOldLocation the location of the node
+     * @param rNewLocation the new location of the node
+     * @return the nodes moved on this process
+     */
+    std::vector<Node<2>*> MoveNode(MutableVertexMesh<2,2>& rMesh, const c_vector<double, 2>& rOldLocation, const c_vector<double, 2>& rNewLocation)
+    {
+        std::vector<Node<2>*> moved_nodes;
+        for (unsigned node_index=0; node_index<rMesh.GetNumAllNodes(); node_index++)
+        {
+            Node<2>* p_node = rMesh.GetNode(node_index);
+            if (!p_node->IsDeleted() && norm_2(p_node->rGetLocation() - rOldLocation) < 1e-8)
+            {
+                p_node->rGetModifiableLocation() = rNewLocation;
+                moved_nodes.push_back(p_node);
+            }
+        }
+        return moved_nodes;
+    }
+
+    /**
+     * @return the sum of a number over all processes.
+     *
+     * @param number the number on this process
+     */
+    unsigned SumOverProcesses(unsigned number)
+    {
+        unsigned total;
+        MPI_Allreduce(&number, &total, 1, MPI_UNSIGNED, MPI_SUM, PetscTools::GetWorld());
+        return total;
+    }
+
+    /**
+     * Check that each process owns the cells in its region, and the total number of cells.
+     *
+     * @param rCellPopulation the cell population
+     * @param numCells the expected total number of cells
+     */
+    void CheckDistributedCellPopulation(VertexBasedCellPopulation<2>& rCellPopulation, unsigned numCells)
+    {
+        unsigned my_rank = PetscTools::GetMyRank();
+        const std::vector<double>& r_boundaries = rCellPopulation.rGetProcessRegionBoundaries();
+        TS_ASSERT_EQUALS(r_boundaries.size(), PetscTools::GetNumProcs() - 1);
+
+        double region_min = PetscTools::AmMaster() ? -DBL_MAX : r_boundaries[my_rank - 1];
+        double region_max = PetscTools::AmTopMost() ? DBL_MAX : r_boundaries[my_rank];
+
+        // Each process owns the cells whose centroids lie in its region
+        for (AbstractCellPopulation<2>::Iterator cell_iter = rCellPopulation.Begin();
+             cell_iter != rCellPopulation.End();
+             ++cell_iter)
+        {
+            double y = rCellPopulation.GetLocationOfCellCentre(*cell_iter)[1];
+            TS_ASSERT_LESS_THAN_EQUALS(region_min, y);
+            TS_ASSERT_LESS_THAN(y, region_max);
+        }
+
+        // Every cell is owned by exactly one process
+        unsigned num_local_cells = rCellPopulation.GetNumRealCells();
+        TS_ASSERT_EQUALS(SumOverProcesses(num_local_cells), numCells);
+
+        // The remaining elements are halo elements, copied from neighbouring processes
+        unsigned num_halo_elements = 0;
+        MutableVertexMesh<2,2>& r_mesh = rCellPopulation.rGetMesh();
+        for (VertexMesh<2,2>::VertexElementIterator elem_iter = r_mesh.GetElementIteratorBegin();
+             elem_iter != r_mesh.GetElementIteratorEnd();
+             ++elem_iter)
+        {
+            TS_ASSERT_THROWS_NOTHING(rCellPopulation.GetCellUsingLocationIndex(elem_iter->GetIndex()));
+            if (!elem_iter->GetOwnership())
+            {
+                num_halo_elements++;
+            }
+        }
+        TS_ASSERT_EQUALS(num_halo_elements + num_local_cells, rCellPopulation.GetNumElements());
+        TS_ASSERT_EQUALS(num_halo_elements > 0, !PetscTools::IsSequential());
+    }
+
+public:
+
+    void TestDistributeBetweenProcesses()
+    {
+        // Create a mesh with four rows of elements for each process, on the master process only
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), PetscTools::AmMaster() ? 16*num_procs : 0u);
+
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+        TS_ASSERT_EQUALS(p_cell_population->IsDistributed(), false);
+
+        p_cell_population->DistributeBetweenProcesses();
+        TS_ASSERT_EQUALS(p_cell_population->IsDistributed(), true);
+
+        // Each process owns four rows of elements
+        TS_ASSERT_EQUALS(p_cell_population->GetNumRealCells(), 16u);
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+
+        TS_ASSERT_THROWS_THIS(p_cell_population->DistributeBetweenProcesses(),
+                              "The cell population has already been distributed between processes");
+    }
+
+    void TestDistributeBetweenProcessesExceptions()
+    {
+        EXIT_IF_SEQUENTIAL;
+
+        unsigned num_procs = PetscTools::GetNumProcs();
+
+        // Only the master process may hold the initial mesh
+        {
+            HoneycombVertexMeshGenerator generator(4, 4*num_procs);
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, generator.GetMesh()->GetNumElements());
+
+            VertexBasedCellPopulation<2> cell_population(*(generator.GetMesh()), cells);
+            TS_ASSERT_THROWS_THIS(cell_population.DistributeBetweenProcesses(),
+                                  "Only the master process may construct the cell population from a non-empty mesh before it is distributed");
+        }
+
+        // There must be at least one cell for each process
+        {
+            boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(ConstructMesh(1, num_procs - 1)));
+            std::stringstream message;
+            message << "Cannot distribute " << num_procs - 1 << " cells between " << num_procs << " processes";
+            TS_ASSERT_THROWS_THIS(p_cell_population->DistributeBetweenProcesses(), message.str());
+        }
+
+        // Regions other than the first and last must be at least two elements high
+        if (num_procs > 2)
+        {
+            boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(ConstructMesh(4, num_procs)));
+            TS_ASSERT_THROWS_THIS(p_cell_population->DistributeBetweenProcesses(),
+                                  "The region owned by process 1 is narrower than twice the extent of an element; use fewer processes");
+        }
+    }
+
+    void TestUpdateMigratesCells()
+    {
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+        p_cell_population->DistributeBetweenProcesses();
+
+        // Move the tissue up by slightly more than the spacing between rows of elements
+        p_mesh->Translate(0.0, 1.0);
+        p_cell_population->Update();
+
+        // The top row of elements owned by each process, bar the last, has moved to the next process
+        unsigned expected_num_cells = 16;
+        if (!PetscTools::AmMaster())
+        {
+            expected_num_cells += 4;
+        }
+        if (!PetscTools::AmTopMost())
+        {
+            expected_num_cells -= 4;
+        }
+        TS_ASSERT_EQUALS(p_cell_population->GetNumRealCells(), expected_num_cells);
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+
+        // Moving the tissue back returns the cells
+        p_mesh->Translate(0.0, -1.0);
+        p_cell_population->Update();
+
+        TS_ASSERT_EQUALS(p_cell_population->GetNumRealCells(), 16u);
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+    }
+
+    void TestUpdateRebalancesRegions()
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+        p_cell_population->SetLoadBalanceFrequency(1);
+        p_cell_population->DistributeBetweenProcesses();
+
+        // The regions follow the tissue as it moves, so no cells migrate
+        std::vector<double> old_boundaries = p_cell_population->rGetProcessRegionBoundaries();
+        p_mesh->Translate(0.0, 1.0);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        p_cell_population->Update();
+
+        const std::vector<double>& r_boundaries = p_cell_population->rGetProcessRegionBoundaries();
+        TS_ASSERT_EQUALS(r_boundaries.size(), num_procs - 1);
+        for (unsigned k=0; k<r_boundaries.size(); k++)
+        {
+            TS_ASSERT_DELTA(r_boundaries[k], old_boundaries[k] + 1.0, 1e-6);
+        }
+        TS_ASSERT_EQUALS(p_cell_population->GetNumRealCells(), 16u);
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+
+        // Without rebalancing, the top row of elements owned by each process, bar the last, moves to the next process
+        p_cell_population->SetLoadBalanceRegions(false);
+        old_boundaries = p_cell_population->rGetProcessRegionBoundaries();
+        p_mesh->Translate(0.0, 1.0);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        p_cell_population->Update();
+
+        for (unsigned k=0; k<r_boundaries.size(); k++)
+        {
+            TS_ASSERT_DELTA(r_boundaries[k], old_boundaries[k], 1e-12);
+        }
+        unsigned expected_num_cells = 16;
+        if (!PetscTools::AmMaster())
+        {
+            expected_num_cells += 4;
+        }
+        if (!PetscTools::AmTopMost())
+        {
+            expected_num_cells -= 4;
+        }
+        TS_ASSERT_EQUALS(p_cell_population->GetNumRealCells(), expected_num_cells);
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+    }
+
+    void TestT1SwapAcrossProcessBoundary()
+    {
+        EXIT_IF_SEQUENTIAL;
+
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+
+        // The top edge of element 12 (in the top row owned by the master process) is shared with an element owned by process 1
+        std::vector<c_vector<double, 2> > locations = GetElementNodeLocationsOnMaster(*p_mesh, 12);
+        p_cell_population->DistributeBetweenProcesses();
+
+        // Shrink the edge below the cell rearrangement threshold, on each process
+        c_vector<double, 2> midpoint = 0.5*(locations[2] + locations[3]);
+        c_vector<double, 2> unit_vector = (locations[3] - locations[2])/norm_2(locations[3] - locations[2]);
+        std::vector<Node<2>*> moved_nodes = MoveNode(*p_mesh, locations[2], midpoint - 0.002*unit_vector);
+        std::vector<Node<2>*> other_moved_nodes = MoveNode(*p_mesh, locations[3], midpoint + 0.002*unit_vector);
+        moved_nodes.insert(moved_nodes.end(), other_moved_nodes.begin(), other_moved_nodes.end());
+
+        // Each of processes 0 and 1 has a copy of the edge, but cannot rearrange the elements around it
+        bool is_at_boundary = (PetscTools::GetMyRank() < 2);
+        TS_ASSERT_EQUALS(moved_nodes.size(), is_at_boundary ? 2u : 0u);
+        for (unsigned i=0; i<moved_nodes.size(); i++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(moved_nodes[i]), false);
+        }
+        std::vector<unsigned> elements_awaiting_rearrangement;
+        p_mesh->GetOwnedElementsAwaitingRearrangement(elements_awaiting_rearrangement);
+        TS_ASSERT_EQUALS(elements_awaiting_rearrangement.empty(), !is_at_boundary);
+
+        // The swap is deferred, and the elements around the edge are moved to the master process
+        p_cell_population->Update();
+        TS_ASSERT_EQUALS(SumOverProcesses(p_mesh->GetLocationsOfT1Swaps().size()), 0u);
+        if (PetscTools::GetMyRank() == 0)
+        {
+            TS_ASSERT_EQUALS(p_cell_population->mCellIdsToRequestFromRight.empty(), false);
+            TS_ASSERT_EQUALS(p_cell_population->mCellIdsToKeep.empty(), false);
+        }
+        if (PetscTools::GetMyRank() == 1)
+        {
+            TS_ASSERT_EQUALS(p_cell_population->mCellIdsToSendLeft.empty(), false);
+        }
+
+        // The master process then performs the swap
+        p_cell_population->Update();
+        TS_ASSERT_EQUALS(p_mesh->GetLocationsOfT1Swaps().size(), PetscTools::AmMaster() ? 1u : 0u);
+        TS_ASSERT_EQUALS(SumOverProcesses(p_mesh->GetLocationsOfT1Swaps().size()), 1u);
+
+        // The cells return to the processes owning their regions
+        p_cell_population->Update();
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+    }
+
+    void TestT2SwapAcrossProcessBoundary()
+    {
+        EXIT_IF_SEQUENTIAL;
+
+        // Replace a node shared by elements owned by processes 0 and 1 with a small triangular element, owned by process 1
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs, 40);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+
+        std::vector<c_vector<double, 2> > locations = GetElementNodeLocationsOnMaster(*p_mesh, 16*num_procs);
+        TS_ASSERT_EQUALS(locations.size(), 3u);
+        p_cell_population->DistributeBetweenProcesses();
+        TS_ASSERT_EQUALS(SumOverProcesses(p_cell_population->GetNumRealCells()), 16*num_procs + 1);
+
+        // Shrink the triangle below the T2 threshold, on each process
+        c_vector<double, 2> centroid = (locations[0] + locations[1] + locations[2])/3.0;
+        std::vector<Node<2>*> moved_nodes;
+        for (unsigned i=0; i<3; i++)
+        {
+            std::vector<Node<2>*> nodes = MoveNode(*p_mesh, locations[i], centroid + 0.1*(locations[i] - centroid));
+            moved_nodes.insert(moved_nodes.end(), nodes.begin(), nodes.end());
+        }
+        for (unsigned i=0; i<moved_nodes.size(); i++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(moved_nodes[i]), false);
+        }
+
+        // The swap is deferred, and the elements around the triangle are moved to the master process
+        p_cell_population->Update();
+        if (PetscTools::GetMyRank() == 1)
+        {
+            TS_ASSERT_EQUALS(p_cell_population->mCellIdsToSendLeft.empty(), false);
+        }
+        p_cell_population->Update();
+
+        // The master process then performs the swap
+        T2SwapCellKiller<2> cell_killer(p_cell_population.get());
+        cell_killer.CheckAndLabelCellsForApoptosisOrDeath();
+        TS_ASSERT_EQUALS(p_cell_population->GetLocationsOfT2Swaps().size(), PetscTools::AmMaster() ? 1u : 0u);
+        TS_ASSERT_EQUALS(SumOverProcesses(p_cell_population->GetLocationsOfT2Swaps().size()), 1u);
+        TS_ASSERT_EQUALS(SumOverProcesses(p_cell_population->RemoveDeadCells()), 1u);
+
+        p_cell_population->Update();
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+    }
+
+    void TestT3SwapAcrossProcessBoundary()
+    {
+        EXIT_IF_SEQUENTIAL;
+
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+
+        // Element 16, owned by process 1, has a boundary node that is not in element 12, owned by the master process
+        std::vector<c_vector<double, 2> > lower_locations = GetElementNodeLocationsOnMaster(*p_mesh, 12);
+        std::vector<c_vector<double, 2> > upper_locations = GetElementNodeLocationsOnMaster(*p_mesh, 16);
+        p_cell_population->DistributeBetweenProcesses();
+
+        // Move this node into element 12, just inside its left edge
+        c_vector<double, 2> centroid = zero_vector<double>(2);
+        for (unsigned i=0; i<lower_locations.size(); i++)
+        {
+            centroid += lower_locations[i]/lower_locations.size();
+        }
+        c_vector<double, 2> edge_midpoint = 0.5*(lower_locations[4] + lower_locations[5]);
+        std::vector<Node<2>*> moved_nodes = MoveNode(*p_mesh, upper_locations[5], edge_midpoint + 0.1*(centroid - edge_midpoint));
+        for (unsigned i=0; i<moved_nodes.size(); i++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(moved_nodes[i]), false);
+        }
+
+        // The swap is deferred, and the elements involved are moved to the master process, which performs it
+        p_cell_population->Update();
+        TS_ASSERT_EQUALS(SumOverProcesses(p_mesh->GetLocationsOfT3Swaps().size()), 0u);
+        p_cell_population->Update();
+        TS_ASSERT_EQUALS(p_mesh->GetLocationsOfT3Swaps().size(), PetscTools::AmMaster() ? 1u : 0u);
+        TS_ASSERT_EQUALS(SumOverProcesses(p_mesh->GetLocationsOfT3Swaps().size()), 1u);
+
+        p_cell_population->Update();
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+    }
+
+    void TestDivisionAcrossProcessBoundary()
+    {
+        EXIT_IF_SEQUENTIAL;
+
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+
+        // Element 13 is in the top row owned by the master process
+        unsigned cell_id = GetCellIdOnMaster(*p_cell_population, 13);
+        p_cell_population->DistributeBetweenProcesses();
+
+        CellPtr p_cell = GetOwnedCell(*p_cell_population, cell_id);
+        TS_ASSERT_EQUALS(bool(p_cell), PetscTools::AmMaster());
+        if (PetscTools::AmMaster())
+        {
+            // The division is deferred until the neighbouring elements are owned by the master process
+            TS_ASSERT_EQUALS(p_cell_population->IsRoomToDivide(p_cell), false);
+            TS_ASSERT_EQUALS(p_cell_population->mCellIdsToRequestFromRight.empty(), false);
+        }
+
+        p_cell_population->Update();
+
+        if (PetscTools::AmMaster())
+        {
+            TS_ASSERT_EQUALS(p_cell_population->IsRoomToDivide(p_cell), true);
+
+            MAKE_PTR(WildTypeCellMutationState, p_state);
+            MAKE_PTR(StemCellProliferativeType, p_stem_type);
+            FixedG1GenerationalCellCycleModel* p_model = new FixedG1GenerationalCellCycleModel();
+            CellPtr p_new_cell(new Cell(p_state, p_model));
+            p_new_cell->SetCellProliferativeType(p_stem_type);
+            p_new_cell->SetBirthTime(-1);
+
+            p_cell_population->AddCell(p_new_cell, p_cell);
+        }
+
+        p_cell_population->Update();
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs + 1);
+    }
+
+    void TestDeathAcrossProcessBoundary()
+    {
+        EXIT_IF_SEQUENTIAL;
+
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+
+        unsigned cell_id = GetCellIdOnMaster(*p_cell_population, 13);
+        p_cell_population->DistributeBetweenProcesses();
+
+        CellPtr p_cell = GetOwnedCell(*p_cell_population, cell_id);
+        if (p_cell)
+        {
+            p_cell->Kill();
+        }
+
+        // The removal is deferred until the neighbouring elements are owned by the master process
+        TS_ASSERT_EQUALS(SumOverProcesses(p_cell_population->RemoveDeadCells()), 0u);
+        if (PetscTools::AmMaster())
+        {
+            TS_ASSERT_EQUALS(p_cell_population->mCellIdsToRequestFromRight.empty(), false);
+        }
+
+        p_cell_population->Update();
+        TS_ASSERT_EQUALS(p_cell_population->RemoveDeadCells(), PetscTools::AmMaster() ? 1u : 0u);
+
+        p_cell_population->Update();
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs - 1);
+    }
+
+    void TestOffLatticeSimulationWithDistributedCellPopulation()
+    {
+        unsigned num_procs = PetscTools::GetNumProcs();
+        MutableVertexMesh<2,2>* p_mesh = ConstructMesh(4, 4*num_procs);
+        boost::scoped_ptr<VertexBasedCellPopulation<2> > p_cell_population(ConstructCellPopulation(p_mesh));
+        p_cell_population->DistributeBetweenProcesses();
+
+        OffLatticeSimulation<2> simulator(*p_cell_population);
+        simulator.SetOutputDirectory("TestOffLatticeSimulationWithDistributedVertexBasedCellPopulation");
+        simulator.SetEndTime(0.1);
+        simulator.SetSamplingTimestepMultiple(10);
+
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        simulator.AddForce(p_force);
+        MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+        simulator.AddSimulationModifier(p_growth_modifier);
+
+        simulator.Solve();
+
+        // No cells divide or die, and each process still owns the cells in its region
+        CheckDistributedCellPopulation(*p_cell_population, 16*num_procs);
+
+        // Each process writes its own results
+        OutputFileHandler handler("TestOffLatticeSimulationWithDistributedVertexBasedCellPopulation/results_from_time_0", false);
+        for (unsigned process=0; process<num_procs; process++)
+        {
+            std::stringstream process_directory;
+            process_directory << "process_" << process << "/";
+            TS_ASSERT(handler.FindFile(process_directory.str() + "results.viznodes").Exists());
+            TS_ASSERT(handler.FindFile(process_directory.str() + "results.vizelements").Exists());
+            TS_ASSERT(handler.FindFile(process_directory.str() + "results.vizcelltypes").Exists());
+        }
+
+        // Archiving a distributed population is not supported
+        std::ostringstream stream;
+        boost::archive::text_oarchive output_arch(stream);
+        VertexBasedCellPopulation<2>* const p_population = p_cell_population.get();
+        TS_ASSERT_THROWS_THIS(output_arch << p_population,
+                              "Archiving a VertexBasedCellPopulation that has been distributed between processes is not supported");
+    }
+};
+
+#endif /*TESTVERTEXBASEDCELLPOPULATIONPARALLELMETHODS_HPP_*/
@@ -65,7 +65,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "PopulationTestingForce.hpp"
 #include "ForwardEulerNumericalMethod.hpp"
+#include "RK2NumericalMethod.hpp"
+#include "RK4NumericalMethod.hpp"
+#include "BogackiShampineNumericalMethod.hpp"
+#include "BackwardEulerNumericalMethod.hpp"
+#include "StepSizeException.hpp"
 #include "Warnings.hpp"
+#include "Cylindrical2dNodesOnlyMesh.hpp"
+#include "CylindricalHoneycombMeshGenerator.hpp"
 
 
 #include "PetscSetupAndFinalize.hpp"
@@ -475,6 +482,496 @@ public:
         }
     }
 
+    void TestFusedForwardEulerUpdateAndDampingConstantCache()
+    {
+        EXIT_IF_PARALLEL;    // This test doesn't work in parallel.
+
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+        p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 2.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+        cell_population.SetDampingConstantMutant(2.3);
+
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        MAKE_PTR(ForwardEulerNumericalMethod<2>, p_fe_method);
+        p_fe_method->SetCellPopulation(&cell_population);
+        p_fe_method->SetForceCollection(&force_collection);
+
+        // Node-based populations on a NodesOnlyMesh use the fused update
+        TS_ASSERT_EQUALS(cell_population.CanMoveNodesInPlace(), true);
+        TS_ASSERT_EQUALS(p_fe_method->CanUseFusedUpdate(), true);
+
+        double dt = 0.01;
+        p_fe_method->UpdateAllNodePositions(dt);
+        TS_ASSERT_EQUALS(cell_population.rGetDampingConstants().size(), cell_population.GetNumNodes());
+        for (unsigned k=0; k<cell_population.GetNumNodes(); k++)
+        {
+            TS_ASSERT_DELTA(cell_population.rGetDampingConstants()[k], 1.1, 1e-12);
+        }
+
+        // The cached damping constants are kept until they are invalidated after a mutation state changes
+        boost::shared_ptr<AbstractCellProperty> p_mutant(CellPropertyRegistry::Instance()->Get<ApcTwoHitCellMutationState>());
+        CellPtr p_cell = cell_population.GetCellUsingLocationIndex(0);
+        p_cell->SetMutationState(p_mutant);
+        TS_ASSERT_DELTA(cell_population.rGetDampingConstants()[cell_population.GetForceAccumulationPosition(0)], 1.1, 1e-12);
+
+        cell_population.InvalidateDampingConstants();
+        TS_ASSERT_DELTA(cell_population.rGetDampingConstants()[cell_population.GetForceAccumulationPosition(0)], 2.3, 1e-12);
+
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+
+        p_fe_method->UpdateAllNodePositions(dt);
+        TS_ASSERT_DELTA(cell_population.rGetDampingConstants()[cell_population.GetForceAccumulationPosition(0)], 2.3, 1e-12);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationFE(j, damping, old_posns[j], dt);
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-12);
+        }
+
+        // Setting a damping constant also invalidates the cache
+        cell_population.SetDampingConstantMutant(3.4);
+        p_fe_method->UpdateAllNodePositions(dt);
+        TS_ASSERT_DELTA(cell_population.rGetDampingConstants()[cell_population.GetForceAccumulationPosition(0)], 3.4, 1e-12);
+
+        // A periodic mesh requires the general update, which must give the same result as the fused one
+        MAKE_PTR_ARGS(Cylindrical2dNodesOnlyMesh, p_periodic_mesh, (6.0));
+        p_periodic_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+        std::vector<CellPtr> periodic_cells;
+        cells_generator.GenerateBasic(periodic_cells, p_periodic_mesh->GetNumNodes());
+
+        NodeBasedCellPopulation<2> periodic_population(*p_periodic_mesh, periodic_cells);
+        periodic_population.SetDampingConstantNormal(1.1);
+
+        MAKE_PTR(ForwardEulerNumericalMethod<2>, p_periodic_method);
+        p_periodic_method->SetCellPopulation(&periodic_population);
+        p_periodic_method->SetForceCollection(&force_collection);
+        TS_ASSERT_EQUALS(periodic_population.CanMoveNodesInPlace(), false);
+        TS_ASSERT_EQUALS(p_periodic_method->CanUseFusedUpdate(), false);
+
+        for (unsigned j=0; j<periodic_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = periodic_population.GetNode(j)->rGetLocation();
+        }
+        p_periodic_method->UpdateAllNodePositions(dt);
+        for (unsigned j=0; j<periodic_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationFE(j, 1.1, old_posns[j], dt);
+            TS_ASSERT_DELTA(norm_2(periodic_population.GetNode(j)->rGetLocation() - expected_location), 0, 1e-12);
+        }
+
+        // Mesh-based populations may move their nodes in place unless the mesh is periodic
+        MutableMesh<2,2>* p_mutable_mesh = generator.GetMesh();
+        std::vector<CellPtr> mesh_based_cells;
+        cells_generator.GenerateBasic(mesh_based_cells, p_mutable_mesh->GetNumNodes());
+        MeshBasedCellPopulation<2> mesh_based_population(*p_mutable_mesh, mesh_based_cells);
+        TS_ASSERT_EQUALS(mesh_based_population.CanMoveNodesInPlace(), true);
+
+        CylindricalHoneycombMeshGenerator cylindrical_generator(4, 4, 0);
+        Cylindrical2dMesh* p_cylindrical_mesh = cylindrical_generator.GetCylindricalMesh();
+        std::vector<CellPtr> cylindrical_cells;
+        cells_generator.GenerateBasic(cylindrical_cells, p_cylindrical_mesh->GetNumNodes());
+        MeshBasedCellPopulation<2> cylindrical_population(*p_cylindrical_mesh, cylindrical_cells);
+        TS_ASSERT_EQUALS(cylindrical_population.CanMoveNodesInPlace(), false);
+    }
+
+    void TestRungeKuttaMethodsWithMeshBased()
+    {
+        // Create a simple mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        // Create a force collection
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // Create numerical methods for testing
+        MAKE_PTR(RK2NumericalMethod<2>, p_rk2_method);
+        p_rk2_method->SetCellPopulation(&cell_population);
+        p_rk2_method->SetForceCollection(&force_collection);
+
+        MAKE_PTR(RK4NumericalMethod<2>, p_rk4_method);
+        p_rk4_method->SetCellPopulation(&cell_population);
+        p_rk4_method->SetForceCollection(&force_collection);
+
+        double dt = 0.01;
+
+        // Test the midpoint method
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+
+        p_rk2_method->UpdateAllNodePositions(dt);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+            double damping =  cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expectedLocation;
+            for (unsigned d=0; d<2; d++)
+            {
+                double k1 = (d+1)*0.01*j*old_posns[j][d]/damping;
+                double k2 = (d+1)*0.01*j*(old_posns[j][d] + 0.5*dt*k1)/damping;
+                expectedLocation[d] = old_posns[j][d] + dt*k2;
+            }
+
+            TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-12);
+        }
+
+        // Test the classical fourth-order method
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+
+        p_rk4_method->UpdateAllNodePositions(dt);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+            double damping =  cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expectedLocation;
+            expectedLocation = p_test_force->GetExpectedOneStepLocationRK4(j, damping, old_posns[j], dt);
+
+            TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-12);
+        }
+    }
+
+    void TestBogackiShampineMethodWithNodeBased()
+    {
+        EXIT_IF_PARALLEL;    // This test doesn't work in parallel.
+
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        // Convert this to a NodesOnlyMesh
+        MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+        p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 2.0);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        // Create a force collection
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // Create numerical method for testing
+        MAKE_PTR(BogackiShampineNumericalMethod<2>, p_bs_method);
+        p_bs_method->SetCellPopulation(&cell_population);
+        p_bs_method->SetForceCollection(&force_collection);
+
+        // The method is adaptive by default
+        TS_ASSERT(p_bs_method->HasAdaptiveTimestep());
+        TS_ASSERT_DELTA(p_bs_method->GetTolerance(), 1e-3, 1e-12);
+        TS_ASSERT_THROWS_THIS(p_bs_method->SetTolerance(0.0), "The tolerance must be positive.");
+
+        double dt = 0.01;
+
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+
+        p_bs_method->UpdateAllNodePositions(dt);
+
+        // For a linear force, a third-order Runge-Kutta method reproduces the cubic Taylor polynomial
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+            double damping =  cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expectedLocation;
+            for (unsigned d=0; d<2; d++)
+            {
+                double h = dt*(d+1)*0.01*j/damping;
+                expectedLocation[d] = old_posns[j][d]*(1.0 + h + h*h/2.0 + h*h*h/6.0);
+            }
+
+            TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-12);
+        }
+
+        // The local error is tiny, so the next step is allowed to grow by the largest permitted factor
+        TS_ASSERT_DELTA(p_bs_method->GetNextTimeStep(dt), 5.0*dt, 1e-12);
+
+        // Between accepted steps the population may change the forces without moving any node,
+        // so the last stage of an accepted step is not kept
+        TS_ASSERT(p_bs_method->mLastStageForces.empty());
+
+        // Changing the forces at fixed node locations changes the next step just as for a fresh method
+        std::vector<c_vector<double, 2> > current_posns = p_bs_method->SaveCurrentLocations();
+        force_collection.push_back(p_test_force);
+
+        MAKE_PTR(BogackiShampineNumericalMethod<2>, p_other_bs_method);
+        p_other_bs_method->SetCellPopulation(&cell_population);
+        p_other_bs_method->SetForceCollection(&force_collection);
+        p_other_bs_method->UpdateAllNodePositions(dt);
+        std::vector<c_vector<double, 2> > fresh_posns = p_other_bs_method->SaveCurrentLocations();
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            cell_population.GetNode(j)->rGetModifiableLocation() = current_posns[j];
+        }
+        p_bs_method->UpdateAllNodePositions(dt);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            TS_ASSERT_DELTA(norm_2(cell_population.GetNode(j)->rGetLocation() - fresh_posns[j]), 0, 1e-12);
+        }
+
+        // With a very tight tolerance and a large step, the step is rejected and a smaller one suggested
+        current_posns = p_bs_method->SaveCurrentLocations();
+        p_bs_method->SetTolerance(1e-12);
+        double large_dt = 1.0;
+        try
+        {
+            p_bs_method->UpdateAllNodePositions(large_dt);
+            TS_FAIL("A StepSizeException should have been thrown");
+        }
+        catch (StepSizeException& e)
+        {
+            TS_ASSERT(!e.IsTerminal());
+            TS_ASSERT_LESS_THAN(e.GetSuggestedNewStep(), large_dt);
+            TS_ASSERT_LESS_THAN_EQUALS(0.2*large_dt, e.GetSuggestedNewStep());
+        }
+
+        // The first stage is kept for the retry from the same locations, but not from anywhere else
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            cell_population.GetNode(j)->rGetModifiableLocation() = current_posns[j];
+        }
+        TS_ASSERT_EQUALS(p_bs_method->mLastStageForces.size(), cell_population.GetNumNodes());
+        TS_ASSERT(p_bs_method->CanReuseLastStage(current_posns));
+        current_posns[0][0] += 1e-3;
+        TS_ASSERT(!p_bs_method->CanReuseLastStage(current_posns));
+
+        // Without adaptivity the step is accepted regardless of the error estimate
+        p_bs_method->SetUseAdaptiveTimestep(false);
+        TS_ASSERT_THROWS_NOTHING(p_bs_method->UpdateAllNodePositions(large_dt));
+    }
+
+    void TestBackwardEulerMethodWithMeshBasedAndNodeBased()
+    {
+        EXIT_IF_PARALLEL;    // BackwardEulerNumericalMethod is not yet implemented in parallel.
+
+        double dt = 0.01;
+
+        // Mesh-based population, where the sparsity pattern comes from the mesh edges
+        {
+            TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+            MutableMesh<2,2> mesh;
+            mesh.ConstructFromMeshReader(mesh_reader);
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+            MeshBasedCellPopulation<2> cell_population(mesh, cells);
+            cell_population.SetDampingConstantNormal(1.1);
+
+            std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+            MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+            force_collection.push_back(p_test_force);
+
+            MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+            p_be_method->SetCellPopulation(&cell_population);
+            p_be_method->SetForceCollection(&force_collection);
+
+            std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+            for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+            {
+                old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+            }
+
+            p_be_method->UpdateAllNodePositions(dt);
+
+            for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+            {
+                c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+                double damping =  cell_population.GetDampingConstant(j);
+                c_vector<double, 2> expectedLocation;
+                expectedLocation = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], dt);
+
+                TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-9);
+            }
+        }
+
+        // Node-based population, where the sparsity pattern comes from the node pairs
+        {
+            HoneycombMeshGenerator generator(3, 3, 0);
+            TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+            MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+            p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+            NodeBasedCellPopulation<2> cell_population(*p_mesh, cells);
+            cell_population.SetDampingConstantNormal(1.1);
+            cell_population.Update();
+
+            std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+            MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+            force_collection.push_back(p_test_force);
+
+            MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+            p_be_method->SetCellPopulation(&cell_population);
+            p_be_method->SetForceCollection(&force_collection);
+
+            std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+            for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+            {
+                old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+            }
+
+            p_be_method->UpdateAllNodePositions(dt);
+
+            for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+            {
+                c_vector<double, 2> actualLocation = cell_population.GetNode(j)->rGetLocation();
+
+                double damping =  cell_population.GetDampingConstant(j);
+                c_vector<double, 2> expectedLocation;
+                expectedLocation = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], dt);
+
+                TS_ASSERT_DELTA(norm_2(actualLocation - expectedLocation), 0, 1e-9);
+            }
+
+            // Each node has at most six neighbours, so a distance-2 colouring needs at least seven colours
+            TS_ASSERT_LESS_THAN_EQUALS(7u, p_be_method->mColourOffsets.size() - 1);
+            TS_ASSERT_EQUALS(p_be_method->mColouredPositions.size(), cell_population.GetNumNodes());
+        }
+    }
+
+    void TestBackwardEulerMethodWithSpringForces()
+    {
+        EXIT_IF_PARALLEL;    // BackwardEulerNumericalMethod is not yet implemented in parallel.
+
+        // For a stiff spring force, one implicit step should stay close to many small explicit steps
+        HoneycombMeshGenerator generator(4, 4, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+        p_mesh->Scale(0.8, 0.8);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(GeneralisedLinearSpringForce<2>, p_force);
+        force_collection.push_back(p_force);
+
+        std::vector<c_vector<double, 2> > initial_locations(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            initial_locations[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+
+        // Reference solution from many small fourth-order steps
+        MAKE_PTR(RK4NumericalMethod<2>, p_rk4_method);
+        p_rk4_method->SetCellPopulation(&cell_population);
+        p_rk4_method->SetForceCollection(&force_collection);
+        double dt = 0.0005;
+        for (unsigned i=0; i<100; i++)
+        {
+            p_rk4_method->UpdateAllNodePositions(dt/100.0);
+        }
+        std::vector<c_vector<double, 2> > reference_locations(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            reference_locations[j] = cell_population.GetNode(j)->rGetLocation();
+            cell_population.GetNode(j)->rGetModifiableLocation() = initial_locations[j];
+        }
+
+        MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+        p_be_method->SetCellPopulation(&cell_population);
+        p_be_method->SetForceCollection(&force_collection);
+        p_be_method->UpdateAllNodePositions(dt);
+
+        double max_reference_displacement = 0.0;
+        double max_error = 0.0;
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            max_reference_displacement = std::max(max_reference_displacement, norm_2(reference_locations[j] - initial_locations[j]));
+            max_error = std::max(max_error, norm_2(cell_population.GetNode(j)->rGetLocation() - reference_locations[j]));
+        }
+        TS_ASSERT_LESS_THAN(0.0, max_reference_displacement);
+        TS_ASSERT_LESS_THAN(max_error, 0.1*max_reference_displacement);
+    }
+
+    void TestArchivingNumericalMethods()
+    {
+        OutputFileHandler handler("archive", false);
+        std::string archive_filename = handler.GetOutputDirectoryFullPath() + "BogackiShampineNumericalMethod.arch";
+
+        {
+            BogackiShampineNumericalMethod<2>* const p_method = new BogackiShampineNumericalMethod<2>();
+            p_method->SetTolerance(1e-5);
+            p_method->SetUseAdaptiveTimestep(false);
+
+            std::ofstream ofs(archive_filename.c_str());
+            boost::archive::text_oarchive output_arch(ofs);
+            AbstractNumericalMethod<2>* const p_abstract_method = p_method;
+            output_arch << p_abstract_method;
+
+            delete p_method;
+        }
+
+        {
+            AbstractNumericalMethod<2>* p_method;
+
+            std::ifstream ifs(archive_filename.c_str(), std::ios::binary);
+            boost::archive::text_iarchive input_arch(ifs);
+            input_arch >> p_method;
+
+            BogackiShampineNumericalMethod<2>* p_bs_method = dynamic_cast<BogackiShampineNumericalMethod<2>*>(p_method);
+            TS_ASSERT(p_bs_method != nullptr);
+            TS_ASSERT_DELTA(p_bs_method->GetTolerance(), 1e-5, 1e-12);
+            TS_ASSERT(!p_bs_method->HasAdaptiveTimestep());
+
+            delete p_method;
+        }
+    }
+
     void TestSettingAndGettingFlags()
     {
         // Create numerical methods for testing
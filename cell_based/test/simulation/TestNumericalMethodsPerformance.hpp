@@ -0,0 +1,415 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTNUMERICALMETHODSPERFORMANCE_HPP_
+#define TESTNUMERICALMETHODSPERFORMANCE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include "AbstractCellBasedWithTimingsTestSuite.hpp"
+#include "BackwardEulerNumericalMethod.hpp"
+#include "BogackiShampineNumericalMethod.hpp"
+#include "CellsGenerator.hpp"
+#include "CylindricalHoneycombMeshGenerator.hpp"
+#include "ForwardEulerNumericalMethod.hpp"
+#include "GeneralisedLinearSpringForce.hpp"
+#include "MeshBasedCellPopulationWithGhostNodes.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "PlaneBasedCellKiller.hpp"
+#include "PlaneBoundaryCondition.hpp"
+#include "RK2NumericalMethod.hpp"
+#include "RK4NumericalMethod.hpp"
+#include "SmartPointers.hpp"
+#include "Timer.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * A numerical method that counts how many times it is asked to update the node
+ * positions, including any attempts rejected by the adaptive time stepping.
+ */
+template<class NUMERICAL_METHOD>
+class StepCountingNumericalMethod : public NUMERICAL_METHOD
+{
+public:
+
+    /** The number of calls to UpdateAllNodePositions(). */
+    unsigned mNumSteps;
+
+    /** Constructor. */
+    StepCountingNumericalMethod()
+        : NUMERICAL_METHOD(),
+          mNumSteps(0)
+    {
+    }
+
+    /**
+     * Count the step, then update the node positions as usual.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt)
+    {
+        mNumSteps++;
+        NUMERICAL_METHOD::UpdateAllNodePositions(dt);
+    }
+};
+
+/**
+ * A forward Euler method that updates the node positions as was done before the force and
+ * position updates were fused: the forces divided by the damping constants are gathered into
+ * a newly allocated vector, then the nodes are moved one at a time through the population.
+ */
+template<unsigned DIM>
+class UnfusedForwardEulerNumericalMethod : public ForwardEulerNumericalMethod<DIM>
+{
+public:
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt)
+    {
+        this->mpCellPopulation->BeginForceAccumulation();
+        for (typename std::vector<boost::shared_ptr<AbstractForce<DIM, DIM> > >::iterator iter = this->mpForceCollection->begin();
+            iter != this->mpForceCollection->end(); ++iter)
+        {
+            (*iter)->AddForceContribution(*(this->mpCellPopulation));
+        }
+        this->mpCellPopulation->EndForceAccumulation();
+
+        std::vector<c_vector<double, DIM> > forces;
+        forces.reserve(this->mpCellPopulation->GetNumNodes());
+        for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd(); ++node_iter)
+        {
+            double damping = this->mpCellPopulation->GetDampingConstant(node_iter->GetIndex());
+            forces.push_back(node_iter->rGetAppliedForce()/damping);
+        }
+
+        unsigned index = 0;
+        for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter, ++index)
+        {
+            c_vector<double, DIM> displacement = dt * forces[index];
+            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
+
+            c_vector<double, DIM> new_location = node_iter->rGetLocation() + displacement;
+            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+        }
+    }
+};
+
+/**
+ * Profiles the off-lattice numerical methods on a crypt-like mesh-based simulation and a
+ * node-based spheroid, reporting the number of position updates per simulated hour and
+ * the run time of each, and times the per-step overhead of forward Euler on large node-based
+ * populations. The explicit methods use the default time step; the adaptive
+ * methods and backward Euler start from a larger one.
+ */
+class TestNumericalMethodsPerformance : public AbstractCellBasedWithTimingsTestSuite
+{
+private:
+
+    /**
+     * Run a crypt-like simulation: a cylindrical monolayer of proliferating cells with
+     * ghost nodes, a fixed base and sloughing at the top.
+     *
+     * @param pMethod the numerical method to use
+     * @param dt the time step
+     * @param rName a name for the method, used for output
+     */
+    template<class NUMERICAL_METHOD>
+    void RunCryptSimulation(boost::shared_ptr<StepCountingNumericalMethod<NUMERICAL_METHOD> > pMethod,
+                            double dt,
+                            const std::string& rName)
+    {
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+        RandomNumberGenerator::Instance()->Reseed(0);
+
+        double crypt_height = 12.0;
+        CylindricalHoneycombMeshGenerator generator(10, 14, 2);
+        Cylindrical2dMesh* p_mesh = generator.GetCylindricalMesh();
+        std::vector<unsigned> location_indices = generator.GetCellLocationIndices();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, location_indices.size(), p_transit_type);
+
+        MeshBasedCellPopulationWithGhostNodes<2> cell_population(*p_mesh, cells, location_indices);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("NumericalMethodsPerformance/Crypt" + rName);
+        simulator.SetSamplingTimestepMultiple(1000);
+        simulator.SetDt(dt);
+        simulator.SetEndTime(5.0);
+        simulator.SetNumericalMethod(pMethod);
+
+        MAKE_PTR(GeneralisedLinearSpringForce<2>, p_force);
+        simulator.AddForce(p_force);
+
+        MAKE_PTR_ARGS(PlaneBoundaryCondition<2>, p_base, (&cell_population, zero_vector<double>(2), -unit_vector<double>(2,1)));
+        simulator.AddCellPopulationBoundaryCondition(p_base);
+
+        MAKE_PTR_ARGS(PlaneBasedCellKiller<2>, p_sloughing, (&cell_population, crypt_height*unit_vector<double>(2,1), unit_vector<double>(2,1)));
+        simulator.AddCellKiller(p_sloughing);
+
+        Timer::Reset();
+        simulator.Solve();
+        ReportSteps("Crypt", rName, pMethod->mNumSteps, 5.0);
+
+        TS_ASSERT_LESS_THAN(0u, simulator.rGetCellPopulation().GetNumRealCells());
+    }
+
+    /**
+     * Run a spheroid simulation: a ball of proliferating node-based cells in 3D.
+     *
+     * @param pMethod the numerical method to use
+     * @param dt the time step
+     * @param rName a name for the method, used for output
+     */
+    template<class NUMERICAL_METHOD>
+    void RunSpheroidSimulation(boost::shared_ptr<StepCountingNumericalMethod<NUMERICAL_METHOD> > pMethod,
+                               double dt,
+                               const std::string& rName)
+    {
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+        RandomNumberGenerator::Instance()->Reseed(0);
+
+        // Cells on a lattice within a ball of radius 4
+        std::vector<Node<3>*> nodes;
+        for (int i=-4; i<=4; i++)
+        {
+            for (int j=-4; j<=4; j++)
+            {
+                for (int k=-4; k<=4; k++)
+                {
+                    if (i*i + j*j + k*k <= 16)
+                    {
+                        nodes.push_back(new Node<3>(nodes.size(), false, (double) i, (double) j, (double) k));
+                    }
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        CellsGenerator<UniformCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_transit_type);
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+
+        OffLatticeSimulation<3> simulator(cell_population);
+        simulator.SetOutputDirectory("NumericalMethodsPerformance/Spheroid" + rName);
+        simulator.SetSamplingTimestepMultiple(1000);
+        simulator.SetDt(dt);
+        simulator.SetEndTime(5.0);
+        simulator.SetNumericalMethod(pMethod);
+
+        MAKE_PTR(GeneralisedLinearSpringForce<3>, p_force);
+        p_force->SetCutOffLength(1.5);
+        simulator.AddForce(p_force);
+
+        Timer::Reset();
+        simulator.Solve();
+        ReportSteps("Spheroid", rName, pMethod->mNumSteps, 5.0);
+
+        TS_ASSERT_LESS_THAN(0u, simulator.rGetCellPopulation().GetNumRealCells());
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+    /**
+     * Time the per-step overhead of a forward Euler method, excluding the cost of any forces,
+     * on a node-based population of cells on a cubic lattice.
+     *
+     * @param pMethod the numerical method to use
+     * @param numNodesPerSide the number of nodes along each side of the lattice
+     * @param rName a name for the method, used for output
+     */
+    void TimeForwardEulerOverhead(boost::shared_ptr<ForwardEulerNumericalMethod<3> > pMethod,
+                                  unsigned numNodesPerSide,
+                                  const std::string& rName)
+    {
+        std::vector<Node<3>*> nodes;
+        nodes.reserve(numNodesPerSide*numNodesPerSide*numNodesPerSide);
+        for (unsigned i=0; i<numNodesPerSide; i++)
+        {
+            for (unsigned j=0; j<numNodesPerSide; j++)
+            {
+                for (unsigned k=0; k<numNodesPerSide; k++)
+                {
+                    nodes.push_back(new Node<3>(nodes.size(), false, (double) i, (double) j, (double) k));
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<UniformCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+
+        std::vector<boost::shared_ptr<AbstractForce<3,3> > > force_collection;
+        pMethod->SetCellPopulation(&cell_population);
+        pMethod->SetForceCollection(&force_collection);
+
+        // The first step allocates the persistent buffers, so is not timed
+        pMethod->UpdateAllNodePositions(0.01);
+
+        unsigned num_steps = 20;
+        Timer::Reset();
+        for (unsigned i=0; i<num_steps; i++)
+        {
+            pMethod->UpdateAllNodePositions(0.01);
+        }
+        double time_per_step = Timer::GetElapsedTime()/num_steps;
+
+        std::cout << mesh.GetNumNodes() << " nodes, " << rName << ": " << 1e3*time_per_step << " ms per step\n";
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+    /**
+     * Print the number of position updates per simulated hour and the elapsed time.
+     *
+     * @param rScenario the name of the scenario
+     * @param rName the name of the numerical method
+     * @param numSteps the number of position updates
+     * @param duration the simulated time in hours
+     */
+    void ReportSteps(const std::string& rScenario, const std::string& rName, unsigned numSteps, double duration)
+    {
+        std::cout << rScenario << ", " << rName << ": " << numSteps/duration << " steps per simulated hour, "
+                  << Timer::GetElapsedTime() << " s\n";
+    }
+
+public:
+
+    void TestCryptScenario()
+    {
+        EXIT_IF_PARALLEL;    // Backward Euler is not yet implemented in parallel
+
+        double dt = 1.0/120.0;
+
+        MAKE_PTR(StepCountingNumericalMethod<ForwardEulerNumericalMethod<2> >, p_fe_method);
+        RunCryptSimulation(p_fe_method, dt, "ForwardEuler");
+
+        MAKE_PTR(StepCountingNumericalMethod<ForwardEulerNumericalMethod<2> >, p_adaptive_fe_method);
+        p_adaptive_fe_method->SetUseAdaptiveTimestep(true);
+        RunCryptSimulation(p_adaptive_fe_method, 5*dt, "AdaptiveForwardEuler");
+
+        MAKE_PTR(StepCountingNumericalMethod<RK2NumericalMethod<2> >, p_rk2_method);
+        RunCryptSimulation(p_rk2_method, dt, "RK2");
+
+        MAKE_PTR(StepCountingNumericalMethod<RK4NumericalMethod<2> >, p_rk4_method);
+        RunCryptSimulation(p_rk4_method, dt, "RK4");
+
+        MAKE_PTR(StepCountingNumericalMethod<BogackiShampineNumericalMethod<2> >, p_bs_method);
+        RunCryptSimulation(p_bs_method, 5*dt, "BogackiShampine");
+
+        MAKE_PTR(StepCountingNumericalMethod<BackwardEulerNumericalMethod<2> >, p_be_method);
+        RunCryptSimulation(p_be_method, 5*dt, "BackwardEuler");
+    }
+
+    void TestSpheroidScenario()
+    {
+        EXIT_IF_PARALLEL;    // Backward Euler is not yet implemented in parallel
+
+        double dt = 1.0/120.0;
+
+        MAKE_PTR(StepCountingNumericalMethod<ForwardEulerNumericalMethod<3> >, p_fe_method);
+        RunSpheroidSimulation(p_fe_method, dt, "ForwardEuler");
+
+        MAKE_PTR(StepCountingNumericalMethod<ForwardEulerNumericalMethod<3> >, p_adaptive_fe_method);
+        p_adaptive_fe_method->SetUseAdaptiveTimestep(true);
+        RunSpheroidSimulation(p_adaptive_fe_method, 5*dt, "AdaptiveForwardEuler");
+
+        MAKE_PTR(StepCountingNumericalMethod<RK2NumericalMethod<3> >, p_rk2_method);
+        RunSpheroidSimulation(p_rk2_method, dt, "RK2");
+
+        MAKE_PTR(StepCountingNumericalMethod<RK4NumericalMethod<3> >, p_rk4_method);
+        RunSpheroidSimulation(p_rk4_method, dt, "RK4");
+
+        MAKE_PTR(StepCountingNumericalMethod<BogackiShampineNumericalMethod<3> >, p_bs_method);
+        RunSpheroidSimulation(p_bs_method, 5*dt, "BogackiShampine");
+
+        MAKE_PTR(StepCountingNumericalMethod<BackwardEulerNumericalMethod<3> >, p_be_method);
+        RunSpheroidSimulation(p_be_method, 5*dt, "BackwardEuler");
+    }
+
+    void TestForwardEulerOverhead()
+    {
+        EXIT_IF_PARALLEL;
+
+        // About 10^5 and 10^6 nodes
+        unsigned num_nodes_per_side[2] = {47, 100};
+        for (unsigned i=0; i<2; i++)
+        {
+            MAKE_PTR(UnfusedForwardEulerNumericalMethod<3>, p_unfused_method);
+            TimeForwardEulerOverhead(p_unfused_method, num_nodes_per_side[i], "Unfused");
+
+            MAKE_PTR(ForwardEulerNumericalMethod<3>, p_fused_method);
+            TimeForwardEulerOverhead(p_fused_method, num_nodes_per_side[i], "Fused");
+        }
+    }
+};
+
+#endif /*TESTNUMERICALMETHODSPERFORMANCE_HPP_*/
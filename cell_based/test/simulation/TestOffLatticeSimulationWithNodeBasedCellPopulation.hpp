@@ -50,6 +50,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PlaneBasedCellKiller.hpp"
 #include "HoneycombMeshGenerator.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
+#include "TysonNovakCellCycleModel.hpp"
 #include "AbstractCellBasedWithTimingsTestSuite.hpp"
 #include "LogFile.hpp"
 #include "WildTypeCellMutationState.hpp"
@@ -541,6 +542,77 @@ public:
         FileComparison node_files(generated_node_file,reference_node_file);
     }
 
+    /**
+     * Run the same proliferating monolayer with and without the parallel cell-cycle
+     * update phase and check that the two simulations give identical results.
+     */
+    void TestParallelCellCycleUpdate()
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenereator does not work in parallel.
+
+        HoneycombMeshGenerator generator(5, 5, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        std::vector<unsigned> num_births(2);
+        std::vector<unsigned> num_cells_updated_in_parallel(2);
+        std::vector<std::vector<c_vector<double, 2> > > cell_locations(2);
+
+        for (unsigned run=0; run<2; run++)
+        {
+            // Reset the singletons so that both runs start from the same state
+            SimulationTime::Instance()->Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            NodesOnlyMesh<2> mesh;
+            mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<TysonNovakCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes());
+
+            NodeBasedCellPopulation<2> node_based_cell_population(mesh, cells);
+
+            OffLatticeSimulation<2> simulator(node_based_cell_population);
+            simulator.SetOutputDirectory("TestOffLatticeSimulationWithParallelCellCycleUpdate");
+            simulator.SetEndTime(2.0);
+
+            // Test the set and get methods
+            TS_ASSERT_EQUALS(simulator.GetUseParallelCellCycleUpdate(), false);
+            simulator.SetUseParallelCellCycleUpdate(run == 1);
+            TS_ASSERT_EQUALS(simulator.GetUseParallelCellCycleUpdate(), run == 1);
+
+            MAKE_PTR(GeneralisedLinearSpringForce<2>, p_linear_force);
+            p_linear_force->SetCutOffLength(1.5);
+            simulator.AddForce(p_linear_force);
+
+            simulator.Solve();
+
+            num_births[run] = simulator.GetNumBirths();
+            num_cells_updated_in_parallel[run] = simulator.GetNumCellsUpdatedInParallel();
+            for (AbstractCellPopulation<2>::Iterator cell_iter = simulator.rGetCellPopulation().Begin();
+                 cell_iter != simulator.rGetCellPopulation().End();
+                 ++cell_iter)
+            {
+                cell_locations[run].push_back(simulator.rGetCellPopulation().GetLocationOfCellCentre(*cell_iter));
+            }
+        }
+
+        // Check that the second run really used the parallel update, with or without CVODE
+        TS_ASSERT_EQUALS(num_cells_updated_in_parallel[0], 0u);
+        TS_ASSERT_LESS_THAN(0u, num_cells_updated_in_parallel[1]);
+
+        // Check that some cells divided and that the order of divisions was unaffected
+        TS_ASSERT_LESS_THAN(0u, num_births[0]);
+        TS_ASSERT_EQUALS(num_births[1], num_births[0]);
+        TS_ASSERT_EQUALS(cell_locations[1].size(), cell_locations[0].size());
+        for (unsigned i=0; i<cell_locations[0].size(); i++)
+        {
+            TS_ASSERT_DELTA(cell_locations[1][i][0], cell_locations[0][i][0], 1e-12);
+            TS_ASSERT_DELTA(cell_locations[1][i][1], cell_locations[0][i][1], 1e-12);
+        }
+    }
+
     double mNode3x, mNode4x, mNode3y, mNode4y; // To preserve locations between the below test and test load.
 
     void TestStandardResultForArchivingTestsBelow()
@@ -171,6 +171,11 @@ double SingleOdeWntCellCycleModel::GetBetaCateninDivisionThreshold()
     return mBetaCateninDivisionThreshold;
 }
 
+bool SingleOdeWntCellCycleModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void SingleOdeWntCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
@@ -164,6 +164,14 @@ public:
      */
     double GetBetaCateninDivisionThreshold();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since UpdateCellCyclePhase() only reads the Wnt level of this cell and solves its
+     * beta-catenin ODE.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Overridden OutputCellCycleModelParameters() method.
      *
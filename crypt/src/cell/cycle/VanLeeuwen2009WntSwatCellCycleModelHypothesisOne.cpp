@@ -86,6 +86,11 @@ AbstractCellCycleModel* VanLeeuwen2009WntSwatCellCycleModelHypothesisOne::Create
     return new VanLeeuwen2009WntSwatCellCycleModelHypothesisOne(*this);
 }
 
+bool VanLeeuwen2009WntSwatCellCycleModelHypothesisOne::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void VanLeeuwen2009WntSwatCellCycleModelHypothesisOne::OutputCellCycleModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
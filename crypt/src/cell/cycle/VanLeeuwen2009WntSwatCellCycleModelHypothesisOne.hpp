@@ -101,6 +101,14 @@ public:
      */
     AbstractCellCycleModel* CreateCellCycleModel();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since updating the cell-cycle phase only reads the Wnt level and mutation state
+     * of this cell and solves its ODEs.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Overridden OutputCellCycleModelParameters() method.
      *
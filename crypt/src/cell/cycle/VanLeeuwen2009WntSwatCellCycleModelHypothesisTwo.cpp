@@ -90,6 +90,11 @@ AbstractCellCycleModel* VanLeeuwen2009WntSwatCellCycleModelHypothesisTwo::Create
     return new VanLeeuwen2009WntSwatCellCycleModelHypothesisTwo(*this);
 }
 
+bool VanLeeuwen2009WntSwatCellCycleModelHypothesisTwo::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void VanLeeuwen2009WntSwatCellCycleModelHypothesisTwo::OutputCellCycleModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
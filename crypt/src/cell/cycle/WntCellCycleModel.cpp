@@ -144,6 +144,11 @@ void WntCellCycleModel::AdjustOdeParameters(double currentTime)
     static_cast<WntCellCycleOdeSystem*>(mpOdeSystem)->SetMutationState(mpCell->GetMutationState());
 }
 
+bool WntCellCycleModel::CanUpdateConcurrently()
+{
+    return true;
+}
+
 void WntCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
 {
     // No new parameters to output, so just call method on direct parent class
@@ -136,6 +136,15 @@ public:
      */
     void Initialise();
 
+    /**
+     * Overridden CanUpdateConcurrently() method.
+     *
+     * @return true, since updating the cell-cycle phase only reads the Wnt level of this cell from the
+     * WntConcentration singleton and changes the proliferative type of this cell. Subclasses
+     * inherit this, so must override it if they draw random numbers after initialisation.
+     */
+    bool CanUpdateConcurrently();
+
     /**
      * Overridden OutputCellCycleModelParameters() method.
      *
@@ -40,7 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * @file
  * This file provides access to some 'system calls' in a cross-platform manner.
  * It provides the normal Linux names, even on Windows.
- * Functions provided: chdir, getpid, chmod, setenv.
+ * Functions provided: chdir, getpid, chmod, setenv, mkstemp.
  */
 
 #ifdef _MSC_VER
@@ -67,8 +67,17 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #define setenv(name, value, mode) _putenv_s(name, value)
 
+#include <fcntl.h>
+/**
+ * Windows version of mkstemp call: replace the trailing XXXXXX of the template with a
+ * unique string, and create and open that file exclusively.
+ * @param template  the file name template; modified in place
+ */
+#define mkstemp(template) _open(_mktemp(template), _O_CREAT | _O_EXCL | _O_RDWR | _O_BINARY, _S_IREAD | _S_IWRITE)
+
 #else
 
+#include <stdlib.h> // For mkstemp()
 #include <unistd.h> // For chdir() and getpid()
 #include <sys/stat.h> // For chmod()
 /** Mode for chmod() to set readonly permissions for everyone. */
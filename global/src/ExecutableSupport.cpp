@@ -114,7 +114,8 @@ void ExecutableSupport::InitializePetsc(int* pArgc, char*** pArgv)
     // Store the arguments in case other code needs them
     CommandLineArguments::Instance()->p_argc = pArgc;
     CommandLineArguments::Instance()->p_argv = pArgv;
-    // Initialise PETSc
+    // Initialise MPI with thread support if asked for, then PETSc
+    PetscSetupUtils::InitialiseMpi(pArgc, pArgv);
     PETSCEXCEPT(PetscInitialize(pArgc, pArgv, PETSC_NULL, PETSC_NULL));
     // Set default output folder
     if (!mOutputDirectory.IsPathSet())
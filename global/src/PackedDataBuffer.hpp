@@ -0,0 +1,202 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef PACKEDDATABUFFER_HPP_
+#define PACKEDDATABUFFER_HPP_
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * A contiguous buffer of plain data for MPI communication.
+ *
+ * Values are packed one after another as raw bytes, with no type information,
+ * and must be unpacked in the same order and with the same types as they were
+ * packed: the sender and receiver share the layout of each message.  This is
+ * much more compact than serializing objects with ObjectCommunicator, and should
+ * be used for data that is exchanged frequently.  Only types that can be copied
+ * with memcpy (numbers and fixed size arrays of them) may be packed.
+ */
+class PackedDataBuffer
+{
+private:
+
+    /** The packed data. */
+    std::vector<char> mData;
+
+    /** The position of the next value to unpack. */
+    unsigned mPosition;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    PackedDataBuffer()
+        : mPosition(0)
+    {
+    }
+
+    /**
+     * Empty the buffer, keeping its storage, so it can be packed again.
+     */
+    void Clear()
+    {
+        mData.clear();
+        mPosition = 0;
+    }
+
+    /**
+     * Pack a value at the end of the buffer.
+     *
+     * @param rValue the value
+     */
+    template<typename T>
+    void Pack(const T& rValue)
+    {
+        PackArray(&rValue, 1);
+    }
+
+    /**
+     * Pack an array of values at the end of the buffer.
+     *
+     * @param pValues the values
+     * @param numValues the number of values
+     */
+    template<typename T>
+    void PackArray(const T* pValues, unsigned numValues)
+    {
+        unsigned size = mData.size();
+        mData.resize(size + numValues*sizeof(T));
+        if (numValues > 0)
+        {
+            memcpy(&mData[size], pValues, numValues*sizeof(T));
+        }
+    }
+
+    /**
+     * Pack a string of bytes (such as a serialized object) with its length.
+     *
+     * @param rBytes the bytes
+     */
+    void PackBytes(const std::string& rBytes)
+    {
+        Pack<unsigned>(rBytes.size());
+        PackArray(rBytes.data(), rBytes.size());
+    }
+
+    /**
+     * @return the next value in the buffer.
+     */
+    template<typename T>
+    T Unpack()
+    {
+        T value;
+        UnpackArray(&value, 1);
+        return value;
+    }
+
+    /**
+     * Copy the next values in the buffer into an array.
+     *
+     * @param pValues the array to fill
+     * @param numValues the number of values
+     */
+    template<typename T>
+    void UnpackArray(T* pValues, unsigned numValues)
+    {
+        assert(mPosition + numValues*sizeof(T) <= mData.size());
+        if (numValues > 0)
+        {
+            memcpy(pValues, &mData[mPosition], numValues*sizeof(T));
+        }
+        mPosition += numValues*sizeof(T);
+    }
+
+    /**
+     * @return the next string of bytes in the buffer, packed with PackBytes().
+     */
+    std::string UnpackBytes()
+    {
+        unsigned length = Unpack<unsigned>();
+        assert(mPosition + length <= mData.size());
+        std::string bytes(mData.begin() + mPosition, mData.begin() + mPosition + length);
+        mPosition += length;
+        return bytes;
+    }
+
+    /**
+     * @return whether all of the values in the buffer have been unpacked.
+     */
+    bool IsFullyUnpacked() const
+    {
+        return mPosition == mData.size();
+    }
+
+    /**
+     * @return the number of bytes in the buffer.
+     */
+    unsigned GetSize() const
+    {
+        return mData.size();
+    }
+
+    /**
+     * Resize the buffer, for example before receiving a message into it, and
+     * start unpacking from the beginning.
+     *
+     * @param size the new number of bytes
+     */
+    void Resize(unsigned size)
+    {
+        mData.resize(size);
+        mPosition = 0;
+    }
+
+    /**
+     * @return a pointer to the start of the buffer, for sending or receiving.
+     * The buffer must not be empty.
+     */
+    char* GetData()
+    {
+        assert(!mData.empty());
+        return &mData[0];
+    }
+};
+
+#endif // PACKEDDATABUFFER_HPP_
@@ -50,6 +50,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/split_member.hpp>
 #include "ChasteSerialization.hpp"
 #include "SerializableSingleton.hpp"
+#include "ChasteSerializationVersion.hpp"
+#include "RandomNumberStream.hpp"
 
 /**
  * A special singleton class allowing one to generate different types of
@@ -95,6 +97,9 @@ private:
 #else
     boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > mGenerateStandardNormal;
 #endif
+    /** The seed last passed to Reseed(), used to key the streams returned by GetStream(). */
+    unsigned mSeed;
+
     /** Pointer to the single instance. */
     static RandomNumberGenerator* mpInstance;
 
@@ -125,6 +130,8 @@ private:
         normal_internals << r_normal_dist;
         std::string normal_internals_string = normal_internals.str();
         archive& normal_internals_string;
+
+        archive& mSeed;
     }
 
     /**
@@ -148,6 +155,11 @@ private:
         archive& normal_internals_string;
         std::stringstream normal_internals(normal_internals_string);
         normal_internals >> mGenerateStandardNormal.distribution();
+
+        if (version > 0)
+        {
+            archive& mSeed;
+        }
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 
@@ -259,6 +271,20 @@ public:
      * @param seed the new seed
      */
     void Reseed(unsigned seed);
+
+    /**
+     * Create a counter-based random number stream, keyed by the current seed and the
+     * given ids. Drawing from the stream does not affect this generator, and the same
+     * ids give the same stream until the generator is reseeded, so streams may be used
+     * concurrently (for example one per cell and time step) with reproducible results.
+     *
+     * @param streamId the stream id, e.g. a cell id
+     * @param substreamId the substream id, e.g. a time step (defaults to 0)
+     * @return the stream
+     */
+    RandomNumberStream GetStream(unsigned streamId, uint64_t substreamId=0u) const;
 };
 
+BOOST_CLASS_VERSION(RandomNumberGenerator, 1u)
+
 #endif /*RANDOMNUMBERGENERATORS_HPP_*/
@@ -0,0 +1,212 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "RandomNumberStream.hpp"
+
+#include <cassert>
+#include <cmath>
+
+
+/** Multipliers and key increments of the Philox4x32 generator. */
+static const uint32_t PHILOX_M0 = 0xD2511F53u;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+static const uint32_t PHILOX_W0 = 0x9E3779B9u;
+static const uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+RandomNumberStream::RandomNumberStream(unsigned seed, unsigned streamId, uint64_t substreamId)
+    : mSubstreamId(substreamId),
+      mPosition(0u),
+      mBlockCounter(UINT64_MAX),
+      mHasSpareNormal(false),
+      mSpareNormal(0.0)
+{
+    mKey[0] = seed;
+    mKey[1] = streamId;
+}
+
+void RandomNumberStream::GenerateBlock(uint64_t blockCounter, uint32_t (&rOutput)[4]) const
+{
+    uint32_t c0 = (uint32_t) blockCounter;
+    uint32_t c1 = (uint32_t) (blockCounter >> 32);
+    uint32_t c2 = (uint32_t) mSubstreamId;
+    uint32_t c3 = (uint32_t) (mSubstreamId >> 32);
+    uint32_t k0 = mKey[0];
+    uint32_t k1 = mKey[1];
+
+    for (unsigned round=0; round<10; round++)
+    {
+        uint64_t product_0 = (uint64_t) PHILOX_M0 * c0;
+        uint64_t product_1 = (uint64_t) PHILOX_M1 * c2;
+
+        c0 = ((uint32_t) (product_1 >> 32)) ^ c1 ^ k0;
+        c1 = (uint32_t) product_1;
+        c2 = ((uint32_t) (product_0 >> 32)) ^ c3 ^ k1;
+        c3 = (uint32_t) product_0;
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    rOutput[0] = c0;
+    rOutput[1] = c1;
+    rOutput[2] = c2;
+    rOutput[3] = c3;
+}
+
+uint32_t RandomNumberStream::NextWord()
+{
+    uint64_t block_counter = mPosition >> 2;
+    if (block_counter != mBlockCounter)
+    {
+        GenerateBlock(block_counter, mBlock);
+        mBlockCounter = block_counter;
+    }
+    return mBlock[mPosition++ & 3u];
+}
+
+double RandomNumberStream::WordsToUnitReal(uint32_t highWord, uint32_t lowWord)
+{
+    // 27 bits from the first word and 26 from the second, offset by half a unit so that 0 is never returned
+    return ((highWord >> 5)*67108864.0 + (lowWord >> 6) + 0.5)*(1.0/9007199254740992.0);
+}
+
+void RandomNumberStream::Seek(uint64_t position)
+{
+    mPosition = position;
+    mHasSpareNormal = false;
+}
+
+uint64_t RandomNumberStream::GetPosition() const
+{
+    return mPosition;
+}
+
+double RandomNumberStream::ranf()
+{
+    uint32_t high_word = NextWord();
+    uint32_t low_word = NextWord();
+    return WordsToUnitReal(high_word, low_word);
+}
+
+unsigned RandomNumberStream::randMod(unsigned base)
+{
+    assert(base > 0u);
+    return NextWord() % base;
+}
+
+double RandomNumberStream::StandardNormalRandomDeviate()
+{
+    if (mHasSpareNormal)
+    {
+        mHasSpareNormal = false;
+        return mSpareNormal;
+    }
+
+    double radius = sqrt(-2.0*log(ranf()));
+    double angle = 2.0*M_PI*ranf();
+    mSpareNormal = radius*sin(angle);
+    mHasSpareNormal = true;
+    return radius*cos(angle);
+}
+
+double RandomNumberStream::NormalRandomDeviate(double mean, double stdDev)
+{
+    return stdDev * StandardNormalRandomDeviate() + mean;
+}
+
+double RandomNumberStream::ExponentialRandomDeviate(double scale)
+{
+    assert(scale > 0.0);
+    return -log(ranf())/scale;
+}
+
+void RandomNumberStream::FillWithUniformRandomNumbers(std::vector<double>& rValues)
+{
+    const unsigned num_values = rValues.size();
+    unsigned i = 0;
+
+    // Use up any part block one number at a time
+    while (i < num_values && (mPosition & 3u) != 0u)
+    {
+        rValues[i++] = ranf();
+    }
+
+    // Each whole block gives two numbers
+    uint32_t block[4];
+    for ( ; i+1 < num_values; i += 2)
+    {
+        GenerateBlock(mPosition >> 2, block);
+        mPosition += 4u;
+        rValues[i] = WordsToUnitReal(block[0], block[1]);
+        rValues[i+1] = WordsToUnitReal(block[2], block[3]);
+    }
+
+    if (i < num_values)
+    {
+        rValues[i] = ranf();
+    }
+}
+
+void RandomNumberStream::FillWithStandardNormalRandomDeviates(std::vector<double>& rValues)
+{
+    const unsigned num_values = rValues.size();
+    unsigned i = 0;
+    if (i < num_values && mHasSpareNormal)
+    {
+        rValues[i++] = StandardNormalRandomDeviate();
+    }
+
+    // Draw all the uniform numbers needed at once, then transform them in pairs
+    const unsigned num_pairs = (num_values - i + 1)/2;
+    std::vector<double> uniforms(2*num_pairs);
+    FillWithUniformRandomNumbers(uniforms);
+
+    for (unsigned pair=0; pair<num_pairs; pair++)
+    {
+        double radius = sqrt(-2.0*log(uniforms[2*pair]));
+        double angle = 2.0*M_PI*uniforms[2*pair+1];
+        rValues[i++] = radius*cos(angle);
+        if (i < num_values)
+        {
+            rValues[i++] = radius*sin(angle);
+        }
+        else
+        {
+            mSpareNormal = radius*sin(angle);
+            mHasSpareNormal = true;
+        }
+    }
+}
@@ -0,0 +1,198 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef RANDOMNUMBERSTREAM_HPP_
+#define RANDOMNUMBERSTREAM_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "ChasteSerialization.hpp"
+
+/**
+ * A counter-based random number generator (Philox4x32-10, Salmon et al. 2011).
+ *
+ * Each stream is identified by a seed, a stream id and a substream id, for example
+ * the global seed, a cell id and a time step, and the numbers it produces are a pure
+ * function of these and of the position in the stream. Unlike RandomNumberGenerator,
+ * streams are therefore independent of one another and of the order in which they are
+ * used, so they may be created and used concurrently by different threads and still
+ * give the same results. Streams are also seekable and cheap to create, so there is no
+ * need to keep one per object.
+ *
+ * RandomNumberGenerator::GetStream() creates streams keyed by its current seed.
+ */
+class RandomNumberStream
+{
+private:
+
+    /** The key of the generator, made from the seed and stream id. */
+    uint32_t mKey[2];
+
+    /** The substream id, used as the high half of the counter. */
+    uint64_t mSubstreamId;
+
+    /** The position in the stream, in 32-bit words. */
+    uint64_t mPosition;
+
+    /** The last block of four words generated. */
+    uint32_t mBlock[4];
+
+    /** The counter of mBlock, or UINT64_MAX if no block has been generated. */
+    uint64_t mBlockCounter;
+
+    /** Whether a second normal deviate from the last Box-Muller transform is available. */
+    bool mHasSpareNormal;
+
+    /** The second normal deviate from the last Box-Muller transform. */
+    double mSpareNormal;
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Archive the stream. Only the key and position are saved; the current block
+     * is regenerated on demand.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & mKey;
+        archive & mSubstreamId;
+        archive & mPosition;
+        archive & mHasSpareNormal;
+        archive & mSpareNormal;
+        mBlockCounter = UINT64_MAX;
+    }
+
+    /**
+     * Apply the Philox4x32-10 bijection to a counter.
+     *
+     * @param blockCounter the low 64 bits of the counter
+     * @param rOutput the four words generated
+     */
+    void GenerateBlock(uint64_t blockCounter, uint32_t (&rOutput)[4]) const;
+
+    /**
+     * @return the next 32-bit word of the stream.
+     */
+    uint32_t NextWord();
+
+    /**
+     * Convert two 32-bit words to a uniform double with 53 random bits.
+     *
+     * @param highWord the word giving the high bits
+     * @param lowWord the word giving the low bits
+     * @return a uniform random number in (0,1)
+     */
+    static double WordsToUnitReal(uint32_t highWord, uint32_t lowWord);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param seed the seed
+     * @param streamId the stream id, e.g. a cell or node index
+     * @param substreamId the substream id, e.g. a time step (defaults to 0)
+     */
+    RandomNumberStream(unsigned seed=0u, unsigned streamId=0u, uint64_t substreamId=0u);
+
+    /**
+     * Move to a given position in the stream.
+     *
+     * @param position the number of 32-bit words to skip from the start of the stream
+     */
+    void Seek(uint64_t position);
+
+    /**
+     * @return the current position in the stream, in 32-bit words.
+     */
+    uint64_t GetPosition() const;
+
+    /**
+     * @return a uniform random number in (0,1). Each number uses two words of the stream.
+     */
+    double ranf();
+
+    /**
+     * @return a random integer in [0, base). Each number uses one word of the stream.
+     *
+     * @param base the number of possible values
+     */
+    unsigned randMod(unsigned base);
+
+    /**
+     * @return a random number from the normal distribution with mean 0 and standard
+     * deviation 1, using the Box-Muller transform.
+     */
+    double StandardNormalRandomDeviate();
+
+    /**
+     * @return a random number from a normal distribution with given mean and standard deviation.
+     *
+     * @param mean the mean of the normal distribution
+     * @param stdDev the standard deviation of the normal distribution
+     */
+    double NormalRandomDeviate(double mean, double stdDev);
+
+    /**
+     * @return a random number from an exponential distribution.
+     *
+     * @param scale the rate parameter of the exponential distribution, often named lambda
+     */
+    double ExponentialRandomDeviate(double scale);
+
+    /**
+     * Fill a vector with uniform random numbers in (0,1). This gives the same numbers
+     * as calling ranf() rValues.size() times, but generates whole blocks at once.
+     *
+     * @param rValues the vector to fill
+     */
+    void FillWithUniformRandomNumbers(std::vector<double>& rValues);
+
+    /**
+     * Fill a vector with standard normal random numbers. This gives the same numbers
+     * as calling StandardNormalRandomDeviate() rValues.size() times.
+     *
+     * @param rValues the vector to fill
+     */
+    void FillWithStandardNormalRandomDeviates(std::vector<double>& rValues);
+};
+
+#endif /*RANDOMNUMBERSTREAM_HPP_*/
@@ -73,16 +73,44 @@ void FpeSignalToAbort(int sig_num, siginfo_t* info, void* context)
 }
 #endif
 
+bool PetscSetupUtils::msMpiStartedHere = false;
+
 void PetscSetupUtils::InitialisePetsc()
 {
     // The CommandLineArguments instance is filled in by the cxxtest test suite runner.
     CommandLineArguments* p_args = CommandLineArguments::Instance();
+    InitialiseMpi(p_args->p_argc, p_args->p_argv);
     PETSCEXCEPT(PetscInitialize(p_args->p_argc, p_args->p_argv, PETSC_NULL, PETSC_NULL));
     // Work around what seems to be an Intel compiler bug/quirk that makes the cache stale,
     // by using an explicit reset to ensure all code is aware we're running in parallel.
     PetscTools::ResetCache();
 }
 
+void PetscSetupUtils::InitialiseMpi(int* pArgc, char*** pArgv)
+{
+    int mpi_is_initialised;
+    MPI_Initialized(&mpi_is_initialised);
+    // Full thread support can make MPI slower, so it is only asked for on request; otherwise
+    // PetscInitialize starts MPI as usual.  We may not get it; Hdf5WriteQueue::IsSupported()
+    // checks what was provided.
+    if (!mpi_is_initialised && CommandLineArguments::Instance()->OptionExists("-mpi_thread_multiple"))
+    {
+        int provided;
+        MPI_Init_thread(pArgc, pArgv, MPI_THREAD_MULTIPLE, &provided);
+        msMpiStartedHere = true;
+    }
+}
+
+void PetscSetupUtils::FinalizePetscAndMpi()
+{
+    PETSCEXCEPT(PetscFinalize());
+    if (msMpiStartedHere)
+    {
+        MPI_Finalize();
+        msMpiStartedHere = false;
+    }
+}
+
 void PetscSetupUtils::CommonSetup()
 {
     InitialisePetsc();
@@ -124,7 +152,7 @@ void PetscSetupUtils::CommonFinalize()
     // This does nothing if we are on a new PETSc, just allows Chaste to print citations instead in this case
     Citations::Print();
 
-    PETSCEXCEPT(PetscFinalize());
+    FinalizePetscAndMpi();
 }
 
 void PetscSetupUtils::ResetStatusCache()
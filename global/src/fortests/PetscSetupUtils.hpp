@@ -53,6 +53,23 @@ public:
      */
     static void InitialisePetsc();
 
+    /**
+     * If the -mpi_thread_multiple command line option is given, and MPI isn't already running,
+     * initialise MPI asking for MPI_THREAD_MULTIPLE support so that background threads (e.g. the
+     * Hdf5WriteQueue used for asynchronous output) may make MPI calls.  Otherwise do nothing, and
+     * leave PetscInitialize to start MPI.  Must be called before PetscInitialize, and after the
+     * CommandLineArguments instance has been filled in.
+     *
+     * @param pArgc  pointer to the number of command line arguments
+     * @param pArgv  pointer to the command line arguments
+     */
+    static void InitialiseMpi(int* pArgc, char*** pArgv);
+
+    /**
+     * Finalize PETSc, and MPI too if it was started by InitialiseMpi().
+     */
+    static void FinalizePetscAndMpi();
+
     /**
      * Call PetscTools::ResetCache().
      * Used by FakePetscSetup.hpp to ensure the cache doesn't reflect being run in parallel.
@@ -65,6 +82,8 @@ public:
     static void CommonFinalize();
 
 private:
+    /** Whether InitialiseMpi() started MPI, in which case PETSc won't finalize it for us. */
+    static bool msMpiStartedHere;
 };
 
 #endif // PETSCSETUPUTILS_HPP_
@@ -0,0 +1,87 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "OpenMpTools.hpp"
+
+#include <cassert>
+
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif // CHASTE_OPENMP
+
+bool OpenMpTools::IsEnabled()
+{
+#ifdef CHASTE_OPENMP
+    return true;
+#else
+    return false;
+#endif // CHASTE_OPENMP
+}
+
+unsigned OpenMpTools::GetMaxNumThreads()
+{
+#ifdef CHASTE_OPENMP
+    return omp_get_max_threads();
+#else
+    return 1u;
+#endif // CHASTE_OPENMP
+}
+
+void OpenMpTools::SetNumThreads(unsigned numThreads)
+{
+    assert(numThreads > 0u);
+#ifdef CHASTE_OPENMP
+    omp_set_num_threads(numThreads);
+#endif // CHASTE_OPENMP
+}
+
+unsigned OpenMpTools::GetThreadNum()
+{
+#ifdef CHASTE_OPENMP
+    return omp_get_thread_num();
+#else
+    return 0u;
+#endif // CHASTE_OPENMP
+}
+
+bool OpenMpTools::InParallel()
+{
+#ifdef CHASTE_OPENMP
+    return omp_in_parallel();
+#else
+    return false;
+#endif // CHASTE_OPENMP
+}
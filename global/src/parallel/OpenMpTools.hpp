@@ -0,0 +1,88 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef OPENMPTOOLS_HPP_
+#define OPENMPTOOLS_HPP_
+
+/**
+ * @file
+ * Contains the OpenMpTools class.
+ */
+
+/**
+ * A helper class of static methods wrapping the OpenMP runtime, so that thread-parallel
+ * code paths can be written once and still compile (running on a single thread) when
+ * Chaste is built without OpenMP support (i.e. CHASTE_OPENMP is not defined).
+ *
+ * Thread parallelism in Chaste is always within a single MPI process; it is intended
+ * for loops over independent local objects (e.g. the cell models owned by a process),
+ * and is an alternative to running more MPI processes per node.
+ */
+class OpenMpTools
+{
+public:
+
+    /**
+     * @return whether Chaste was compiled with OpenMP support.
+     */
+    static bool IsEnabled();
+
+    /**
+     * @return the maximum number of threads a parallel region may use (1 without OpenMP).
+     */
+    static unsigned GetMaxNumThreads();
+
+    /**
+     * Set the number of threads that subsequent parallel regions will use.
+     * Has no effect without OpenMP.
+     *
+     * @param numThreads  the number of threads (must be positive)
+     */
+    static void SetNumThreads(unsigned numThreads);
+
+    /**
+     * @return the index of the calling thread within the current parallel region
+     * (0 outside a parallel region, and always 0 without OpenMP).
+     */
+    static unsigned GetThreadNum();
+
+    /**
+     * @return whether the caller is executing inside an active parallel region.
+     */
+    static bool InParallel();
+};
+
+#endif // OPENMPTOOLS_HPP_
@@ -0,0 +1,94 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _TESTOPENMPTOOLS_HPP_
+#define _TESTOPENMPTOOLS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <vector>
+#include "Exception.hpp"
+#include "OpenMpTools.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestOpenMpTools : public CxxTest::TestSuite
+{
+public:
+
+    void TestOutsideParallelRegion()
+    {
+        TS_ASSERT_LESS_THAN_EQUALS(1u, OpenMpTools::GetMaxNumThreads());
+        TS_ASSERT_EQUALS(OpenMpTools::GetThreadNum(), 0u);
+        TS_ASSERT_EQUALS(OpenMpTools::InParallel(), false);
+
+        if (!OpenMpTools::IsEnabled())
+        {
+            TS_ASSERT_EQUALS(OpenMpTools::GetMaxNumThreads(), 1u);
+        }
+    }
+
+    void TestParallelLoop()
+    {
+        unsigned original_num_threads = OpenMpTools::GetMaxNumThreads();
+        OpenMpTools::SetNumThreads(2u);
+        if (OpenMpTools::IsEnabled())
+        {
+            TS_ASSERT_EQUALS(OpenMpTools::GetMaxNumThreads(), 2u);
+        }
+
+        // Each iteration records the thread that ran it; every thread index must be in range
+        const unsigned num_iterations = 100;
+        std::vector<unsigned> thread_used(num_iterations, UNSIGNED_UNSET);
+        std::vector<unsigned> in_parallel(num_iterations, 0u); // not vector<bool>, which packs bits
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for
+#endif // CHASTE_OPENMP
+        for (unsigned i=0; i<num_iterations; i++)
+        {
+            thread_used[i] = OpenMpTools::GetThreadNum();
+            in_parallel[i] = OpenMpTools::InParallel();
+        }
+
+        for (unsigned i=0; i<num_iterations; i++)
+        {
+            TS_ASSERT_LESS_THAN(thread_used[i], OpenMpTools::GetMaxNumThreads());
+            TS_ASSERT_EQUALS(in_parallel[i] == 1u, OpenMpTools::IsEnabled());
+        }
+
+        OpenMpTools::SetNumThreads(original_num_threads);
+    }
+};
+
+#endif //_TESTOPENMPTOOLS_HPP_
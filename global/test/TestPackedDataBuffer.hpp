@@ -0,0 +1,118 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _TESTPACKEDDATABUFFER_HPP_
+#define _TESTPACKEDDATABUFFER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "PackedDataBuffer.hpp"
+#include "PetscTools.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestPackedDataBuffer : public CxxTest::TestSuite
+{
+public:
+
+    void TestPackAndUnpack()
+    {
+        PackedDataBuffer buffer;
+        TS_ASSERT_EQUALS(buffer.GetSize(), 0u);
+        TS_ASSERT(buffer.IsFullyUnpacked());
+
+        double location[3] = {1.5, -2.5, 3.25};
+        buffer.Pack<unsigned>(42);
+        buffer.PackArray(location, 3);
+        buffer.PackBytes("hello");
+        buffer.Pack(true);
+        TS_ASSERT_EQUALS(buffer.GetSize(), sizeof(unsigned) + 3*sizeof(double) + sizeof(unsigned) + 5 + sizeof(bool));
+
+        TS_ASSERT_EQUALS(buffer.Unpack<unsigned>(), 42u);
+        double unpacked_location[3];
+        buffer.UnpackArray(unpacked_location, 3);
+        for (unsigned i=0; i<3; i++)
+        {
+            TS_ASSERT_EQUALS(unpacked_location[i], location[i]);
+        }
+        TS_ASSERT_EQUALS(buffer.UnpackBytes(), "hello");
+        TS_ASSERT(!buffer.IsFullyUnpacked());
+        TS_ASSERT_EQUALS(buffer.Unpack<bool>(), true);
+        TS_ASSERT(buffer.IsFullyUnpacked());
+
+        // Empty arrays and strings take no space beyond the string length
+        buffer.Clear();
+        buffer.PackArray(location, 0);
+        buffer.PackBytes("");
+        TS_ASSERT_EQUALS(buffer.GetSize(), sizeof(unsigned));
+        TS_ASSERT_EQUALS(buffer.UnpackBytes(), "");
+        TS_ASSERT(buffer.IsFullyUnpacked());
+    }
+
+    void TestSendingBuffer()
+    {
+        PackedDataBuffer buffer;
+        if (PetscTools::AmMaster())
+        {
+            for (unsigned i=0; i<10; i++)
+            {
+                buffer.Pack<double>(0.5*i);
+            }
+            for (unsigned p=1; p<PetscTools::GetNumProcs(); p++)
+            {
+                MPI_Send(buffer.GetData(), buffer.GetSize(), MPI_BYTE, p, 123, PetscTools::GetWorld());
+            }
+        }
+        else
+        {
+            MPI_Status status;
+            MPI_Probe(0, 123, PetscTools::GetWorld(), &status);
+            int size;
+            MPI_Get_count(&status, MPI_BYTE, &size);
+            TS_ASSERT_EQUALS(size, (int)(10*sizeof(double)));
+
+            buffer.Resize(size);
+            MPI_Recv(buffer.GetData(), size, MPI_BYTE, 0, 123, PetscTools::GetWorld(), &status);
+            for (unsigned i=0; i<10; i++)
+            {
+                TS_ASSERT_EQUALS(buffer.Unpack<double>(), 0.5*i);
+            }
+            TS_ASSERT(buffer.IsFullyUnpacked());
+        }
+    }
+};
+
+#endif // _TESTPACKEDDATABUFFER_HPP_
@@ -485,6 +485,123 @@ public:
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(3.0), 0.2967, 1e-4);
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(4.0), 0.2715, 1e-4);
     }
+
+    void TestRandomNumberStream()
+    {
+        // The first block of the stream with zero key and counter matches the Philox4x32-10 known-answer test
+        RandomNumberStream zero_stream;
+        TS_ASSERT_EQUALS(zero_stream.randMod(UINT_MAX), 0x6627e8d5u);
+        TS_ASSERT_EQUALS(zero_stream.randMod(UINT_MAX), 0xe169c58du);
+        TS_ASSERT_EQUALS(zero_stream.randMod(UINT_MAX), 0xbc57ac4cu);
+        TS_ASSERT_EQUALS(zero_stream.randMod(UINT_MAX), 0x9b00dbd8u);
+        TS_ASSERT_EQUALS(zero_stream.GetPosition(), 4u);
+
+        // Streams are a function of the seed, the ids and the position only
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(3);
+        RandomNumberStream stream = p_gen->GetStream(12, 7);
+        double first = stream.ranf();
+        double second = stream.ranf();
+        TS_ASSERT_LESS_THAN(0.0, first);
+        TS_ASSERT_LESS_THAN(first, 1.0);
+        TS_ASSERT_DIFFERS(first, second);
+
+        p_gen->ranf();
+        TS_ASSERT_EQUALS(p_gen->GetStream(12, 7).ranf(), first);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(13, 7).ranf(), first);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(12, 8).ranf(), first);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(12, (uint64_t(1) << 32) + 7).ranf(), first);
+        p_gen->Reseed(4);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(12, 7).ranf(), first);
+
+        stream.Seek(2);
+        TS_ASSERT_EQUALS(stream.ranf(), second);
+
+        // The batch methods give the same numbers as the single ones, from any position
+        RandomNumberStream single_stream(1, 2, 3);
+        RandomNumberStream batch_stream(1, 2, 3);
+        single_stream.randMod(10);
+        batch_stream.randMod(10);
+
+        std::vector<double> values(11);
+        batch_stream.FillWithUniformRandomNumbers(values);
+        for (unsigned i=0; i<values.size(); i++)
+        {
+            TS_ASSERT_EQUALS(values[i], single_stream.ranf());
+        }
+        batch_stream.FillWithStandardNormalRandomDeviates(values);
+        for (unsigned i=0; i<values.size(); i++)
+        {
+            TS_ASSERT_EQUALS(values[i], single_stream.StandardNormalRandomDeviate());
+        }
+        TS_ASSERT_EQUALS(batch_stream.NormalRandomDeviate(1.0, 2.0), single_stream.NormalRandomDeviate(1.0, 2.0));
+        TS_ASSERT_EQUALS(batch_stream.ExponentialRandomDeviate(2.0), single_stream.ExponentialRandomDeviate(2.0));
+
+        // Check the moments of the normal deviates
+        RandomNumberStream normal_stream(5);
+        std::vector<double> normals(100000);
+        normal_stream.FillWithStandardNormalRandomDeviates(normals);
+        double mean = 0.0;
+        double mean_square = 0.0;
+        for (unsigned i=0; i<normals.size(); i++)
+        {
+            mean += normals[i]/normals.size();
+            mean_square += normals[i]*normals[i]/normals.size();
+        }
+        TS_ASSERT_DELTA(mean, 0.0, 1e-2);
+        TS_ASSERT_DELTA(mean_square, 1.0, 1e-2);
+
+        RandomNumberGenerator::Destroy();
+    }
+
+    void TestArchiveRandomNumberStream()
+    {
+        OutputFileHandler handler("archive", false);
+        std::string archive_filename = handler.GetOutputDirectoryFullPath() + "random_number_stream.arch";
+
+        std::vector<double> expected_numbers;
+        double expected_generator_stream_number;
+        {
+            RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+            p_gen->Reseed(9);
+            expected_generator_stream_number = p_gen->GetStream(4).ranf();
+
+            RandomNumberStream stream(1, 2);
+            stream.randMod(5);
+            stream.StandardNormalRandomDeviate();
+
+            std::ofstream ofs(archive_filename.c_str());
+            boost::archive::text_oarchive output_arch(ofs);
+            output_arch << stream;
+            SerializableSingleton<RandomNumberGenerator>* const p_wrapper = p_gen->GetSerializationWrapper();
+            output_arch << p_wrapper;
+
+            for (unsigned i=0; i<5; i++)
+            {
+                expected_numbers.push_back(stream.StandardNormalRandomDeviate());
+            }
+            RandomNumberGenerator::Destroy();
+        }
+
+        {
+            RandomNumberGenerator::Instance()->Reseed(1);
+
+            RandomNumberStream stream;
+            std::ifstream ifs(archive_filename.c_str(), std::ios::binary);
+            boost::archive::text_iarchive input_arch(ifs);
+            input_arch >> stream;
+            SerializableSingleton<RandomNumberGenerator>* p_wrapper;
+            input_arch >> p_wrapper;
+
+            // The spare normal deviate is restored too
+            for (unsigned i=0; i<5; i++)
+            {
+                TS_ASSERT_EQUALS(stream.StandardNormalRandomDeviate(), expected_numbers[i]);
+            }
+            TS_ASSERT_EQUALS(RandomNumberGenerator::Instance()->GetStream(4).ranf(), expected_generator_stream_number);
+            RandomNumberGenerator::Destroy();
+        }
+    }
 };
 
 #endif /*TESTRANDOMNUMBERGENERATOR_HPP_*/
@@ -35,7 +35,229 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractLookupTableCollection.hpp"
 
+#include <cassert>
 #include <cmath>
+#include <stdint.h>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include "BoostFilesystem.hpp"
+#include "ChasteSyscalls.hpp"
+#include "Exception.hpp"
+
+/** The size of a cache line, in bytes; table rows are padded to a multiple of this. */
+static const unsigned CACHE_LINE_BYTES = 64u;
+
+/** Identifies (the version of) a table cache file. */
+static const char TABLE_FILE_MAGIC[8] = {'C', 'H', 'L', 'U', 'T', '0', '0', '1'};
+
+/**
+ * @return the length of the header of a table cache file holding the given key; the
+ * header is padded so that the table data that follows it is cache-line aligned.
+ *
+ * @param rKey  the cache key
+ */
+static size_t GetTableFileHeaderLength(const std::string& rKey)
+{
+    size_t length = sizeof(TABLE_FILE_MAGIC) + sizeof(unsigned) + rKey.length();
+    return CACHE_LINE_BYTES*((length + CACHE_LINE_BYTES - 1)/CACHE_LINE_BYTES);
+}
+
+/**
+ * Create an empty file with a unique name for writing a cache file before it is renamed into
+ * place.  The name is chosen and the file created atomically (by mkstemp), so processes on
+ * different hosts sharing the cache directory can never write to the same temporary file.
+ *
+ * @param rPath  the path the file will be renamed to
+ * @return the path of the new file
+ */
+static std::string CreateTemporaryTableFile(const std::string& rPath)
+{
+    std::string name_template = rPath + ".tmp.XXXXXX";
+    std::vector<char> name(name_template.begin(), name_template.end());
+    name.push_back('\0');
+    int fd = mkstemp(&name[0]);
+    if (fd == -1)
+    {
+        throw std::runtime_error("Unable to create a temporary file for " + rPath);
+    }
+    close(fd);
+
+    // mkstemp makes the file private to its owner; let the group share the cache too
+    chmod(&name[0], CHASTE_READ_WRITE);
+    return std::string(&name[0]);
+}
+
+/**
+ * @return the path of the table cache file for the given key.  The name is a stable (FNV-1a)
+ * hash of the key; the key itself is stored in the file and checked on loading.
+ *
+ * @param rDirectory  the cache directory, with trailing slash
+ * @param rKey  the cache key
+ */
+static std::string GetTableFilePath(const std::string& rDirectory, const std::string& rKey)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (std::string::const_iterator it = rKey.begin(); it != rKey.end(); ++it)
+    {
+        hash = (hash ^ static_cast<unsigned char>(*it)) * 1099511628211ull;
+    }
+    std::stringstream path;
+    path << rDirectory << "lut_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    return path.str();
+}
+
+class AbstractLookupTableCollection::TableMemory
+{
+public:
+    /** Private memory, if the tables were generated by this process. */
+    boost::scoped_array<char> mpPrivate;
+
+    /** The table file, if the tables are mapped from the cache. */
+    boost::scoped_ptr<boost::interprocess::file_mapping> mpFile;
+
+    /** The mapping of #mpFile into memory. */
+    boost::scoped_ptr<boost::interprocess::mapped_region> mpRegion;
+
+    /** The first row of the tables, cache-line aligned. */
+    double* mpData;
+
+    /** The number of doubles in the tables, including padding. */
+    size_t mNumDoubles;
+
+    /** The key describing these tables in the file cache. */
+    std::string mKey;
+
+    /**
+     * Allocate private memory for tables.
+     *
+     * @param numDoubles  the number of doubles needed
+     * @param rKey  the cache key for the tables
+     */
+    TableMemory(size_t numDoubles, const std::string& rKey)
+        : mpData(NULL),
+          mNumDoubles(numDoubles),
+          mKey(rKey)
+    {
+        mpPrivate.reset(new char[numDoubles*sizeof(double) + CACHE_LINE_BYTES]);
+        size_t offset = CACHE_LINE_BYTES - (reinterpret_cast<size_t>(mpPrivate.get()) % CACHE_LINE_BYTES);
+        mpData = reinterpret_cast<double*>(mpPrivate.get() + offset%CACHE_LINE_BYTES);
+    }
+
+    /**
+     * Try to map tables from the given cache file.
+     *
+     * @param rPath  the cache file
+     * @param numDoubles  the number of doubles expected
+     * @param rKey  the cache key expected
+     * @return whether the file exists and holds the expected tables
+     */
+    bool MapFile(const std::string& rPath, size_t numDoubles, const std::string& rKey)
+    {
+        try
+        {
+            if (!fs::exists(rPath))
+            {
+                return false;
+            }
+            const size_t header_length = GetTableFileHeaderLength(rKey);
+            if (fs::file_size(rPath) != header_length + numDoubles*sizeof(double))
+            {
+                return false;
+            }
+            boost::scoped_ptr<boost::interprocess::file_mapping> p_file(
+                new boost::interprocess::file_mapping(rPath.c_str(), boost::interprocess::read_only));
+            boost::scoped_ptr<boost::interprocess::mapped_region> p_region(
+                new boost::interprocess::mapped_region(*p_file, boost::interprocess::read_only));
+
+            // Check the header matches exactly, in case of hash collisions or stale files
+            const char* p_header = static_cast<const char*>(p_region->get_address());
+            unsigned key_length;
+            memcpy(&key_length, p_header + sizeof(TABLE_FILE_MAGIC), sizeof(unsigned));
+            if (memcmp(p_header, TABLE_FILE_MAGIC, sizeof(TABLE_FILE_MAGIC)) != 0
+                || key_length != rKey.length()
+                || rKey.compare(0, key_length, p_header + sizeof(TABLE_FILE_MAGIC) + sizeof(unsigned), key_length) != 0)
+            {
+                return false;
+            }
+
+            mpPrivate.reset();
+            mpFile.swap(p_file);
+            mpRegion.swap(p_region);
+            mpData = reinterpret_cast<double*>(static_cast<char*>(mpRegion->get_address()) + header_length);
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            // Any problem with the cache just means we generate the tables ourselves
+            return false;
+        }
+    }
+
+    /**
+     * Write the tables to the given cache file.  The file is written under a temporary
+     * name and then renamed, so that other processes never see a partial file.
+     *
+     * @param rPath  the cache file
+     * @return whether the file was written
+     */
+    bool WriteFile(const std::string& rPath) const
+    {
+        std::string temp_path;
+        try
+        {
+            temp_path = CreateTemporaryTableFile(rPath);
+            {
+                std::ofstream file(temp_path.c_str(), std::ios::binary);
+                unsigned key_length = mKey.length();
+                std::string padding(GetTableFileHeaderLength(mKey) - sizeof(TABLE_FILE_MAGIC) - sizeof(unsigned) - key_length, '\0');
+                file.write(TABLE_FILE_MAGIC, sizeof(TABLE_FILE_MAGIC));
+                file.write(reinterpret_cast<const char*>(&key_length), sizeof(unsigned));
+                file.write(mKey.c_str(), key_length);
+                file.write(padding.c_str(), padding.length());
+                file.write(reinterpret_cast<const char*>(mpData), mNumDoubles*sizeof(double));
+                file.close();
+                if (!file)
+                {
+                    fs::remove(temp_path);
+                    return false;
+                }
+            }
+            fs::rename(temp_path, rPath);
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            try
+            {
+                if (!temp_path.empty())
+                {
+                    fs::remove(temp_path);
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+            return false;
+        }
+    }
+
+    /** @return whether the tables are mapped from the file cache. */
+    bool IsShared() const
+    {
+        return mpRegion.get() != NULL;
+    }
+};
+
+std::string AbstractLookupTableCollection::msTableCacheDirectory = "";
 
 AbstractLookupTableCollection::AbstractLookupTableCollection()
     : mDt(0.0)
@@ -111,4 +333,91 @@ AbstractLookupTableCollection::~AbstractLookupTableCollection()
 {
 }
 
+void AbstractLookupTableCollection::EnableTableFileCache(const FileFinder& rDirectory)
+{
+    if (!rDirectory.IsDir())
+    {
+        EXCEPTION("Lookup table cache directory '" + rDirectory.GetAbsolutePath() + "' does not exist.");
+    }
+    msTableCacheDirectory = rDirectory.GetAbsolutePath();
+}
+
+void AbstractLookupTableCollection::DisableTableFileCache()
+{
+    msTableCacheDirectory = "";
+}
+
+bool AbstractLookupTableCollection::IsTableFileCacheEnabled()
+{
+    return !msTableCacheDirectory.empty();
+}
+
+unsigned AbstractLookupTableCollection::GetPaddedRowLength(unsigned numTables)
+{
+    const unsigned doubles_per_line = CACHE_LINE_BYTES/sizeof(double);
+    return doubles_per_line*((numTables + doubles_per_line - 1)/doubles_per_line);
+}
+
+std::string AbstractLookupTableCollection::GetTableCacheKey(unsigned keyIndex, unsigned numRows, unsigned rowStride) const
+{
+    std::stringstream key;
+    key << std::setprecision(17) << mTableCacheIdentifier << "|" << mKeyingVariableNames[keyIndex]
+        << "|" << mTableMins[keyIndex] << "|" << mTableSteps[keyIndex] << "|" << mTableMaxs[keyIndex]
+        << "|" << mNumberOfTables[keyIndex] << "|" << numRows << "|" << rowStride << "|" << mDt
+        << "|" << sizeof(double);
+    return key.str();
+}
+
+double* AbstractLookupTableCollection::AllocateTableMemory(unsigned keyIndex, unsigned numRows, unsigned rowStride)
+{
+    assert(rowStride >= mNumberOfTables[keyIndex]);
+    if (mTableMemory.size() < mKeyingVariableNames.size())
+    {
+        mTableMemory.resize(mKeyingVariableNames.size());
+    }
+    FreeTableMemory(keyIndex);
+
+    const size_t num_doubles = static_cast<size_t>(numRows)*rowStride;
+    const std::string key = GetTableCacheKey(keyIndex, numRows, rowStride);
+    boost::shared_ptr<TableMemory> p_memory(new TableMemory(num_doubles, key));
+    if (IsTableFileCacheEnabled() && !mTableCacheIdentifier.empty())
+    {
+        p_memory->MapFile(GetTableFilePath(msTableCacheDirectory, key), num_doubles, key);
+    }
+    mTableMemory[keyIndex] = p_memory;
+    return p_memory->mpData;
+}
+
+bool AbstractLookupTableCollection::IsTableMemoryShared(unsigned keyIndex) const
+{
+    assert(keyIndex < mTableMemory.size() && mTableMemory[keyIndex]);
+    return mTableMemory[keyIndex]->IsShared();
+}
+
+double* AbstractLookupTableCollection::FinaliseTableMemory(unsigned keyIndex)
+{
+    assert(keyIndex < mTableMemory.size() && mTableMemory[keyIndex]);
+    boost::shared_ptr<TableMemory> p_memory = mTableMemory[keyIndex];
+    if (!p_memory->IsShared() && IsTableFileCacheEnabled() && !mTableCacheIdentifier.empty())
+    {
+        const std::string path = GetTableFilePath(msTableCacheDirectory, p_memory->mKey);
+
+        // Another process may have got there first, in which case its file is just as good
+        if (p_memory->WriteFile(path) || fs::exists(path))
+        {
+            // Swap our private copy for the shared mapping, so that only one copy is resident
+            p_memory->MapFile(path, p_memory->mNumDoubles, p_memory->mKey);
+        }
+    }
+    return p_memory->mpData;
+}
+
+void AbstractLookupTableCollection::FreeTableMemory(unsigned keyIndex)
+{
+    if (keyIndex < mTableMemory.size())
+    {
+        mTableMemory[keyIndex].reset();
+    }
+}
+
 const char* AbstractLookupTableCollection::EventHandler::EventName[] =  {"GenTables"};
@@ -38,13 +38,26 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
 #include <vector>
+#include <boost/shared_ptr.hpp>
 
+#include "FileFinder.hpp"
 #include "GenericEventHandler.hpp"
 
 /**
  * Base class for lookup tables used in optimised cells generated by PyCml.
  * Contains methods to query and adjust table parameters (i.e. size and spacing),
  * and an event handler to time table generation.
+ *
+ * It also owns the memory for the tables.  All the tables keyed by one variable are
+ * stored interleaved, one row per value of the keying variable, with each row padded
+ * to a whole number of cache lines and the first row cache-line aligned; so looking up
+ * every table for one value of the key touches as few cache lines as possible.
+ *
+ * If EnableTableFileCache() has been called, generated tables are also written to a
+ * read-only file in the given directory, and later requests for identical tables (from
+ * this or any other process on the machine, e.g. every MPI rank on a node) map that file
+ * instead of regenerating the tables.  The operating system then holds a single copy of
+ * the tables in memory, shared by all the processes using them.
  */
 class AbstractLookupTableCollection
 {
@@ -114,6 +127,34 @@ public:
     /** Virtual destructor since we have a virtual method. */
     virtual ~AbstractLookupTableCollection();
 
+    /**
+     * Share generated tables between processes, and between runs, through files in the
+     * given directory.  The directory must exist; it is safe for many processes to use
+     * the same directory concurrently.  Affects tables (re)generated after this call.
+     *
+     * @param rDirectory  where to store the table files
+     */
+    static void EnableTableFileCache(const FileFinder& rDirectory);
+
+    /**
+     * Stop using the table file cache for tables generated from now on.
+     */
+    static void DisableTableFileCache();
+
+    /**
+     * @return whether the table file cache is in use.
+     */
+    static bool IsTableFileCacheEnabled();
+
+    /**
+     * The number of doubles each row of the tables keyed by one variable occupies,
+     * i.e. the number of tables rounded up to a whole number of cache lines.
+     *
+     * @param numTables  the number of tables keyed by the variable
+     * @return the row stride
+     */
+    static unsigned GetPaddedRowLength(unsigned numTables);
+
     /**
      * A little event handler with one event, to time table generation.
      */
@@ -161,6 +202,71 @@ protected:
 
     /** Timestep to use in lookup tables */
     double mDt;
+
+    /**
+     * Identifies the code that generates these tables, so that tables cached on disk are
+     * only reused by an identical build of the same cell model.  Set by subclasses.
+     */
+    std::string mTableCacheIdentifier;
+
+    /**
+     * Provide memory for the tables keyed by the given variable, releasing any memory
+     * already held for it.  If the file cache is enabled and holds matching tables, the
+     * returned memory is a read-only mapping of them and IsTableMemoryShared() is true;
+     * otherwise it is private memory that the caller must fill in before calling
+     * FinaliseTableMemory().
+     *
+     * @param keyIndex  the index of the keying variable
+     * @param numRows  the number of rows (values of the keying variable)
+     * @param rowStride  the row length, from GetPaddedRowLength()
+     * @return the first row, aligned to a cache line
+     */
+    double* AllocateTableMemory(unsigned keyIndex, unsigned numRows, unsigned rowStride);
+
+    /**
+     * @return whether the memory for the given tables was mapped from the file cache,
+     * in which case it already holds the tables and must not be written to.
+     *
+     * @param keyIndex  the index of the keying variable
+     */
+    bool IsTableMemoryShared(unsigned keyIndex) const;
+
+    /**
+     * Called once freshly generated tables have been filled in.  If the file cache is
+     * enabled, the tables are written to it and replaced by a shared mapping of the file,
+     * which may move them.
+     *
+     * @param keyIndex  the index of the keying variable
+     * @return the (possibly new) location of the first row
+     */
+    double* FinaliseTableMemory(unsigned keyIndex);
+
+    /**
+     * Release the memory for the tables keyed by the given variable.
+     *
+     * @param keyIndex  the index of the keying variable
+     */
+    void FreeTableMemory(unsigned keyIndex);
+
+private:
+
+    /** Holds, and knows how to release, the memory for one set of tables. */
+    class TableMemory;
+
+    /** The memory for the tables keyed by each variable (may be empty pointers). */
+    std::vector<boost::shared_ptr<TableMemory> > mTableMemory;
+
+    /** The directory holding cached tables, or empty if the cache is disabled. */
+    static std::string msTableCacheDirectory;
+
+    /**
+     * @return the string uniquely describing the given tables in the file cache.
+     *
+     * @param keyIndex  the index of the keying variable
+     * @param numRows  the number of rows
+     * @param rowStride  the row length
+     */
+    std::string GetTableCacheKey(unsigned keyIndex, unsigned numRows, unsigned rowStride) const;
 };
 
 #endif // ABSTRACTLOOKUPTABLECOLLECTION_HPP_
@@ -42,8 +42,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstring> // For strerror()
 #include <cerrno> // For errno
 
+#include <algorithm>
 #include <boost/foreach.hpp>
 
+#include "BoostFilesystem.hpp"
 #include "ChasteSyscalls.hpp"
 #include "Exception.hpp"
 #include "Warnings.hpp"
@@ -51,6 +53,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscTools.hpp"
 #include "DynamicModelLoaderRegistry.hpp"
 #include "GetCurrentWorkingDirectory.hpp"
+#include "Version.hpp"
 
 #define IGNORE_EXCEPTIONS(code) \
     try {                       \
@@ -119,7 +122,28 @@ DynamicCellModelLoaderPtr CellMLToSharedLibraryConverter::Convert(const FileFind
             {
                 EXCEPTION("Unable to convert .cellml to .so unless called collectively, due to possible race conditions.");
             }
-            ConvertCellmlToSo(absolute_path, folder);
+            DynamicModelLoaderRegistry* p_registry = DynamicModelLoaderRegistry::Instance();
+            std::string cache_key;
+            bool use_cached = false;
+            if (p_registry->IsBuildCacheEnabled())
+            {
+                cache_key = GetBuildCacheKey(file_path_copy);
+                // A cached build doesn't include the generated sources, and every process must agree to use it
+                use_cached = !mPreserveGeneratedSources
+                             && !PetscTools::ReplicateBool(!p_registry->FindCachedLibrary(cache_key).IsPathSet());
+            }
+            if (use_cached)
+            {
+                TRY_IF_MASTER(CopyLibraryIntoPlace(p_registry->FindCachedLibrary(cache_key), so_file));
+            }
+            else
+            {
+                ConvertCellmlToSo(absolute_path, folder);
+                if (!cache_key.empty())
+                {
+                    TRY_IF_MASTER(p_registry->AddToBuildCache(cache_key, so_file));
+                }
+            }
         }
         // Load the .so
         p_loader = DynamicModelLoaderRegistry::Instance()->GetLoader(so_file);
@@ -138,6 +162,56 @@ DynamicCellModelLoaderPtr CellMLToSharedLibraryConverter::Convert(const FileFind
     return p_loader;
 }
 
+std::string CellMLToSharedLibraryConverter::GetBuildCacheKey(const FileFinder& rCellmlFile) const
+{
+    // Everything that goes into the build: the model and any options files alongside it
+    // (as copied by ConvertCellmlToSo), but not sources generated by an earlier conversion...
+    std::vector<FileFinder> sources = rCellmlFile.GetParent().FindMatches(rCellmlFile.GetLeafNameNoExtension() + "*");
+    std::vector<FileFinder> inputs;
+    BOOST_FOREACH(const FileFinder& r_source, sources)
+    {
+        std::string extension = r_source.GetExtension();
+        if (r_source.IsFile() && extension != ".cpp" && extension != ".hpp")
+        {
+            inputs.push_back(r_source);
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    // ...and the code generator, compiler and flags
+    std::stringstream settings;
+    settings << ChasteBuildInfo::GetVersionString() << " " << ChasteBuildInfo::IsWorkingCopyModified()
+             << " " << ChasteBuildInfo::GetBuildTime() << " " << ChasteBuildInfo::GetCompilerType()
+             << " " << ChasteBuildInfo::GetCompilerVersion() << " " << ChasteBuildInfo::GetCompilerFlags()
+             << " " << ChasteBuildType() << " " << mComponentName << " " << msSoSuffix;
+    return DynamicModelLoaderRegistry::GetBuildCacheKey(inputs, settings.str());
+}
+
+void CellMLToSharedLibraryConverter::CopyLibraryIntoPlace(const FileFinder& rCachedLibrary,
+                                                          const FileFinder& rDestination)
+{
+    std::string temp_path;
+    try
+    {
+        temp_path = DynamicModelLoaderRegistry::CopyToTemporaryFile(rCachedLibrary.GetAbsolutePath(),
+                                                                    rDestination.GetAbsolutePath());
+        if (rDestination.Exists())
+        {
+            fs::remove(rDestination.GetAbsolutePath());
+        }
+        fs::rename(temp_path, rDestination.GetAbsolutePath());
+    }
+    catch (const std::exception& e)
+    {
+        if (!temp_path.empty())
+        {
+            IGNORE_EXCEPTIONS(fs::remove(temp_path));
+        }
+        EXCEPTION("Unable to copy cached library '" << rCachedLibrary.GetAbsolutePath() << "' to '"
+                  << rDestination.GetAbsolutePath() << "': " << e.what());
+    }
+}
+
 void CellMLToSharedLibraryConverter::ConvertCellmlToSo(const std::string& rCellmlFullPath,
                                                        const std::string& rCellmlFolder)
 {
@@ -70,6 +70,10 @@ public:
      * the loader.  The interesting case comes when it is a .cellml file.  If
      * the file has any other extension, an exception is thrown.
      *
+     * If DynamicModelLoaderRegistry has a build cache, a .cellml file already built
+     * with the same options and compiler settings is copied from the cache rather than
+     * converted again, and new conversions are added to the cache.
+     *
      * @param rFilePath  the model to load
      * @param isCollective  whether this method is being called collectively.
      *   If it is not, then we require the .so to already exist, rather than
@@ -105,6 +109,24 @@ private:
     void ConvertCellmlToSo(const std::string& rCellmlFullPath,
                            const std::string& rCellmlFolder);
 
+    /**
+     * @return the key identifying, in the build cache, the library built from the given
+     * model with our settings.  Covers the model and its options files, this Chaste build,
+     * and the compiler and flags used.
+     *
+     * @param rCellmlFile  the .cellml file
+     */
+    std::string GetBuildCacheKey(const FileFinder& rCellmlFile) const;
+
+    /**
+     * Copy a library from the build cache to where Convert() expects to find it, replacing
+     * the destination atomically.  Must only be called by one process.
+     *
+     * @param rCachedLibrary  the library in the build cache
+     * @param rDestination  where the .so should go
+     */
+    void CopyLibraryIntoPlace(const FileFinder& rCachedLibrary, const FileFinder& rDestination);
+
     /** Whether to save copies of generated C++ source files. */
     bool mPreserveGeneratedSources;
 
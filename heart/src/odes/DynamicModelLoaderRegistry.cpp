@@ -35,6 +35,32 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "DynamicModelLoaderRegistry.hpp"
 
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+#include "BoostFilesystem.hpp"
+#include "ChasteSyscalls.hpp"
+#include "Exception.hpp"
+#include "Warnings.hpp"
+
+/**
+ * Remove a (temporary) file, ignoring any error.
+ *
+ * @param rPath  the file to remove
+ */
+static void RemoveIgnoringErrors(const std::string& rPath)
+{
+    try
+    {
+        fs::remove(rPath);
+    }
+    catch (const std::exception&)
+    {
+    }
+}
 
 DynamicModelLoaderRegistry* DynamicModelLoaderRegistry::Instance()
 {
@@ -78,6 +104,130 @@ void DynamicModelLoaderRegistry::ScheduleForDeletion(DynamicCellModelLoaderPtr p
     mDeletableLoaders.insert(pLoader);
 }
 
+void DynamicModelLoaderRegistry::SetBuildCacheDirectory(const FileFinder& rDirectory)
+{
+    if (!rDirectory.IsDir())
+    {
+        EXCEPTION("Build cache directory '" + rDirectory.GetAbsolutePath() + "' does not exist.");
+    }
+    mBuildCacheDirectory = rDirectory.GetAbsolutePath();
+}
+
+void DynamicModelLoaderRegistry::DisableBuildCache()
+{
+    mBuildCacheDirectory = "";
+}
+
+bool DynamicModelLoaderRegistry::IsBuildCacheEnabled() const
+{
+    return !mBuildCacheDirectory.empty();
+}
+
+FileFinder DynamicModelLoaderRegistry::FindCachedLibrary(const std::string& rKey) const
+{
+    FileFinder library;
+    if (IsBuildCacheEnabled())
+    {
+        FileFinder cached(mBuildCacheDirectory + rKey, RelativeTo::Absolute);
+        if (cached.IsFile())
+        {
+            library = cached;
+        }
+    }
+    return library;
+}
+
+void DynamicModelLoaderRegistry::AddToBuildCache(const std::string& rKey, const FileFinder& rLibrary)
+{
+    if (!IsBuildCacheEnabled() || FindCachedLibrary(rKey).IsPathSet())
+    {
+        return;
+    }
+    try
+    {
+        std::string temp_path = CopyToTemporaryFile(rLibrary.GetAbsolutePath(), mBuildCacheDirectory + rKey);
+        // Atomic, so other processes either see no library or the whole of it
+        try
+        {
+            fs::rename(temp_path, mBuildCacheDirectory + rKey);
+        }
+        catch (const std::exception&)
+        {
+            RemoveIgnoringErrors(temp_path);
+            throw;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        WARNING("Unable to add '" << rLibrary.GetAbsolutePath() << "' to the build cache: " << e.what());
+    }
+}
+
+std::string DynamicModelLoaderRegistry::CopyToTemporaryFile(const std::string& rLibrary, const std::string& rDestination)
+{
+    std::string name_template = rDestination + ".tmp.XXXXXX";
+    std::vector<char> name(name_template.begin(), name_template.end());
+    name.push_back('\0');
+    int fd = mkstemp(&name[0]);
+    if (fd == -1)
+    {
+        throw std::runtime_error("unable to create a temporary file for '" + rDestination + "'");
+    }
+    close(fd);
+    const std::string temp_path(&name[0]);
+
+    // The file already exists, so copy the contents rather than using fs::copy_file
+    {
+        std::ifstream source(rLibrary.c_str(), std::ios::binary);
+        std::ofstream copy(temp_path.c_str(), std::ios::binary | std::ios::trunc);
+        copy << source.rdbuf();
+        copy.close();
+        if (!source || !copy)
+        {
+            RemoveIgnoringErrors(temp_path);
+            throw std::runtime_error("unable to copy '" + rLibrary + "' to '" + temp_path + "'");
+        }
+    }
+    // mkstemp makes the file private to its owner
+    chmod(temp_path.c_str(), CHASTE_READ_WRITE_EXECUTE);
+    return temp_path;
+}
+
+std::string DynamicModelLoaderRegistry::GetBuildCacheKey(const std::vector<FileFinder>& rSources,
+                                                         const std::string& rSettings)
+{
+    // A 64-bit FNV-1a hash of the settings, then the name and contents of each source
+    uint64_t hash = 14695981039346656037ull;
+    std::string name_and_settings = rSettings;
+    for (std::vector<FileFinder>::const_iterator it = rSources.begin(); it != rSources.end(); ++it)
+    {
+        name_and_settings += "|" + it->GetLeafName();
+    }
+    for (std::string::const_iterator it = name_and_settings.begin(); it != name_and_settings.end(); ++it)
+    {
+        hash = (hash ^ static_cast<unsigned char>(*it)) * 1099511628211ull;
+    }
+    for (std::vector<FileFinder>::const_iterator it = rSources.begin(); it != rSources.end(); ++it)
+    {
+        std::ifstream file(it->GetAbsolutePath().c_str(), std::ios::binary);
+        if (!file.is_open())
+        {
+            EXCEPTION("Unable to read '" + it->GetAbsolutePath() + "' to compute its build cache key.");
+        }
+        char buffer[4096];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        {
+            for (std::streamsize i=0; i<file.gcount(); i++)
+            {
+                hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+            }
+        }
+    }
+    std::stringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
 DynamicModelLoaderRegistry::DynamicModelLoaderRegistry()
 {
 }
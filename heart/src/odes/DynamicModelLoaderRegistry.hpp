@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <map>
 #include <set>
+#include <vector>
 #include <boost/utility.hpp>
 #include <boost/weak_ptr.hpp>
 #include "DynamicCellModelLoader.hpp"
@@ -78,6 +79,67 @@ public:
      */
     void ScheduleForDeletion(DynamicCellModelLoaderPtr pLoader);
 
+    /**
+     * Keep a persistent cache of shared libraries built from CellML in the given directory,
+     * which must exist.  CellMLToSharedLibraryConverter consults this cache before running
+     * the code generator and compiler.  Many processes (e.g. the jobs of a parameter sweep)
+     * may safely share a cache directory.
+     *
+     * @param rDirectory  where to keep cached libraries
+     */
+    void SetBuildCacheDirectory(const FileFinder& rDirectory);
+
+    /**
+     * Stop using the build cache.
+     */
+    void DisableBuildCache();
+
+    /**
+     * @return whether the build cache is in use.
+     */
+    bool IsBuildCacheEnabled() const;
+
+    /**
+     * @return the cached library built from the given sources, or a finder with no path set
+     * if there isn't one (or the cache is disabled).
+     *
+     * @param rKey  build cache key, from GetBuildCacheKey()
+     */
+    FileFinder FindCachedLibrary(const std::string& rKey) const;
+
+    /**
+     * Store a copy of the given library in the build cache, if it isn't already there.
+     * The copy is written under a temporary name then renamed, so concurrent readers never
+     * see a partial library.  Failing to store the library just gives a warning.
+     *
+     * @param rKey  build cache key, from GetBuildCacheKey()
+     * @param rLibrary  the library to store
+     */
+    void AddToBuildCache(const std::string& rKey, const FileFinder& rLibrary);
+
+    /**
+     * @return the build cache key for the given sources and build settings.  The key is a
+     * hash of the names and contents of the source files, and the given settings.
+     *
+     * @param rSources  the files used to build a library (model and options files)
+     * @param rSettings  a description of everything else affecting the build, e.g. the
+     *     Chaste version, compiler and flags
+     */
+    static std::string GetBuildCacheKey(const std::vector<FileFinder>& rSources,
+                                        const std::string& rSettings);
+
+    /**
+     * Copy a library to a new file next to the given destination, ready to be renamed into
+     * place.  The file's name is chosen and the file created atomically (by mkstemp), so
+     * processes on different hosts sharing a directory never write to the same temporary
+     * file.  On failure the temporary file is removed and an exception thrown.
+     *
+     * @param rLibrary  absolute path of the library to copy
+     * @param rDestination  absolute path the copy will be renamed to
+     * @return the absolute path of the copy
+     */
+    static std::string CopyToTemporaryFile(const std::string& rLibrary, const std::string& rDestination);
+
 private:
     /**
      * Loaders for shared-library cell models.
@@ -90,6 +152,9 @@ private:
     /** Loaders to be deleted before creating any new ones. */
     std::set<DynamicCellModelLoaderPtr> mDeletableLoaders;
 
+    /** The build cache directory (with trailing slash), or empty if the cache is disabled. */
+    std::string mBuildCacheDirectory;
+
     /** The single instance of this class. */
     static std::shared_ptr<DynamicModelLoaderRegistry> mpInstance;
 
@@ -261,23 +261,7 @@ void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteApdMapFile(double repola
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteUpstrokeTimeMap(double threshold)
 {
-    std::vector<std::vector<double> > output_data;
-    //Fill in data
-    for (unsigned node_index = mLo; node_index < mHi; node_index++)
-    {
-        std::vector<double> upstroke_times;
-        try
-        {
-            upstroke_times = mpCalculator->CalculateUpstrokeTimes(node_index, threshold);
-            assert(upstroke_times.size() != 0);
-        }
-        catch(Exception&)
-        {
-            upstroke_times.push_back(0);
-            assert(upstroke_times.size() == 1);
-        }
-        output_data.push_back(upstroke_times);
-    }
+    std::vector<std::vector<double> > output_data = mpCalculator->CalculateUpstrokeTimesForNodeRange(mLo, mHi, threshold);
 
     WriteOutputDataToHdf5(output_data,
                           "UpstrokeTimeMap" + ConvertToHdf5FriendlyString(threshold),
@@ -287,23 +271,7 @@ void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteUpstrokeTimeMap(double t
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WriteMaxUpstrokeVelocityMap(double threshold)
 {
-    std::vector<std::vector<double> > output_data;
-    //Fill in data
-    for (unsigned node_index = mLo; node_index < mHi; node_index++)
-    {
-        std::vector<double> upstroke_velocities;
-        try
-        {
-            upstroke_velocities = mpCalculator->CalculateAllMaximumUpstrokeVelocities(node_index, threshold);
-            assert(upstroke_velocities.size() != 0);
-        }
-        catch(Exception&)
-        {
-            upstroke_velocities.push_back(0);
-            assert(upstroke_velocities.size() ==1);
-        }
-        output_data.push_back(upstroke_velocities);
-    }
+    std::vector<std::vector<double> > output_data = mpCalculator->CalculateAllMaximumUpstrokeVelocitiesForNodeRange(mLo, mHi, threshold);
 
     WriteOutputDataToHdf5(output_data,
                           "MaxUpstrokeVelocityMap" + ConvertToHdf5FriendlyString(threshold),
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UblasIncludes.hpp"
 #include "PropagationPropertiesCalculator.hpp"
 #include "CellProperties.hpp"
+#include "Hdf5NodeBlockReader.hpp"
 #include "Exception.hpp"
 #include <sstream>
 #include "HeartEventHandler.hpp"
@@ -102,53 +103,86 @@ std::vector<std::vector<double> > PropagationPropertiesCalculator::CalculateAllA
         double threshold)
 {
     std::vector<std::vector<double> > output_data;
-    output_data.reserve(upperNodeIndex-lowerNodeIndex+1);
-    unsigned num_nodes_per_data_block = 100; // number of nodes
-    unsigned num_complete_blocks = (upperNodeIndex-lowerNodeIndex) / num_nodes_per_data_block;
-    unsigned size_last_block = (upperNodeIndex-lowerNodeIndex) % num_nodes_per_data_block;
-
-    for (unsigned block_num=0;
-         block_num<num_complete_blocks+1;
-         block_num++)
+    output_data.reserve(upperNodeIndex-lowerNodeIndex);
+
+    Hdf5NodeBlockReader blocks(*mpDataReader, mVoltageName, lowerNodeIndex, upperNodeIndex);
+    while (blocks.NextBlock())
     {
-        unsigned num_nodes_to_read;
-        if (block_num != num_complete_blocks)
+        for (unsigned node_index=blocks.GetBlockLowerIndex(); node_index<blocks.GetBlockUpperIndex(); node_index++)
         {
-            num_nodes_to_read = num_nodes_per_data_block;
+            CellProperties cell_props(blocks.rGetTimeSeries(node_index), mTimes, threshold);
+            std::vector<double> apds;
+            try
+            {
+                apds = cell_props.GetAllActionPotentialDurations(percentage);
+                assert(apds.size() != 0);
+            }
+            catch (Exception& e)
+            {
+                assert(e.GetShortMessage()=="No full action potential was recorded" ||
+                       e.GetShortMessage()=="AP did not occur, never exceeded threshold voltage.");
+                apds.push_back(0);
+                assert(apds.size() == 1);
+            }
+            output_data.push_back(apds);
         }
-        else
+    }
+    return output_data;
+}
+
+std::vector<std::vector<double> > PropagationPropertiesCalculator::CalculateUpstrokeTimesForNodeRange(unsigned lowerNodeIndex,
+                                                                                                     unsigned upperNodeIndex,
+                                                                                                     double threshold)
+{
+    std::vector<std::vector<double> > output_data;
+    output_data.reserve(upperNodeIndex-lowerNodeIndex);
+
+    Hdf5NodeBlockReader blocks(*mpDataReader, mVoltageName, lowerNodeIndex, upperNodeIndex);
+    while (blocks.NextBlock())
+    {
+        for (unsigned node_index=blocks.GetBlockLowerIndex(); node_index<blocks.GetBlockUpperIndex(); node_index++)
         {
-            num_nodes_to_read = size_last_block;
+            std::vector<double> upstroke_times;
+            try
+            {
+                CellProperties cell_props(blocks.rGetTimeSeries(node_index), mTimes, threshold);
+                upstroke_times = cell_props.GetTimesAtMaxUpstrokeVelocity();
+                assert(upstroke_times.size() != 0);
+            }
+            catch (Exception&)
+            {
+                upstroke_times.push_back(0);
+            }
+            output_data.push_back(upstroke_times);
         }
+    }
+    return output_data;
+}
 
-        if (num_nodes_to_read > 0)
+std::vector<std::vector<double> > PropagationPropertiesCalculator::CalculateAllMaximumUpstrokeVelocitiesForNodeRange(unsigned lowerNodeIndex,
+                                                                                                                    unsigned upperNodeIndex,
+                                                                                                                    double threshold)
+{
+    std::vector<std::vector<double> > output_data;
+    output_data.reserve(upperNodeIndex-lowerNodeIndex);
+
+    Hdf5NodeBlockReader blocks(*mpDataReader, mVoltageName, lowerNodeIndex, upperNodeIndex);
+    while (blocks.NextBlock())
+    {
+        for (unsigned node_index=blocks.GetBlockLowerIndex(); node_index<blocks.GetBlockUpperIndex(); node_index++)
         {
-            // Read a big block of data
-            unsigned low_node = lowerNodeIndex + block_num*num_nodes_per_data_block;
-            unsigned high_node = low_node + num_nodes_to_read;
-            std::vector<std::vector<double> > voltages = mpDataReader->GetVariableOverTimeOverMultipleNodes(mVoltageName, low_node, high_node);
-
-            for (unsigned node_within_block=0;
-                 node_within_block < num_nodes_to_read;
-                 node_within_block++)
+            std::vector<double> upstroke_velocities;
+            try
+            {
+                CellProperties cell_props(blocks.rGetTimeSeries(node_index), mTimes, threshold);
+                upstroke_velocities = cell_props.GetMaxUpstrokeVelocities();
+                assert(upstroke_velocities.size() != 0);
+            }
+            catch (Exception&)
             {
-                std::vector<double>& r_voltages = voltages[node_within_block];
-                CellProperties cell_props(r_voltages, mTimes, threshold);
-                std::vector<double> apds;
-                try
-                {
-                    apds = cell_props.GetAllActionPotentialDurations(percentage);
-                    assert(apds.size() != 0);
-                }
-                catch (Exception& e)
-                {
-                    assert(e.GetShortMessage()=="No full action potential was recorded" ||
-                           e.GetShortMessage()=="AP did not occur, never exceeded threshold voltage.");
-                    apds.push_back(0);
-                    assert(apds.size() == 1);
-                }
-                output_data.push_back(apds);
+                upstroke_velocities.push_back(0);
             }
+            output_data.push_back(upstroke_velocities);
         }
     }
     return output_data;
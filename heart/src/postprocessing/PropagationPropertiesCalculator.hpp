@@ -187,6 +187,31 @@ public:
                                                                                        unsigned upperNodeIndex,
                                                                                        double threshold);
 
+    /**
+     * @return the times of upstroke at cells [lowerNodeIndex, upperNodeIndex-1], or {0}
+     * for cells where no upstroke was found.  The data are streamed through in blocks,
+     * which is much faster than calling CalculateUpstrokeTimes() for each node.
+     *
+     * @param lowerNodeIndex  First cell at which to calculate.
+     * @param upperNodeIndex  One past the last cell at which to calculate.
+     * @param threshold  The voltage threshold (we count this as the start of an AP)
+     */
+    std::vector<std::vector<double> > CalculateUpstrokeTimesForNodeRange(unsigned lowerNodeIndex,
+                                                                         unsigned upperNodeIndex,
+                                                                         double threshold);
+
+    /**
+     * @return all the maximum upstroke velocities at cells [lowerNodeIndex, upperNodeIndex-1],
+     * or {0} for cells where no upstroke was found.  The data are streamed through in blocks.
+     *
+     * @param lowerNodeIndex  First cell at which to calculate.
+     * @param upperNodeIndex  One past the last cell at which to calculate.
+     * @param threshold  The voltage threshold (we use this for marking the end of an AP)
+     */
+    std::vector<std::vector<double> > CalculateAllMaximumUpstrokeVelocitiesForNodeRange(unsigned lowerNodeIndex,
+                                                                                        unsigned upperNodeIndex,
+                                                                                        double threshold);
+
      /**
       * @return all the depolarisations that occur above threshold at a single cell.
       *
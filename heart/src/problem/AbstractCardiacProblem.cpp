@@ -66,6 +66,9 @@ AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::AbstractCardiacProble
       mpTimeAdaptivityController(NULL),
       mpWriter(NULL),
       mUseHdf5DataWriterCache(false),
+      mUseHdf5AsyncWrites(false),
+      mHdf5DataWriterCompression(Hdf5DataWriter::NO_COMPRESSION),
+      mHdf5DataWriterCompressionLevel(1u),
       mHdf5DataWriterChunkSizeAndAlignment(0)
 {
     assert(mNodesToOutput.empty());
@@ -96,6 +99,9 @@ AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::AbstractCardiacProble
       mpTimeAdaptivityController(NULL),
       mpWriter(NULL),
       mUseHdf5DataWriterCache(false),
+      mUseHdf5AsyncWrites(false),
+      mHdf5DataWriterCompression(Hdf5DataWriter::NO_COMPRESSION),
+      mHdf5DataWriterCompressionLevel(1u),
       mHdf5DataWriterChunkSizeAndAlignment(0)
 {
 }
@@ -857,10 +863,21 @@ bool AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::InitialiseWriter
         mpWriter->SetTargetChunkSize(mHdf5DataWriterChunkSizeAndAlignment);
         mpWriter->SetAlignment(mHdf5DataWriterChunkSizeAndAlignment);
     }
+    if (!extend_file && mHdf5DataWriterCompression != Hdf5DataWriter::NO_COMPRESSION)
+    {
+        mpWriter->SetCompression(mHdf5DataWriterCompression, mHdf5DataWriterCompressionLevel);
+    }
 
     // Define columns, or get the variable IDs from the writer
     DefineWriterColumns(extend_file);
 
+    for (std::map<std::string, double>::const_iterator it = mHdf5DataWriterErrorBounds.begin();
+         it != mHdf5DataWriterErrorBounds.end();
+         ++it)
+    {
+        mpWriter->SetVariableErrorBound(mpWriter->GetVariableByName(it->first), it->second);
+    }
+
     //Possibility of applying a permutation
     if (HeartConfig::Instance()->GetOutputUsingOriginalNodeOrdering())
     {
@@ -877,6 +894,11 @@ bool AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::InitialiseWriter
         mpWriter->EndDefineMode();
     }
 
+    if (mUseHdf5AsyncWrites)
+    {
+        mpWriter->SetUseAsyncWrites();
+    }
+
     return extend_file;
 }
 
@@ -886,6 +908,25 @@ void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetUseHdf5DataWr
     mUseHdf5DataWriterCache = useCache;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetUseHdf5AsyncWrites(bool useAsync)
+{
+    mUseHdf5AsyncWrites = useAsync;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetHdf5DataWriterCompression(Hdf5DataWriter::CompressionType type, unsigned level)
+{
+    mHdf5DataWriterCompression = type;
+    mHdf5DataWriterCompressionLevel = level;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetHdf5DataWriterErrorBound(const std::string& rVariableName, double absoluteErrorBound)
+{
+    mHdf5DataWriterErrorBounds[rVariableName] = absoluteErrorBound;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
 void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::SetHdf5DataWriterTargetChunkSizeAndAlignment(hsize_t size)
 {
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ABSTRACTCARDIACPROBLEM_HPP_
 #define ABSTRACTCARDIACPROBLEM_HPP_
 
+#include <map>
 #include <string>
 #include <vector>
 #include <cassert>
@@ -476,6 +477,27 @@ protected:
      */
     bool mUseHdf5DataWriterCache;
 
+    /**
+     * Whether to instruct the writer to write asynchronously.  Not saved in checkpoints.
+     */
+    bool mUseHdf5AsyncWrites;
+
+    /**
+     * Compression filter for the Hdf5DataWriter to use.  Not saved in checkpoints.
+     */
+    Hdf5DataWriter::CompressionType mHdf5DataWriterCompression;
+
+    /**
+     * Compression level for the Hdf5DataWriter to use.  Not saved in checkpoints.
+     */
+    unsigned mHdf5DataWriterCompressionLevel;
+
+    /**
+     * Absolute error bounds for variables the Hdf5DataWriter should store lossily,
+     * keyed by variable name.  Not saved in checkpoints.
+     */
+    std::map<std::string, double> mHdf5DataWriterErrorBounds;
+
     /**
      * Size to pass to Hdf5DataWriter for chunk size and alignment.
      */
@@ -679,6 +701,32 @@ public:
      */
     void SetUseHdf5DataWriterCache(bool useCache=true);
 
+    /**
+     * Set whether the Hdf5DataWriter should write asynchronously, so that output
+     * steps don't wait for the filesystem (see Hdf5DataWriter::SetUseAsyncWrites).
+     * @param useAsync Whether to write asynchronously
+     */
+    void SetUseHdf5AsyncWrites(bool useAsync=true);
+
+    /**
+     * Set the compression filter the Hdf5DataWriter applies to the results dataset
+     * (see Hdf5DataWriter::SetCompression).  Ignored when extending an existing file.
+     *
+     * @param type  the filter
+     * @param level  the compression level
+     */
+    void SetHdf5DataWriterCompression(Hdf5DataWriter::CompressionType type, unsigned level=1u);
+
+    /**
+     * Store an output variable lossily, to within an absolute error bound (see
+     * Hdf5DataWriter::SetVariableErrorBound).  This is most useful for "V" and "Phi_e"
+     * together with SetHdf5DataWriterCompression.
+     *
+     * @param rVariableName  the name of the variable in the results file
+     * @param absoluteErrorBound  the largest error allowed
+     */
+    void SetHdf5DataWriterErrorBound(const std::string& rVariableName, double absoluteErrorBound);
+
     /**
      * Set Hdf5DataWriter target chunk size and alignment parameters.
      *
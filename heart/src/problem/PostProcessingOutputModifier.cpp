@@ -0,0 +1,318 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "PostProcessingOutputModifier.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+
+#include "Exception.hpp" // for DOUBLE_UNSET
+#include "HeartConfig.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+
+void PostProcessingOutputModifier::AddApdMap(double percentage)
+{
+    if (percentage < 0.0 || percentage > 100.0)
+    {
+        EXCEPTION("The APD percentage " << percentage << " should be between 0 and 100.");
+    }
+    mApdPercentages.push_back(percentage);
+}
+
+void PostProcessingOutputModifier::AddConductionVelocityMap(unsigned originNode, const std::vector<double>& rDistancesFromOriginNode)
+{
+    mConductionVelocityOrigins.push_back(originNode);
+    mConductionVelocityDistances.push_back(rDistancesFromOriginNode);
+}
+
+void PostProcessingOutputModifier::InitialiseAtStart(DistributedVectorFactory* pVectorFactory)
+{
+    unsigned num_nodes = pVectorFactory->GetProblemSize();
+    for (unsigned i=0; i<mConductionVelocityOrigins.size(); i++)
+    {
+        if (mConductionVelocityOrigins[i] >= num_nodes || mConductionVelocityDistances[i].size() != num_nodes)
+        {
+            EXCEPTION("Conduction velocity map " << i << " does not match the mesh: it has origin node "
+                      << mConductionVelocityOrigins[i] << " and " << mConductionVelocityDistances[i].size()
+                      << " distances, but there are " << num_nodes << " nodes.");
+        }
+    }
+
+    mLo = pVectorFactory->GetLow();
+    unsigned local_size = pVectorFactory->GetLocalOwnership();
+
+    NodeState initial_state;
+    initial_state.mPreviousV = DOUBLE_UNSET;
+    initial_state.mPreviousTime = DOUBLE_UNSET;
+    initial_state.mAboveThreshold = false;
+    initial_state.mFoundAFlatBit = false;
+    initial_state.mMinimumVelocity = DBL_MAX;
+    initial_state.mRestingValue = DBL_MAX;
+    initial_state.mApRestingValue = DBL_MAX;
+    initial_state.mMaxUpstrokeVelocity = -DBL_MAX;
+    initial_state.mTimeOfMaxUpstrokeVelocity = 0.0;
+    initial_state.mPeak = -DBL_MAX;
+    initial_state.mOnsetTime = DOUBLE_UNSET;
+    mNodeStates.assign(local_size, initial_state);
+
+    mApdsInProgress.assign(local_size*mApdPercentages.size(), false);
+    mUpstrokeTimes.assign(local_size, std::vector<double>());
+    mMaxUpstrokeVelocities.assign(local_size, std::vector<double>());
+    mApds.assign(mApdPercentages.size(), std::vector<std::vector<double> >(local_size));
+}
+
+void PostProcessingOutputModifier::ProcessSolutionAtTimeStep(double time, Vec solution, unsigned problemDim)
+{
+    const double resting_potential_gradient_threshold = 1e-2; // As in CellProperties
+    const unsigned num_apds = mApdPercentages.size();
+
+    double* p_solution;
+    VecGetArray(solution, &p_solution);
+    for (unsigned local_index=0; local_index<mNodeStates.size(); local_index++)
+    {
+        NodeState& r_state = mNodeStates[local_index];
+        double v = p_solution[local_index*problemDim];
+
+        if (r_state.mPreviousTime != DOUBLE_UNSET)
+        {
+            double prev_v = r_state.mPreviousV;
+            double prev_t = r_state.mPreviousTime;
+            double voltage_derivative = (time == prev_t) ? 0.0 : (v - prev_v) / (time - prev_t);
+
+            // Look for the max upstroke velocity and when it happens (could be below or above threshold).
+            if (voltage_derivative >= r_state.mMaxUpstrokeVelocity)
+            {
+                r_state.mMaxUpstrokeVelocity = voltage_derivative;
+                r_state.mTimeOfMaxUpstrokeVelocity = time;
+            }
+
+            if (!r_state.mAboveThreshold)
+            {
+                // Find the resting value where the voltage is flattest
+                if (fabs(voltage_derivative) <= r_state.mMinimumVelocity && fabs(voltage_derivative) <= resting_potential_gradient_threshold)
+                {
+                    r_state.mMinimumVelocity = fabs(voltage_derivative);
+                    r_state.mRestingValue = prev_v;
+                    r_state.mFoundAFlatBit = true;
+                }
+                else if (prev_v < r_state.mRestingValue && !r_state.mFoundAFlatBit)
+                {
+                    r_state.mRestingValue = prev_v;
+                }
+
+                // If we cross the threshold, this counts as an AP
+                if (v > mThreshold && prev_v <= mThreshold)
+                {
+                    r_state.mApRestingValue = r_state.mRestingValue;
+                    r_state.mMinimumVelocity = DBL_MAX;
+                    r_state.mRestingValue = DBL_MAX;
+                    r_state.mFoundAFlatBit = false;
+                    r_state.mAboveThreshold = true;
+                    r_state.mPeak = -DBL_MAX;
+                    r_state.mOnsetTime = prev_t + (time - prev_t) / (v - prev_v) * (mThreshold - prev_v);
+
+                    // An APD which hasn't finished by the next AP is not measured
+                    for (unsigned p=0; p<num_apds; p++)
+                    {
+                        mApdsInProgress[local_index*num_apds + p] = true;
+                    }
+                }
+            }
+
+            if (r_state.mAboveThreshold)
+            {
+                r_state.mPeak = std::max(r_state.mPeak, v);
+
+                // If we cross the threshold again, the AP is over
+                if (v < mThreshold && prev_v >= mThreshold)
+                {
+                    mMaxUpstrokeVelocities[local_index].push_back(r_state.mMaxUpstrokeVelocity);
+                    mUpstrokeTimes[local_index].push_back(r_state.mTimeOfMaxUpstrokeVelocity);
+                    r_state.mMaxUpstrokeVelocity = -DBL_MAX;
+                    r_state.mTimeOfMaxUpstrokeVelocity = 0.0;
+                    r_state.mAboveThreshold = false;
+                }
+            }
+
+            // Look for repolarisation past the target of each APD in progress, found from the peak so far
+            for (unsigned p=0; p<num_apds; p++)
+            {
+                if (mApdsInProgress[local_index*num_apds + p])
+                {
+                    double target = r_state.mApRestingValue + 0.01*(100.0 - mApdPercentages[p])*(r_state.mPeak - r_state.mApRestingValue);
+                    if (v < target && prev_v >= target)
+                    {
+                        double end_time = prev_t + ((target - prev_v) / (v - prev_v)) * (time - prev_t);
+                        mApds[p][local_index].push_back(end_time - r_state.mOnsetTime);
+                        mApdsInProgress[local_index*num_apds + p] = false;
+                    }
+                }
+            }
+        }
+
+        r_state.mPreviousV = v;
+        r_state.mPreviousTime = time;
+    }
+    VecRestoreArray(solution, &p_solution);
+}
+
+std::vector<std::vector<double> > PostProcessingOutputModifier::GetUpstrokeResults(const std::vector<std::vector<double> >& rResults,
+                                                                                   bool maxUpstrokeVelocity) const
+{
+    std::vector<std::vector<double> > results(rResults);
+    for (unsigned local_index=0; local_index<mNodeStates.size(); local_index++)
+    {
+        if (mNodeStates[local_index].mAboveThreshold)
+        {
+            results[local_index].push_back(maxUpstrokeVelocity ? mNodeStates[local_index].mMaxUpstrokeVelocity
+                                                               : mNodeStates[local_index].mTimeOfMaxUpstrokeVelocity);
+        }
+    }
+    return results;
+}
+
+void PostProcessingOutputModifier::FinaliseAtEnd()
+{
+    std::vector<std::vector<double> > upstroke_times = GetUpstrokeResults(mUpstrokeTimes, false);
+    WriteMap("_UpstrokeTimeMap.txt", upstroke_times);
+    WriteMap("_MaxUpstrokeVelocityMap.txt", GetUpstrokeResults(mMaxUpstrokeVelocities, true));
+
+    for (unsigned p=0; p<mApdPercentages.size(); p++)
+    {
+        std::stringstream suffix;
+        suffix << "_Apd_" << mApdPercentages[p] << "_Map.txt";
+        WriteMap(suffix.str(), mApds[p]);
+    }
+
+    for (unsigned i=0; i<mConductionVelocityOrigins.size(); i++)
+    {
+        // Share the upstroke times at the origin
+        unsigned origin = mConductionVelocityOrigins[i];
+        bool origin_is_local = (origin >= mLo && origin < mLo + mNodeStates.size());
+        unsigned local_num_aps = origin_is_local ? upstroke_times[origin - mLo].size() : 0u;
+        unsigned num_aps = 0u;
+        MPI_Allreduce(&local_num_aps, &num_aps, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+
+        std::vector<double> origin_times(num_aps);
+        if (num_aps > 0u)
+        {
+            std::vector<double> local_origin_times(num_aps, 0.0);
+            if (origin_is_local)
+            {
+                local_origin_times = upstroke_times[origin - mLo];
+            }
+            MPI_Allreduce(&local_origin_times[0], &origin_times[0], num_aps, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+        }
+
+        // As PropagationPropertiesCalculator::CalculateAllConductionVelocities
+        std::vector<std::vector<double> > velocities(mNodeStates.size());
+        for (unsigned local_index=0; local_index<mNodeStates.size(); local_index++)
+        {
+            unsigned global_index = mLo + local_index;
+            const std::vector<double>& r_times = upstroke_times[local_index];
+            unsigned num_common_aps = std::min(num_aps, (unsigned)r_times.size());
+            for (unsigned ap=0; ap<num_common_aps; ap++)
+            {
+                if (global_index == origin || fabs(r_times[ap] - origin_times[ap]) < 1e-8)
+                {
+                    velocities[local_index].push_back(0.0);
+                }
+                else
+                {
+                    velocities[local_index].push_back(mConductionVelocityDistances[i][global_index] / (r_times[ap] - origin_times[ap]));
+                }
+            }
+        }
+
+        std::stringstream suffix;
+        suffix << "_ConductionVelocityFromNode" << origin << ".txt";
+        WriteMap(suffix.str(), velocities);
+    }
+}
+
+void PostProcessingOutputModifier::WriteMap(const std::string& rSuffix, const std::vector<std::vector<double> >& rData) const
+{
+    // Pad to the maximum number of paces, as PostProcessingWriter does
+    unsigned local_max_paces = 1u;
+    for (unsigned local_index=0; local_index<rData.size(); local_index++)
+    {
+        local_max_paces = std::max(local_max_paces, (unsigned)rData[local_index].size());
+    }
+    unsigned max_paces = 0u;
+    MPI_Allreduce(&local_max_paces, &max_paces, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+
+    OutputFileHandler output_handler(HeartConfig::Instance()->GetOutputDirectory(), false);
+    PetscTools::BeginRoundRobin();
+    {
+        out_stream file_stream = out_stream(NULL);
+        // Open the file as new or append
+        if (PetscTools::AmMaster())
+        {
+            file_stream = output_handler.OpenOutputFile(mFilename + rSuffix);
+        }
+        else
+        {
+            file_stream = output_handler.OpenOutputFile(mFilename + rSuffix, std::ios::app);
+        }
+        for (unsigned local_index=0; local_index<rData.size(); local_index++)
+        {
+            for (unsigned pace=0; pace<max_paces; pace++)
+            {
+                if (pace > 0u)
+                {
+                    (*file_stream) << ",\t";
+                }
+                if (pace < rData[local_index].size())
+                {
+                    (*file_stream) << rData[local_index][pace];
+                }
+                else
+                {
+                    // A node with no results gets a single 0
+                    (*file_stream) << (rData[local_index].empty() && pace == 0u ? 0.0 : -999.0);
+                }
+            }
+            (*file_stream) << "\n";
+        }
+        file_stream->close();
+    }
+    PetscTools::EndRoundRobin();
+}
+
+#include "SerializationExportWrapperForCpp.hpp"
+CHASTE_CLASS_EXPORT(PostProcessingOutputModifier)
@@ -0,0 +1,224 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef POSTPROCESSINGOUTPUTMODIFIER_HPP_
+#define POSTPROCESSINGOUTPUTMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "AbstractOutputModifier.hpp"
+
+/**
+ * Calculates the upstroke time, maximum upstroke velocity, action potential duration and
+ * conduction velocity maps of PostProcessingWriter on the fly, so that they don't need a
+ * second pass over the voltage history in the HDF5 file.
+ *
+ * Each process keeps a state machine for each of its nodes, updated at every printing
+ * time step (i.e. on the same data that PostProcessingWriter would read back).  The
+ * upstroke times and velocities are calculated exactly as CellProperties does.
+ *
+ * Action potential durations are measured without keeping any samples: each runs from the
+ * (interpolated) time the voltage crosses the threshold to the first time it then falls below
+ * the repolarisation target, interpolated between the last sample and the current one.  The
+ * target is found from the resting potential before the action potential and the highest
+ * voltage so far.  CellProperties measures from where the upstroke crosses the target instead,
+ * so the APDs differ from its by the time the upstroke takes between the target and the
+ * threshold.  An APD that hasn't finished by the start of the next action potential is not
+ * measured.
+ *
+ * Each map is written to a file named after the modifier's file name, in the output
+ * directory, with one row per node (in solution order).  Just as in the HDF5 maps made by
+ * PostProcessingWriter, a node with no result gets a single 0, and rows are padded to the
+ * same length with -999.
+ *
+ * WARNING:  If you checkpoint this class then the partial results will not be stored (only
+ * the requested maps are), just as for ActivationOutputModifier.
+ */
+class PostProcessingOutputModifier : public AbstractOutputModifier
+{
+private:
+    /** For testing */
+    friend class TestPostProcessingOutputModifier;
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * The state of the calculation at one node.  Mirrors the local variables of
+     * CellProperties::CalculateProperties.
+     */
+    struct NodeState
+    {
+        double mPreviousV;                  /**< The voltage at the last time step */
+        double mPreviousTime;               /**< The last time step */
+        bool mAboveThreshold;               /**< Whether we are in an action potential */
+        bool mFoundAFlatBit;                /**< Whether a flat bit has been found since the last onset */
+        double mMinimumVelocity;            /**< The flattest gradient since the last onset */
+        double mRestingValue;               /**< The resting potential since the last onset */
+        double mApRestingValue;             /**< The resting potential before the current action potential */
+        double mMaxUpstrokeVelocity;        /**< The largest gradient since the last action potential */
+        double mTimeOfMaxUpstrokeVelocity;  /**< When #mMaxUpstrokeVelocity happened */
+        double mPeak;                       /**< The highest voltage of the latest action potential so far */
+        double mOnsetTime;                  /**< When the latest action potential crossed the threshold */
+    };
+
+    /** The transmembrane voltage threshold defining an action potential. */
+    double mThreshold;
+
+    /** The repolarisation percentages of the APD maps to make. */
+    std::vector<double> mApdPercentages;
+
+    /** The origin node of each conduction velocity map to make. */
+    std::vector<unsigned> mConductionVelocityOrigins;
+
+    /** For each conduction velocity map, the distance of each node from its origin. */
+    std::vector<std::vector<double> > mConductionVelocityDistances;
+
+    /** The global index of the first node on this process (set in #InitialiseAtStart). */
+    unsigned mLo;
+
+    /** The state of each local node. */
+    std::vector<NodeState> mNodeStates;
+
+    /** For each local node and APD percentage, whether the APD of the latest action potential is still to be found. */
+    std::vector<bool> mApdsInProgress;
+
+    /** The times of maximum upstroke velocity of the finished action potentials at each local node. */
+    std::vector<std::vector<double> > mUpstrokeTimes;
+
+    /** The maximum upstroke velocities of the finished action potentials at each local node. */
+    std::vector<std::vector<double> > mMaxUpstrokeVelocities;
+
+    /** For each APD percentage, the action potential durations at each local node. */
+    std::vector<std::vector<std::vector<double> > > mApds;
+
+    /**
+     * Archive the output modifier, never used directly - boost uses this.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        // This calls serialize on the base class.
+        archive & boost::serialization::base_object<AbstractOutputModifier>(*this);
+        archive & mThreshold;
+        archive & mApdPercentages;
+        archive & mConductionVelocityOrigins;
+        archive & mConductionVelocityDistances;
+        // Other private data are re-initialised in a process-specific manner
+    }
+
+    /** Private constructor that does nothing, for archiving */
+    PostProcessingOutputModifier()
+        : mThreshold(0.0),
+          mLo(0u)
+    {}
+
+    /**
+     * @return the upstroke results at each local node, with those of a final, unfinished
+     * action potential added (as CellProperties does).
+     *
+     * @param rResults  the results of finished action potentials
+     * @param maxUpstrokeVelocity  whether these are max upstroke velocities (else their times)
+     */
+    std::vector<std::vector<double> > GetUpstrokeResults(const std::vector<std::vector<double> >& rResults,
+                                                         bool maxUpstrokeVelocity) const;
+
+    /**
+     * Write a map to file (collective).  Nodes with no results are written as 0.
+     *
+     * @param rSuffix  appended to the modifier's file name
+     * @param rData  the results at each local node
+     */
+    void WriteMap(const std::string& rSuffix, const std::vector<std::vector<double> >& rData) const;
+
+public:
+    /**
+     * Constructor.  Upstroke time and maximum upstroke velocity maps are always made; use
+     * AddApdMap and AddConductionVelocityMap for the others.
+     *
+     * @param rFilename  The stem of the files produced by this modifier
+     * @param threshold  The transmembrane voltage threshold (in mV) an action potential must cross
+     */
+    PostProcessingOutputModifier(const std::string& rFilename, double threshold)
+        : AbstractOutputModifier(rFilename),
+          mThreshold(threshold),
+          mLo(0u)
+    {
+    }
+
+    /**
+     * Also make a map of action potential durations.
+     *
+     * @param percentage  the repolarisation percentage, e.g. 90 for APD90
+     */
+    void AddApdMap(double percentage);
+
+    /**
+     * Also make a map of conduction velocities from a node.
+     *
+     * @param originNode  the global index of the node to measure from
+     * @param rDistancesFromOriginNode  the distance of every node from the origin (see DistanceMapCalculator)
+     */
+    void AddConductionVelocityMap(unsigned originNode, const std::vector<double>& rDistancesFromOriginNode);
+
+    /**
+     * Initialise the modifier (make space for the local state) when the solve loop is starting.
+     *
+     * @param pVectorFactory  The vector factory which is associated with the calling problem's mesh
+     */
+    virtual void InitialiseAtStart(DistributedVectorFactory* pVectorFactory);
+
+    /**
+     * Finalise the modifier (write all the maps to file)
+     */
+    virtual void FinaliseAtEnd();
+
+    /**
+     * Process a solution time-step (update the state of every local node)
+     * @param time  The current simulation time
+     * @param solution  A working copy of the solution at the current time-step.  This is the PETSc vector which is distributed across the processes.
+     * @param problemDim  The calling problem dimension. Used here to avoid probing the size of the solution vector
+     */
+    virtual void ProcessSolutionAtTimeStep(double time, Vec solution, unsigned problemDim);
+};
+
+#include "SerializationExportWrapper.hpp"
+CHASTE_CLASS_EXPORT(PostProcessingOutputModifier)
+
+#endif /* POSTPROCESSINGOUTPUTMODIFIER_HPP_ */
@@ -35,6 +35,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCardiacTissue.hpp"
 
+#include <typeinfo>
 #include <boost/scoped_array.hpp>
 
 #include "DistributedVector.hpp"
@@ -44,6 +45,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChastePoint.hpp"
 #include "AbstractChasteRegion.hpp"
 #include "HeartEventHandler.hpp"
+#include "OpenMpTools.hpp"
 #include "PetscTools.hpp"
 #include "PetscVecTools.hpp"
 #include "AbstractCvodeCell.hpp"
@@ -59,7 +61,10 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
       mHasPurkinje(false),
       mDoCacheReplication(true),
       mMeshUnarchived(false),
-      mExchangeHalos(exchangeHalos)
+      mExchangeHalos(exchangeHalos),
+      mUseBatchedCellSolve(false),
+      mLocalCellBatchesUpToDate(false),
+      mUseThreadedCellSolve(false)
 {
     //This constructor is called from the Initialise() method of the CardiacProblem class
     assert(pCellFactory != NULL);
@@ -184,7 +189,10 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(AbstractTetr
       mHasPurkinje(false),
       mDoCacheReplication(true),
       mMeshUnarchived(true),
-      mExchangeHalos(false)
+      mExchangeHalos(false),
+      mUseBatchedCellSolve(false),
+      mLocalCellBatchesUpToDate(false),
+      mUseThreadedCellSolve(false)
 {
     mIionicCacheReplicated.Resize(mpDistributedVectorFactory->GetProblemSize());
     mIntracellularStimulusCacheReplicated.Resize(mpDistributedVectorFactory->GetProblemSize());
@@ -361,6 +369,40 @@ bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetDoCacheReplication()
     return mDoCacheReplication;
 }
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUseBatchedCellSolve(bool useBatchedCellSolve)
+{
+    mUseBatchedCellSolve = useBatchedCellSolve;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetUseBatchedCellSolve() const
+{
+    return mUseBatchedCellSolve;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+const std::vector<std::vector<unsigned> >& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetLocalCellBatches()
+{
+    if (!mLocalCellBatchesUpToDate)
+    {
+        CalculateLocalCellBatches();
+    }
+    return mLocalCellBatches;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUseThreadedCellSolve(bool useThreadedCellSolve)
+{
+    mUseThreadedCellSolve = useThreadedCellSolve;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetUseThreadedCellSolve() const
+{
+    return mUseThreadedCellSolve;
+}
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 const c_matrix<double, SPACE_DIM, SPACE_DIM>& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIntracellularConductivityTensor(unsigned elementIndex)
 {
@@ -460,6 +502,248 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpHaloCells(AbstractCardia
 }
 
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystem(unsigned globalIndex, unsigned localIndex, double& rVoltage,
+                                                                   double time, double nextTime, bool updateVoltage)
+{
+    const double voltage_before_update = rVoltage;
+    mCellsDistributed[localIndex]->SetVoltage(voltage_before_update);
+
+    // Added a try-catch here to provide more output to screen when an error occurs.
+    /// \todo This may want to go to std::cerr ??
+    try
+    {
+        if (!updateVoltage)
+        {
+            // solve ODE system at this node.
+            // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
+#ifndef CHASTE_CVODE
+            mCellsDistributed[localIndex]->ComputeExceptVoltage(time, nextTime);
+#else
+            // If CVODE is enabled, and this is a CVODE cell
+            // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
+            try
+            {
+                mCellsDistributed[localIndex]->ComputeExceptVoltage(time, nextTime);
+            }
+            catch (Exception &e)
+            {
+                // Try an 'emergency' reset if this is a CVODE cell.
+                // See #2594 for why we think this may be necessary.
+                if (dynamic_cast<AbstractCvodeCell*>(mCellsDistributed[localIndex]))
+                {
+                    // Reset the CVODE cell, this leads to a call to CVodeReInit.
+                    static_cast<AbstractCvodeCell*>(mCellsDistributed[localIndex])->ResetSolver();
+                    mCellsDistributed[localIndex]->ComputeExceptVoltage(time, nextTime);
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueDiagnostics)
+#endif // CHASTE_OPENMP
+                    WARNING("Global node " << globalIndex << " had an ODE solving problem in t = [" << time <<
+                            ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
+                            " step should be reduced, or CVODE tolerances relaxed.");
+                }
+                else
+                {
+                    throw e;
+                }
+            }
+#endif // CHASTE_CVODE
+        }
+        else
+        {
+            // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
+            mCellsDistributed[localIndex]->SolveAndUpdateState(time, nextTime);
+            rVoltage = mCellsDistributed[localIndex]->GetVoltage();
+        }
+    }
+    catch (Exception &e)
+    {
+        // Several threads may be reporting failures at once
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueDiagnostics)
+#endif // CHASTE_OPENMP
+        {
+            std::cout << std::setprecision(16);
+            std::cout << "Global node " << globalIndex << " had problems with ODE solve between "
+                    "t = " << time << " and " << nextTime << "ms.\n";
+
+            std::cout << "Voltage at this node before solve was " << voltage_before_update << "mV\n"
+                    "(this SHOULD NOT necessarily be the same as the one in the state variables,\n"
+                    "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
+
+            std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
+                << mCellsDistributed[localIndex]->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
+                << mCellsDistributed[localIndex]->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
+
+            std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(mCellsDistributed[localIndex])->GetSystemName() << "\n";
+
+            std::cout << "All state variables are now:\n";
+            std::vector<double> state_vars = mCellsDistributed[localIndex]->GetStdVecStateVariables();
+            std::vector<std::string> state_var_names = mCellsDistributed[localIndex]->rGetStateVariableNames();
+            for (unsigned i=0; i<state_vars.size(); i++)
+            {
+                std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
+            }
+            std::cout << std::flush;
+        }
+
+        throw e;
+    }
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystemsThreaded(DistributedVector::Stripe& rVoltage,
+                                                                            double time, double nextTime, bool updateVoltage)
+{
+    const unsigned num_local_cells = mCellsDistributed.size();
+    const unsigned low = mpDistributedVectorFactory->GetLow();
+
+    // The order in which nodes are handed out to threads
+    std::vector<unsigned> solve_order;
+    if (mUseBatchedCellSolve)
+    {
+        const std::vector<std::vector<unsigned> >& r_batches = rGetLocalCellBatches();
+        solve_order.reserve(num_local_cells);
+        for (unsigned batch=0; batch<r_batches.size(); batch++)
+        {
+            solve_order.insert(solve_order.end(), r_batches[batch].begin(), r_batches[batch].end());
+        }
+    }
+
+    // Exceptions can't propagate out of a parallel region, so each thread keeps its first failure
+    const unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+    if (mThreadOdeSolvers.size() < num_threads)
+    {
+        mThreadOdeSolvers.resize(num_threads);
+    }
+    std::vector<boost::shared_ptr<Exception> > thread_exceptions(num_threads);
+    std::vector<unsigned> thread_failed_nodes(num_threads, UNSIGNED_UNSET);
+    bool any_failed = false;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif // CHASTE_OPENMP
+    for (unsigned i=0; i<num_local_cells; i++)
+    {
+        bool stop;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+        stop = any_failed;
+        if (stop)
+        {
+            continue;
+        }
+
+        const unsigned local_index = mUseBatchedCellSolve ? solve_order[i] : i;
+        const unsigned global_index = low + local_index;
+        const unsigned thread = OpenMpTools::GetThreadNum();
+
+        // Threads other than the master lend the cell their own copy of its solver for this solve
+        AbstractCardiacCellInterface* p_cell = mCellsDistributed[local_index];
+        boost::shared_ptr<AbstractIvpOdeSolver> p_cell_solver;
+        bool swap_solver = false;
+        if (thread != 0)
+        {
+            p_cell_solver = p_cell->GetSolver();
+            boost::shared_ptr<AbstractIvpOdeSolver> p_thread_solver = GetOdeSolverForThread(p_cell_solver, thread);
+            if (p_thread_solver != p_cell_solver)
+            {
+                p_cell->SetSolver(p_thread_solver);
+                swap_solver = true;
+            }
+        }
+
+        try
+        {
+            SolveCellSystem(global_index, local_index, rVoltage[global_index], time, nextTime, updateVoltage);
+
+            // update the Iionic and stimulus caches
+            UpdateCaches(global_index, local_index, nextTime);
+        }
+        catch (Exception& e)
+        {
+            if (global_index < thread_failed_nodes[thread])
+            {
+                thread_failed_nodes[thread] = global_index;
+                thread_exceptions[thread].reset(new Exception(e));
+            }
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+            any_failed = true;
+        }
+
+        if (swap_solver)
+        {
+            p_cell->SetSolver(p_cell_solver);
+        }
+    }
+
+    if (any_failed)
+    {
+        unsigned failed_thread = 0;
+        for (unsigned thread=1; thread<num_threads; thread++)
+        {
+            if (thread_failed_nodes[thread] < thread_failed_nodes[failed_thread])
+            {
+                failed_thread = thread;
+            }
+        }
+        throw *(thread_exceptions[failed_thread]);
+    }
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetOdeSolverForThread(
+        const boost::shared_ptr<AbstractIvpOdeSolver>& rpCellSolver, unsigned thread)
+{
+    if (!rpCellSolver)
+    {
+        return rpCellSolver;
+    }
+
+    // Only this thread touches its own map, so no locking is needed
+    assert(thread < mThreadOdeSolvers.size());
+    typedef std::pair<boost::shared_ptr<AbstractIvpOdeSolver>, boost::shared_ptr<AbstractIvpOdeSolver> > SolverAndCopy;
+    std::map<AbstractIvpOdeSolver*, SolverAndCopy>& r_solvers = mThreadOdeSolvers[thread];
+    typename std::map<AbstractIvpOdeSolver*, SolverAndCopy>::iterator it = r_solvers.find(rpCellSolver.get());
+    if (it == r_solvers.end())
+    {
+        SolverAndCopy solver_and_copy(rpCellSolver, rpCellSolver->CreateCopyForThread());
+        it = r_solvers.insert(std::make_pair(rpCellSolver.get(), solver_and_copy)).first;
+    }
+    return it->second.second ? it->second.second : rpCellSolver;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::CalculateLocalCellBatches()
+{
+    mLocalCellBatches.clear();
+
+    // Maps a model type to its position in mLocalCellBatches, so batches come out in order of first appearance
+    std::map<std::string, unsigned> batch_for_type;
+    for (unsigned local_index=0; local_index<mCellsDistributed.size(); local_index++)
+    {
+        const std::string type_name = typeid(*(mCellsDistributed[local_index])).name();
+        std::map<std::string, unsigned>::iterator it = batch_for_type.find(type_name);
+        if (it == batch_for_type.end())
+        {
+            it = batch_for_type.insert(std::make_pair(type_name, (unsigned) mLocalCellBatches.size())).first;
+            mLocalCellBatches.push_back(std::vector<unsigned>());
+        }
+        mLocalCellBatches[it->second].push_back(local_index);
+    }
+    mLocalCellBatchesUpToDate = true;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::InvalidateLocalCellBatches()
+{
+    mLocalCellBatches.clear();
+    mLocalCellBatchesUpToDate = false;
+}
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existingSolution, double time, double nextTime, bool updateVoltage)
 {
@@ -483,87 +767,41 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existing
     DistributedVector::Stripe voltage(dist_solution, 0);
     try
     {
-        double voltage_before_update;
-        for (DistributedVector::Iterator index = dist_solution.Begin();
-             index != dist_solution.End();
-             ++index)
+        if (mUseThreadedCellSolve)
         {
-            voltage_before_update = voltage[index];
-            mCellsDistributed[index.Local]->SetVoltage( voltage_before_update );
-
-            // Added a try-catch here to provide more output to screen when an error occurs.
-            /// \todo This may want to go to std::cerr ??
-            try
+            SolveCellSystemsThreaded(voltage, time, nextTime, updateVoltage);
+        }
+        else if (mUseBatchedCellSolve)
+        {
+            const std::vector<std::vector<unsigned> >& r_batches = rGetLocalCellBatches();
+            const unsigned low = mpDistributedVectorFactory->GetLow();
+            for (std::vector<std::vector<unsigned> >::const_iterator batch_it = r_batches.begin();
+                 batch_it != r_batches.end();
+                 ++batch_it)
             {
-                if (!updateVoltage)
-                {
-                    // solve ODE system at this node.
-                    // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
-#ifndef CHASTE_CVODE
-                    mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-#else
-                    // If CVODE is enabled, and this is a CVODE cell
-                    // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
-                    try
-                    {
-                        mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-                    }
-                    catch (Exception &e)
-                    {
-                        // Try an 'emergency' reset if this is a CVODE cell.
-                        // See #2594 for why we think this may be necessary.
-                        if (dynamic_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local]))
-                        {
-                            // Reset the CVODE cell, this leads to a call to CVodeReInit.
-                            static_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local])->ResetSolver();
-                            mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-                            WARNING("Global node " << index.Global << " had an ODE solving problem in t = [" << time <<
-                                    ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
-                                    " step should be reduced, or CVODE tolerances relaxed.");
-                        }
-                        else
-                        {
-                            throw e;
-                        }
-                    }
-#endif // CHASTE_CVODE
-                }
-                else
+                for (std::vector<unsigned>::const_iterator local_it = batch_it->begin();
+                     local_it != batch_it->end();
+                     ++local_it)
                 {
-                    // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
-                    mCellsDistributed[index.Local]->SolveAndUpdateState(time, nextTime);
-                    voltage[index] = mCellsDistributed[index.Local]->GetVoltage();
+                    const unsigned global_index = low + *local_it;
+                    SolveCellSystem(global_index, *local_it, voltage[global_index], time, nextTime, updateVoltage);
+
+                    // update the Iionic and stimulus caches
+                    UpdateCaches(global_index, *local_it, nextTime);
                 }
             }
-            catch (Exception &e)
+        }
+        else
+        {
+            for (DistributedVector::Iterator index = dist_solution.Begin();
+                 index != dist_solution.End();
+                 ++index)
             {
-                std::cout << std::setprecision(16);
-                std::cout << "Global node " << index.Global << " had problems with ODE solve between "
-                        "t = " << time << " and " << nextTime << "ms.\n";
-
-                std::cout << "Voltage at this node before solve was " << voltage_before_update << "mV\n"
-                        "(this SHOULD NOT necessarily be the same as the one in the state variables,\n"
-                        "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
-
-                std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
+                SolveCellSystem(index.Global, index.Local, voltage[index], time, nextTime, updateVoltage);
 
-                std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(mCellsDistributed[index.Local])->GetSystemName() << "\n";
-
-                std::cout << "All state variables are now:\n";
-                std::vector<double> state_vars = mCellsDistributed[index.Local]->GetStdVecStateVariables();
-                std::vector<std::string> state_var_names = mCellsDistributed[index.Local]->rGetStateVariableNames();
-                for (unsigned i=0; i<state_vars.size(); i++)
-                {
-                    std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
-                }
-                std::cout << std::flush;
-
-                throw e;
+                // update the Iionic and stimulus caches
+                UpdateCaches(index.Global, index.Local, nextTime);
             }
-            // update the Iionic and stimulus caches
-            UpdateCaches(index.Global, index.Local, nextTime);
         }
 
         if (updateVoltage)
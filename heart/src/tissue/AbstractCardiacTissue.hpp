@@ -35,6 +35,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ABSTRACTCARDIACTISSUE_HPP_
 #define ABSTRACTCARDIACTISSUE_HPP_
 
+#include <map>
 #include <set>
 #include <vector>
 #include <boost/shared_ptr.hpp>
@@ -55,6 +56,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCardiacCellFactory.hpp"
 #include "AbstractConductivityTensors.hpp"
 #include "AbstractPurkinjeCellFactory.hpp"
+#include "DistributedVector.hpp"
 #include "ReplicatableVector.hpp"
 #include "HeartConfig.hpp"
 #include "ArchiveLocationInfo.hpp"
@@ -313,6 +315,39 @@ protected:
      */
     bool mExchangeHalos;
 
+    /**
+     * Whether to integrate the local cell models in batches of cells sharing the
+     * same concrete model type, rather than in plain node order.
+     * See SetUseBatchedCellSolve().  Defaults to false; not archived.
+     */
+    bool mUseBatchedCellSolve;
+
+    /**
+     * Local indices into #mCellsDistributed, grouped by concrete cell model type.
+     * Within each batch the indices are in increasing order.  Calculated lazily
+     * by CalculateLocalCellBatches(), and recalculated after any local cell has
+     * been replaced (see InvalidateLocalCellBatches()).
+     */
+    std::vector<std::vector<unsigned> > mLocalCellBatches;
+
+    /** Whether #mLocalCellBatches matches the current local cells. */
+    bool mLocalCellBatchesUpToDate;
+
+    /**
+     * Whether to integrate the local cell models on a pool of threads.
+     * See SetUseThreadedCellSolve().  Defaults to false; not archived.
+     */
+    bool mUseThreadedCellSolve;
+
+    /**
+     * For each thread other than the master thread, copies of the ODE solvers used by the
+     * local cells, keyed by the solver copied.  The value also holds the original solver so
+     * that its address cannot be reused while the copy exists.  Created as needed by
+     * GetOdeSolverForThread(); not archived.
+     */
+    std::vector<std::map<AbstractIvpOdeSolver*, std::pair<boost::shared_ptr<AbstractIvpOdeSolver>,
+                                                          boost::shared_ptr<AbstractIvpOdeSolver> > > > mThreadOdeSolvers;
+
     /** Vector of halo node indices for current process */
     std::vector<unsigned> mHaloNodes;
 
@@ -350,6 +385,60 @@ protected:
      */
     void SetUpHaloCells(AbstractCardiacCellFactory<ELEMENT_DIM,SPACE_DIM>* pCellFactory);
 
+    /**
+     * Fill in #mLocalCellBatches by grouping the local cells by their concrete
+     * (most derived) model type.  Batches are ordered by first appearance.
+     */
+    void CalculateLocalCellBatches();
+
+    /**
+     * Mark #mLocalCellBatches as out of date, so that they are recalculated before
+     * the next batched solve.  Subclasses which replace any of #mCellsDistributed
+     * must call this.
+     */
+    void InvalidateLocalCellBatches();
+
+    /**
+     * Integrate the cell model at a single locally-owned node, printing diagnostic
+     * information to std::cout if the ODE solve throws.
+     *
+     * @param globalIndex  global index of the node
+     * @param localIndex  local index of the node (i.e. into #mCellsDistributed)
+     * @param rVoltage  the transmembrane potential at this node; overwritten with the
+     *     new value of the cell's voltage if updateVoltage is true
+     * @param time  the current time
+     * @param nextTime  the time to integrate to
+     * @param updateVoltage  whether to also update the voltage
+     */
+    void SolveCellSystem(unsigned globalIndex, unsigned localIndex, double& rVoltage,
+                         double time, double nextTime, bool updateVoltage);
+
+    /**
+     * Integrate all the local cell models and update the caches, sharing the nodes
+     * dynamically between threads.  Used by SolveCellSystems() when #mUseThreadedCellSolve
+     * is set.  If any ODE solve fails, the exception from the lowest-numbered failing node
+     * seen is rethrown once all threads have finished.
+     *
+     * @param rVoltage  the voltage stripe of the current solution
+     * @param time  the current time
+     * @param nextTime  the time to integrate to
+     * @param updateVoltage  whether to also update the voltage
+     */
+    void SolveCellSystemsThreaded(DistributedVector::Stripe& rVoltage, double time, double nextTime, bool updateVoltage);
+
+    /**
+     * Get the ODE solver that a thread other than the master thread should use for a cell,
+     * so that no solver (with its working memory and stopping-event state) is used by two
+     * threads at once.  A copy of the cell's own solver is made the first time it is needed.
+     *
+     * @param rpCellSolver  the cell's own ODE solver
+     * @param thread  the calling thread's number (not 0)
+     * @return the thread's copy of the solver, or the cell's own solver if it is empty or
+     *     cannot be copied (see AbstractIvpOdeSolver::CreateCopyForThread())
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> GetOdeSolverForThread(const boost::shared_ptr<AbstractIvpOdeSolver>& rpCellSolver,
+                                                                  unsigned thread);
+
 public:
     /**
      * This constructor is called from the Initialise() method of the CardiacProblem class.
@@ -391,6 +480,57 @@ public:
      */
     bool GetDoCacheReplication();
 
+    /**
+     * Set whether SolveCellSystems() should integrate the local cells in batches of the
+     * same model type.  This only changes the order in which the local cells are visited:
+     * each cell is still integrated through its own ComputeExceptVoltage() call on its own
+     * state vector, so there is no vectorisation across cells.  A homogeneous tissue forms
+     * a single batch and is solved exactly as without batching; a speed-up can only be
+     * expected where different models are finely interleaved across the local nodes.
+     * Results are identical to the unbatched solve.
+     *
+     * @param useBatchedCellSolve  whether to solve the cells batched by model type
+     */
+    void SetUseBatchedCellSolve(bool useBatchedCellSolve);
+
+    /**
+     * @return whether the local cells are solved in batches of the same model type.
+     */
+    bool GetUseBatchedCellSolve() const;
+
+    /**
+     * @return the local cell indices grouped into batches of the same concrete model type,
+     * as used by SolveCellSystems() when batching is switched on.  The batches are
+     * recalculated first if any local cell has changed type since they were last calculated.
+     */
+    const std::vector<std::vector<unsigned> >& rGetLocalCellBatches();
+
+    /**
+     * Set whether SolveCellSystems() should share the local cell solves between threads
+     * (when Chaste is compiled with OpenMP; see OpenMpTools).  Nodes are handed out to
+     * threads dynamically, since the cost of a cell solve can vary a lot between nodes.
+     * This can be combined with SetUseBatchedCellSolve().  Results are identical to the
+     * single-threaded solve.
+     *
+     * Each thread other than the master thread solves its cells with its own copy of the
+     * cells' ODE solver (see AbstractIvpOdeSolver::CreateCopyForThread()).  All Chaste
+     * one-step solvers can be copied; a cell whose solver cannot must integrate itself
+     * (as Rush-Larsen, backward Euler and CVODE cells do) or have a solver that is safe
+     * to call concurrently.
+     *
+     * The threads share this process's replicated caches (#mIionicCacheReplicated and
+     * #mIntracellularStimulusCacheReplicated) and halo data, so running fewer processes
+     * with more threads each reduces how many copies of them are held.
+     *
+     * @param useThreadedCellSolve  whether to solve the cells on multiple threads
+     */
+    void SetUseThreadedCellSolve(bool useThreadedCellSolve);
+
+    /**
+     * @return whether the local cells are solved on multiple threads.
+     */
+    bool GetUseThreadedCellSolve() const;
+
     /** @return the intracellular conductivity tensor for the given element
      * @param elementIndex  index of the element of interest
      */
@@ -572,6 +712,8 @@ public:
         archive & p_factory;
         unsigned num_cells;
         archive & num_cells;
+        // Loaded cells may be of different types to any current ones
+        InvalidateLocalCellBatches();
         if (mCellsDistributed.empty())
         {
             mCellsDistributed.resize(p_mesh_factory->GetLocalOwnership());
@@ -367,6 +367,59 @@ public:
 #endif
     }
 
+    void TestBuildCache()
+    {
+        DynamicModelLoaderRegistry* p_registry = DynamicModelLoaderRegistry::Instance();
+        TS_ASSERT(!p_registry->IsBuildCacheEnabled());
+        FileFinder missing_dir("TestBuildCache/no_such_dir", RelativeTo::ChasteTestOutput);
+        TS_ASSERT_THROWS_CONTAINS(p_registry->SetBuildCacheDirectory(missing_dir), "does not exist.");
+
+        std::string dirname = "TestBuildCache";
+        OutputFileHandler handler(dirname);
+        OutputFileHandler cache_handler(dirname + "/cache");
+        OutputFileHandler handler1(dirname + "/first");
+        OutputFileHandler handler2(dirname + "/second");
+        OutputFileHandler handler3(dirname + "/third");
+        FileFinder cache_dir = cache_handler.FindFile("");
+        p_registry->SetBuildCacheDirectory(cache_dir);
+        TS_ASSERT(p_registry->IsBuildCacheEnabled());
+
+        // The key depends on file names and contents, not location
+        FileFinder cellml_file_src("heart/dynamic/luo_rudy_1991_dyn.cellml", RelativeTo::ChasteSourceRoot);
+        FileFinder cellml_file1 = handler1.CopyFileTo(cellml_file_src);
+        FileFinder cellml_file2 = handler2.CopyFileTo(cellml_file_src);
+        std::string key1 = DynamicModelLoaderRegistry::GetBuildCacheKey(std::vector<FileFinder>(1, cellml_file1), "settings");
+        TS_ASSERT_EQUALS(key1.length(), 16u);
+        TS_ASSERT_EQUALS(DynamicModelLoaderRegistry::GetBuildCacheKey(std::vector<FileFinder>(1, cellml_file2), "settings"), key1);
+        TS_ASSERT_DIFFERS(DynamicModelLoaderRegistry::GetBuildCacheKey(std::vector<FileFinder>(1, cellml_file1), "other"), key1);
+        TS_ASSERT(!p_registry->FindCachedLibrary(key1).IsPathSet());
+
+        // The first conversion populates the cache
+        CellMLToSharedLibraryConverter converter;
+        DynamicCellModelLoaderPtr p_loader = converter.Convert(cellml_file1);
+        RunLr91Test(*p_loader, 0u);
+        PetscTools::Barrier("TestBuildCache");
+        TS_ASSERT_EQUALS(cache_dir.FindMatches("*").size(), 1u);
+
+        // A second copy of the model comes straight from the cache, so doesn't need a Chaste build tree
+        FileFinder::FakePath(RelativeTo::ChasteBuildRoot, "/tmp/not-a-chaste-source-tree");
+        p_loader = converter.Convert(cellml_file2);
+        TS_ASSERT(handler2.FindFile("libluo_rudy_1991_dyn." + CellMLToSharedLibraryConverter::msSoSuffix).Exists());
+        TS_ASSERT(handler2.FindMatches("*.tmp.*").empty());
+        RunLr91Test(*p_loader, 0u);
+
+        // But different conversion options mean a different build
+        FileFinder cellml_file3 = handler3.CopyFileTo(cellml_file_src);
+        std::vector<std::string> args(1, "--opt");
+        converter.CreateOptionsFile(handler3, "luo_rudy_1991_dyn", args);
+        TS_ASSERT_THROWS_CONTAINS(converter.Convert(cellml_file3), "No Chaste build tree found");
+        FileFinder::StopFaking();
+
+        p_registry->DisableBuildCache();
+        TS_ASSERT(!p_registry->IsBuildCacheEnabled());
+        TS_ASSERT(!p_registry->FindCachedLibrary(key1).IsPathSet());
+    }
+
     void TestArchiving()
     {
 #ifdef CHASTE_CAN_CHECKPOINT_DLLS
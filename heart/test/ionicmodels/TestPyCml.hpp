@@ -478,6 +478,59 @@ public:
         }
     }
 
+    void TestLookupTableFileCache()
+    {
+        TS_ASSERT_EQUALS(AbstractLookupTableCollection::GetPaddedRowLength(1u), 8u);
+        TS_ASSERT_EQUALS(AbstractLookupTableCollection::GetPaddedRowLength(8u), 8u);
+        TS_ASSERT_EQUALS(AbstractLookupTableCollection::GetPaddedRowLength(19u), 24u);
+
+        TS_ASSERT(!AbstractLookupTableCollection::IsTableFileCacheEnabled());
+        FileFinder missing_dir("TestLookupTableFileCache/no_such_dir", RelativeTo::ChasteTestOutput);
+        TS_ASSERT_THROWS_CONTAINS(AbstractLookupTableCollection::EnableTableFileCache(missing_dir),
+                                  "does not exist.");
+
+        boost::shared_ptr<SimpleStimulus> p_stimulus(new SimpleStimulus(-25.5, 2.0, 50.0));
+        boost::shared_ptr<EulerIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        CellLuoRudy1991FromCellMLOpt opt(p_solver, p_stimulus);
+        AbstractLookupTableCollection* p_tables = opt.GetLookupTableCollection();
+        TS_ASSERT(p_tables);
+        p_tables->SetTableProperties("membrane_voltage", -150.0001, 0.001, 199.9999);
+        p_tables->RegenerateTables();
+        opt.SetVoltage(-40.0);
+        double private_i_ionic = opt.GetIIonic();
+
+        // Generating tables with the cache enabled writes them to files, which are then used
+        OutputFileHandler handler("TestLookupTableFileCache");
+        FileFinder cache_dir = handler.FindFile("");
+        AbstractLookupTableCollection::EnableTableFileCache(cache_dir);
+        TS_ASSERT(AbstractLookupTableCollection::IsTableFileCacheEnabled());
+        p_tables->FreeMemory();
+        p_tables->RegenerateTables();
+        TS_ASSERT_EQUALS(cache_dir.FindMatches("lut_*.bin").size(), 2u);
+        TS_ASSERT_EQUALS(opt.GetIIonic(), private_i_ionic);
+
+        // Regenerating identical tables maps the existing files rather than writing new ones
+        p_tables->FreeMemory();
+        p_tables->RegenerateTables();
+        TS_ASSERT_EQUALS(cache_dir.FindMatches("lut_*.bin").size(), 2u);
+        TS_ASSERT_EQUALS(opt.GetIIonic(), private_i_ionic);
+
+        // Different table properties give a different file
+        p_tables->SetTableProperties("membrane_voltage", -150.0001, 0.01, 199.9999);
+        p_tables->RegenerateTables();
+        TS_ASSERT_EQUALS(cache_dir.FindMatches("lut_*.bin").size(), 3u);
+        TS_ASSERT_DELTA(opt.GetIIonic(), private_i_ionic, 1e-3);
+
+        // The uniquely named temporary files were all renamed into place
+        TS_ASSERT_EQUALS(cache_dir.FindMatches("lut_*.bin.tmp.*").size(), 0u);
+
+        AbstractLookupTableCollection::DisableTableFileCache();
+        TS_ASSERT(!AbstractLookupTableCollection::IsTableFileCacheEnabled());
+        p_tables->SetTableProperties("membrane_voltage", -150.0001, 0.001, 199.9999);
+        p_tables->RegenerateTables();
+        TS_ASSERT_EQUALS(opt.GetIIonic(), private_i_ionic);
+    }
+
     void TestModelWithNoIntracellularCalcium()
     {
         boost::shared_ptr<AbstractStimulusFunction> p_stimulus;
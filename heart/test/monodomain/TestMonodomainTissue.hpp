@@ -43,8 +43,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CardiacSimulationArchiver.hpp"
 
 #include <vector>
+#include <set>
+#include <typeinfo>
 
 #include "SimpleStimulus.hpp"
+#include "ZeroStimulus.hpp"
 #include "EulerIvpOdeSolver.hpp"
 #include "LuoRudy1991.hpp"
 #include "MonodomainTissue.hpp"
@@ -94,6 +97,39 @@ public:
     }
 };
 
+class MixedModelCellFactory : public AbstractCardiacCellFactory<1>
+{
+private:
+    boost::shared_ptr<SimpleStimulus> mpStimulus;
+
+public:
+    MixedModelCellFactory()
+        : AbstractCardiacCellFactory<1>(),
+          mpStimulus(new SimpleStimulus(-80.0, 0.5))
+    {
+    }
+
+    AbstractCardiacCell* CreateCardiacCellForTissueNode(Node<1>* pNode)
+    {
+        unsigned node_index = pNode->GetIndex();
+        boost::shared_ptr<AbstractStimulusFunction> p_stimulus = mpZeroStimulus;
+        if (node_index==0)
+        {
+            p_stimulus = mpStimulus;
+        }
+
+        // Interleave two different cell models so that the batches are non-trivial
+        if (node_index%2 == 0)
+        {
+            return new CellLuoRudy1991FromCellML(mpSolver, p_stimulus);
+        }
+        else
+        {
+            return new CellDiFrancescoNoble1985FromCellML(mpSolver, p_stimulus);
+        }
+    }
+};
+
 class PurkinjeCellFactory : public AbstractPurkinjeCellFactory<2>
 {
 private:
@@ -127,6 +163,26 @@ public:
     }
 };
 
+/**
+ * A monodomain tissue whose local cells can be swapped for new ones, to check that
+ * the batches used by the batched cell solve are kept up to date.
+ */
+class CellReplacingMonodomainTissue : public MonodomainTissue<1>
+{
+public:
+    CellReplacingMonodomainTissue(AbstractCardiacCellFactory<1>* pCellFactory)
+        : MonodomainTissue<1>(pCellFactory)
+    {
+    }
+
+    void ReplaceLocalCell(unsigned localIndex, AbstractCardiacCellInterface* pCell)
+    {
+        delete mCellsDistributed[localIndex];
+        mCellsDistributed[localIndex] = pCell;
+        InvalidateLocalCellBatches();
+    }
+};
+
 class TestMonodomainTissue : public CxxTest::TestSuite
 {
 public:
@@ -322,6 +378,135 @@ public:
         PetscTools::Destroy(voltage2);
     }
 
+    void TestBatchedSolveCellSystems()
+    {
+        HeartConfig::Instance()->Reset();
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.01, 0.1); // 11 nodes
+
+        MixedModelCellFactory cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> unbatched_tissue(&cell_factory);
+        MonodomainTissue<1> batched_tissue(&cell_factory);
+
+        TS_ASSERT_EQUALS(batched_tissue.GetUseBatchedCellSolve(), false);
+        batched_tissue.SetUseBatchedCellSolve(true);
+        TS_ASSERT_EQUALS(batched_tissue.GetUseBatchedCellSolve(), true);
+
+        // Local cells are split by model type, and every local cell appears exactly once
+        const std::vector<std::vector<unsigned> >& r_batches = batched_tissue.rGetLocalCellBatches();
+        unsigned num_local_nodes = mesh.GetDistributedVectorFactory()->GetLocalOwnership();
+        TS_ASSERT_EQUALS(r_batches.size(), std::min(2u, num_local_nodes));
+        std::set<unsigned> cells_seen;
+        for (unsigned batch=0; batch<r_batches.size(); batch++)
+        {
+            for (unsigned i=0; i<r_batches[batch].size(); i++)
+            {
+                unsigned local_index = r_batches[batch][i];
+                TS_ASSERT_EQUALS(typeid(*(batched_tissue.rGetCellsDistributed()[local_index])).name(),
+                                 typeid(*(batched_tissue.rGetCellsDistributed()[r_batches[batch][0]])).name());
+                cells_seen.insert(local_index);
+            }
+        }
+        TS_ASSERT_EQUALS(cells_seen.size(), num_local_nodes);
+
+        // Both with and without updating the voltage, the results must be identical
+        for (unsigned update_voltage=0; update_voltage<2; update_voltage++)
+        {
+            Vec unbatched_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -81.4354);
+            Vec batched_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -81.4354);
+            for (double time=0.0; time<1.0-1e-6; time+=0.5)
+            {
+                unbatched_tissue.SolveCellSystems(unbatched_voltage, time, time+0.5, update_voltage);
+                batched_tissue.SolveCellSystems(batched_voltage, time, time+0.5, update_voltage);
+            }
+
+            ReplicatableVector unbatched_replicated(unbatched_voltage);
+            ReplicatableVector batched_replicated(batched_voltage);
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                TS_ASSERT_EQUALS(batched_tissue.rGetIionicCacheReplicated()[i], unbatched_tissue.rGetIionicCacheReplicated()[i]);
+                TS_ASSERT_EQUALS(batched_tissue.rGetIntracellularStimulusCacheReplicated()[i],
+                                 unbatched_tissue.rGetIntracellularStimulusCacheReplicated()[i]);
+                TS_ASSERT_EQUALS(batched_replicated[i], unbatched_replicated[i]);
+            }
+
+            PetscTools::Destroy(unbatched_voltage);
+            PetscTools::Destroy(batched_voltage);
+        }
+
+        // If the local cells are replaced by cells of a single type, the batches are recalculated
+        CellReplacingMonodomainTissue replacing_tissue(&cell_factory);
+        replacing_tissue.SetUseBatchedCellSolve(true);
+        TS_ASSERT_EQUALS(replacing_tissue.rGetLocalCellBatches().size(), std::min(2u, num_local_nodes));
+
+        boost::shared_ptr<AbstractIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        boost::shared_ptr<ZeroStimulus> p_zero_stimulus(new ZeroStimulus);
+        for (unsigned local_index=0; local_index<num_local_nodes; local_index++)
+        {
+            replacing_tissue.ReplaceLocalCell(local_index, new CellLuoRudy1991FromCellML(p_solver, p_zero_stimulus));
+        }
+        const std::vector<std::vector<unsigned> >& r_new_batches = replacing_tissue.rGetLocalCellBatches();
+        TS_ASSERT_EQUALS(r_new_batches.size(), std::min(1u, num_local_nodes));
+        if (num_local_nodes > 0)
+        {
+            TS_ASSERT_EQUALS(r_new_batches[0].size(), num_local_nodes);
+        }
+
+        // The batched solve uses the new cells
+        Vec replaced_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -81.4354);
+        TS_ASSERT_THROWS_NOTHING(replacing_tissue.SolveCellSystems(replaced_voltage, 0.0, 0.5));
+        PetscTools::Destroy(replaced_voltage);
+    }
+
+    void TestThreadedSolveCellSystems()
+    {
+        HeartConfig::Instance()->Reset();
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.001, 0.1); // 101 nodes
+
+        // All cells share the factory's forward Euler solver
+        MixedModelCellFactory cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> serial_tissue(&cell_factory);
+        MonodomainTissue<1> threaded_tissue(&cell_factory);
+        MonodomainTissue<1> threaded_batched_tissue(&cell_factory);
+
+        TS_ASSERT_EQUALS(threaded_tissue.GetUseThreadedCellSolve(), false);
+        threaded_tissue.SetUseThreadedCellSolve(true);
+        TS_ASSERT_EQUALS(threaded_tissue.GetUseThreadedCellSolve(), true);
+        threaded_batched_tissue.SetUseThreadedCellSolve(true);
+        threaded_batched_tissue.SetUseBatchedCellSolve(true);
+
+        for (unsigned update_voltage=0; update_voltage<2; update_voltage++)
+        {
+            Vec serial_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -81.4354);
+            Vec threaded_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -81.4354);
+            Vec threaded_batched_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -81.4354);
+            for (double time=0.0; time<1.0-1e-6; time+=0.5)
+            {
+                serial_tissue.SolveCellSystems(serial_voltage, time, time+0.5, update_voltage);
+                threaded_tissue.SolveCellSystems(threaded_voltage, time, time+0.5, update_voltage);
+                threaded_batched_tissue.SolveCellSystems(threaded_batched_voltage, time, time+0.5, update_voltage);
+            }
+
+            ReplicatableVector serial_replicated(serial_voltage);
+            ReplicatableVector threaded_replicated(threaded_voltage);
+            ReplicatableVector threaded_batched_replicated(threaded_batched_voltage);
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                TS_ASSERT_EQUALS(threaded_tissue.rGetIionicCacheReplicated()[i], serial_tissue.rGetIionicCacheReplicated()[i]);
+                TS_ASSERT_EQUALS(threaded_batched_tissue.rGetIionicCacheReplicated()[i], serial_tissue.rGetIionicCacheReplicated()[i]);
+                TS_ASSERT_EQUALS(threaded_replicated[i], serial_replicated[i]);
+                TS_ASSERT_EQUALS(threaded_batched_replicated[i], serial_replicated[i]);
+            }
+
+            PetscTools::Destroy(serial_voltage);
+            PetscTools::Destroy(threaded_voltage);
+            PetscTools::Destroy(threaded_batched_voltage);
+        }
+    }
+
     void TestNodeExchange()
     {
         HeartConfig::Instance()->Reset();
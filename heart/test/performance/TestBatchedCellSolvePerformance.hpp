@@ -0,0 +1,152 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTBATCHEDCELLSOLVEPERFORMANCE_HPP_
+#define TESTBATCHEDCELLSOLVEPERFORMANCE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbstractCardiacCellFactory.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "LuoRudy1991.hpp"
+#include "MonodomainTissue.hpp"
+#include "PetscTools.hpp"
+#include "SimpleStimulus.hpp"
+#include "TenTusscher2006Epi.hpp"
+#include "Timer.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * Creates a transmurally layered tissue: TenTusscher2006Epi cells in an epicardial
+ * layer (x > epiBoundary) and LuoRudy1991 cells elsewhere, so that, as in a real
+ * mesh, cells of one type occupy contiguous regions.  With epiBoundary >= 1 the
+ * tissue is homogeneous.
+ */
+class LayeredModelsCellFactory : public AbstractCardiacCellFactory<2>
+{
+private:
+    boost::shared_ptr<SimpleStimulus> mpStimulus;
+    double mEpiBoundary;
+
+public:
+    LayeredModelsCellFactory(double epiBoundary)
+        : AbstractCardiacCellFactory<2>(),
+          mpStimulus(new SimpleStimulus(-80000.0, 1.0)),
+          mEpiBoundary(epiBoundary)
+    {
+    }
+
+    AbstractCardiacCell* CreateCardiacCellForTissueNode(Node<2>* pNode)
+    {
+        boost::shared_ptr<AbstractStimulusFunction> p_stimulus = mpZeroStimulus;
+        if (pNode->rGetLocation()[0] < 1e-6)
+        {
+            p_stimulus = mpStimulus;
+        }
+
+        if (pNode->rGetLocation()[0] > mEpiBoundary)
+        {
+            return new CellTenTusscher2006EpiFromCellML(mpSolver, p_stimulus);
+        }
+        else
+        {
+            return new CellLuoRudy1991FromCellML(mpSolver, p_stimulus);
+        }
+    }
+};
+
+/**
+ * Compares the wall-clock time of AbstractCardiacTissue::SolveCellSystems with and
+ * without batching the cells by model type, on a homogeneous and on a layered tissue.
+ * Batching only reorders the per-cell solves, so little difference is expected.
+ */
+class TestBatchedCellSolvePerformance : public CxxTest::TestSuite
+{
+private:
+
+    double TimeCellSolve(bool useBatchedCellSolve, double epiBoundary,
+                         DistributedTetrahedralMesh<2,2>& rMesh, unsigned numSteps)
+    {
+        LayeredModelsCellFactory cell_factory(epiBoundary);
+        cell_factory.SetMesh(&rMesh);
+        MonodomainTissue<2> tissue(&cell_factory);
+        tissue.SetUseBatchedCellSolve(useBatchedCellSolve);
+
+        Vec voltage = PetscTools::CreateAndSetVec(rMesh.GetNumNodes(), -85.0);
+        const double pde_dt = 0.1;
+
+        Timer::Reset();
+        for (unsigned step=0; step<numSteps; step++)
+        {
+            tissue.SolveCellSystems(voltage, step*pde_dt, (step+1)*pde_dt);
+        }
+        double elapsed = Timer::GetElapsedTime();
+
+        PetscTools::Destroy(voltage);
+        return elapsed;
+    }
+
+public:
+
+    void TestBatchedVersusPerCellSolve()
+    {
+        HeartConfig::Instance()->Reset();
+        HeartConfig::Instance()->SetOdeTimeStep(0.01);
+
+        DistributedTetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.01, 1.0, 1.0); // 10201 nodes
+
+        const unsigned num_steps = 100;
+        const double epi_boundaries[2] = {2.0, 0.7}; // homogeneous, then a 30% epicardial layer
+        const char* tissue_names[2] = {"homogeneous", "layered"};
+        for (unsigned tissue=0; tissue<2; tissue++)
+        {
+            double per_cell_time = TimeCellSolve(false, epi_boundaries[tissue], mesh, num_steps);
+            double batched_time = TimeCellSolve(true, epi_boundaries[tissue], mesh, num_steps);
+
+            if (PetscTools::AmMaster())
+            {
+                std::cout << "Cell solve of " << tissue_names[tissue] << " tissue over " << mesh.GetNumNodes()
+                          << " nodes, " << num_steps << " steps:\n"
+                          << "\tper-cell: " << per_cell_time << "s\n"
+                          << "\tbatched:  " << batched_time << "s\n" << std::flush;
+            }
+        }
+    }
+};
+
+#endif /*TESTBATCHEDCELLSOLVEPERFORMANCE_HPP_*/
@@ -0,0 +1,252 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTPOSTPROCESSINGOUTPUTMODIFIER_HPP_
+#define TESTPOSTPROCESSINGOUTPUTMODIFIER_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <algorithm>
+#include <cmath>
+
+#include "PostProcessingOutputModifier.hpp"
+#include "Hdf5DataReader.hpp"
+#include "DistributedVectorFactory.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "DistanceMapCalculator.hpp"
+#include "OutputFileHandler.hpp"
+#include "HeartConfig.hpp"
+#include "NumericFileComparison.hpp"
+#include "CellProperties.hpp"
+#include "PetscTools.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestPostProcessingOutputModifier : public CxxTest::TestSuite
+{
+private:
+    /**
+     * @return the APDs that PostProcessingOutputModifier should find in a voltage trace: from each
+     * threshold crossing to the next fall below the repolarisation target, which is found from the
+     * resting and peak potentials given by CellProperties.
+     *
+     * @param rVoltages  the voltage trace
+     * @param rTimes  the sample times
+     * @param threshold  the threshold defining an action potential
+     * @param percentage  the repolarisation percentage
+     */
+    std::vector<double> GetApdsFromThresholdCrossings(const std::vector<double>& rVoltages,
+                                                      const std::vector<double>& rTimes,
+                                                      double threshold,
+                                                      double percentage)
+    {
+        std::vector<double> apds;
+        if (*std::max_element(rVoltages.begin(), rVoltages.end()) <= threshold)
+        {
+            return apds;
+        }
+
+        CellProperties cell_properties(rVoltages, rTimes, threshold);
+        std::vector<double> resting_potentials = cell_properties.GetRestingPotentials();
+        std::vector<double> peak_potentials = cell_properties.GetPeakPotentials();
+
+        unsigned num_aps = 0u;
+        bool in_progress = false;
+        double onset = 0.0;
+        double target = 0.0;
+        for (unsigned i=1; i<rTimes.size(); i++)
+        {
+            double prev_v = rVoltages[i-1];
+            double v = rVoltages[i];
+            if (v > threshold && prev_v <= threshold)
+            {
+                onset = rTimes[i-1] + (rTimes[i] - rTimes[i-1]) / (v - prev_v) * (threshold - prev_v);
+                target = resting_potentials[num_aps] + 0.01*(100.0 - percentage)*(peak_potentials[num_aps] - resting_potentials[num_aps]);
+                num_aps++;
+                in_progress = true;
+            }
+            if (in_progress && v < target && prev_v >= target)
+            {
+                double end = rTimes[i-1] + ((target - prev_v) / (v - prev_v)) * (rTimes[i] - rTimes[i-1]);
+                apds.push_back(end - onset);
+                in_progress = false;
+            }
+        }
+        return apds;
+    }
+
+public:
+    void tearDown()
+    {
+        HeartConfig::Reset();
+    }
+
+    void TestMapsMatchPostProcessingWriter()
+    {
+        HeartConfig::Instance()->SetOutputDirectory("TestPostProcessingOutputModifier");
+        OutputFileHandler handler("TestPostProcessingOutputModifier");
+
+        TrianglesMeshReader<1,1> mesh_reader("mesh/test/data/1D_0_to_1_10_elements");
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        DistanceMapCalculator<1,1> dist_calculator(mesh);
+        std::vector<unsigned> origin_node(1, 0u);
+        std::vector<double> distance_map_from_0;
+        dist_calculator.ComputeDistanceMap(origin_node, distance_map_from_0);
+
+        // The same data as TestPostProcessingWriter::TestWriterMethods
+        Hdf5DataReader reader("heart/test/data/PostProcessingWriter", "postprocessingapd", false);
+        std::vector<double> times = reader.GetUnlimitedDimensionValues();
+        DistributedVectorFactory factory(reader.GetNumberOfRows());
+
+        PostProcessingOutputModifier modifier("postprocessing", -30.0);
+        modifier.AddApdMap(60.0);
+        modifier.AddConductionVelocityMap(0u, distance_map_from_0);
+
+        // Replay the solution as a cardiac problem would
+        modifier.InitialiseAtStart(&factory);
+        TS_ASSERT_EQUALS(modifier.mNodeStates.size(), factory.GetLocalOwnership());
+        Vec solution = factory.CreateVec();
+        for (unsigned i=0; i<times.size(); i++)
+        {
+            reader.GetVariableOverNodes(solution, "V", i);
+            modifier.ProcessSolutionAtTimeStep(times[i], solution, 1u);
+        }
+        PetscTools::Destroy(solution);
+        modifier.FinaliseAtEnd();
+
+        // Upstroke times and velocities are calculated exactly as CellProperties does
+        std::string results_dir = handler.GetOutputDirectoryFullPath();
+        NumericFileComparison comp_times(results_dir + "postprocessing_UpstrokeTimeMap.txt",
+                                         "heart/test/data/PostProcessingWriter/good_upstroke_time_postprocessing.dat");
+        TS_ASSERT(comp_times.CompareFiles(1e-12));
+        NumericFileComparison comp_velocities(results_dir + "postprocessing_MaxUpstrokeVelocityMap.txt",
+                                              "heart/test/data/PostProcessingWriter/good_upstroke_velocity_postprocessing.dat");
+        TS_ASSERT(comp_velocities.CompareFiles(1e-12));
+        NumericFileComparison comp_cv(results_dir + "postprocessing_ConductionVelocityFromNode0.txt",
+                                      "heart/test/data/PostProcessingWriter/conduction_velocity_10_nodes_from_node_0.dat");
+        TS_ASSERT(comp_cv.CompareFiles(1e-12));
+
+        // APDs are measured from the threshold crossing, so differ from PostProcessingWriter's by part of the upstroke
+        for (unsigned local_index=0; local_index<factory.GetLocalOwnership(); local_index++)
+        {
+            std::vector<double> voltages = reader.GetVariableOverTime("V", factory.GetLow() + local_index);
+            std::vector<double> expected_apds = GetApdsFromThresholdCrossings(voltages, times, -30.0, 60.0);
+            TS_ASSERT_EQUALS(modifier.mApds[0][local_index].size(), expected_apds.size());
+            for (unsigned pace=0; pace<std::min(expected_apds.size(), modifier.mApds[0][local_index].size()); pace++)
+            {
+                TS_ASSERT_DELTA(modifier.mApds[0][local_index][pace], expected_apds[pace], 1e-9);
+            }
+        }
+    }
+
+    void TestApdsAreMeasuredFromThresholdCrossings()
+    {
+        // Two paces of a simple action potential, with an upstroke spanning many samples when finely sampled
+        for (unsigned spacing=0; spacing<3; spacing++)
+        {
+            double sample_spacing = (spacing == 0) ? 1.0 : ((spacing == 1) ? 0.1 : 0.01);
+            std::vector<double> times;
+            std::vector<double> voltages;
+            for (unsigned i=0; i*sample_spacing<=600.0+1e-9; i++)
+            {
+                double time = i*sample_spacing;
+                double time_in_pace = fmod(time - 10.0, 300.0);
+                double voltage = -85.0;
+                if (time >= 10.0 && time_in_pace < 2.0)
+                {
+                    voltage = -85.0 + 115.0*time_in_pace/2.0;
+                }
+                else if (time >= 10.0 && time_in_pace < 250.0)
+                {
+                    voltage = 30.0 - 40.0*(time_in_pace - 2.0)/248.0 + 3.0*sin(time_in_pace);
+                }
+                else if (time >= 10.0 && time_in_pace < 280.0)
+                {
+                    voltage = -10.0 - 75.0*(time_in_pace - 250.0)/30.0;
+                }
+                times.push_back(time);
+                voltages.push_back(voltage);
+            }
+
+            // One node per process, all with the same trace
+            DistributedVectorFactory factory(PetscTools::GetNumProcs());
+            PostProcessingOutputModifier modifier("postprocessing", -30.0);
+            modifier.AddApdMap(90.0);
+            modifier.AddApdMap(30.0); // Starts above the threshold
+            modifier.InitialiseAtStart(&factory);
+            Vec solution = factory.CreateVec();
+            for (unsigned i=0; i<times.size(); i++)
+            {
+                VecSet(solution, voltages[i]);
+                modifier.ProcessSolutionAtTimeStep(times[i], solution, 1u);
+            }
+            PetscTools::Destroy(solution);
+
+            std::vector<double> apd90s = GetApdsFromThresholdCrossings(voltages, times, -30.0, 90.0);
+            std::vector<double> apd30s = GetApdsFromThresholdCrossings(voltages, times, -30.0, 30.0);
+            TS_ASSERT_EQUALS(apd90s.size(), 2u);
+            TS_ASSERT_EQUALS(apd30s.size(), 2u);
+            TS_ASSERT_EQUALS(modifier.mApds[0][0].size(), 2u);
+            TS_ASSERT_EQUALS(modifier.mApds[1][0].size(), 2u);
+
+            // CellProperties measures from where the upstroke crosses the target, which is within 1ms of the threshold crossing
+            CellProperties cell_properties(voltages, times, -30.0);
+            std::vector<double> cell_properties_apd90s = cell_properties.GetAllActionPotentialDurations(90.0);
+            std::vector<double> cell_properties_apd30s = cell_properties.GetAllActionPotentialDurations(30.0);
+            for (unsigned pace=0; pace<2u; pace++)
+            {
+                TS_ASSERT_DELTA(modifier.mApds[0][0][pace], apd90s[pace], 1e-12);
+                TS_ASSERT_DELTA(modifier.mApds[1][0][pace], apd30s[pace], 1e-12);
+                TS_ASSERT_DELTA(modifier.mApds[0][0][pace], cell_properties_apd90s[pace], 1.0);
+                TS_ASSERT_DELTA(modifier.mApds[1][0][pace], cell_properties_apd30s[pace], 1.0);
+            }
+        }
+    }
+
+    void TestExceptions()
+    {
+        PostProcessingOutputModifier modifier("postprocessing", -30.0);
+        TS_ASSERT_THROWS_THIS(modifier.AddApdMap(110.0), "The APD percentage 110 should be between 0 and 100.");
+
+        modifier.AddConductionVelocityMap(20u, std::vector<double>(11u, 0.0));
+        DistributedVectorFactory factory(11u);
+        TS_ASSERT_THROWS_THIS(modifier.InitialiseAtStart(&factory),
+                              "Conduction velocity map 0 does not match the mesh: it has origin node 20 and 11 distances, but there are 11 nodes.");
+    }
+};
+
+#endif /*TESTPOSTPROCESSINGOUTPUTMODIFIER_HPP_*/
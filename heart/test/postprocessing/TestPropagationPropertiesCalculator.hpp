@@ -249,6 +249,24 @@ public:
         TS_ASSERT_EQUALS(ppc_fs.CalculateAllActionPotentialDurations(90, 6u, -30.0)[0],
                          all_aps_for_node_range[5][0]);
 
+        // The streamed upstroke calculations agree with the single-node versions
+        unsigned num_nodes = mono_fs_reader.GetNumberOfRows();
+        std::vector<std::vector<double> > upstroke_times = ppc_fs.CalculateUpstrokeTimesForNodeRange(0u, num_nodes, -30.0);
+        std::vector<std::vector<double> > upstroke_velocities = ppc_fs.CalculateAllMaximumUpstrokeVelocitiesForNodeRange(0u, num_nodes, -30.0);
+        TS_ASSERT_EQUALS(upstroke_times.size(), num_nodes);
+        TS_ASSERT_EQUALS(upstroke_velocities.size(), num_nodes);
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            std::vector<double> expected_times = ppc_fs.CalculateUpstrokeTimes(node_index, -30.0);
+            std::vector<double> expected_velocities = ppc_fs.CalculateAllMaximumUpstrokeVelocities(node_index, -30.0);
+            TS_ASSERT_EQUALS(upstroke_times[node_index].size(), expected_times.size());
+            TS_ASSERT_EQUALS(upstroke_velocities[node_index].size(), expected_velocities.size());
+            for (unsigned i=0; i<expected_times.size(); i++)
+            {
+                TS_ASSERT_EQUALS(upstroke_times[node_index][i], expected_times[i]);
+                TS_ASSERT_EQUALS(upstroke_velocities[node_index][i], expected_velocities[i]);
+            }
+        }
     }
 
     void TestEadCalculation()
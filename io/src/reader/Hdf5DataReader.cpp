@@ -277,6 +277,16 @@ std::vector<double> Hdf5DataReader::GetVariableOverTime(const std::string& rVari
 std::vector<std::vector<double> > Hdf5DataReader::GetVariableOverTimeOverMultipleNodes(const std::string& rVariableName,
                                                                                        unsigned lowerIndex,
                                                                                        unsigned upperIndex)
+{
+    std::vector<std::vector<double> > ret;
+    GetVariableOverTimeOverMultipleNodes(rVariableName, lowerIndex, upperIndex, ret);
+    return ret;
+}
+
+void Hdf5DataReader::GetVariableOverTimeOverMultipleNodes(const std::string& rVariableName,
+                                                          unsigned lowerIndex,
+                                                          unsigned upperIndex,
+                                                          std::vector<std::vector<double> >& rData)
 {
     if (!mIsUnlimitedDimensionSet)
     {
@@ -300,44 +310,85 @@ std::vector<std::vector<double> > Hdf5DataReader::GetVariableOverTimeOverMultipl
     }
     unsigned column_index = (*col_iter).second;
 
-    // Define hyperslab in the dataset.
-    hsize_t offset[3] = {0, lowerIndex, column_index};
-    hsize_t count[3]  = {mDatasetDims[0], upperIndex-lowerIndex, 1};
-    hid_t variables_dataspace = H5Dget_space(mVariablesDatasetId);
-    H5Sselect_hyperslab(variables_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+    unsigned num_nodes_read = upperIndex-lowerIndex;
+    unsigned num_timesteps = mDatasetDims[0];
 
-    // Define a simple memory dataspace
-    hsize_t data_dimensions[2];
-    data_dimensions[0] = mDatasetDims[0];
-    data_dimensions[1] = upperIndex-lowerIndex;
-    hid_t memspace = H5Screate_simple(2, data_dimensions, nullptr);
+    // Reuse the caller's vectors where possible
+    rData.resize(num_nodes_read);
+    for (unsigned node_num=0; node_num<num_nodes_read; node_num++)
+    {
+        rData[node_num].resize(num_timesteps);
+    }
+    if (num_nodes_read == 0 || num_timesteps == 0)
+    {
+        return;
+    }
 
-    double* data_read = new double[mDatasetDims[0]*(upperIndex-lowerIndex)];
+    /*
+     * Read one chunk's worth of time steps at a time, so that each read touches whole chunks
+     * and the (time-major) slab buffer stays small compared with the output.
+     */
+    unsigned timesteps_per_slab = std::min(GetNumberOfTimestepsPerChunk(), num_timesteps);
+    std::vector<double> slab(timesteps_per_slab*num_nodes_read);
+    hid_t variables_dataspace = H5Dget_space(mVariablesDatasetId);
 
-    // Read data from hyperslab in the file into the hyperslab in memory
-    H5Dread(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, variables_dataspace, H5P_DEFAULT, data_read);
+    for (unsigned first_time=0; first_time<num_timesteps; first_time+=timesteps_per_slab)
+    {
+        unsigned num_slab_timesteps = std::min(timesteps_per_slab, num_timesteps-first_time);
 
-    H5Sclose(variables_dataspace);
-    H5Sclose(memspace);
+        // Define hyperslab in the dataset.
+        hsize_t offset[3] = {first_time, lowerIndex, column_index};
+        hsize_t count[3]  = {num_slab_timesteps, num_nodes_read, 1};
+        H5Sselect_hyperslab(variables_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
 
-    // Data buffer to return
-    unsigned num_nodes_read = upperIndex-lowerIndex;
-    unsigned num_timesteps = mDatasetDims[0];
+        // Define a simple memory dataspace
+        hsize_t data_dimensions[2];
+        data_dimensions[0] = num_slab_timesteps;
+        data_dimensions[1] = num_nodes_read;
+        hid_t memspace = H5Screate_simple(2, data_dimensions, nullptr);
 
-    std::vector<std::vector<double> > ret(num_nodes_read);
+        // Read data from hyperslab in the file into the hyperslab in memory
+        H5Dread(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, variables_dataspace, H5P_DEFAULT, &slab[0]);
+        H5Sclose(memspace);
 
-    for (unsigned node_num=0; node_num<num_nodes_read; node_num++)
-    {
-        ret[node_num].resize(num_timesteps);
-        for (unsigned time_num=0; time_num<num_timesteps; time_num++)
+        for (unsigned node_num=0; node_num<num_nodes_read; node_num++)
         {
-            ret[node_num][time_num] = data_read[num_nodes_read*time_num + node_num];
+            double* p_series = &rData[node_num][first_time];
+            for (unsigned time_num=0; time_num<num_slab_timesteps; time_num++)
+            {
+                p_series[time_num] = slab[num_nodes_read*time_num + node_num];
+            }
         }
     }
 
-    delete[] data_read;
+    H5Sclose(variables_dataspace);
+}
 
-    return ret;
+unsigned Hdf5DataReader::GetNumberOfNodesPerChunk()
+{
+    return GetChunkDimension(1);
+}
+
+unsigned Hdf5DataReader::GetNumberOfTimestepsPerChunk()
+{
+    return GetChunkDimension(0);
+}
+
+unsigned Hdf5DataReader::GetChunkDimension(unsigned dimension)
+{
+    assert(dimension < AbstractHdf5Access::DATASET_DIMS);
+    unsigned size = mDatasetDims[dimension];
+
+    hid_t dcpl = H5Dget_create_plist(mVariablesDatasetId);
+    if (H5Pget_layout(dcpl) == H5D_CHUNKED)
+    {
+        hsize_t chunk_dims[AbstractHdf5Access::DATASET_DIMS];
+        H5Pget_chunk(dcpl, AbstractHdf5Access::DATASET_DIMS, chunk_dims);
+        size = chunk_dims[dimension];
+    }
+    H5Pclose(dcpl);
+
+    return std::max(size, 1u);
 }
 
 void Hdf5DataReader::GetVariableOverNodes(Vec data,
@@ -66,6 +66,14 @@ private:
      */
     void CommonConstructor();
 
+    /**
+     * @return the size of a chunk of the main dataset in the given dimension (the
+     * size of the dataset if it is not chunked).
+     *
+     * @param dimension  0 for time steps, 1 for nodes, 2 for variables
+     */
+    unsigned GetChunkDimension(unsigned dimension);
+
 public:
 
     /**
@@ -113,6 +121,33 @@ public:
                                                                            unsigned lowerIndex,
                                                                            unsigned upperIndex);
 
+    /**
+     * Fill in the values of a given variable at each time step over multiple nodes.  The
+     * dataset is read a chunk's worth of time steps at a time, and the vectors in rData are
+     * reused, so calling this repeatedly for successive blocks of nodes avoids reallocating.
+     *
+     * @param rVariableName  name of a variable in the data file
+     * @param lowerIndex the index of the lower node for which the data is obtained
+     * @param upperIndex one past the index of the upper node for which the data is obtained
+     * @param rData  filled with the time series of each node, in order
+     */
+    void GetVariableOverTimeOverMultipleNodes(const std::string& rVariableName,
+                                              unsigned lowerIndex,
+                                              unsigned upperIndex,
+                                              std::vector<std::vector<double> >& rData);
+
+    /**
+     * @return the number of nodes spanned by a chunk of the main dataset.  Reading
+     * blocks of nodes aligned to multiples of this avoids decompressing or seeking
+     * through the same chunk more than once.
+     */
+    unsigned GetNumberOfNodesPerChunk();
+
+    /**
+     * @return the number of time steps spanned by a chunk of the main dataset.
+     */
+    unsigned GetNumberOfTimestepsPerChunk();
+
     /**
      * @return the values of a given variable at each node at a given time step.
      *
@@ -0,0 +1,142 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "Hdf5NodeBlockReader.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "MathsCustomFunctions.hpp"
+
+Hdf5NodeBlockReader::Hdf5NodeBlockReader(Hdf5DataReader& rReader,
+                                         const std::string& rVariableName,
+                                         unsigned lowerIndex,
+                                         unsigned upperIndex,
+                                         unsigned minNodesPerBlock,
+                                         bool prefetch)
+    : mrReader(rReader),
+      mVariableName(rVariableName),
+      mUpperIndex(upperIndex),
+      mPrefetch(prefetch),
+      mBlockLowerIndex(lowerIndex),
+      mBlockUpperIndex(lowerIndex),
+      mNextLowerIndex(lowerIndex)
+{
+    if (lowerIndex > upperIndex)
+    {
+        EXCEPTION("The lower node index " << lowerIndex << " is after the upper node index " << upperIndex << ".");
+    }
+    unsigned nodes_per_chunk = mrReader.GetNumberOfNodesPerChunk();
+    mNodesPerBlock = nodes_per_chunk * CeilDivide(std::max(minNodesPerBlock, 1u), nodes_per_chunk);
+}
+
+Hdf5NodeBlockReader::~Hdf5NodeBlockReader()
+{
+    if (mPrefetchThread.joinable())
+    {
+        mPrefetchThread.join();
+    }
+}
+
+unsigned Hdf5NodeBlockReader::GetBlockEnd(unsigned lowerIndex) const
+{
+    // Blocks end on multiples of the block size, so they cover whole chunks
+    return std::min(mUpperIndex, (lowerIndex/mNodesPerBlock + 1u) * mNodesPerBlock);
+}
+
+void Hdf5NodeBlockReader::PrefetchNextBlock()
+{
+    try
+    {
+        mrReader.GetVariableOverTimeOverMultipleNodes(mVariableName, mNextLowerIndex,
+                                                      GetBlockEnd(mNextLowerIndex), mNextBlock);
+    }
+    catch (const Exception& e)
+    {
+        mPrefetchError = e.GetShortMessage();
+    }
+}
+
+bool Hdf5NodeBlockReader::NextBlock()
+{
+    if (mNextLowerIndex >= mUpperIndex)
+    {
+        assert(!mPrefetchThread.joinable());
+        mBlockLowerIndex = mBlockUpperIndex = mUpperIndex;
+        return false;
+    }
+
+    if (mPrefetchThread.joinable())
+    {
+        mPrefetchThread.join();
+        if (!mPrefetchError.empty())
+        {
+            EXCEPTION(mPrefetchError);
+        }
+    }
+    else
+    {
+        mrReader.GetVariableOverTimeOverMultipleNodes(mVariableName, mNextLowerIndex,
+                                                      GetBlockEnd(mNextLowerIndex), mNextBlock);
+    }
+
+    mBlock.swap(mNextBlock);
+    mBlockLowerIndex = mNextLowerIndex;
+    mBlockUpperIndex = GetBlockEnd(mBlockLowerIndex);
+    mNextLowerIndex = mBlockUpperIndex;
+
+    if (mPrefetch && mNextLowerIndex < mUpperIndex)
+    {
+        mPrefetchThread = std::thread(&Hdf5NodeBlockReader::PrefetchNextBlock, this);
+    }
+    return true;
+}
+
+unsigned Hdf5NodeBlockReader::GetBlockLowerIndex() const
+{
+    return mBlockLowerIndex;
+}
+
+unsigned Hdf5NodeBlockReader::GetBlockUpperIndex() const
+{
+    return mBlockUpperIndex;
+}
+
+std::vector<double>& Hdf5NodeBlockReader::rGetTimeSeries(unsigned globalNodeIndex)
+{
+    assert(globalNodeIndex >= mBlockLowerIndex && globalNodeIndex < mBlockUpperIndex);
+    return mBlock[globalNodeIndex - mBlockLowerIndex];
+}
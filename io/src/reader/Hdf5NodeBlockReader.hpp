@@ -0,0 +1,175 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef HDF5NODEBLOCKREADER_HPP_
+#define HDF5NODEBLOCKREADER_HPP_
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "Hdf5DataReader.hpp"
+
+/**
+ * Streams the time series of one variable over a range of nodes from an Hdf5DataReader,
+ * one block of nodes at a time, for post-processing that looks at each node's whole trace.
+ *
+ * Block boundaries are aligned with the chunks of the dataset, and each block is read a
+ * chunk of time steps at a time (see Hdf5DataReader::GetVariableOverTimeOverMultipleNodes),
+ * so every chunk is read exactly once.  Optionally the next block is read on a background
+ * thread while the caller processes the current one.
+ *
+ * Usage:
+ *
+ *   Hdf5NodeBlockReader blocks(reader, "V", lo, hi);
+ *   while (blocks.NextBlock())
+ *   {
+ *       for (unsigned node=blocks.GetBlockLowerIndex(); node<blocks.GetBlockUpperIndex(); node++)
+ *       {
+ *           std::vector<double>& r_trace = blocks.rGetTimeSeries(node);
+ *           ...
+ *       }
+ *   }
+ *
+ * The HDF5 library is not thread-safe, so when prefetching the caller must not make any
+ * other HDF5 calls between NextBlock() returning true and the last block being reached
+ * (or this object being destroyed).
+ */
+class Hdf5NodeBlockReader : private boost::noncopyable
+{
+private:
+
+    /** The reader to read from; must outlive this object. */
+    Hdf5DataReader& mrReader;
+
+    /** The variable to read. */
+    const std::string mVariableName;
+
+    /** One past the last node to read. */
+    const unsigned mUpperIndex;
+
+    /** The number of nodes in a (full) block, a multiple of the nodes per chunk. */
+    unsigned mNodesPerBlock;
+
+    /** Whether to read the next block in the background. */
+    const bool mPrefetch;
+
+    /** The first node of the current block. */
+    unsigned mBlockLowerIndex;
+
+    /** One past the last node of the current block. */
+    unsigned mBlockUpperIndex;
+
+    /** The first node of the next block. */
+    unsigned mNextLowerIndex;
+
+    /** The time series of each node in the current block. */
+    std::vector<std::vector<double> > mBlock;
+
+    /** The time series of each node in the next block (being read by #mPrefetchThread, if running). */
+    std::vector<std::vector<double> > mNextBlock;
+
+    /** The thread reading the next block, if any. */
+    std::thread mPrefetchThread;
+
+    /** The message of an exception thrown by the prefetch thread, or empty. */
+    std::string mPrefetchError;
+
+    /**
+     * @return one past the last node of the block starting at the given node.
+     *
+     * @param lowerIndex  the first node of the block
+     */
+    unsigned GetBlockEnd(unsigned lowerIndex) const;
+
+    /**
+     * Read the block starting at #mNextLowerIndex into #mNextBlock.  Run on #mPrefetchThread,
+     * so any exception is stored in #mPrefetchError rather than propagated.
+     */
+    void PrefetchNextBlock();
+
+public:
+
+    /**
+     * Constructor.  Nothing is read until NextBlock() is called.
+     *
+     * @param rReader  the reader to read from, which must outlive this object
+     * @param rVariableName  the variable to read
+     * @param lowerIndex  the first node to read
+     * @param upperIndex  one past the last node to read
+     * @param minNodesPerBlock  the smallest number of nodes in a block (other than the first
+     *     and last); rounded up to a whole number of chunks
+     * @param prefetch  whether to read the next block in the background
+     */
+    Hdf5NodeBlockReader(Hdf5DataReader& rReader,
+                        const std::string& rVariableName,
+                        unsigned lowerIndex,
+                        unsigned upperIndex,
+                        unsigned minNodesPerBlock=100u,
+                        bool prefetch=true);
+
+    /**
+     * Destructor.  Waits for any background read to finish.
+     */
+    ~Hdf5NodeBlockReader();
+
+    /**
+     * Move on to the next block of nodes (the first block, on the first call).
+     *
+     * @return false if there are no more blocks.
+     */
+    bool NextBlock();
+
+    /**
+     * @return the first node of the current block.
+     */
+    unsigned GetBlockLowerIndex() const;
+
+    /**
+     * @return one past the last node of the current block.
+     */
+    unsigned GetBlockUpperIndex() const;
+
+    /**
+     * @return the time series of a node in the current block.  The reference is valid
+     * until the next call to NextBlock().
+     *
+     * @param globalNodeIndex  the node, which must be in the current block
+     */
+    std::vector<double>& rGetTimeSeries(unsigned globalNodeIndex);
+};
+
+#endif /*HDF5NODEBLOCKREADER_HPP_*/
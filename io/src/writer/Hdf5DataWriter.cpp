@@ -37,6 +37,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Implementation file for Hdf5DataWriter class.
  *
  */
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <cstring> //For strcmp etc. Needed in gcc-4.4
 #include <boost/scoped_array.hpp>
@@ -48,6 +50,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscTools.hpp"
 #include "Version.hpp"
 #include "MathsCustomFunctions.hpp"
+#include "Warnings.hpp"
+
+/** Registered HDF5 filter identifier of the LZ4 plugin. */
+#define CHASTE_H5Z_FILTER_LZ4 32004
+/** Registered HDF5 filter identifier of the Zstandard plugin. */
+#define CHASTE_H5Z_FILTER_ZSTD 32015
 
 Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
                                const std::string& rDirectory,
@@ -80,6 +88,8 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
       mNumberOfChunks(0),
       mChunkTargetSize(0x20000), // 128 K
       mAlignment(0), // No alignment
+      mCompressionType(NO_COMPRESSION),
+      mCompressionLevel(1u),
       mUseCache(useCache),
       mCacheFirstTimeStep(0u)
 {
@@ -619,6 +629,26 @@ void Hdf5DataWriter::EndDefineMode()
     // Create chunked dataset and clean up
     hid_t cparms = H5Pcreate (H5P_DATASET_CREATE);
     H5Pset_chunk( cparms, DATASET_DIMS, mChunkSize);
+    if (mCompressionType != NO_COMPRESSION)
+    {
+        // Shuffling groups the bytes of each double by significance, so that exponents
+        // and (quantised) low mantissa bytes form long compressible runs
+        H5Pset_shuffle(cparms);
+        switch (mCompressionType)
+        {
+            case DEFLATE:
+                H5Pset_deflate(cparms, mCompressionLevel);
+                break;
+            case LZ4:
+                H5Pset_filter(cparms, CHASTE_H5Z_FILTER_LZ4, H5Z_FLAG_MANDATORY, 0, nullptr);
+                break;
+            case ZSTD:
+                H5Pset_filter(cparms, CHASTE_H5Z_FILTER_ZSTD, H5Z_FLAG_MANDATORY, 1, &mCompressionLevel);
+                break;
+            default:
+                NEVER_REACHED;
+        }
+    }
     hid_t filespace = H5Screate_simple(DATASET_DIMS, mDatasetDims, dataset_max_dims);
     mVariablesDatasetId = H5Dcreate(mFileId, mDatasetName.c_str(), H5T_NATIVE_DOUBLE, filespace,
                                     H5P_DEFAULT, cparms, H5P_DEFAULT);
@@ -819,28 +849,17 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         MatMult(mSinglePermutation, petscVector, output_petsc_vector);
     }
 
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
-    {
-        hsize_t v_size[1] = {mNumberOwned};
-        memspace = H5Screate_simple(1, v_size, nullptr);
-
-        hsize_t count[DATASET_DIMS] = {1, mNumberOwned, 1};
-        hsize_t offset_dims[DATASET_DIMS] = {mCurrentTimeStep, mOffset, (unsigned)(variableID)};
-
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset_dims, nullptr, count, nullptr);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
-
-    // Create property list for collective dataset
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+    // Define the hyperslab to write (a collective write)
+    Hdf5WriteQueue::Request request;
+    request.mDatasetId = mVariablesDatasetId;
+    request.mRank = DATASET_DIMS;
+    request.mNumValues = mNumberOwned;
+    request.mStart[0] = mCurrentTimeStep;
+    request.mStart[1] = mOffset;
+    request.mStart[2] = (unsigned)(variableID);
+    request.mCount[0] = 1;
+    request.mCount[1] = mNumberOwned;
+    request.mCount[2] = 1;
 
     double* p_petsc_vector;
     VecGetArray(output_petsc_vector, &p_petsc_vector);
@@ -854,7 +873,8 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            request.mpData = p_petsc_vector;
+            WriteData(request);
         }
     }
     else
@@ -877,7 +897,8 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
             }
             else
             {
-                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector_incomplete);
+                request.mpData = p_petsc_vector_incomplete;
+                WriteData(request);
             }
         }
         else
@@ -896,17 +917,14 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
             }
             else
             {
-                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                request.mpData = local_data.get();
+                WriteData(request);
             }
         }
     }
 
     VecRestoreArray(output_petsc_vector, &p_petsc_vector);
 
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
-
     if (petscVector != output_petsc_vector)
     {
         // Free local vector
@@ -981,30 +999,20 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         // Apply the permutation matrix
         MatMult(mDoublePermutation, petscVector, output_petsc_vector);
     }
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
-    {
-        hsize_t v_size[1] = {mNumberOwned*NUM_STRIPES};
-        memspace = H5Screate_simple(1, v_size, nullptr);
-
-        hsize_t start[DATASET_DIMS] = {mCurrentTimeStep, mOffset, (unsigned)(firstVariableID)};
-        hsize_t stride[DATASET_DIMS] = {1, 1, 1};//we are imposing contiguous variables, hence the stride is 1 (3rd component)
-        hsize_t block_size[DATASET_DIMS] = {1, mNumberOwned, 1};
-        hsize_t number_blocks[DATASET_DIMS] = {1, 1, NUM_STRIPES};
-
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, stride, number_blocks, block_size);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
-
-    // Create property list for collective dataset write, and write! Finally.
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+    // Define the hyperslab to write (a collective write)
+    Hdf5WriteQueue::Request request;
+    request.mDatasetId = mVariablesDatasetId;
+    request.mRank = DATASET_DIMS;
+    request.mNumValues = mNumberOwned*NUM_STRIPES;
+    request.mUseStrideAndBlock = true;
+    request.mStart[0] = mCurrentTimeStep;
+    request.mStart[1] = mOffset;
+    request.mStart[2] = (unsigned)(firstVariableID);
+    // We are imposing contiguous variables, hence the stride is 1 (3rd component)
+    request.mBlock[1] = mNumberOwned;
+    request.mCount[0] = 1;
+    request.mCount[1] = 1;
+    request.mCount[2] = NUM_STRIPES;
 
     double* p_petsc_vector;
     VecGetArray(output_petsc_vector, &p_petsc_vector);
@@ -1018,7 +1026,8 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            request.mpData = p_petsc_vector;
+            WriteData(request);
         }
     }
     else
@@ -1043,7 +1052,8 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
                 }
                 else
                 {
-                    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector_incomplete);
+                    request.mpData = p_petsc_vector_incomplete;
+                    WriteData(request);
                 }
             }
             else
@@ -1064,7 +1074,8 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
                 }
                 else
                 {
-                    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                    request.mpData = local_data.get();
+                    WriteData(request);
                 }
             }
         }
@@ -1076,10 +1087,6 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
 
     VecRestoreArray(output_petsc_vector, &p_petsc_vector);
 
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
-
     if (petscVector != output_petsc_vector)
     {
         // Free local vector
@@ -1107,37 +1114,25 @@ void Hdf5DataWriter::WriteCache()
 //    PRINT_3_VARIABLES(mCurrentTimeStep-mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2])
 //    PRINT_VARIABLE(mDataCache.size())
 
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
+    // Define the hyperslab to write (a collective write)
+    Hdf5WriteQueue::Request request;
+    request.mDatasetId = mVariablesDatasetId;
+    request.mRank = DATASET_DIMS;
     if (mNumberOwned != 0)
     {
-        hsize_t v_size[1] = {mDataCache.size()};
-        memspace = H5Screate_simple(1, v_size, nullptr);
-
-        hsize_t start[DATASET_DIMS] = {mCacheFirstTimeStep, mOffset, 0};
-        hsize_t count[DATASET_DIMS] = {mCurrentTimeStep-mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2]};
+        request.mNumValues = mDataCache.size();
+        request.mStart[0] = mCacheFirstTimeStep;
+        request.mStart[1] = mOffset;
+        request.mStart[2] = 0;
+        request.mCount[0] = mCurrentTimeStep-mCacheFirstTimeStep;
+        request.mCount[1] = mNumberOwned;
+        request.mCount[2] = mDatasetDims[2];
         assert((mCurrentTimeStep-mCacheFirstTimeStep)*mNumberOwned*mDatasetDims[2] == mDataCache.size()); // Got size right?
-
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, nullptr, count, nullptr);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
     }
 
-    // Create property list for collective dataset write
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
-
     // Write!
-    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, &mDataCache[0]);
-
-    // Tidy up
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
+    request.mpData = mDataCache.empty() ? nullptr : &mDataCache[0];
+    WriteData(request);
 
     mCacheFirstTimeStep = mCurrentTimeStep; // Update where we got to
     mDataCache.clear(); // Clear out cache
@@ -1164,19 +1159,17 @@ void Hdf5DataWriter::PutUnlimitedVariable(double value)
         return;
     }
 
-    hsize_t size[1] = {1};
-    hid_t memspace = H5Screate_simple(1, size, nullptr);
+    // Select hyperslab in the file (an independent write).
+    Hdf5WriteQueue::Request request;
+    request.mDatasetId = mUnlimitedDatasetId;
+    request.mRank = 1;
+    request.mNumValues = 1;
+    request.mCollective = false;
+    request.mStart[0] = mCurrentTimeStep;
+    request.mCount[0] = 1;
+    request.mpData = &value;
 
-    // Select hyperslab in the file.
-    hsize_t count[1] = {1};
-    hsize_t offset[1] = {mCurrentTimeStep};
-    hid_t hyperslab_space = H5Dget_space(mUnlimitedDatasetId);
-    H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset, nullptr, count, nullptr);
-
-    H5Dwrite(mUnlimitedDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, H5P_DEFAULT, &value);
-
-    H5Sclose(hyperslab_space);
-    H5Sclose(memspace);
+    WriteData(request);
 }
 
 void Hdf5DataWriter::Close()
@@ -1191,6 +1184,21 @@ void Hdf5DataWriter::Close()
         WriteCache();
     }
 
+    // Wait for any asynchronous writes, and stop the I/O thread
+    bool async_write_failed = false;
+    if (mpWriteQueue)
+    {
+        try
+        {
+            mpWriteQueue->Flush();
+        }
+        catch (Exception&)
+        {
+            async_write_failed = true;
+        }
+        mpWriteQueue.reset();
+    }
+
     H5Dclose(mVariablesDatasetId);
     if (mIsUnlimitedDimensionSet)
     {
@@ -1200,6 +1208,11 @@ void Hdf5DataWriter::Close()
 
     // Cope with being called twice (e.g. if a user calls Close then the destructor)
     mIsInDefineMode = true;
+
+    if (async_write_failed)
+    {
+        EXCEPTION("An asynchronous HDF5 write failed; the file is incomplete.");
+    }
 }
 
 void Hdf5DataWriter::DefineUnlimitedDimension(const std::string& rVariableName,
@@ -1256,12 +1269,97 @@ void Hdf5DataWriter::PossiblyExtend()
 {
     if (mNeedExtend)
     {
-        H5Dset_extent( mVariablesDatasetId, mDatasetDims );
-        H5Dset_extent( mUnlimitedDatasetId, mDatasetDims );
+        Hdf5WriteQueue::Request request;
+        request.mType = Hdf5WriteQueue::SET_EXTENT;
+        request.mDatasetId = mVariablesDatasetId;
+        request.mSecondDatasetId = mUnlimitedDatasetId;
+        request.mRank = DATASET_DIMS;
+        std::copy(mDatasetDims, mDatasetDims+DATASET_DIMS, request.mCount);
+        WriteData(request);
     }
     mNeedExtend = false;
 }
 
+void Hdf5DataWriter::WriteData(const Hdf5WriteQueue::Request& rRequest)
+{
+    if (!mVariableQuanta.empty()
+        && rRequest.mType == Hdf5WriteQueue::WRITE_HYPERSLAB
+        && rRequest.mDatasetId == mVariablesDatasetId
+        && rRequest.mNumValues > 0)
+    {
+        /*
+         * All writes to the main dataset cover whole rows of contiguous variables starting at
+         * mStart[2], so value i belongs to variable mStart[2] + i % (variables per row).
+         * Quantise a copy: the caller's data is often the solution vector itself.
+         */
+        hsize_t vars_per_row = rRequest.mCount[2];
+        if (rRequest.mUseStrideAndBlock)
+        {
+            vars_per_row *= rRequest.mBlock[2];
+        }
+        Hdf5WriteQueue::Request quantised_request(rRequest);
+        quantised_request.mBuffer.assign(rRequest.mpData, rRequest.mpData + rRequest.mNumValues);
+        for (hsize_t i=0; i<rRequest.mNumValues; i++)
+        {
+            unsigned var = rRequest.mStart[2] + i%vars_per_row;
+            double& r_value = quantised_request.mBuffer[i];
+            if (var < mVariableQuanta.size() && mVariableQuanta[var] > 0.0 && std::isfinite(r_value))
+            {
+                // Exact in binary floating point, since the quantum is a power of two
+                r_value = std::round(r_value/mVariableQuanta[var]) * mVariableQuanta[var];
+            }
+        }
+        quantised_request.mpData = &quantised_request.mBuffer[0];
+
+        if (mpWriteQueue)
+        {
+            mpWriteQueue->Push(quantised_request);
+        }
+        else
+        {
+            Hdf5WriteQueue::Execute(quantised_request);
+        }
+        return;
+    }
+
+    if (mpWriteQueue)
+    {
+        mpWriteQueue->Push(rRequest);
+    }
+    else
+    {
+        Hdf5WriteQueue::Execute(rRequest);
+    }
+}
+
+void Hdf5DataWriter::SetUseAsyncWrites(bool useAsync, unsigned maxPendingWrites)
+{
+    Flush();
+    mpWriteQueue.reset();
+    if (useAsync)
+    {
+        if (!Hdf5WriteQueue::IsSupported())
+        {
+            WARNING("Asynchronous HDF5 writes need MPI to support MPI_THREAD_MULTIPLE (run with -mpi_thread_multiple); writing synchronously instead.");
+            return;
+        }
+        mpWriteQueue.reset(new Hdf5WriteQueue(maxPendingWrites));
+    }
+}
+
+bool Hdf5DataWriter::GetUsingAsyncWrites()
+{
+    return (bool)mpWriteQueue;
+}
+
+void Hdf5DataWriter::Flush()
+{
+    if (mpWriteQueue)
+    {
+        mpWriteQueue->Flush();
+    }
+}
+
 void Hdf5DataWriter::EmptyDataset()
 {
     // Set internal counter to 0
@@ -1512,3 +1610,86 @@ void Hdf5DataWriter::SetAlignment(hsize_t alignment)
 
     mAlignment = alignment;
 }
+
+void Hdf5DataWriter::SetCompression(CompressionType type, unsigned level)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set compression when not in define mode.");
+    }
+    if ((type == DEFLATE && level > 9u) || (type == ZSTD && (level < 1u || level > 22u)))
+    {
+        EXCEPTION("Compression level " << level << " is not valid for this filter.");
+    }
+    if (!IsCompressionAvailable(type))
+    {
+        EXCEPTION("The requested HDF5 compression filter is not available; check HDF5_PLUGIN_PATH.");
+    }
+#if !H5_VERSION_GE(1,10,2)
+    if (type != NO_COMPRESSION && PetscTools::IsParallel())
+    {
+        EXCEPTION("Writing compressed HDF5 files in parallel requires HDF5 1.10.2 or later.");
+    }
+#endif
+    mCompressionType = type;
+    mCompressionLevel = level;
+}
+
+Hdf5DataWriter::CompressionType Hdf5DataWriter::GetCompression() const
+{
+    return mCompressionType;
+}
+
+bool Hdf5DataWriter::IsCompressionAvailable(CompressionType type)
+{
+    bool available = true;
+    switch (type)
+    {
+        case NO_COMPRESSION:
+            break;
+        case DEFLATE:
+            available = (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0);
+            break;
+        case LZ4:
+            available = (H5Zfilter_avail(CHASTE_H5Z_FILTER_LZ4) > 0);
+            break;
+        case ZSTD:
+            available = (H5Zfilter_avail(CHASTE_H5Z_FILTER_ZSTD) > 0);
+            break;
+        default:
+            NEVER_REACHED;
+    }
+    // Plugins are found at run time, so make sure all processes agree
+    return !PetscTools::ReplicateBool(!available);
+}
+
+void Hdf5DataWriter::SetVariableErrorBound(int variableID, double absoluteErrorBound)
+{
+    if (variableID < 0 || (unsigned)variableID >= mVariables.size())
+    {
+        EXCEPTION("Variable " << variableID << " has not been defined.");
+    }
+    if (!(absoluteErrorBound >= 0.0))
+    {
+        EXCEPTION("The error bound must be non-negative.");
+    }
+    if (mVariableQuanta.size() < mVariables.size())
+    {
+        mVariableQuanta.resize(mVariables.size(), 0.0);
+    }
+
+    double quantum = 0.0;
+    if (absoluteErrorBound > 0.0)
+    {
+        // The largest power of two not exceeding twice the bound, so that rounding errs by at most the bound
+        int exponent;
+        std::frexp(2.0*absoluteErrorBound, &exponent);
+        quantum = std::ldexp(1.0, exponent-1);
+    }
+    mVariableQuanta[variableID] = quantum;
+
+    if (*std::max_element(mVariableQuanta.begin(), mVariableQuanta.end()) == 0.0)
+    {
+        mVariableQuanta.clear();
+    }
+}
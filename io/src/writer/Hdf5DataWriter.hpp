@@ -37,10 +37,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define HDF5DATAWRITER_HPP_
 
 #include <vector>
+#include <boost/scoped_ptr.hpp>
 
 #include "AbstractHdf5Access.hpp"
 #include "DataWriterVariable.hpp"
 #include "DistributedVectorFactory.hpp"
+#include "Hdf5WriteQueue.hpp"
 
 /**
  * A concrete HDF5 data writer class.
@@ -48,6 +50,21 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 class Hdf5DataWriter : public AbstractHdf5Access //: public AbstractDataWriter
 {
     friend class TestHdf5DataWriter;
+public:
+
+    /**
+     * The compression filters that can be applied to the main dataset.  All but
+     * NO_COMPRESSION shuffle the bytes of each chunk first, which greatly improves
+     * the compression ratio of floating point data.
+     */
+    typedef enum
+    {
+        NO_COMPRESSION=0,   /**< Store raw doubles (the default) */
+        DEFLATE,            /**< zlib deflate, built in to HDF5 */
+        LZ4,                /**< LZ4 (fast), from the registered HDF5 filter plugin */
+        ZSTD                /**< Zstandard, from the registered HDF5 filter plugin */
+    } CompressionType;
+
 private:
 
     /** The factory to use in creating PETSc Vec and DistributedVector objects. */
@@ -87,10 +104,16 @@ private:
 
     hsize_t mAlignment;                             /**< User-provided alignment parameter */
 
+    CompressionType mCompressionType;               /**< Compression filter for the main dataset */
+    unsigned mCompressionLevel;                     /**< Compression level passed to the filter */
+    std::vector<double> mVariableQuanta;            /**< Quantum each variable is rounded to before writing (0 for lossless) */
+
     bool mUseCache;                                 /**< Whether to use a cache */
     long unsigned mCacheFirstTimeStep;              /**< Coordinate to keep track of cache writes */
     std::vector<double> mDataCache;                 /**< Cache results here before writing */
 
+    boost::scoped_ptr<Hdf5WriteQueue> mpWriteQueue; /**< Performs writes in the background, if asynchronous writes are on */
+
     /**
      * Check name of variable is allowed, i.e. contains only alphanumeric & _, and isn't blank.
      *
@@ -143,6 +166,15 @@ private:
      */
     void SetChunkSize();
 
+    /**
+     * Perform a dataset operation now, or queue it for the I/O thread if asynchronous
+     * writes are on.  Values of variables with an error bound (see SetVariableErrorBound)
+     * are quantised on a copy first.
+     *
+     * @param rRequest  the operation
+     */
+    void WriteData(const Hdf5WriteQueue::Request& rRequest);
+
 public:
 
     /**
@@ -270,6 +302,35 @@ public:
      */
     void WriteCache();
 
+    /**
+     * Set whether to write asynchronously.  In asynchronous mode PutVector, PutStripedVector,
+     * PutUnlimitedVariable and WriteCache copy the local data into a staging buffer and return
+     * straight away, while a background thread performs the (collective) HDF5 writes in order.
+     * At most maxPendingWrites buffers are used, so memory use is bounded; once they are all
+     * full the next write waits.  The file produced is identical to a synchronous write.
+     *
+     * Requires MPI to provide MPI_THREAD_MULTIPLE, which is only asked for when Chaste is run
+     * with the -mpi_thread_multiple option; otherwise a warning is given and writes stay
+     * synchronous.  Must be called collectively.
+     *
+     * @note Don't make any other HDF5 calls (e.g. read the file) until Flush() or Close()
+     * has been called, since the HDF5 library isn't thread-safe.
+     *
+     * @param useAsync  whether to write asynchronously
+     * @param maxPendingWrites  the number of staging buffers (2 gives double buffering)
+     */
+    void SetUseAsyncWrites(bool useAsync=true, unsigned maxPendingWrites=2u);
+
+    /**
+     * @return whether writes are being done asynchronously.
+     */
+    bool GetUsingAsyncWrites();
+
+    /**
+     * Wait for any asynchronous writes to finish.  Called by Close().
+     */
+    void Flush();
+
     /**
      * Write a single value for the unlimited variable (e.g. time) to the dataset.
      *
@@ -410,6 +471,46 @@ public:
      * @param alignment Alignment (bytes)
      */
     void SetAlignment(hsize_t alignment);
+
+    /**
+     * Compress the main dataset with the given filter.  Compression is lossless and
+     * transparent to readers, although for the LZ4 and ZSTD filters the corresponding
+     * plugin must be on HDF5_PLUGIN_PATH to read the file.  The filter applies to the
+     * whole dataset, i.e. to all variables; combine it with SetVariableErrorBound to
+     * make particular variables compress much better.
+     *
+     * Compressed output in parallel needs HDF5 1.10.2 or later.
+     *
+     * This method only has an effect when creating a NEW DATASET. Must be
+     * called in define mode.
+     *
+     * @param type  the filter to use
+     * @param level  the compression level (0-9 for DEFLATE, 1-22 for ZSTD, ignored for LZ4)
+     */
+    void SetCompression(CompressionType type, unsigned level=1u);
+
+    /**
+     * @return the compression filter that new datasets are created with.
+     */
+    CompressionType GetCompression() const;
+
+    /**
+     * @return whether a compression filter can be used by this build of HDF5.
+     * @param type  the filter
+     */
+    static bool IsCompressionAvailable(CompressionType type);
+
+    /**
+     * Store a variable lossily: each value written is rounded to the nearest multiple
+     * of the largest power of two not exceeding twice the given bound, so that it differs
+     * from the original by at most the bound.  The rounded values have many trailing zero
+     * bits, which a compression filter (see SetCompression) removes.  Readers still see
+     * ordinary doubles.
+     *
+     * @param variableID  the variable, as returned by DefineVariable or GetVariableByName
+     * @param absoluteErrorBound  the largest error allowed; zero makes the variable lossless again
+     */
+    void SetVariableErrorBound(int variableID, double absoluteErrorBound);
 };
 
 #endif /*HDF5DATAWRITER_HPP_*/
@@ -0,0 +1,227 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "Hdf5WriteQueue.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+
+Hdf5WriteQueue::Request::Request()
+    : mType(WRITE_HYPERSLAB),
+      mDatasetId(-1),
+      mSecondDatasetId(-1),
+      mRank(1u),
+      mUseStrideAndBlock(false),
+      mNumValues(0u),
+      mCollective(true),
+      mpData(nullptr)
+{
+    std::fill(mStart, mStart+MAX_DIMS, 0u);
+    std::fill(mCount, mCount+MAX_DIMS, 0u);
+    std::fill(mStride, mStride+MAX_DIMS, 1u);
+    std::fill(mBlock, mBlock+MAX_DIMS, 1u);
+}
+
+Hdf5WriteQueue::Hdf5WriteQueue(unsigned maxPendingRequests)
+    : mRequests(std::max(maxPendingRequests, 1u)),
+      mBusy(false),
+      mStop(false),
+      mFailed(false)
+{
+    for (unsigned i=0; i<mRequests.size(); i++)
+    {
+        mFreeRequests.push_back(&mRequests[i]);
+    }
+    mThread = std::thread(&Hdf5WriteQueue::ThreadMain, this);
+}
+
+Hdf5WriteQueue::~Hdf5WriteQueue()
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWorkAvailable.notify_one();
+    mThread.join();
+}
+
+void Hdf5WriteQueue::Push(const Request& rRequest)
+{
+    Request* p_request;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (mFreeRequests.empty())
+        {
+            mWorkDone.wait(lock);
+        }
+        p_request = mFreeRequests.back();
+        mFreeRequests.pop_back();
+    }
+
+    // Copy the request, keeping the staging buffer's memory for reuse
+    std::vector<double> buffer;
+    buffer.swap(p_request->mBuffer);
+    *p_request = rRequest;
+    p_request->mBuffer.swap(buffer);
+    if (rRequest.mType == WRITE_HYPERSLAB)
+    {
+        // Always have some memory to point at, as HDF5 rejects null buffers even for empty selections
+        p_request->mBuffer.resize(std::max(rRequest.mNumValues, (hsize_t)1u));
+        if (rRequest.mNumValues > 0)
+        {
+            std::copy(rRequest.mpData, rRequest.mpData + rRequest.mNumValues, p_request->mBuffer.begin());
+        }
+        p_request->mpData = &(p_request->mBuffer[0]);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mPendingRequests.push_back(p_request);
+    }
+    mWorkAvailable.notify_one();
+}
+
+void Hdf5WriteQueue::Flush()
+{
+    bool failed;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (mBusy || !mPendingRequests.empty())
+        {
+            mWorkDone.wait(lock);
+        }
+        failed = mFailed;
+        mFailed = false;
+    }
+    if (failed)
+    {
+        EXCEPTION("An asynchronous HDF5 write failed.");
+    }
+}
+
+void Hdf5WriteQueue::ThreadMain()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        while (mPendingRequests.empty() && !mStop)
+        {
+            mWorkAvailable.wait(lock);
+        }
+        if (mPendingRequests.empty())
+        {
+            // Stopping, and nothing left to do
+            break;
+        }
+        Request* p_request = mPendingRequests.front();
+        mPendingRequests.pop_front();
+        mBusy = true;
+
+        lock.unlock();
+        bool success = Execute(*p_request);
+        lock.lock();
+
+        mFailed = mFailed || !success;
+        mBusy = false;
+        mFreeRequests.push_back(p_request);
+        mWorkDone.notify_all();
+    }
+}
+
+bool Hdf5WriteQueue::Execute(const Request& rRequest)
+{
+    herr_t status = 0;
+    if (rRequest.mType == SET_EXTENT)
+    {
+        status = H5Dset_extent(rRequest.mDatasetId, rRequest.mCount);
+        if (rRequest.mSecondDatasetId >= 0 && status >= 0)
+        {
+            status = H5Dset_extent(rRequest.mSecondDatasetId, rRequest.mCount);
+        }
+        return status >= 0;
+    }
+
+    assert(rRequest.mType == WRITE_HYPERSLAB);
+    hid_t memspace, hyperslab_space;
+    if (rRequest.mNumValues != 0)
+    {
+        hsize_t v_size[1] = {rRequest.mNumValues};
+        memspace = H5Screate_simple(1, v_size, nullptr);
+
+        hyperslab_space = H5Dget_space(rRequest.mDatasetId);
+        if (rRequest.mUseStrideAndBlock)
+        {
+            H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, rRequest.mStart, rRequest.mStride,
+                                rRequest.mCount, rRequest.mBlock);
+        }
+        else
+        {
+            H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, rRequest.mStart, nullptr, rRequest.mCount, nullptr);
+        }
+    }
+    else
+    {
+        memspace = H5Screate(H5S_NULL);
+        hyperslab_space = H5Screate(H5S_NULL);
+    }
+
+    hid_t property_list_id = H5P_DEFAULT;
+    if (rRequest.mCollective)
+    {
+        property_list_id = H5Pcreate(H5P_DATASET_XFER);
+        H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+    }
+
+    status = H5Dwrite(rRequest.mDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, rRequest.mpData);
+
+    H5Sclose(memspace);
+    H5Sclose(hyperslab_space);
+    if (rRequest.mCollective)
+    {
+        H5Pclose(property_list_id);
+    }
+    return status >= 0;
+}
+
+bool Hdf5WriteQueue::IsSupported()
+{
+    int provided;
+    MPI_Query_thread(&provided);
+    return provided >= MPI_THREAD_MULTIPLE;
+}
@@ -0,0 +1,187 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef HDF5WRITEQUEUE_HPP_
+#define HDF5WRITEQUEUE_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <hdf5.h>
+#include <boost/utility.hpp>
+
+/**
+ * A bounded queue of HDF5 dataset operations, performed in order by a background I/O thread.
+ *
+ * Used by Hdf5DataWriter in asynchronous mode: the data to be written is copied into one of a
+ * fixed number of staging buffers, and the caller carries on while the I/O thread does the
+ * (collective) write.  Once every staging buffer is in use, the next write waits for one to be
+ * freed, so memory use is bounded.  Since the same operations are performed in the same order
+ * as a synchronous writer would, the resulting files are identical.
+ *
+ * The HDF5 library is not thread-safe, so while any operations are pending the caller must
+ * not make any other HDF5 calls; use Flush() first.  Collective operations need MPI to have
+ * been initialised with MPI_THREAD_MULTIPLE support (see IsSupported()).
+ */
+class Hdf5WriteQueue : private boost::noncopyable
+{
+public:
+    /** The number of dimensions in the hyperslab descriptions of a request. */
+    static const unsigned MAX_DIMS = 3;
+
+    /** The kinds of operation the queue can perform. */
+    typedef enum
+    {
+        WRITE_HYPERSLAB=0,  /**< Write data to a hyperslab of a dataset */
+        SET_EXTENT          /**< Set the extent of one or two datasets to #mCount */
+    } RequestType;
+
+    /**
+     * A single dataset operation.  The same object describes a synchronous operation (when
+     * #mpData points at the caller's data) or a queued one (when the data lives in #mBuffer).
+     */
+    struct Request
+    {
+        /** What to do */
+        RequestType mType;
+        /** The dataset to act on */
+        hid_t mDatasetId;
+        /** A second dataset whose extent is also set (SET_EXTENT only), or -1 */
+        hid_t mSecondDatasetId;
+        /** The rank of the dataset */
+        unsigned mRank;
+        /** Hyperslab start */
+        hsize_t mStart[MAX_DIMS];
+        /** Hyperslab count (or new extent for SET_EXTENT) */
+        hsize_t mCount[MAX_DIMS];
+        /** Hyperslab stride (only if #mUseStrideAndBlock) */
+        hsize_t mStride[MAX_DIMS];
+        /** Hyperslab block (only if #mUseStrideAndBlock) */
+        hsize_t mBlock[MAX_DIMS];
+        /** Whether the hyperslab has a stride and block */
+        bool mUseStrideAndBlock;
+        /** The number of values written by this process; zero gives an empty (null) selection */
+        hsize_t mNumValues;
+        /** Whether to use a collective transfer */
+        bool mCollective;
+        /** The data to write */
+        const double* mpData;
+        /** Staging buffer for queued writes */
+        std::vector<double> mBuffer;
+
+        /** Default constructor, describing a collective write of nothing. */
+        Request();
+    };
+
+    /**
+     * Start the I/O thread.
+     *
+     * @param maxPendingRequests  the number of staging buffers (at least 1)
+     */
+    Hdf5WriteQueue(unsigned maxPendingRequests);
+
+    /**
+     * Perform any pending operations, then stop the I/O thread.
+     */
+    ~Hdf5WriteQueue();
+
+    /**
+     * Queue an operation.  The request's data (if any) is copied into a staging buffer, waiting
+     * for one to become free if necessary.
+     *
+     * @param rRequest  the operation
+     */
+    void Push(const Request& rRequest);
+
+    /**
+     * Wait until all queued operations have been performed.  Throws if any of them failed.
+     */
+    void Flush();
+
+    /**
+     * Perform an operation immediately, in the calling thread.
+     *
+     * @param rRequest  the operation
+     * @return whether all the HDF5 calls succeeded
+     */
+    static bool Execute(const Request& rRequest);
+
+    /**
+     * @return whether MPI supports the multi-threaded use needed for asynchronous collective writes.
+     * Chaste only asks for this when run with the -mpi_thread_multiple option (see
+     * PetscSetupUtils::InitialiseMpi()), and not all MPI implementations can provide it.
+     */
+    static bool IsSupported();
+
+private:
+    /** The main loop of the I/O thread. */
+    void ThreadMain();
+
+    /** Staging buffers not currently in use. */
+    std::vector<Request*> mFreeRequests;
+
+    /** Requests waiting to be performed, in order. */
+    std::deque<Request*> mPendingRequests;
+
+    /** Owns all the staging buffers. */
+    std::vector<Request> mRequests;
+
+    /** Whether the I/O thread is performing a request. */
+    bool mBusy;
+
+    /** Set to tell the I/O thread to finish. */
+    bool mStop;
+
+    /** Whether any request has failed since the last Flush(). */
+    bool mFailed;
+
+    /** Protects the members above. */
+    std::mutex mMutex;
+
+    /** Signalled when a request is queued or #mStop is set. */
+    std::condition_variable mWorkAvailable;
+
+    /** Signalled when a request has been performed. */
+    std::condition_variable mWorkDone;
+
+    /** The I/O thread. */
+    std::thread mThread;
+};
+
+#endif // HDF5WRITEQUEUE_HPP_
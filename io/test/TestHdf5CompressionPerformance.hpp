@@ -0,0 +1,158 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTHDF5COMPRESSIONPERFORMANCE_HPP_
+#define TESTHDF5COMPRESSIONPERFORMANCE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <iomanip>
+
+#include "DistributedVector.hpp"
+#include "DistributedVectorFactory.hpp"
+#include "Hdf5DataWriter.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+#include "Timer.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * Reports the write throughput and file size of Hdf5DataWriter with each of its
+ * compression options, on bidomain-like striped V/Phi_e output.
+ */
+class TestHdf5CompressionPerformance : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Write a file and report how long it took and how big it is.
+     *
+     * @param rName  the file name and description
+     * @param type  the compression filter
+     * @param level  the compression level
+     * @param vErrorBound  error bound for V (0 for lossless)
+     */
+    void WriteAndReport(const std::string& rName, Hdf5DataWriter::CompressionType type, unsigned level, double vErrorBound)
+    {
+        bool parallel_unsupported = (type != Hdf5DataWriter::NO_COMPRESSION && PetscTools::IsParallel() && !H5_VERSION_GE(1,10,2));
+        if (parallel_unsupported || !Hdf5DataWriter::IsCompressionAvailable(type))
+        {
+            if (PetscTools::AmMaster())
+            {
+                std::cout << std::setw(24) << rName << ": not available\n" << std::flush;
+            }
+            return;
+        }
+
+        const unsigned number_nodes = 100000;
+        const unsigned num_steps = 50;
+        DistributedVectorFactory factory(number_nodes);
+        Vec petsc_data = factory.CreateVec(2);
+        DistributedVector distributed_vector = factory.CreateDistributedVector(petsc_data);
+        DistributedVector::Stripe vm_stripe(distributed_vector, 0);
+        DistributedVector::Stripe phi_e_stripe(distributed_vector, 1);
+
+        Timer::Reset();
+        {
+            Hdf5DataWriter writer(factory, "TestHdf5CompressionPerformance", rName, false);
+            writer.DefineFixedDimension(number_nodes);
+            std::vector<int> striped_variable_IDs;
+            striped_variable_IDs.push_back(writer.DefineVariable("V", "millivolts"));
+            striped_variable_IDs.push_back(writer.DefineVariable("Phi_e", "millivolts"));
+            writer.DefineUnlimitedDimension("Time", "msec", num_steps);
+            writer.SetCompression(type, level);
+            if (vErrorBound > 0.0)
+            {
+                writer.SetVariableErrorBound(striped_variable_IDs[0], vErrorBound);
+                writer.SetVariableErrorBound(striped_variable_IDs[1], vErrorBound);
+            }
+            writer.EndDefineMode();
+
+            for (unsigned time_step=0; time_step<num_steps; time_step++)
+            {
+                // A wavefront crossing the tissue, plus a little noise
+                for (DistributedVector::Iterator index = distributed_vector.Begin();
+                     index!= distributed_vector.End();
+                     ++index)
+                {
+                    double x = 0.001*index.Global - 2.0*time_step;
+                    vm_stripe[index] = -85.0 + 105.0/(1.0 + exp(-x)) + 1e-3*sin(7.0*index.Global);
+                    phi_e_stripe[index] = 2.0*exp(-x*x) + 1e-4*cos(3.0*index.Global);
+                }
+                distributed_vector.Restore();
+
+                writer.PutStripedVector(striped_variable_IDs, petsc_data);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+            }
+            writer.Close();
+        }
+        double elapsed = Timer::GetElapsedTime();
+        PetscTools::Destroy(petsc_data);
+
+        if (PetscTools::AmMaster())
+        {
+            OutputFileHandler handler("TestHdf5CompressionPerformance", false);
+            FileFinder file = handler.FindFile(rName + ".h5");
+            hid_t h5_file = H5Fopen(file.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            hid_t dset = H5Dopen(h5_file, "Data", H5P_DEFAULT);
+            double stored_mb = H5Dget_storage_size(dset)/1e6;
+            H5Dclose(dset);
+            H5Fclose(h5_file);
+
+            double raw_mb = number_nodes*num_steps*2*sizeof(double)/1e6;
+            std::cout << std::setw(24) << rName << ": "
+                      << raw_mb/elapsed << " MB/s, "
+                      << stored_mb << " MB stored (ratio " << raw_mb/stored_mb << ")\n" << std::flush;
+        }
+    }
+
+public:
+
+    void TestCompressionTradeOffs()
+    {
+        WriteAndReport("none", Hdf5DataWriter::NO_COMPRESSION, 0u, 0.0);
+        WriteAndReport("deflate_1", Hdf5DataWriter::DEFLATE, 1u, 0.0);
+        WriteAndReport("deflate_6", Hdf5DataWriter::DEFLATE, 6u, 0.0);
+        WriteAndReport("lz4", Hdf5DataWriter::LZ4, 0u, 0.0);
+        WriteAndReport("zstd_3", Hdf5DataWriter::ZSTD, 3u, 0.0);
+        WriteAndReport("deflate_1_bound_1e-3", Hdf5DataWriter::DEFLATE, 1u, 1e-3);
+        WriteAndReport("zstd_3_bound_1e-3", Hdf5DataWriter::ZSTD, 3u, 1e-3);
+    }
+};
+
+#endif /*TESTHDF5COMPRESSIONPERFORMANCE_HPP_*/
@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Hdf5DataWriter.hpp"
 #include "Hdf5DataReader.hpp"
+#include "Hdf5NodeBlockReader.hpp"
 #include "PetscSetupAndFinalize.hpp"
 #include "OutputFileHandler.hpp"
 #include "PetscTools.hpp"
@@ -662,6 +663,61 @@ public:
         TS_ASSERT_EQUALS(dataset_names[2], "Data");
         TS_ASSERT_EQUALS(dataset_names[3], "Data_Unlimited");
     }
+
+    void TestNodeBlockReader()
+    {
+        // This file has 100 nodes and 10 time steps (see TestHdf5DataWriterFullFormat)
+        Hdf5DataReader reader("io/test/data", "hdf5_test_full_format", false);
+        TS_ASSERT_LESS_THAN(0u, reader.GetNumberOfNodesPerChunk());
+        TS_ASSERT_LESS_THAN(0u, reader.GetNumberOfTimestepsPerChunk());
+
+        // Reading into a reused buffer gives the same as reading fresh
+        std::vector<std::vector<double> > buffer(50, std::vector<double>(3, -1.0));
+        reader.GetVariableOverTimeOverMultipleNodes("I_Na", 10, 19, buffer);
+        TS_ASSERT_EQUALS(buffer.size(), 9u);
+        for (unsigned i=0; i<buffer.size(); i++)
+        {
+            TS_ASSERT_EQUALS(buffer[i].size(), 10u);
+            for (unsigned time_step=0; time_step<10u; time_step++)
+            {
+                TS_ASSERT_DELTA(buffer[i][time_step], time_step*1000 + 200 + 10 + i, 1e-9);
+            }
+        }
+
+        for (unsigned prefetch=0; prefetch<2; prefetch++)
+        {
+            // Blocks cover the range exactly once, in order, whatever the block size
+            for (unsigned min_nodes_per_block=1; min_nodes_per_block<150; min_nodes_per_block+=37)
+            {
+                Hdf5NodeBlockReader blocks(reader, "I_K", 3, 97, min_nodes_per_block, prefetch);
+                unsigned next_node = 3;
+                while (blocks.NextBlock())
+                {
+                    TS_ASSERT_EQUALS(blocks.GetBlockLowerIndex(), next_node);
+                    TS_ASSERT_LESS_THAN(blocks.GetBlockLowerIndex(), blocks.GetBlockUpperIndex());
+                    for (unsigned node_index=blocks.GetBlockLowerIndex(); node_index<blocks.GetBlockUpperIndex(); node_index++)
+                    {
+                        std::vector<double>& r_series = blocks.rGetTimeSeries(node_index);
+                        TS_ASSERT_EQUALS(r_series.size(), 10u);
+                        for (unsigned time_step=0; time_step<r_series.size(); time_step++)
+                        {
+                            TS_ASSERT_DELTA(r_series[time_step], time_step*1000 + 100 + node_index, 1e-9);
+                        }
+                    }
+                    next_node = blocks.GetBlockUpperIndex();
+                }
+                TS_ASSERT_EQUALS(next_node, 97u);
+                TS_ASSERT(!blocks.NextBlock());
+            }
+
+            // Errors are reported by NextBlock, whether or not they happen in the background
+            Hdf5NodeBlockReader bad_variable(reader, "I_Ca", 0, 100, 1, prefetch);
+            TS_ASSERT_THROWS_CONTAINS(bad_variable.NextBlock(), "doesn't contain data for variable I_Ca");
+        }
+
+        TS_ASSERT_THROWS_THIS(Hdf5NodeBlockReader(reader, "I_K", 10, 9),
+                              "The lower node index 10 is after the upper node index 9.");
+    }
 };
 
 /************************************************************
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cxxtest/TestSuite.h>
 
+#include <cmath>
 #include <cstring> // For strcpy
 
 #include "Hdf5DataWriter.hpp"
@@ -791,6 +792,94 @@ public:
         PetscTools::Destroy(petsc_data_short);
     }
 
+    void TestHdf5DataWriterFullFormatStripedAsync()
+    {
+        int number_nodes = 100;
+        DistributedVectorFactory vec_factory(number_nodes);
+
+        Hdf5DataWriter writer(vec_factory, "TestHdf5DataWriter", "hdf5_test_full_format_striped_async", false);
+        writer.DefineFixedDimension(number_nodes);
+
+        int node_id = writer.DefineVariable("Node", "dimensionless");
+        int vm_id = writer.DefineVariable("V_m", "millivolts");
+        int phi_e_id = writer.DefineVariable("Phi_e", "millivolts");
+        int ina_id = writer.DefineVariable("I_Na", "milliamperes");
+
+        std::vector<int> striped_variable_IDs;
+        striped_variable_IDs.push_back(vm_id);
+        striped_variable_IDs.push_back(phi_e_id);
+
+        writer.DefineUnlimitedDimension("Time", "msec");
+
+        writer.EndDefineMode();
+
+        TS_ASSERT(!writer.GetUsingAsyncWrites());
+        writer.SetUseAsyncWrites(true, 2u);
+        // MPI only provides full thread support if the test was run with -mpi_thread_multiple
+        if (Hdf5WriteQueue::IsSupported())
+        {
+            TS_ASSERT(writer.GetUsingAsyncWrites());
+        }
+        else
+        {
+            // Falls back to synchronous writes, which must give the same file
+            TS_ASSERT(!writer.GetUsingAsyncWrites());
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+            Warnings::QuietDestroy();
+        }
+
+        Vec petsc_data_short = vec_factory.CreateVec();
+        DistributedVector distributed_vector_short = vec_factory.CreateDistributedVector(petsc_data_short);
+
+        Vec node_number = vec_factory.CreateVec();
+        DistributedVector distributed_node_number = vec_factory.CreateDistributedVector(node_number);
+
+        for (DistributedVector::Iterator index = distributed_vector_short.Begin();
+             index!= distributed_vector_short.End();
+             ++index)
+        {
+            distributed_node_number[index] = index.Global;
+            distributed_vector_short[index] = -0.5;
+        }
+        distributed_node_number.Restore();
+        distributed_vector_short.Restore();
+
+        Vec petsc_data_long = vec_factory.CreateVec(2);
+        for (unsigned time_step=0; time_step<10; time_step++)
+        {
+            DistributedVector distributed_vector_long = vec_factory.CreateDistributedVector(petsc_data_long);
+            DistributedVector::Stripe vm_stripe(distributed_vector_long, 0);
+            DistributedVector::Stripe phi_e_stripe(distributed_vector_long, 1);
+            for (DistributedVector::Iterator index = distributed_vector_long.Begin();
+                 index!= distributed_vector_long.End();
+                 ++index)
+            {
+                vm_stripe[index] =  time_step*1000 + index.Global*2;
+                phi_e_stripe[index] =  time_step*1000 + index.Global*2+1;
+            }
+            distributed_vector_long.Restore();
+
+            writer.PutVector(node_id, node_number);
+            writer.PutVector(ina_id, petsc_data_short);
+            writer.PutStripedVector(striped_variable_IDs, petsc_data_long);
+            writer.PutUnlimitedVariable(time_step);
+            writer.AdvanceAlongUnlimitedDimension();
+
+            // The data have been staged, so overwriting our copy mustn't affect the file
+            VecSet(petsc_data_long, -999.0);
+        }
+
+        writer.Close();
+        TS_ASSERT(!writer.GetUsingAsyncWrites());
+
+        TS_ASSERT(CompareFilesViaHdf5DataReader("TestHdf5DataWriter", "hdf5_test_full_format_striped_async", true,
+                                                "io/test/data", "hdf5_test_full_format_striped", false));
+
+        PetscTools::Destroy(node_number);
+        PetscTools::Destroy(petsc_data_long);
+        PetscTools::Destroy(petsc_data_short);
+    }
+
     void TestHdf5DataWriterStripedCached()
     {
         int number_nodes = 100;
@@ -2169,6 +2258,132 @@ public:
         H5Dclose(dset);
         H5Fclose(h5_file);
     }
+
+    void TestHdf5DataWriterCompression()
+    {
+        std::string folder("TestHdf5DataWriter");
+        const unsigned number_nodes = 1000;
+        const unsigned num_steps = 20;
+        const double v_error_bound = 1e-3;
+        DistributedVectorFactory factory(number_nodes);
+
+        // Compressed output in parallel needs a recent HDF5
+        if (PetscTools::IsParallel() && !H5_VERSION_GE(1,10,2))
+        {
+            Hdf5DataWriter writer(factory, folder, "hdf5_test_compression_fails", false);
+            TS_ASSERT_THROWS_THIS(writer.SetCompression(Hdf5DataWriter::DEFLATE),
+                                  "Writing compressed HDF5 files in parallel requires HDF5 1.10.2 or later.");
+            return;
+        }
+        TS_ASSERT(Hdf5DataWriter::IsCompressionAvailable(Hdf5DataWriter::NO_COMPRESSION));
+        TS_ASSERT(Hdf5DataWriter::IsCompressionAvailable(Hdf5DataWriter::DEFLATE));
+
+        Vec petsc_data_long = factory.CreateVec(2);
+        DistributedVector distributed_vector_long = factory.CreateDistributedVector(petsc_data_long);
+        DistributedVector::Stripe vm_stripe(distributed_vector_long, 0);
+        DistributedVector::Stripe phi_e_stripe(distributed_vector_long, 1);
+
+        // Write the same data uncompressed, and compressed with V stored lossily
+        for (unsigned compress=0; compress<2; compress++)
+        {
+            Hdf5DataWriter writer(factory, folder, compress ? "hdf5_test_compressed" : "hdf5_test_uncompressed", false);
+            writer.DefineFixedDimension(number_nodes);
+            int vm_id = writer.DefineVariable("V", "millivolts");
+            int phi_e_id = writer.DefineVariable("Phi_e", "millivolts");
+            writer.DefineUnlimitedDimension("Time", "msec", num_steps);
+
+            std::vector<int> striped_variable_IDs;
+            striped_variable_IDs.push_back(vm_id);
+            striped_variable_IDs.push_back(phi_e_id);
+
+            if (compress)
+            {
+                TS_ASSERT_THROWS_THIS(writer.SetCompression(Hdf5DataWriter::DEFLATE, 10u),
+                                      "Compression level 10 is not valid for this filter.");
+                writer.SetCompression(Hdf5DataWriter::DEFLATE, 4u);
+                TS_ASSERT_THROWS_THIS(writer.SetVariableErrorBound(2, 1.0), "Variable 2 has not been defined.");
+                TS_ASSERT_THROWS_THIS(writer.SetVariableErrorBound(vm_id, -1.0), "The error bound must be non-negative.");
+                writer.SetVariableErrorBound(vm_id, v_error_bound);
+            }
+            writer.EndDefineMode();
+            TS_ASSERT_EQUALS(writer.GetCompression(), compress ? Hdf5DataWriter::DEFLATE : Hdf5DataWriter::NO_COMPRESSION);
+            TS_ASSERT_THROWS_THIS(writer.SetCompression(Hdf5DataWriter::NO_COMPRESSION),
+                                  "Cannot set compression when not in define mode.");
+
+            for (unsigned time_step=0; time_step<num_steps; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_vector_long.Begin();
+                     index!= distributed_vector_long.End();
+                     ++index)
+                {
+                    vm_stripe[index] = -85.0 + 100.0*sin(0.01*index.Global + 0.3*time_step);
+                    phi_e_stripe[index] = 10.0*cos(0.01*index.Global + 0.3*time_step);
+                }
+                distributed_vector_long.Restore();
+
+                writer.PutStripedVector(striped_variable_IDs, petsc_data_long);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+            }
+            writer.Close();
+        }
+
+        // The solution vector itself must not have been quantised
+        for (DistributedVector::Iterator index = distributed_vector_long.Begin();
+             index!= distributed_vector_long.End();
+             ++index)
+        {
+            TS_ASSERT_EQUALS(vm_stripe[index], -85.0 + 100.0*sin(0.01*index.Global + 0.3*(num_steps-1)));
+        }
+
+        // Reading is transparent: Phi_e is unchanged and V is within its error bound
+        Hdf5DataReader compressed_reader(folder, "hdf5_test_compressed");
+        Hdf5DataReader uncompressed_reader(folder, "hdf5_test_uncompressed");
+        Vec compressed = factory.CreateVec();
+        Vec uncompressed = factory.CreateVec();
+        DistributedVector distributed_compressed = factory.CreateDistributedVector(compressed);
+        DistributedVector distributed_uncompressed = factory.CreateDistributedVector(uncompressed);
+        for (unsigned time_step=0; time_step<num_steps; time_step++)
+        {
+            compressed_reader.GetVariableOverNodes(compressed, "Phi_e", time_step);
+            uncompressed_reader.GetVariableOverNodes(uncompressed, "Phi_e", time_step);
+            for (DistributedVector::Iterator index = distributed_compressed.Begin();
+                 index!= distributed_compressed.End();
+                 ++index)
+            {
+                TS_ASSERT_EQUALS(distributed_compressed[index], distributed_uncompressed[index]);
+            }
+
+            compressed_reader.GetVariableOverNodes(compressed, "V", time_step);
+            uncompressed_reader.GetVariableOverNodes(uncompressed, "V", time_step);
+            for (DistributedVector::Iterator index = distributed_compressed.Begin();
+                 index!= distributed_compressed.End();
+                 ++index)
+            {
+                TS_ASSERT_DELTA(distributed_compressed[index], distributed_uncompressed[index], v_error_bound);
+            }
+        }
+        compressed_reader.Close();
+        uncompressed_reader.Close();
+
+        // The compressed dataset takes much less space
+        OutputFileHandler file_handler(folder, false);
+        hsize_t storage_size[2];
+        for (unsigned compress=0; compress<2; compress++)
+        {
+            FileFinder file = file_handler.FindFile(compress ? "hdf5_test_compressed.h5" : "hdf5_test_uncompressed.h5");
+            hid_t h5_file = H5Fopen(file.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+            hid_t dset = H5Dopen(h5_file, "Data", H5P_DEFAULT);
+            storage_size[compress] = H5Dget_storage_size(dset);
+            H5Dclose(dset);
+            H5Fclose(h5_file);
+        }
+        TS_ASSERT_LESS_THAN(storage_size[1], storage_size[0]/2);
+
+        PetscTools::Destroy(compressed);
+        PetscTools::Destroy(uncompressed);
+        PetscTools::Destroy(petsc_data_long);
+    }
 };
 
 #endif /*TESTHDF5DATAWRITER_HPP_*/
@@ -227,6 +227,12 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::SetNode(unsigned index,
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::CanMoveNodesInPlace() const
+{
+    return true;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableMesh<ELEMENT_DIM, SPACE_DIM>::DeleteNode(unsigned index)
 {
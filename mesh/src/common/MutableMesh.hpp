@@ -240,6 +240,13 @@ public:
      */
     virtual void SetNode(unsigned index, ChastePoint<SPACE_DIM> point, bool concreteMove=true);
 
+    /**
+     * @return whether SetNode(), without a concrete move, does nothing but move the node, so
+     * that nodes may instead be moved by changing their locations in place. Returns true;
+     * overridden in subclasses whose SetNode() does more.
+     */
+    virtual bool CanMoveNodesInPlace() const;
+
     /**
      * Move one node to another (i.e. merges the nodes), refreshing/deleting
      * elements as appropriate.
@@ -45,7 +45,8 @@ NodesOnlyMesh<SPACE_DIM>::NodesOnlyMesh()
           mMinimumNodeDomainBoundarySeparation(1.0),
           mMaxAddedNodeIndex(0u),
           mpBoxCollection(nullptr),
-          mCalculateNodeNeighbours(true)
+          mCalculateNodeNeighbours(true),
+          mUseBlockDecomposition(false)
 {
 }
 
@@ -222,6 +223,22 @@ void NodesOnlyMesh<SPACE_DIM>::SetCalculateNodeNeighbours(bool calculateNodeNeig
     mCalculateNodeNeighbours = calculateNodeNeighbours;
 }
 
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetUseBlockDecomposition(bool useBlockDecomposition)
+{
+    if (mpBoxCollection)
+    {
+        EXCEPTION("SetUseBlockDecomposition() must be called before the box collection is set up.");
+    }
+    mUseBlockDecomposition = useBlockDecomposition;
+}
+
+template<unsigned SPACE_DIM>
+bool NodesOnlyMesh<SPACE_DIM>::GetUseBlockDecomposition() const
+{
+    return mUseBlockDecomposition;
+}
+
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::CalculateInteriorNodePairs(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs)
 {
@@ -292,13 +309,26 @@ void NodesOnlyMesh<SPACE_DIM>::CalculateNodesOutsideLocalDomain()
 {
     mNodesToSendRight.clear();
     mNodesToSendLeft.clear();
+    mNodesToSendToProcesses.clear();
 
     for (typename AbstractMesh<SPACE_DIM, SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
             node_iter != this->GetNodeIteratorEnd();
             ++node_iter)
     {
         unsigned owning_process = mpBoxCollection->GetProcessOwningNode(&(*node_iter));
-        if (owning_process == PetscTools::GetMyRank())
+        if (mpBoxCollection->GetUsesBlockDecomposition())
+        {
+            if (owning_process != PetscTools::GetMyRank())
+            {
+                // Nodes can only be sent to the processes owning neighbouring blocks
+                if (mpBoxCollection->rGetHaloNodesForProcesses().find(owning_process) == mpBoxCollection->rGetHaloNodesForProcesses().end())
+                {
+                    EXCEPTION("A node has moved further than one block of the box collection in a single time step.");
+                }
+                mNodesToSendToProcesses[owning_process].push_back(node_iter->GetIndex());
+            }
+        }
+        else if (owning_process == PetscTools::GetMyRank())
         {
             // Do nothing.
         }
@@ -337,6 +367,25 @@ std::vector<unsigned>& NodesOnlyMesh<SPACE_DIM>::rGetHaloNodesToSendLeft()
     return mpBoxCollection->rGetHaloNodesLeft();
 }
 
+template<unsigned SPACE_DIM>
+std::map<unsigned, std::vector<unsigned> >& NodesOnlyMesh<SPACE_DIM>::rGetNodesToSendToProcesses()
+{
+    return mNodesToSendToProcesses;
+}
+
+template<unsigned SPACE_DIM>
+std::map<unsigned, std::vector<unsigned> >& NodesOnlyMesh<SPACE_DIM>::rGetHaloNodesToSendToProcesses()
+{
+    return mpBoxCollection->rGetHaloNodesForProcesses();
+}
+
+template<unsigned SPACE_DIM>
+unsigned NodesOnlyMesh<SPACE_DIM>::GetNeighbouringProcess(unsigned direction)
+{
+    assert(mpBoxCollection);
+    return mpBoxCollection->GetNeighbouringProcess(direction);
+}
+
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::AddNodeWithFixedIndex(Node<SPACE_DIM>* pNewNode)
 {
@@ -492,6 +541,16 @@ void NodesOnlyMesh<SPACE_DIM>::EnlargeBoxCollection()
     int num_local_rows = mpBoxCollection->GetNumLocalRows();
     int new_local_rows = num_local_rows + (int)(PetscTools::AmTopMost()) + (int)(PetscTools::AmMaster());
 
+    // The blocks keep their boxes, which all move up one slice, and the new slices join the outer blocks
+    std::vector<std::vector<unsigned> > new_block_boundaries = mpBoxCollection->rGetBlockBoundaries();
+    for (unsigned d=0; d<new_block_boundaries.size(); d++)
+    {
+        for (unsigned i=1; i<new_block_boundaries[d].size(); i++)
+        {
+            new_block_boundaries[d][i] += (i+1 < new_block_boundaries[d].size()) ? 1 : 2;
+        }
+    }
+
     c_vector<double, 2*SPACE_DIM> current_domain_size = mpBoxCollection->rGetDomainSize();
     c_vector<double, 2*SPACE_DIM> new_domain_size = current_domain_size;
 
@@ -503,7 +562,15 @@ void NodesOnlyMesh<SPACE_DIM>::EnlargeBoxCollection()
         new_domain_size[2*d] = current_domain_size[2*d] - (mMaximumInteractionDistance - fudge);
         new_domain_size[2*d+1] = current_domain_size[2*d+1] + (mMaximumInteractionDistance - fudge);
     }
-    SetUpBoxCollection(mMaximumInteractionDistance, new_domain_size, new_local_rows);
+
+    if (mpBoxCollection->GetUsesBlockDecomposition())
+    {
+        SetUpBlockBoxCollection(mMaximumInteractionDistance, new_domain_size, new_block_boundaries);
+    }
+    else
+    {
+        SetUpBoxCollection(mMaximumInteractionDistance, new_domain_size, new_local_rows);
+    }
 }
 
 template<unsigned SPACE_DIM>
@@ -562,6 +629,17 @@ void NodesOnlyMesh<SPACE_DIM>::SetInitialBoxCollection(const c_vector<double, 2*
     this->SetUpBoxCollection(maxInteractionDistance, domainSize);
 }
 
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::ResetBoxCollection(double maxInteractionDistance)
+{
+    assert(mpBoxCollection);
+
+    mMaximumInteractionDistance = maxInteractionDistance;
+
+    c_vector<double, 2*SPACE_DIM> current_domain_size = mpBoxCollection->rGetDomainSize();
+    this->SetUpBoxCollection(maxInteractionDistance, current_domain_size);
+}
+
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(const std::vector<Node<SPACE_DIM>* >& rNodes)
 {
@@ -582,6 +660,16 @@ void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(const std::vector<Node<SPACE_D
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(double cutOffLength, c_vector<double, 2*SPACE_DIM> domainSize, int numLocalRows, bool isPeriodic)
 {
+     if (mUseBlockDecomposition)
+     {
+         if (isPeriodic)
+         {
+             EXCEPTION("Block decompositions of the box collection are not available for periodic meshes.");
+         }
+         SetUpBlockBoxCollection(cutOffLength, domainSize, std::vector<std::vector<unsigned> >());
+         return;
+     }
+
      ClearBoxCollection();
 
      mpBoxCollection = new DistributedBoxCollection<SPACE_DIM>(cutOffLength, domainSize, isPeriodic, numLocalRows);
@@ -589,17 +677,29 @@ void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(double cutOffLength, c_vector<
      mpBoxCollection->SetCalculateNodeNeighbours(mCalculateNodeNeighbours);
 }
 
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetUpBlockBoxCollection(double cutOffLength, c_vector<double, 2*SPACE_DIM> domainSize, const std::vector<std::vector<unsigned> >& rBlockBoundaries)
+{
+     ClearBoxCollection();
+
+     mpBoxCollection = new DistributedBoxCollection<SPACE_DIM>(cutOffLength, domainSize, rBlockBoundaries);
+     mpBoxCollection->SetupLocalBoxesHalfOnly();
+     mpBoxCollection->SetCalculateNodeNeighbours(mCalculateNodeNeighbours);
+}
+
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::AddNodesToBoxes()
 {
-     // Put the nodes in the boxes.
+     // Put the nodes in the boxes, in index order.
+     std::vector<Node<SPACE_DIM>*> nodes;
+     nodes.reserve(this->GetNumNodes());
      for (typename AbstractMesh<SPACE_DIM, SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
                node_iter != this->GetNodeIteratorEnd();
                ++node_iter)
      {
-          unsigned box_index = mpBoxCollection->CalculateContainingBox(&(*node_iter));
-          mpBoxCollection->rGetBox(box_index).AddNode(&(*node_iter));
+          nodes.push_back(&(*node_iter));
      }
+     mpBoxCollection->AddNodesToBoxes(nodes);
 }
 
 template<unsigned SPACE_DIM>
@@ -645,10 +745,6 @@ void NodesOnlyMesh<SPACE_DIM>::ResizeBoxCollection()
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::LoadBalanceMesh()
 {
-    std::vector<int> local_node_distribution = mpBoxCollection->CalculateNumberOfNodesInEachStrip();
-
-    unsigned new_rows = mpBoxCollection->LoadBalance(local_node_distribution);
-
     c_vector<double, 2*SPACE_DIM> current_domain_size = mpBoxCollection->rGetDomainSize();
 
     // This ensures the domain will stay the same size.
@@ -658,7 +754,23 @@ void NodesOnlyMesh<SPACE_DIM>::LoadBalanceMesh()
         current_domain_size[2*d] = current_domain_size[2*d] + fudge;
         current_domain_size[2*d+1] = current_domain_size[2*d+1] - fudge;
     }
-    SetUpBoxCollection(mMaximumInteractionDistance, current_domain_size, new_rows);
+
+    if (mpBoxCollection->GetUsesBlockDecomposition())
+    {
+        std::vector<std::vector<int> > node_distribution = mpBoxCollection->CalculateNumberOfNodesInEachSlice();
+
+        std::vector<std::vector<unsigned> > new_block_boundaries = mpBoxCollection->LoadBalanceBlocks(node_distribution);
+
+        SetUpBlockBoxCollection(mMaximumInteractionDistance, current_domain_size, new_block_boundaries);
+    }
+    else
+    {
+        std::vector<int> local_node_distribution = mpBoxCollection->CalculateNumberOfNodesInEachStrip();
+
+        unsigned new_rows = mpBoxCollection->LoadBalance(local_node_distribution);
+
+        SetUpBoxCollection(mMaximumInteractionDistance, current_domain_size, new_rows);
+    }
 }
 
 template<unsigned SPACE_DIM>
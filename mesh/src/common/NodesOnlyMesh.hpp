@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NODESONLYMESH_HPP_
 
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
 
@@ -74,6 +75,7 @@ private:
     {
         archive & mMaximumInteractionDistance;
         archive & mMinimumNodeDomainBoundarySeparation;
+        archive & mUseBlockDecomposition;
         std::vector<unsigned> indices = GetAllNodeIndices();
         archive & indices;
         archive & boost::serialization::base_object<MutableMesh<SPACE_DIM, SPACE_DIM> >(*this);
@@ -95,6 +97,10 @@ private:
     {
         archive & mMaximumInteractionDistance;
         archive & mMinimumNodeDomainBoundarySeparation;
+        if (version > 0)
+        {
+            archive & mUseBlockDecomposition;
+        }
         std::vector<unsigned> indices;
         archive & indices;
         archive & boost::serialization::base_object<MutableMesh<SPACE_DIM, SPACE_DIM> >(*this);
@@ -138,6 +144,9 @@ private:
     /** A list of global indices of nodes that need to be moved to the left hand process. */
     std::vector<unsigned> mNodesToSendLeft;
 
+    /** For each neighbouring process, the global indices of nodes that need to be moved to it (block decomposition only). */
+    std::map<unsigned, std::vector<unsigned> > mNodesToSendToProcesses;
+
     /**A list of flags showing which initial nodes passed to ConstructNodesWithoutMesh
      * were created on this process. */
     std::vector<bool> mLocalInitialNodes;
@@ -152,6 +161,9 @@ private:
     /** Whether to calculate node neighbours in the box collection. Switch off for efficiency */
     bool mCalculateNodeNeighbours;
 
+    /** Whether to split the box collection between processes in blocks rather than rows, defaults to false. */
+    bool mUseBlockDecomposition;
+
     /**
      * Calculate the next unique global index available on this
      * process. Uses a hashing function to ensure that a unique
@@ -221,6 +233,15 @@ protected:
      */
      virtual void SetUpBoxCollection(double cutOffLength, c_vector<double, 2*SPACE_DIM> domainSize, int numLocalRows = PETSC_DECIDE, bool isPeriodic = false);
 
+    /**
+     * Set up a box collection that is split between processes in blocks.
+     *
+     * @param cutOffLength the cut off length for node neighbours.
+     * @param domainSize the size of the domain containing the nodes.
+     * @param rBlockBoundaries the block boundaries along each axis, or empty to split the boxes evenly.
+     */
+     void SetUpBlockBoxCollection(double cutOffLength, c_vector<double, 2*SPACE_DIM> domainSize, const std::vector<std::vector<unsigned> >& rBlockBoundaries);
+
      /** @return mpBoxCollection */
      DistributedBoxCollection<SPACE_DIM>* GetBoxCollection();
 
@@ -338,6 +359,21 @@ public:
      */
     void SetCalculateNodeNeighbours(bool calculateNodeNeighbours);
 
+    /**
+     * Set whether to split the box collection between processes in blocks, with halo exchange across
+     * faces, edges and corners, rather than in rows along the last axis.  This scales better to large
+     * numbers of processes.  Must be called before ConstructNodesWithoutMesh(), and is not available
+     * for periodic meshes.
+     *
+     * @param useBlockDecomposition whether to use a block decomposition (defaults to true).
+     */
+    void SetUseBlockDecomposition(bool useBlockDecomposition=true);
+
+    /**
+     * @return #mUseBlockDecomposition
+     */
+    bool GetUseBlockDecomposition() const;
+
     /**
      * Calculate pairs of nodes from interior boxes using the BoxCollection.
      *
@@ -368,6 +404,13 @@ public:
      */
     void SetInitialBoxCollection(const c_vector<double, 2*SPACE_DIM> domainSize, double maxInteractionDistance);
 
+    /**
+     * Change the max interaction distance and rebuild the box collection over the same domain,
+     * with boxes of the new width. The nodes are put back in the boxes by the next UpdateBoxCollection().
+     * @param maxInteractionDistance the new max interaction distance between nodes.
+     */
+    void ResetBoxCollection(double maxInteractionDistance);
+
     /**
      * Clear the old box collection and set up a new one if necessary.
      */
@@ -390,7 +433,8 @@ public:
     void AddHaloNodesToBoxes();
 
     /**
-     * Work out which nodes lie outside the local domain and add their indices to the vectors #mNodesToSendLeft and #mNodesToSendRight.
+     * Work out which nodes lie outside the local domain and add their indices to the vectors #mNodesToSendLeft and #mNodesToSendRight,
+     * or to #mNodesToSendToProcesses if the box collection is split into blocks.
      */
     void CalculateNodesOutsideLocalDomain();
 
@@ -414,6 +458,24 @@ public:
      */
     std::vector<unsigned>& rGetHaloNodesToSendLeft();
 
+    /**
+     * @return #mNodesToSendToProcesses.
+     */
+    std::map<unsigned, std::vector<unsigned> >& rGetNodesToSendToProcesses();
+
+    /**
+     * @return the indices of halo nodes, owned by this process, to send to each neighbouring process (block decomposition only).
+     */
+    std::map<unsigned, std::vector<unsigned> >& rGetHaloNodesToSendToProcesses();
+
+    /**
+     * Get the process owning a neighbouring block of the box collection, see DistributedBoxCollection::GetNeighbouringProcess().
+     *
+     * @param direction the direction of the neighbouring block
+     * @return the rank of the process, or UNSIGNED_UNSET if there is none.
+     */
+    unsigned GetNeighbouringProcess(unsigned direction);
+
     /**
      * Add a temporary halo node on this process.
      * @param pNewNode a shared pointer to the new node to add.
@@ -470,7 +532,7 @@ public:
     void SetMinimumNodeDomainBoundarySeparation(double separation);
 
     /**
-     * Re-allocate the underlaying BoxCollection rows based on the load-balance algorithm implemented
+     * Re-allocate the underlaying BoxCollection rows (or blocks) based on the load-balance algorithm implemented
      * in the box collection.
      */
     void LoadBalanceMesh();
@@ -492,4 +554,23 @@ public:
 #include "SerializationExportWrapper.hpp"
 EXPORT_TEMPLATE_CLASS_SAME_DIMS(NodesOnlyMesh)
 
+namespace boost
+{
+namespace serialization
+{
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(NodesOnlyMesh, 1)
+ * with a templated class.
+ */
+template <unsigned SPACE_DIM>
+struct version<NodesOnlyMesh<SPACE_DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+}
+} // namespace ...
+
 #endif /*NODESONLYMESH_HPP_*/
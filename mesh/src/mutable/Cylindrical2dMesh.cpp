@@ -510,6 +510,11 @@ void Cylindrical2dMesh::SetNode(unsigned index, ChastePoint<2> point, bool concr
     MutableMesh<2,2>::SetNode(index, point, concreteMove);
 }
 
+bool Cylindrical2dMesh::CanMoveNodesInPlace() const
+{
+    return false;
+}
+
 double Cylindrical2dMesh::GetWidth(const unsigned& rDimension) const
 {
     double width = 0.0;
@@ -273,6 +273,13 @@ public:
      */
     void SetNode(unsigned index, ChastePoint<2> point, bool concreteMove);
 
+    /**
+     * Overridden CanMoveNodesInPlace() method.
+     *
+     * @return false, since SetNode() moves nodes back onto the cylinder.
+     */
+    bool CanMoveNodesInPlace() const;
+
     /**
      * Overridden GetWidth() method.
      *
@@ -111,6 +111,11 @@ void Cylindrical2dNodesOnlyMesh::SetNode(unsigned nodeIndex, ChastePoint<2> poin
     this->GetNode(nodeIndex)->SetPoint(point);
 }
 
+bool Cylindrical2dNodesOnlyMesh::CanMoveNodesInPlace() const
+{
+    return false;
+}
+
 unsigned Cylindrical2dNodesOnlyMesh::AddNode(Node<2>* pNewNode)
 {
     // Call method on parent class
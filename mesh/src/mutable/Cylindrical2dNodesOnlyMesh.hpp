@@ -133,6 +133,13 @@ public:
      */
     void SetNode(unsigned nodeIndex, ChastePoint<2> point, bool concreteMove = false);
 
+    /**
+     * Overridden CanMoveNodesInPlace() method.
+     *
+     * @return false, since SetNode() moves nodes back onto the cylinder.
+     */
+    bool CanMoveNodesInPlace() const;
+
     /**
      * Overridden AddNode() method.
      *
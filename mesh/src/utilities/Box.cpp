@@ -34,40 +34,67 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Box.hpp"
 
+#include <algorithm>
+
 template<unsigned DIM>
 void Box<DIM>::AddNode(Node<DIM>* pNode)
 {
-    mNodesContained.insert(pNode);
+    mNodesContained.push_back(pNode);
+}
+
+template<unsigned DIM>
+void Box<DIM>::AddNodes(typename std::vector< Node<DIM>* >::const_iterator first,
+                        typename std::vector< Node<DIM>* >::const_iterator last)
+{
+    mNodesContained.insert(mNodesContained.end(), first, last);
 }
 
 template<unsigned DIM>
 void Box<DIM>::RemoveNode(Node<DIM>* pNode)
 {
-    mNodesContained.erase(pNode);
+    typename std::vector< Node<DIM>* >::iterator iter = std::find(mNodesContained.begin(), mNodesContained.end(), pNode);
+    if (iter != mNodesContained.end())
+    {
+        mNodesContained.erase(iter);
+    }
 }
 
 template<unsigned DIM>
 void Box<DIM>::ClearNodes()
 {
-    mNodesContained = std::set< Node<DIM>* >();
+    mNodesContained.clear();
 }
 
 template<unsigned DIM>
 std::set< Node<DIM>* >& Box<DIM>::rGetNodesContained()
 {
-    return mNodesContained;
+    mNodesContainedSet = std::set< Node<DIM>* >(mNodesContained.begin(), mNodesContained.end());
+    return mNodesContainedSet;
 }
 
 template<unsigned DIM>
 void Box<DIM>::AddElement(Element<DIM,DIM>* pElement)
 {
-    mElementsContained.insert(pElement);
+    mElementsContained.push_back(pElement);
 }
 
 ///\todo #2308 there are no methods to remove or clear elements
 
 template<unsigned DIM>
 std::set< Element<DIM,DIM>* >& Box<DIM>::rGetElementsContained()
+{
+    mElementsContainedSet = std::set< Element<DIM,DIM>* >(mElementsContained.begin(), mElementsContained.end());
+    return mElementsContainedSet;
+}
+
+template<unsigned DIM>
+const std::vector< Node<DIM>* >& Box<DIM>::rGetNodesContainedVector() const
+{
+    return mNodesContained;
+}
+
+template<unsigned DIM>
+const std::vector< Element<DIM,DIM>* >& Box<DIM>::rGetElementsContainedVector() const
 {
     return mElementsContained;
 }
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BOX_HPP_
 
 #include <set>
+#include <vector>
 
 #include "UblasVectorInclude.hpp"
 #include "Node.hpp"
@@ -44,27 +45,47 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /**
  * A small class for a nD 'box' defined by its min/max x/y/z values which
- * can contains a list of nodes and elements located in that box
+ * can contains a list of nodes and elements located in that box.
+ *
+ * The contents are stored in contiguous arrays, in the order they were added,
+ * rather than in trees: boxes are emptied and refilled every time step, and a
+ * cleared box keeps its storage so that refilling it doesn't allocate. Code
+ * that visits the contents often should use rGetNodesContainedVector() and
+ * rGetElementsContainedVector(), which return these arrays.
  */
 template<unsigned DIM>
 class Box
 {
 private:
 
-    /** Nodes contained in this box. */
-    std::set< Node<DIM>* > mNodesContained;
+    /** Nodes contained in this box, in the order they were added. */
+    std::vector< Node<DIM>* > mNodesContained;
 
-    /** Elements contained in this box. */
-    std::set< Element<DIM,DIM>* > mElementsContained;
+    /** Elements contained in this box, in the order they were added. */
+    std::vector< Element<DIM,DIM>* > mElementsContained;
+
+    /** Nodes contained in this box, as a set; only filled by rGetNodesContained(). */
+    std::set< Node<DIM>* > mNodesContainedSet;
+
+    /** Elements contained in this box, as a set; only filled by rGetElementsContained(). */
+    std::set< Element<DIM,DIM>* > mElementsContainedSet;
 
 public:
 
     /**
-     * Add a node to this box.
+     * Add a node to this box.  The node must not already be in the box.
      * @param pNode address of the node to be added
      */
     void AddNode(Node<DIM>* pNode);
 
+    /**
+     * Add a number of nodes to this box, in order.  None of them may already be in the box.
+     * @param first the first of the nodes to be added
+     * @param last one past the last of the nodes to be added
+     */
+    void AddNodes(typename std::vector< Node<DIM>* >::const_iterator first,
+                  typename std::vector< Node<DIM>* >::const_iterator last);
+
     /**
      * Remove a node from this box.
      * @param pNode address of the node to be removed
@@ -72,21 +93,33 @@ public:
     void RemoveNode(Node<DIM>* pNode);
 
     /**
-     * Remove all nodes from the box.
+     * Remove all nodes from the box (keeping the storage for re-use).
      */
     void ClearNodes();
 
     /**
-     * An element to this box.
+     * An element to this box.  The element must not already be in the box.
      * @param pElement address of the element to be added
      */
     void AddElement(Element<DIM,DIM>* pElement);
 
-    /** @return all the nodes in this box. */
+    /**
+     * @return all the nodes in this box.  The set is rebuilt from the box's contents on
+     * each call, and changing it does not change the box.
+     */
     std::set< Node<DIM>* >& rGetNodesContained();
 
-    /** @return all the elements in this box. */
+    /**
+     * @return all the elements in this box.  The set is rebuilt from the box's contents on
+     * each call, and changing it does not change the box.
+     */
     std::set< Element<DIM,DIM>* >& rGetElementsContained();
+
+    /** @return all the nodes in this box, in the order they were added. */
+    const std::vector< Node<DIM>* >& rGetNodesContainedVector() const;
+
+    /** @return all the elements in this box, in the order they were added. */
+    const std::vector< Element<DIM,DIM>* >& rGetElementsContainedVector() const;
 };
 
 #endif /*BOX_HPP_*/
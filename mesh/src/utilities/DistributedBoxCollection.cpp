@@ -36,6 +36,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Exception.hpp"
 #include "MathsCustomFunctions.hpp"
 #include "Warnings.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
 
 // Static member for "fudge factor" is instantiated here
 template<unsigned DIM>
@@ -46,7 +49,8 @@ DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vecto
     : mBoxWidth(boxWidth),
       mIsPeriodicInX(isPeriodicInX),
       mAreLocalBoxesSet(false),
-      mCalculateNodeNeighbours(true)
+      mCalculateNodeNeighbours(true),
+      mUsesBlockDecomposition(false)
 {
     // Periodicity only works in 2d
     if (isPeriodicInX)
@@ -54,13 +58,156 @@ DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vecto
         assert(DIM==2);    // LCOV_EXCL_LINE
     }
 
+    SetupBoxGrid(domainSize);
+
+    // Make sure there are enough boxes for the number of processes.
+    if (mNumBoxesEachDirection(DIM-1) < PetscTools::GetNumProcs())
+    {
+        WARNING("There are more processes than convenient for the domain/mesh/box size.  The domain size has been swollen.")
+        mDomainSize[2*DIM - 1] += (PetscTools::GetNumProcs() - mNumBoxesEachDirection(DIM-1))*mBoxWidth;
+        mNumBoxesEachDirection(DIM-1) = PetscTools::GetNumProcs();
+    }
+
+    // Make a distributed vector factory to split the rows of boxes between processes.
+    mpDistributedBoxStackFactory = new DistributedVectorFactory(mNumBoxesEachDirection(DIM-1), localRows);
+
+    // Calculate how many boxes in a row / face. A useful piece of data in the class.
+    mNumBoxes = 1u;
+    for (unsigned dim=0; dim<DIM; dim++)
+    {
+        mNumBoxes *= mNumBoxesEachDirection(dim);
+    }
+
+    mNumBoxesInAFace = mNumBoxes / mNumBoxesEachDirection(DIM-1);
+
+    unsigned num_local_boxes = mNumBoxesInAFace * GetNumLocalRows();
+
+    mMinBoxIndex = mpDistributedBoxStackFactory->GetLow() * mNumBoxesInAFace;
+    mMaxBoxIndex = mpDistributedBoxStackFactory->GetHigh() * mNumBoxesInAFace - 1;
+
+    // Create the correct number of boxes and set up halos
+    mBoxes.resize(num_local_boxes);
+    mLocalBoxGlobalIndices.resize(num_local_boxes);
+    for (unsigned i=0; i<num_local_boxes; i++)
+    {
+        mLocalBoxGlobalIndices[i] = mMinBoxIndex + i;
+    }
+    SetupHaloBoxes();
+}
+
+template<unsigned DIM>
+DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vector<double, 2*DIM> domainSize, const std::vector<std::vector<unsigned> >& rBlockBoundaries)
+    : mBoxWidth(boxWidth),
+      mIsPeriodicInX(false),
+      mAreLocalBoxesSet(false),
+      mpDistributedBoxStackFactory(nullptr),
+      mCalculateNodeNeighbours(true),
+      mUsesBlockDecomposition(true)
+{
+    SetupBoxGrid(domainSize);
+
+    unsigned num_procs = PetscTools::GetNumProcs();
+    if (rBlockBoundaries.empty())
+    {
+        mNumProcessesEachDirection = CalculateProcessGrid(mNumBoxesEachDirection, num_procs);
+
+        // Make sure there are enough boxes for the number of processes along each axis.
+        bool is_swollen = false;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            if (mNumBoxesEachDirection(d) < mNumProcessesEachDirection(d))
+            {
+                mDomainSize[2*d + 1] += (mNumProcessesEachDirection(d) - mNumBoxesEachDirection(d))*mBoxWidth;
+                mNumBoxesEachDirection(d) = mNumProcessesEachDirection(d);
+                is_swollen = true;
+            }
+        }
+        if (is_swollen)
+        {
+            WARNING("There are more processes than convenient for the domain/mesh/box size.  The domain size has been swollen.")
+        }
+
+        // Split the boxes evenly along each axis
+        mBlockBoundaries.resize(DIM);
+        for (unsigned d=0; d<DIM; d++)
+        {
+            for (unsigned i=0; i<=mNumProcessesEachDirection(d); i++)
+            {
+                mBlockBoundaries[d].push_back((i*mNumBoxesEachDirection(d))/mNumProcessesEachDirection(d));
+            }
+        }
+    }
+    else
+    {
+        if (rBlockBoundaries.size() != DIM)
+        {
+            EXCEPTION("Block boundaries must be given for each axis.");
+        }
+
+        unsigned num_blocks = 1;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            const std::vector<unsigned>& r_boundaries = rBlockBoundaries[d];
+            if (r_boundaries.size() < 2 || r_boundaries.front() != 0 || r_boundaries.back() != mNumBoxesEachDirection(d))
+            {
+                EXCEPTION("The block boundaries along each axis must run from 0 to the number of boxes along that axis.");
+            }
+            for (unsigned i=1; i<r_boundaries.size(); i++)
+            {
+                if (!(r_boundaries[i-1] < r_boundaries[i]))
+                {
+                    EXCEPTION("Each block must have at least one slice of boxes along each axis.");
+                }
+            }
+            mNumProcessesEachDirection(d) = r_boundaries.size() - 1;
+            num_blocks *= mNumProcessesEachDirection(d);
+        }
+        if (num_blocks != num_procs)
+        {
+            EXCEPTION("The number of blocks must be equal to the number of processes.");
+        }
+        mBlockBoundaries = rBlockBoundaries;
+    }
+
+    mNumBoxes = 1u;
+    for (unsigned dim=0; dim<DIM; dim++)
+    {
+        mNumBoxes *= mNumBoxesEachDirection(dim);
+    }
+    mNumBoxesInAFace = mNumBoxes / mNumBoxesEachDirection(DIM-1);
+
+    // Find this process in the process grid (with x varying fastest) and the block it owns.
+    unsigned rank = PetscTools::GetMyRank();
+    for (unsigned d=0; d<DIM; d++)
+    {
+        mProcessGridIndices(d) = rank % mNumProcessesEachDirection(d);
+        rank /= mNumProcessesEachDirection(d);
+
+        mMinBoxGridIndices(d) = mBlockBoundaries[d][mProcessGridIndices(d)];
+        mMaxBoxGridIndices(d) = mBlockBoundaries[d][mProcessGridIndices(d) + 1] - 1;
+    }
+    mMinBoxIndex = CalculateGlobalIndex(mMinBoxGridIndices);
+    mMaxBoxIndex = CalculateGlobalIndex(mMaxBoxGridIndices);
+
+    SetupBlockBoxes();
+}
+
+template<unsigned DIM>
+DistributedBoxCollection<DIM>::~DistributedBoxCollection()
+{
+    delete mpDistributedBoxStackFactory;
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::SetupBoxGrid(c_vector<double, 2*DIM> domainSize)
+{
     // If the domain size is not 'divisible' (i.e. fmod(width, box_size) > 0.0) we swell the domain to enforce this.
     for (unsigned i=0; i<DIM; i++)
     {
-        double r = fmod((domainSize[2*i+1]-domainSize[2*i]), boxWidth);
+        double r = fmod((domainSize[2*i+1]-domainSize[2*i]), mBoxWidth);
         if (r > 0.0)
         {
-            domainSize[2*i+1] += boxWidth - r;
+            domainSize[2*i+1] += mBoxWidth - r;
         }
     }
 
@@ -78,41 +225,273 @@ DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vecto
             counter += mBoxWidth;
         }
     }
+}
 
-    // Make sure there are enough boxes for the number of processes.
-    if (mNumBoxesEachDirection(DIM-1) < PetscTools::GetNumProcs())
+template<unsigned DIM>
+c_vector<unsigned, DIM> DistributedBoxCollection<DIM>::CalculateProcessGrid(const c_vector<unsigned, DIM>& rNumBoxesEachDirection, unsigned numProcs)
+{
+    // By default put all the processes along the last axis, as for a split into rows
+    c_vector<unsigned, DIM> best_grid = scalar_vector<unsigned>(DIM, 1u);
+    best_grid(DIM-1) = numProcs;
+    double best_surface = DBL_MAX;
+
+    // Try each way of writing numProcs as a product of DIM factors
+    c_vector<unsigned, DIM> grid = scalar_vector<unsigned>(DIM, 1u);
+    unsigned num_grids = SmallPow(numProcs, DIM-1);
+    for (unsigned i=0; i<num_grids; i++)
     {
-        WARNING("There are more processes than convenient for the domain/mesh/box size.  The domain size has been swollen.")
-        mDomainSize[2*DIM - 1] += (PetscTools::GetNumProcs() - mNumBoxesEachDirection(DIM-1))*mBoxWidth;
-        mNumBoxesEachDirection(DIM-1) = PetscTools::GetNumProcs();
+        unsigned remainder = i;
+        unsigned product = 1;
+        for (unsigned d=0; d<DIM-1; d++)
+        {
+            grid(d) = 1 + remainder % numProcs;
+            remainder /= numProcs;
+            product *= grid(d);
+        }
+        if (numProcs % product != 0)
+        {
+            continue;
+        }
+        grid(DIM-1) = numProcs / product;
+
+        // Each block needs at least one slice of boxes along each axis
+        bool fits = true;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            fits = fits && !(rNumBoxesEachDirection(d) < grid(d));
+        }
+        if (!fits)
+        {
+            continue;
+        }
+
+        // The area of the faces of a block, in units of boxes
+        double surface = 0.0;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            double face_area = 1.0;
+            for (unsigned e=0; e<DIM; e++)
+            {
+                if (e != d)
+                {
+                    face_area *= (double)rNumBoxesEachDirection(e)/(double)grid(e);
+                }
+            }
+            surface += face_area;
+        }
+
+        if (surface < best_surface)
+        {
+            best_surface = surface;
+            best_grid = grid;
+        }
     }
 
-    // Make a distributed vector factory to split the rows of boxes between processes.
-    mpDistributedBoxStackFactory = new DistributedVectorFactory(mNumBoxesEachDirection(DIM-1), localRows);
+    return best_grid;
+}
 
-    // Calculate how many boxes in a row / face. A useful piece of data in the class.
-    mNumBoxes = 1u;
-    for (unsigned dim=0; dim<DIM; dim++)
+template<unsigned DIM>
+unsigned DistributedBoxCollection<DIM>::CalculateProcessFromGridIndices(const c_vector<unsigned, DIM>& rProcessGridIndices) const
+{
+    unsigned process = 0;
+    unsigned stride = 1;
+    for (unsigned d=0; d<DIM; d++)
     {
-        mNumBoxes *= mNumBoxesEachDirection(dim);
+        process += rProcessGridIndices(d) * stride;
+        stride *= mNumProcessesEachDirection(d);
     }
+    return process;
+}
 
-    mNumBoxesInAFace = mNumBoxes / mNumBoxesEachDirection(DIM-1);
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::SetupBlockBoxes()
+{
+    // Number the owned boxes with x varying fastest
+    c_vector<unsigned, DIM> block_size;
+    unsigned num_local_boxes = 1;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        block_size(d) = mMaxBoxGridIndices(d) - mMinBoxGridIndices(d) + 1;
+        num_local_boxes *= block_size(d);
+    }
 
-    unsigned num_local_boxes = mNumBoxesInAFace * GetNumLocalRows();
+    mBoxes.resize(num_local_boxes);
+    mLocalBoxGlobalIndices.resize(num_local_boxes);
+    for (unsigned local_index=0; local_index<num_local_boxes; local_index++)
+    {
+        c_vector<unsigned, DIM> grid_indices;
+        unsigned remainder = local_index;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            grid_indices(d) = mMinBoxGridIndices(d) + remainder % block_size(d);
+            remainder /= block_size(d);
+        }
+        mLocalBoxGlobalIndices[local_index] = CalculateGlobalIndex(grid_indices);
+    }
 
-    mMinBoxIndex = mpDistributedBoxStackFactory->GetLow() * mNumBoxesInAFace;
-    mMaxBoxIndex = mpDistributedBoxStackFactory->GetHigh() * mNumBoxesInAFace - 1;
+    // Find the neighbouring processes in each direction
+    unsigned num_directions = SmallPow(3u, DIM);
+    mNeighbouringProcesses.assign(num_directions, UNSIGNED_UNSET);
+    for (unsigned direction=0; direction<num_directions; direction++)
+    {
+        bool has_neighbour = (direction != (num_directions - 1)/2);
+        c_vector<unsigned, DIM> neighbour_grid_indices;
+        unsigned remainder = direction;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            int index = (int)mProcessGridIndices(d) + (int)(remainder % 3) - 1;
+            remainder /= 3;
+            if (index < 0 || !(index < (int)mNumProcessesEachDirection(d)))
+            {
+                has_neighbour = false;
+            }
+            else
+            {
+                neighbour_grid_indices(d) = index;
+            }
+        }
 
-    // Create the correct number of boxes and set up halos
-    mBoxes.resize(num_local_boxes);
-    SetupHaloBoxes();
+        if (has_neighbour)
+        {
+            unsigned neighbour = CalculateProcessFromGridIndices(neighbour_grid_indices);
+            mNeighbouringProcesses[direction] = neighbour;
+            mHalosForProcesses[neighbour].clear();
+            mHaloNodesForProcesses[neighbour].clear();
+        }
+    }
+
+    // The halo boxes are the layer of boxes around the block
+    c_vector<unsigned, DIM> halo_min;
+    c_vector<unsigned, DIM> halo_size;
+    unsigned num_halo_region_boxes = 1;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        halo_min(d) = (mMinBoxGridIndices(d) > 0) ? mMinBoxGridIndices(d) - 1 : 0;
+        unsigned halo_max = (mMaxBoxGridIndices(d) + 1 < mNumBoxesEachDirection(d)) ? mMaxBoxGridIndices(d) + 1 : mMaxBoxGridIndices(d);
+        halo_size(d) = halo_max - halo_min(d) + 1;
+        num_halo_region_boxes *= halo_size(d);
+    }
+    for (unsigned i=0; i<num_halo_region_boxes; i++)
+    {
+        c_vector<unsigned, DIM> grid_indices;
+        unsigned remainder = i;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            grid_indices(d) = halo_min(d) + remainder % halo_size(d);
+            remainder /= halo_size(d);
+        }
+
+        unsigned global_index = CalculateGlobalIndex(grid_indices);
+        if (!IsBoxOwned(global_index))
+        {
+            mHaloBoxes.push_back(Box<DIM>());
+            mHaloBoxesMapping[global_index] = mHaloBoxes.size() - 1;
+        }
+    }
+
+    // An owned box is a halo of the neighbour in a given direction if it lies on the faces of the block facing that way
+    for (unsigned local_index=0; local_index<num_local_boxes; local_index++)
+    {
+        c_vector<unsigned, DIM> grid_indices = CalculateGridIndices(mLocalBoxGlobalIndices[local_index]);
+
+        for (unsigned direction=0; direction<num_directions; direction++)
+        {
+            if (mNeighbouringProcesses[direction] == UNSIGNED_UNSET)
+            {
+                continue;
+            }
+
+            bool is_halo = true;
+            unsigned remainder = direction;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                unsigned offset = remainder % 3;
+                remainder /= 3;
+                if ((offset == 0 && grid_indices(d) != mMinBoxGridIndices(d)) ||
+                    (offset == 2 && grid_indices(d) != mMaxBoxGridIndices(d)))
+                {
+                    is_halo = false;
+                }
+            }
+
+            if (is_halo)
+            {
+                mHalosForProcesses[mNeighbouringProcesses[direction]].push_back(mLocalBoxGlobalIndices[local_index]);
+            }
+        }
+    }
 }
 
 template<unsigned DIM>
-DistributedBoxCollection<DIM>::~DistributedBoxCollection()
+void DistributedBoxCollection<DIM>::SetupBlockLocalBoxes(bool halfOnly)
 {
-    delete mpDistributedBoxStackFactory;
+    mLocalBoxes.clear();
+    mLocalBoxes.resize(mBoxes.size());
+
+    unsigned num_directions = SmallPow(3u, DIM);
+    for (unsigned local_index=0; local_index<mBoxes.size(); local_index++)
+    {
+        c_vector<unsigned, DIM> grid_indices = CalculateGridIndices(mLocalBoxGlobalIndices[local_index]);
+
+        for (unsigned direction=0; direction<num_directions; direction++)
+        {
+            // A neighbour is 'above' this box if the last non-zero component of its offset is positive
+            bool is_in_domain = true;
+            bool is_above = true;
+            c_vector<unsigned, DIM> neighbour_grid_indices;
+            unsigned remainder = direction;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                int offset = (int)(remainder % 3) - 1;
+                remainder /= 3;
+                if (offset != 0)
+                {
+                    is_above = (offset > 0);
+                }
+
+                int index = (int)grid_indices(d) + offset;
+                if (index < 0 || !(index < (int)mNumBoxesEachDirection(d)))
+                {
+                    is_in_domain = false;
+                }
+                else
+                {
+                    neighbour_grid_indices(d) = index;
+                }
+            }
+
+            if (is_in_domain)
+            {
+                unsigned neighbour_index = CalculateGlobalIndex(neighbour_grid_indices);
+                if (!halfOnly || is_above || !IsBoxOwned(neighbour_index))
+                {
+                    mLocalBoxes[local_index].insert(neighbour_index);
+                }
+            }
+        }
+    }
+    mAreLocalBoxesSet = true;
+}
+
+template<unsigned DIM>
+unsigned DistributedBoxCollection<DIM>::GetLocalBoxIndex(unsigned globalIndex)
+{
+    assert(IsBoxOwned(globalIndex));
+
+    if (!mUsesBlockDecomposition)
+    {
+        return globalIndex - mMinBoxIndex;
+    }
+
+    c_vector<unsigned, DIM> grid_indices = CalculateGridIndices(globalIndex);
+    unsigned local_index = 0;
+    unsigned stride = 1;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        local_index += (grid_indices(d) - mMinBoxGridIndices(d)) * stride;
+        stride *= mMaxBoxGridIndices(d) - mMinBoxGridIndices(d) + 1;
+    }
+    return local_index;
 }
 
 template<unsigned DIM>
@@ -128,6 +507,78 @@ void DistributedBoxCollection<DIM>::EmptyBoxes()
     }
 }
 
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::AddNodesToBoxes(const std::vector<Node<DIM>*>& rNodes)
+{
+    // Local boxes are numbered first, then halo boxes
+    unsigned num_boxes = mBoxes.size() + mHaloBoxes.size();
+    mBoxNodeOffsets.assign(num_boxes + 1, 0u);
+    if (rNodes.empty())
+    {
+        return;
+    }
+
+    unsigned min_index = UINT_MAX;
+    unsigned max_index = 0;
+    for (unsigned i=0; i<rNodes.size(); i++)
+    {
+        min_index = std::min(min_index, rNodes[i]->GetIndex());
+        max_index = std::max(max_index, rNodes[i]->GetIndex());
+    }
+
+    // Find the box each node goes into, listing the nodes by index, and count the nodes in each box
+    unsigned num_indices = max_index - min_index + 1;
+    mNodesByIndex.assign(num_indices, nullptr);
+    mNodeBoxSlots.resize(num_indices);
+    for (unsigned i=0; i<rNodes.size(); i++)
+    {
+        unsigned box_index = CalculateContainingBox(rNodes[i]);
+        unsigned slot;
+        if (IsBoxOwned(box_index))
+        {
+            slot = GetLocalBoxIndex(box_index);
+        }
+        else
+        {
+            assert(IsHaloBox(box_index));
+            slot = mBoxes.size() + mHaloBoxesMapping.find(box_index)->second;
+        }
+
+        unsigned position = rNodes[i]->GetIndex() - min_index;
+        assert(mNodesByIndex[position] == nullptr);
+        mNodesByIndex[position] = rNodes[i];
+        mNodeBoxSlots[position] = slot;
+        mBoxNodeOffsets[slot + 1]++;
+    }
+
+    // The prefix sums give where each box starts in one flat array...
+    for (unsigned slot=0; slot<num_boxes; slot++)
+    {
+        mBoxNodeOffsets[slot + 1] += mBoxNodeOffsets[slot];
+    }
+
+    // ...into which the nodes are scattered in index order, so that each box is sorted by node index
+    mBoxedNodes.resize(rNodes.size());
+    std::vector<unsigned> next_slot_position(mBoxNodeOffsets.begin(), mBoxNodeOffsets.end() - 1);
+    for (unsigned position=0; position<num_indices; position++)
+    {
+        if (mNodesByIndex[position] != nullptr)
+        {
+            mBoxedNodes[next_slot_position[mNodeBoxSlots[position]]++] = mNodesByIndex[position];
+        }
+    }
+
+    // Each box then takes its part of the flat array in one go
+    for (unsigned slot=0; slot<num_boxes; slot++)
+    {
+        if (mBoxNodeOffsets[slot + 1] > mBoxNodeOffsets[slot])
+        {
+            Box<DIM>& r_box = (slot < mBoxes.size()) ? mBoxes[slot] : mHaloBoxes[slot - mBoxes.size()];
+            r_box.AddNodes(mBoxedNodes.begin() + mBoxNodeOffsets[slot], mBoxedNodes.begin() + mBoxNodeOffsets[slot + 1]);
+        }
+    }
+}
+
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::SetupHaloBoxes()
 {
@@ -168,11 +619,31 @@ void DistributedBoxCollection<DIM>::SetupHaloBoxes()
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::UpdateHaloBoxes()
 {
+    if (mUsesBlockDecomposition)
+    {
+        for (std::map<unsigned, std::vector<unsigned> >::iterator process_iter = mHalosForProcesses.begin();
+             process_iter != mHalosForProcesses.end();
+             ++process_iter)
+        {
+            std::vector<unsigned>& r_halo_nodes = mHaloNodesForProcesses[process_iter->first];
+            r_halo_nodes.clear();
+            for (unsigned i=0; i<process_iter->second.size(); i++)
+            {
+                const std::vector<Node<DIM>*>& r_nodes = rGetBox(process_iter->second[i]).rGetNodesContainedVector();
+                for (unsigned j=0; j<r_nodes.size(); j++)
+                {
+                    r_halo_nodes.push_back(r_nodes[j]->GetIndex());
+                }
+            }
+        }
+        return;
+    }
+
     mHaloNodesLeft.clear();
     for (unsigned i=0; i<mHalosLeft.size(); i++)
     {
-        for (typename std::set<Node<DIM>* >::iterator iter=this->rGetBox(mHalosLeft[i]).rGetNodesContained().begin();
-                iter!=this->rGetBox(mHalosLeft[i]).rGetNodesContained().end();
+        for (typename std::vector<Node<DIM>* >::const_iterator iter=this->rGetBox(mHalosLeft[i]).rGetNodesContainedVector().begin();
+                iter!=this->rGetBox(mHalosLeft[i]).rGetNodesContainedVector().end();
                 iter++)
         {
             mHaloNodesLeft.push_back((*iter)->GetIndex());
@@ -183,8 +654,8 @@ void DistributedBoxCollection<DIM>::UpdateHaloBoxes()
     mHaloNodesRight.clear();
     for (unsigned i=0; i<mHalosRight.size(); i++)
     {
-        for (typename std::set<Node<DIM>* >::iterator iter=this->rGetBox(mHalosRight[i]).rGetNodesContained().begin();
-                iter!=this->rGetBox(mHalosRight[i]).rGetNodesContained().end();
+        for (typename std::vector<Node<DIM>* >::const_iterator iter=this->rGetBox(mHalosRight[i]).rGetNodesContainedVector().begin();
+                iter!=this->rGetBox(mHalosRight[i]).rGetNodesContainedVector().end();
                 iter++)
         {
             mHaloNodesRight.push_back((*iter)->GetIndex());
@@ -195,18 +666,40 @@ void DistributedBoxCollection<DIM>::UpdateHaloBoxes()
 template<unsigned DIM>
 unsigned DistributedBoxCollection<DIM>::GetNumLocalRows() const
 {
+    if (mUsesBlockDecomposition)
+    {
+        return mMaxBoxGridIndices(DIM-1) - mMinBoxGridIndices(DIM-1) + 1;
+    }
     return mpDistributedBoxStackFactory->GetHigh() - mpDistributedBoxStackFactory->GetLow();
 }
 
 template<unsigned DIM>
 bool DistributedBoxCollection<DIM>::IsBoxOwned(unsigned globalIndex)
 {
+    if (mUsesBlockDecomposition)
+    {
+        c_vector<unsigned, DIM> grid_indices = CalculateGridIndices(globalIndex);
+        for (unsigned d=0; d<DIM; d++)
+        {
+            if (grid_indices(d) < mMinBoxGridIndices(d) || mMaxBoxGridIndices(d) < grid_indices(d))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     return (!(globalIndex<mMinBoxIndex) && !(mMaxBoxIndex<globalIndex));
 }
 
 template<unsigned DIM>
 bool DistributedBoxCollection<DIM>::IsHaloBox(unsigned globalIndex)
 {
+    if (mUsesBlockDecomposition)
+    {
+        return (mHaloBoxesMapping.find(globalIndex) != mHaloBoxesMapping.end());
+    }
+
     bool is_halo_right = ((globalIndex > mMaxBoxIndex) && !(globalIndex > mMaxBoxIndex + mNumBoxesInAFace));
     bool is_halo_left = ((globalIndex < mMinBoxIndex) && !(globalIndex < mMinBoxIndex - mNumBoxesInAFace));
 
@@ -216,6 +709,21 @@ bool DistributedBoxCollection<DIM>::IsHaloBox(unsigned globalIndex)
 template<unsigned DIM>
 bool DistributedBoxCollection<DIM>::IsInteriorBox(unsigned globalIndex)
 {
+    if (mUsesBlockDecomposition)
+    {
+        // A box is on the boundary if it is at a face of the block that is shared with another block
+        c_vector<unsigned, DIM> grid_indices = CalculateGridIndices(globalIndex);
+        for (unsigned d=0; d<DIM; d++)
+        {
+            if ((grid_indices(d) == mMinBoxGridIndices(d) && mMinBoxGridIndices(d) > 0) ||
+                (grid_indices(d) == mMaxBoxGridIndices(d) && mMaxBoxGridIndices(d) + 1 < mNumBoxesEachDirection(d)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     bool is_on_boundary = !(globalIndex < mMaxBoxIndex - mNumBoxesInAFace) || (globalIndex < mMinBoxIndex + mNumBoxesInAFace);
 
     return (PetscTools::IsSequential() || !(is_on_boundary));
@@ -346,9 +854,9 @@ template<unsigned DIM>
 Box<DIM>& DistributedBoxCollection<DIM>::rGetBox(unsigned boxIndex)
 {
     // Check first for local ownership
-    if (!(boxIndex<mMinBoxIndex) && !(mMaxBoxIndex<boxIndex))
+    if (IsBoxOwned(boxIndex))
     {
-        return mBoxes[boxIndex-mMinBoxIndex];
+        return mBoxes[GetLocalBoxIndex(boxIndex)];
     }
 
     // If normal execution reaches this point then the box does not belong to the process so we will check for a halo box
@@ -404,7 +912,33 @@ bool DistributedBoxCollection<DIM>::GetIsPeriodicInX() const
 template<unsigned DIM>
 unsigned DistributedBoxCollection<DIM>::GetNumRowsOfBoxes() const
 {
-    return mpDistributedBoxStackFactory->GetHigh() - mpDistributedBoxStackFactory->GetLow();
+    return GetNumLocalRows();
+}
+
+template<unsigned DIM>
+bool DistributedBoxCollection<DIM>::GetUsesBlockDecomposition() const
+{
+    return mUsesBlockDecomposition;
+}
+
+template<unsigned DIM>
+c_vector<unsigned, DIM> DistributedBoxCollection<DIM>::GetNumProcessesEachDirection() const
+{
+    return mNumProcessesEachDirection;
+}
+
+template<unsigned DIM>
+const std::vector<std::vector<unsigned> >& DistributedBoxCollection<DIM>::rGetBlockBoundaries() const
+{
+    return mBlockBoundaries;
+}
+
+template<unsigned DIM>
+unsigned DistributedBoxCollection<DIM>::GetNeighbouringProcess(unsigned direction) const
+{
+    assert(mUsesBlockDecomposition);
+    assert(direction < mNeighbouringProcesses.size());
+    return mNeighbouringProcesses[direction];
 }
 
 template<unsigned DIM>
@@ -495,6 +1029,68 @@ int DistributedBoxCollection<DIM>::LoadBalance(std::vector<int> localDistributio
     return new_rows;
 }
 
+template<unsigned DIM>
+std::vector<std::vector<unsigned> > DistributedBoxCollection<DIM>::LoadBalanceBlocks(const std::vector<std::vector<int> >& rSliceDistributions)
+{
+    assert(mUsesBlockDecomposition);
+    assert(rSliceDistributions.size() == DIM);
+
+    // Every process makes the same moves, as the slice distributions are summed over all processes
+    std::vector<std::vector<unsigned> > new_boundaries = mBlockBoundaries;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        std::vector<unsigned>& r_boundaries = new_boundaries[d];
+        const std::vector<int>& r_slices = rSliceDistributions[d];
+        unsigned num_layers = r_boundaries.size() - 1;
+
+        // The load on each layer of blocks along this axis
+        std::vector<int> layer_loads(num_layers, 0);
+        for (unsigned layer=0; layer<num_layers; layer++)
+        {
+            for (unsigned slice=r_boundaries[layer]; slice<r_boundaries[layer+1]; slice++)
+            {
+                layer_loads[layer] += r_slices[slice];
+            }
+        }
+
+        // Move each boundary between layers by at most one slice, keeping at least two slices in each layer
+        for (unsigned layer=1; layer<num_layers; layer++)
+        {
+            unsigned boundary = r_boundaries[layer];
+            int load_below = layer_loads[layer-1];
+            int load_above = layer_loads[layer];
+
+            int current_imbalance = std::abs(load_above - load_below);
+            int imbalance_if_down = std::abs((load_above + r_slices[boundary-1]) - (load_below - r_slices[boundary-1]));
+            int imbalance_if_up = std::abs((load_above - r_slices[boundary]) - (load_below + r_slices[boundary]));
+
+            bool move_down = (boundary - r_boundaries[layer-1] > 2) && (imbalance_if_down < current_imbalance);
+            bool move_up = (r_boundaries[layer+1] - boundary > 2) && (imbalance_if_up < current_imbalance);
+
+            if (move_down && move_up)
+            {
+                move_up = (imbalance_if_up < imbalance_if_down);
+                move_down = !move_up;
+            }
+
+            if (move_down)
+            {
+                layer_loads[layer-1] -= r_slices[boundary-1];
+                layer_loads[layer] += r_slices[boundary-1];
+                r_boundaries[layer]--;
+            }
+            else if (move_up)
+            {
+                layer_loads[layer-1] += r_slices[boundary];
+                layer_loads[layer] -= r_slices[boundary];
+                r_boundaries[layer]++;
+            }
+        }
+    }
+
+    return new_boundaries;
+}
+
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::SetupLocalBoxesHalfOnly()
 {
@@ -502,6 +1098,10 @@ void DistributedBoxCollection<DIM>::SetupLocalBoxesHalfOnly()
     {
         EXCEPTION("Local Boxes Are Already Set");
     }
+    else if (mUsesBlockDecomposition)
+    {
+        SetupBlockLocalBoxes(true);
+    }
     else
     {
         switch (DIM)
@@ -758,6 +1358,12 @@ void DistributedBoxCollection<DIM>::SetupLocalBoxesHalfOnly()
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::SetupAllLocalBoxes()
 {
+    if (mUsesBlockDecomposition)
+    {
+        SetupBlockLocalBoxes(false);
+        return;
+    }
+
     mAreLocalBoxesSet = true;
     switch (DIM)
     {
@@ -1080,8 +1686,8 @@ template<unsigned DIM>
 std::set<unsigned>& DistributedBoxCollection<DIM>::rGetLocalBoxes(unsigned boxIndex)
 {
     // Make sure the box is locally owned
-    assert(!(boxIndex < mMinBoxIndex) && !(mMaxBoxIndex<boxIndex));
-    return mLocalBoxes[boxIndex-mMinBoxIndex];
+    assert(IsBoxOwned(boxIndex));
+    return mLocalBoxes[GetLocalBoxIndex(boxIndex)];
 }
 
 template<unsigned DIM>
@@ -1104,6 +1710,20 @@ template<unsigned DIM>
 unsigned DistributedBoxCollection<DIM>::GetProcessOwningNode(Node<DIM>* pNode)
 {
     unsigned box_index = CalculateContainingBox(pNode);
+
+    if (mUsesBlockDecomposition)
+    {
+        // Find the block containing the box along each axis
+        c_vector<unsigned, DIM> grid_indices = CalculateGridIndices(box_index);
+        c_vector<unsigned, DIM> process_grid_indices;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            process_grid_indices(d) = std::upper_bound(mBlockBoundaries[d].begin(), mBlockBoundaries[d].end(), grid_indices(d))
+                                      - mBlockBoundaries[d].begin() - 1;
+        }
+        return CalculateProcessFromGridIndices(process_grid_indices);
+    }
+
     unsigned containing_process = PetscTools::GetMyRank();
 
     if (box_index > mMaxBoxIndex)
@@ -1130,6 +1750,12 @@ std::vector<unsigned>& DistributedBoxCollection<DIM>::rGetHaloNodesLeft()
     return mHaloNodesLeft;
 }
 
+template<unsigned DIM>
+std::map<unsigned, std::vector<unsigned> >& DistributedBoxCollection<DIM>::rGetHaloNodesForProcesses()
+{
+    return mHaloNodesForProcesses;
+}
+
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::SetCalculateNodeNeighbours(bool calculateNodeNeighbours)
 {
@@ -1154,9 +1780,9 @@ void DistributedBoxCollection<DIM>::CalculateNodePairs(std::vector<Node<DIM>*>&
         }
     }
 
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    for (unsigned local_index=0; local_index<mLocalBoxGlobalIndices.size(); local_index++)
     {
-        AddPairsFromBox(box_index, rNodePairs);
+        AddPairsFromBox(mLocalBoxGlobalIndices[local_index], rNodePairs);
     }
 
     if (mCalculateNodeNeighbours)
@@ -1194,8 +1820,9 @@ void DistributedBoxCollection<DIM>::CalculateInteriorNodePairs(std::vector<Node<
         }
     }
 
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    for (unsigned local_index=0; local_index<mLocalBoxGlobalIndices.size(); local_index++)
     {
+        unsigned box_index = mLocalBoxGlobalIndices[local_index];
         if (IsInteriorBox(box_index))
         {
             AddPairsFromBox(box_index, rNodePairs);
@@ -1222,8 +1849,9 @@ void DistributedBoxCollection<DIM>::CalculateInteriorNodePairs(std::vector<Node<
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::CalculateBoundaryNodePairs(std::vector<Node<DIM>*>& rNodes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
 {
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    for (unsigned local_index=0; local_index<mLocalBoxGlobalIndices.size(); local_index++)
     {
+        unsigned box_index = mLocalBoxGlobalIndices[local_index];
         if (!IsInteriorBox(box_index))
         {
             AddPairsFromBox(box_index, rNodePairs);
@@ -1254,8 +1882,8 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
     // Get the box
     Box<DIM>& r_box = rGetBox(boxIndex);
 
-    // Get the set of nodes in this box
-    const std::set< Node<DIM>* >& r_contained_nodes = r_box.rGetNodesContained();
+    // Get the nodes in this box
+    const std::vector< Node<DIM>* >& r_contained_nodes = r_box.rGetNodesContainedVector();
 
     // Get the local boxes to this box
     const std::set<unsigned>& local_boxes_indices = rGetLocalBoxes(boxIndex);
@@ -1270,7 +1898,7 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
         // Establish whether box is locally owned or halo.
         if (IsBoxOwned(*box_iter))
         {
-            p_neighbour_box = &mBoxes[*box_iter - mMinBoxIndex];
+            p_neighbour_box = &mBoxes[GetLocalBoxIndex(*box_iter)];
         }
         else // Assume it is a halo.
         {
@@ -1278,11 +1906,11 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
         }
         assert(p_neighbour_box);
 
-        // Get the set of nodes contained in this box
-        std::set< Node<DIM>* >& r_contained_neighbour_nodes = p_neighbour_box->rGetNodesContained();
+        // Get the nodes contained in this box
+        const std::vector< Node<DIM>* >& r_contained_neighbour_nodes = p_neighbour_box->rGetNodesContainedVector();
 
         // Loop over these nodes
-        for (typename std::set<Node<DIM>*>::iterator neighbour_node_iter = r_contained_neighbour_nodes.begin();
+        for (typename std::vector<Node<DIM>*>::const_iterator neighbour_node_iter = r_contained_neighbour_nodes.begin();
              neighbour_node_iter != r_contained_neighbour_nodes.end();
              ++neighbour_node_iter)
         {
@@ -1290,7 +1918,7 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
             unsigned other_node_index = (*neighbour_node_iter)->GetIndex();
 
             // Loop over nodes in this box
-            for (typename std::set<Node<DIM>*>::iterator node_iter = r_contained_nodes.begin();
+            for (typename std::vector<Node<DIM>*>::const_iterator node_iter = r_contained_nodes.begin();
                  node_iter != r_contained_nodes.end();
                  ++node_iter)
             {
@@ -1315,19 +1943,49 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
 template<unsigned DIM>
 std::vector<int> DistributedBoxCollection<DIM>::CalculateNumberOfNodesInEachStrip()
 {
-    std::vector<int> cell_numbers(mpDistributedBoxStackFactory->GetHigh() - mpDistributedBoxStackFactory->GetLow(), 0);
+    std::vector<int> cell_numbers(GetNumLocalRows(), 0);
+    unsigned lowest_row = CalculateGridIndices(mMinBoxIndex)[DIM-1];
 
-    for (unsigned global_index=mMinBoxIndex; global_index<=mMaxBoxIndex; global_index++)
+    for (unsigned local_index=0; local_index<mLocalBoxGlobalIndices.size(); local_index++)
     {
-        c_vector<unsigned, DIM> coords = CalculateGridIndices(global_index);
-        unsigned location_in_vector = coords[DIM-1] - mpDistributedBoxStackFactory->GetLow();
-        unsigned local_index = global_index - mMinBoxIndex;
-        cell_numbers[location_in_vector] += mBoxes[local_index].rGetNodesContained().size();
+        c_vector<unsigned, DIM> coords = CalculateGridIndices(mLocalBoxGlobalIndices[local_index]);
+        unsigned location_in_vector = coords[DIM-1] - lowest_row;
+        cell_numbers[location_in_vector] += mBoxes[local_index].rGetNodesContainedVector().size();
     }
 
     return cell_numbers;
 }
 
+template<unsigned DIM>
+std::vector<std::vector<int> > DistributedBoxCollection<DIM>::CalculateNumberOfNodesInEachSlice()
+{
+    std::vector<std::vector<int> > local_numbers(DIM);
+    for (unsigned d=0; d<DIM; d++)
+    {
+        local_numbers[d].resize(mNumBoxesEachDirection(d), 0);
+    }
+
+    for (unsigned local_index=0; local_index<mLocalBoxGlobalIndices.size(); local_index++)
+    {
+        c_vector<unsigned, DIM> coords = CalculateGridIndices(mLocalBoxGlobalIndices[local_index]);
+        int num_nodes = mBoxes[local_index].rGetNodesContainedVector().size();
+        for (unsigned d=0; d<DIM; d++)
+        {
+            local_numbers[d][coords[d]] += num_nodes;
+        }
+    }
+
+    // Sum over all processes
+    std::vector<std::vector<int> > slice_numbers(DIM);
+    for (unsigned d=0; d<DIM; d++)
+    {
+        slice_numbers[d].resize(mNumBoxesEachDirection(d));
+        MPI_Allreduce(&local_numbers[d][0], &slice_numbers[d][0], mNumBoxesEachDirection(d), MPI_INT, MPI_SUM, PetscTools::GetWorld());
+    }
+
+    return slice_numbers;
+}
+
 ///////// Explicit instantiation///////
 
 template class DistributedBoxCollection<1>;
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DISTRIBUTEDBOXCOLLECTION_HPP_
 
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include <boost/serialization/vector.hpp>
 
 #include "Node.hpp"
@@ -116,6 +117,54 @@ private:
     /** A flag that can be set to not save rNodeNeighbours in CalculateNodePairs - for efficiency */
     bool mCalculateNodeNeighbours;
 
+    /** Workspace for AddNodesToBoxes(): the nodes being added, listed by index from the lowest. */
+    std::vector<Node<DIM>*> mNodesByIndex;
+
+    /** Workspace for AddNodesToBoxes(): the box each node in mNodesByIndex goes into (local boxes then halo boxes). */
+    std::vector<unsigned> mNodeBoxSlots;
+
+    /** Workspace for AddNodesToBoxes(): where the nodes going into each box start in mBoxedNodes. */
+    std::vector<unsigned> mBoxNodeOffsets;
+
+    /** Workspace for AddNodesToBoxes(): the nodes being added, box by box and in index order within each box. */
+    std::vector<Node<DIM>*> mBoxedNodes;
+
+    /** Whether the boxes are split between processes in blocks, rather than in rows along the last axis. */
+    bool mUsesBlockDecomposition;
+
+    /** The global indices of the boxes in mBoxes. */
+    std::vector<unsigned> mLocalBoxGlobalIndices;
+
+    /** The number of processes along each axis of the process grid (block decomposition only). */
+    c_vector<unsigned, DIM> mNumProcessesEachDirection;
+
+    /** The (i,j,k) position of this process in the process grid (block decomposition only). */
+    c_vector<unsigned, DIM> mProcessGridIndices;
+
+    /**
+     * For each axis, the grid index of the first slice of boxes in each block along that axis,
+     * followed by the number of boxes along that axis (block decomposition only).
+     */
+    std::vector<std::vector<unsigned> > mBlockBoundaries;
+
+    /** The grid indices of the first box owned by this process (block decomposition only). */
+    c_vector<unsigned, DIM> mMinBoxGridIndices;
+
+    /** The grid indices of the last box owned by this process (block decomposition only). */
+    c_vector<unsigned, DIM> mMaxBoxGridIndices;
+
+    /**
+     * The process owning the neighbouring block in each of the 3^DIM directions, or UNSIGNED_UNSET
+     * if there is none (block decomposition only). See GetNeighbouringProcess().
+     */
+    std::vector<unsigned> mNeighbouringProcesses;
+
+    /** For each neighbouring process, the global indices of the boxes owned here that are halos of that process. */
+    std::map<unsigned, std::vector<unsigned> > mHalosForProcesses;
+
+    /** For each neighbouring process, the nodes that are halos of that process but lie locally. */
+    std::map<unsigned, std::vector<unsigned> > mHaloNodesForProcesses;
+
     /**
      * Setup the halo box structure on this process.
      * (Private method since this is called as a helper method by the constructor.)
@@ -124,6 +173,53 @@ private:
      */
     void SetupHaloBoxes();
 
+    /**
+     * Make the domain size a whole number of boxes in each direction, and count the boxes.
+     * (Private method since this is called as a helper method by the constructors.)
+     *
+     * @param domainSize the size of the domain, in the form (xmin, xmax, ymin, ymax) (etc)
+     */
+    void SetupBoxGrid(c_vector<double, 2*DIM> domainSize);
+
+    /**
+     * Set up the owned boxes and the halo box structure for a block decomposition.
+     * (Private method since this is called as a helper method by the constructor.)
+     *
+     * Sets up the containers mBoxes, mHaloBoxes, mHalosForProcesses and mNeighbouringProcesses.
+     */
+    void SetupBlockBoxes();
+
+    /**
+     * Set up the local boxes of each owned box for a block decomposition.  The owned neighbours
+     * of a box are only included 'above' it when halfOnly is true, but its halo neighbours always are.
+     *
+     * @param halfOnly whether to set up half of the local boxes, as in SetupLocalBoxesHalfOnly()
+     */
+    void SetupBlockLocalBoxes(bool halfOnly);
+
+    /**
+     * @param globalIndex the global index of a box owned by this process
+     * @return the index of the box in mBoxes.
+     */
+    unsigned GetLocalBoxIndex(unsigned globalIndex);
+
+    /**
+     * @param rProcessGridIndices the (i,j,k) position of a process in the process grid
+     * @return the rank of the process.
+     */
+    unsigned CalculateProcessFromGridIndices(const c_vector<unsigned, DIM>& rProcessGridIndices) const;
+
+    /**
+     * Choose how many processes to place along each axis, so that the blocks have the smallest
+     * total surface (and hence the fewest halo boxes) and each has at least one slice of boxes
+     * along each axis.  If no such choice exists, all processes are placed along the last axis.
+     *
+     * @param rNumBoxesEachDirection the number of boxes along each axis
+     * @param numProcs the number of processes
+     * @return the number of processes along each axis.
+     */
+    static c_vector<unsigned, DIM> CalculateProcessGrid(const c_vector<unsigned, DIM>& rNumBoxesEachDirection, unsigned numProcs);
+
     /** Needed for serialization **/
     friend class boost::serialization::access;
 
@@ -154,6 +250,25 @@ public:
      */
     DistributedBoxCollection(double boxWidth, c_vector<double, 2*DIM> domainSize, bool isPeriodicInX = false, int localRows = PETSC_DECIDE);
 
+    /**
+     * Constructor for a box collection split between processes in blocks, rather than in rows
+     * along the last axis.  Each process owns a block of boxes and has halo boxes on the faces,
+     * edges and corners it shares with up to 3^DIM-1 neighbouring processes, which keeps the
+     * amount of halo communication down on large numbers of processes.  Periodic domains are
+     * not supported.
+     *
+     * @param boxWidth the width of each box (cut-off length in NodeBasedCellPopulation simulations)
+     * @param domainSize the size of the domain, in the form (xmin, xmax, ymin, ymax) (etc)
+     * @param rBlockBoundaries for each axis, the grid index of the first slice of boxes in each
+     *     block, followed by the number of boxes along that axis; the product of the numbers of
+     *     blocks along each axis must equal the number of processes.  If empty, the process grid
+     *     is chosen by CalculateProcessGrid() and the boxes are split evenly.
+     *
+     * As with the other constructor the domain may be swollen (with a warning) so that each block
+     * has at least one slice of boxes along each axis.
+     */
+    DistributedBoxCollection(double boxWidth, c_vector<double, 2*DIM> domainSize, const std::vector<std::vector<unsigned> >& rBlockBoundaries);
+
 
     /**
      * Destructor - frees memory allocated to distributed vector.
@@ -165,6 +280,16 @@ public:
      */
     void EmptyBoxes();
 
+    /**
+     * Add nodes to the boxes (owned or halo) containing them.  The nodes are
+     * counted box by box and scattered in index order into one flat array, from
+     * which each box takes its nodes in one go, so the nodes added to each box
+     * are sorted by index without sorting any box.
+     *
+     * @param rNodes the nodes to add
+     */
+    void AddNodesToBoxes(const std::vector<Node<DIM>*>& rNodes);
+
     /**
      * Update the halo boxes on this process, by transferring
      * the nodes to be sent into the lists mHaloNodesRight / Left.
@@ -275,6 +400,31 @@ public:
      */
     unsigned GetNumRowsOfBoxes() const;
 
+    /**
+     * @return #mUsesBlockDecomposition
+     */
+    bool GetUsesBlockDecomposition() const;
+
+    /**
+     * @return #mNumProcessesEachDirection
+     */
+    c_vector<unsigned, DIM> GetNumProcessesEachDirection() const;
+
+    /**
+     * @return #mBlockBoundaries
+     */
+    const std::vector<std::vector<unsigned> >& rGetBlockBoundaries() const;
+
+    /**
+     * Get the process owning a neighbouring block, for a block decomposition.  The 3^DIM directions
+     * are numbered with the x offset varying fastest, so direction 0 is (-1,-1,-1) in 3d, direction
+     * (3^DIM-1)/2 is this process, and direction 3^DIM-1-d is opposite to direction d.
+     *
+     * @param direction the direction of the neighbouring block
+     * @return the rank of the process owning the neighbouring block, or UNSIGNED_UNSET if there is none.
+     */
+    unsigned GetNeighbouringProcess(unsigned direction) const;
+
     /**
      * A helper function to work out the optimal number of rows to be owned by this process, to balance the
      * number of nodes.
@@ -284,6 +434,17 @@ public:
      */
     int LoadBalance(std::vector<int> localDistribution);
 
+    /**
+     * The equivalent of LoadBalance() for a block decomposition.  Each boundary between layers of
+     * blocks along each axis is moved by at most one slice of boxes, if this reduces the difference
+     * between the numbers of nodes in the two layers.  Each layer keeps at least two slices.
+     *
+     * @param rSliceDistributions the number of nodes in each slice of boxes along each axis, as
+     *     returned by CalculateNumberOfNodesInEachSlice()
+     * @return the new block boundaries, to pass to the block decomposition constructor.
+     */
+    std::vector<std::vector<unsigned> > LoadBalanceBlocks(const std::vector<std::vector<int> >& rSliceDistributions);
+
     /**
      *  Set up the local boxes (ie itself and its nearest-neighbours) for each of the boxes.
      *  This method just sets up half of the local boxes (for example, in 1D, local boxes for box0 = {1}
@@ -318,7 +479,8 @@ public:
 
     /**
      * Get the process that should own this node.
-     * Currently only returns +/-1 of this process so assumes nodes don't move too far. //\ todo this should be fixed.
+     * Currently only returns +/-1 of this process so assumes nodes don't move too far, unless the
+     * boxes are split between processes in blocks. //\ todo this should be fixed.
      *
      * @param pNode the node to be tested
      * @return the ID of the process that should own the node.
@@ -335,6 +497,11 @@ public:
      */
     std::vector<unsigned>& rGetHaloNodesLeft();
 
+    /**
+     * @return #mHaloNodesForProcesses the lists of nodes that are halos of each neighbouring process
+     */
+    std::map<unsigned, std::vector<unsigned> >& rGetHaloNodesForProcesses();
+
     /**
      * Set whether to record node neighbour in the map rNodeNeighbours during CalculateNodePairs. Set to false for efficiency if not needed.
      *
@@ -383,6 +550,14 @@ public:
      * @return A vector containing the number of nodes in each of the strips of boxes.
      */
     std::vector<int> CalculateNumberOfNodesInEachStrip();
+
+    /**
+     * Calculate how many nodes lie in each slice of boxes along each axis, summed over all
+     * processes.  Used in load balancing a block decomposition.
+     *
+     * @return for each axis, a vector containing the number of nodes in each slice of boxes.
+     */
+    std::vector<std::vector<int> > CalculateNumberOfNodesInEachSlice();
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -426,6 +601,12 @@ inline void save_construct_data(
 
         std::vector<int> const const_num_rows = num_rows;
         ar << const_num_rows;
+
+        bool uses_block_decomposition = t->GetUsesBlockDecomposition();
+        ar << uses_block_decomposition;
+
+        std::vector<std::vector<unsigned> > const block_boundaries = t->rGetBlockBoundaries();
+        ar << block_boundaries;
     }
 }
 /**
@@ -466,14 +647,48 @@ inline void load_construct_data(
         num_rows = original_rows[PetscTools::GetMyRank()];
     }
 
-    // Invoke inplace constructor to initialise instance. Assume non-periodic
-    ::new(t)DistributedBoxCollection<DIM>(cut_off, domain_size, false, num_rows);
+    // Archives written before block decompositions were introduced always use rows of boxes
+    bool uses_block_decomposition = false;
+    std::vector<std::vector<unsigned> > block_boundaries;
+    if (file_version > 0)
+    {
+        ar >> uses_block_decomposition;
+        ar >> block_boundaries;
+    }
+
+    if (uses_block_decomposition)
+    {
+        // Keep the blocks if there is still one per process, otherwise split the boxes afresh
+        if (num_original_procs != PetscTools::GetNumProcs())
+        {
+            block_boundaries.clear();
+        }
+        ::new(t)DistributedBoxCollection<DIM>(cut_off, domain_size, block_boundaries);
+    }
+    else
+    {
+        // Invoke inplace constructor to initialise instance. Assume non-periodic
+        ::new(t)DistributedBoxCollection<DIM>(cut_off, domain_size, false, num_rows);
+    }
 
     if (are_boxes_set)
     {
         t->SetupLocalBoxesHalfOnly();
     }
 }
+
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(DistributedBoxCollection, 1)
+ * with a templated class.
+ */
+template <unsigned DIM>
+struct version<DistributedBoxCollection<DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
 }
 } // namespace ...
 
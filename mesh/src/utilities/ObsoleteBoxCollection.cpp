@@ -664,10 +664,10 @@ void ObsoleteBoxCollection<DIM>::CalculateNodePairs(std::vector<Node<DIM>*>& rNo
                 box_iter++)
         {
             // Get the set of nodes contained in this box
-            std::set<Node<DIM>*>& r_contained_nodes = mBoxes[*box_iter].rGetNodesContained();
+            const std::vector<Node<DIM>*>& r_contained_nodes = mBoxes[*box_iter].rGetNodesContainedVector();
 
             // Loop over these nodes
-            for (typename std::set<Node<DIM>*>::iterator node_iter = r_contained_nodes.begin();
+            for (typename std::vector<Node<DIM>*>::const_iterator node_iter = r_contained_nodes.begin();
                     node_iter != r_contained_nodes.end(); ++node_iter)
             {
                 // Get the index of the other node
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MutableVertexMesh.hpp"
 
 #include "LogFile.hpp"
+#include "OpenMpTools.hpp"
 #include "UblasCustomFunctions.hpp"
 #include "Warnings.hpp"
 
@@ -55,7 +56,8 @@ MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh(std::vector<Node<SP
           mProtorosetteResolutionProbabilityPerTimestep(protorosetteResolutionProbabilityPerTimestep),
           mRosetteResolutionProbabilityPerTimestep(rosetteResolutionProbabilityPerTimestep),
           mCheckForInternalIntersections(false),
-          mDistanceForT3SwapChecking(5.0)
+          mDistanceForT3SwapChecking(5.0),
+          mUseParallelRemeshing(false)
 {
     // Threshold parameters must be strictly positive
     assert(cellRearrangementThreshold > 0.0);
@@ -129,7 +131,8 @@ MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh()
       mProtorosetteResolutionProbabilityPerTimestep(0.0),
       mRosetteResolutionProbabilityPerTimestep(0.0),
       mCheckForInternalIntersections(false),
-      mDistanceForT3SwapChecking(5.0)
+      mDistanceForT3SwapChecking(5.0),
+      mUseParallelRemeshing(false)
 {
     // Note that the member variables initialised above will be overwritten as soon as archiving is complete
     this->mMeshChangesDuringSimulation = true;
@@ -273,11 +276,24 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetCheckForInternalIntersections
     mCheckForInternalIntersections = checkForInternalIntersections;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetUseParallelRemeshing(bool useParallelRemeshing)
+{
+    mUseParallelRemeshing = useParallelRemeshing;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetUseParallelRemeshing() const
+{
+    return mUseParallelRemeshing;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
 {
     mDeletedNodeIndices.clear();
     mDeletedElementIndices.clear();
+    mElementGrid.Clear();
 
     VertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear();
 }
@@ -722,6 +738,137 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteNodePriorToReMesh(unsigned
     mDeletedNodeIndices.push_back(index);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::RemoveElementPriorToReMesh(unsigned index)
+{
+    // Mark any nodes that are contained only in this element as deleted
+    for (unsigned i=0; i<this->mElements[index]->GetNumNodes(); i++)
+    {
+        Node<SPACE_DIM>* p_node = this->mElements[index]->GetNode(i);
+        if (p_node->rGetContainingElementIndices().size() == 1)
+        {
+            DeleteNodePriorToReMesh(p_node->GetIndex());
+        }
+    }
+
+    // Mark this element as deleted
+    this->mElements[index]->MarkAsDeleted();
+    mDeletedElementIndices.push_back(index);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CanRearrangeAroundNode(Node<SPACE_DIM>* pNode)
+{
+    // Check each element containing the node, and each element sharing a node with one of these
+    const std::set<unsigned>& r_containing_elements = pNode->rGetContainingElementIndices();
+    for (std::set<unsigned>::const_iterator elem_iter = r_containing_elements.begin();
+         elem_iter != r_containing_elements.end();
+         ++elem_iter)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[*elem_iter];
+        for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            const std::set<unsigned>& r_neighbouring_elements = p_element->GetNode(local_index)->rGetContainingElementIndices();
+            for (std::set<unsigned>::const_iterator neighbour_iter = r_neighbouring_elements.begin();
+                 neighbour_iter != r_neighbouring_elements.end();
+                 ++neighbour_iter)
+            {
+                if (!this->mElements[*neighbour_iter]->GetOwnership())
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetOwnedElementsAwaitingRearrangement(std::vector<unsigned>& rElementIndices)
+{
+    assert(SPACE_DIM == 2); // LCOV_EXCL_LINE - code will be removed at compile time
+
+    rElementIndices.clear();
+    for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        if (!elem_iter->GetOwnership())
+        {
+            continue;
+        }
+
+        // Only elements near elements owned by other processes can be awaiting a rearrangement
+        unsigned elem_index = elem_iter->GetIndex();
+        unsigned num_nodes = elem_iter->GetNumNodes();
+        bool is_near_unowned_element = false;
+        for (unsigned local_index=0; local_index<num_nodes; local_index++)
+        {
+            if (!CanRearrangeAroundNode(elem_iter->GetNode(local_index)))
+            {
+                is_near_unowned_element = true;
+                break;
+            }
+        }
+        if (!is_near_unowned_element)
+        {
+            continue;
+        }
+
+        // Check for short edges...
+        bool is_awaiting_rearrangement = false;
+        for (unsigned local_index=0; local_index<num_nodes; local_index++)
+        {
+            if (this->GetDistanceBetweenNodes(elem_iter->GetNodeGlobalIndex(local_index),
+                                              elem_iter->GetNodeGlobalIndex((local_index+1)%num_nodes)) < mCellRearrangementThreshold)
+            {
+                is_awaiting_rearrangement = true;
+                break;
+            }
+        }
+
+        // ...small triangular elements...
+        if (num_nodes == 3 && this->GetVolumeOfElement(elem_index) < mT2Threshold)
+        {
+            is_awaiting_rearrangement = true;
+        }
+
+        // ...and nodes overlapping neighbouring elements
+        std::set<unsigned> neighbouring_elements = this->GetNeighbouringElementIndices(elem_index);
+        for (std::set<unsigned>::iterator neighbour_iter = neighbouring_elements.begin();
+             neighbour_iter != neighbouring_elements.end() && !is_awaiting_rearrangement;
+             ++neighbour_iter)
+        {
+            VertexElement<ELEMENT_DIM, SPACE_DIM>* p_neighbour = this->mElements[*neighbour_iter];
+            for (unsigned local_index=0; local_index<num_nodes; local_index++)
+            {
+                Node<SPACE_DIM>* p_node = elem_iter->GetNode(local_index);
+                if (p_node->rGetContainingElementIndices().count(*neighbour_iter) == 0
+                    && this->ElementIncludesPoint(p_node->rGetLocation(), *neighbour_iter))
+                {
+                    is_awaiting_rearrangement = true;
+                    break;
+                }
+            }
+            for (unsigned local_index=0; local_index<p_neighbour->GetNumNodes(); local_index++)
+            {
+                Node<SPACE_DIM>* p_node = p_neighbour->GetNode(local_index);
+                if (p_node->rGetContainingElementIndices().count(elem_index) == 0
+                    && this->ElementIncludesPoint(p_node->rGetLocation(), elem_index))
+                {
+                    is_awaiting_rearrangement = true;
+                    break;
+                }
+            }
+        }
+
+        if (is_awaiting_rearrangement)
+        {
+            rElementIndices.push_back(elem_index);
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideEdge(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
@@ -891,7 +1038,14 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElemen
         while (recheck_mesh == true)
         {
             // We check for any short edges and perform swaps if necessary and possible.
-            recheck_mesh = CheckForSwapsFromShortEdges();
+            if (mUseParallelRemeshing)
+            {
+                recheck_mesh = PerformNonOverlappingSwapsFromShortEdges();
+            }
+            else
+            {
+                recheck_mesh = CheckForSwapsFromShortEdges();
+            }
         }
 
         // Check for element intersections
@@ -936,78 +1090,279 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
     {
         ///\todo Could we search more efficiently by just iterating over edges? (see #2401)
 
-        unsigned num_nodes = elem_iter->GetNumNodes();
-        assert(num_nodes > 0);
+        Node<SPACE_DIM>* p_node_a;
+        Node<SPACE_DIM>* p_node_b;
+        if (FindShortEdgeForSwap(&(*elem_iter), p_node_a, p_node_b))
+        {
+            // Perform the required type of swap and halt the search, returning true
+            IdentifySwapType(p_node_a, p_node_b);
+            return true;
+        }
+    }
 
-        // Loop over the nodes contained in this element
-        for (unsigned local_index=0; local_index<num_nodes; local_index++)
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformNonOverlappingSwapsFromShortEdges()
+{
+    std::vector<VertexElement<ELEMENT_DIM,SPACE_DIM>*> elements;
+    elements.reserve(GetNumElements());
+    for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        elements.push_back(&(*elem_iter));
+    }
+    const unsigned num_elements = elements.size();
+
+    /*
+     * For each element, find the short edge that CheckForSwapsFromShortEdges() would find first on
+     * reaching it, together with the elements that a swap on this edge might affect. This only reads
+     * the mesh, so is done in parallel.
+     */
+    std::vector<Node<SPACE_DIM>*> candidate_nodes_a(num_elements, nullptr);
+    std::vector<Node<SPACE_DIM>*> candidate_nodes_b(num_elements, nullptr);
+    std::vector<std::vector<unsigned> > nearby_elements(num_elements);
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (mUseParallelRemeshing)
+#endif // CHASTE_OPENMP
+    for (unsigned i=0; i<num_elements; i++)
+    {
+        if (FindShortEdgeForSwap(elements[i], candidate_nodes_a[i], candidate_nodes_b[i]))
+        {
+            GetElementsNearEdge(candidate_nodes_a[i], candidate_nodes_b[i], nearby_elements[i]);
+        }
+        else
         {
-            // Find locations of the current node and anticlockwise node
-            Node<SPACE_DIM>* p_current_node = elem_iter->GetNode(local_index);
-            unsigned local_index_plus_one = (local_index+1)%num_nodes;    ///\todo Use iterators to tidy this up (see #2401)
-            Node<SPACE_DIM>* p_anticlockwise_node = elem_iter->GetNode(local_index_plus_one);
+            candidate_nodes_a[i] = nullptr;
+        }
+    }
+
+    // An interior edge is found from both elements containing it; only the first of these is a candidate
+    std::set<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> > candidate_edges;
+    for (unsigned i=0; i<num_elements; i++)
+    {
+        if (candidate_nodes_a[i] != nullptr)
+        {
+            std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> edge(std::min(candidate_nodes_a[i], candidate_nodes_b[i]),
+                                                               std::max(candidate_nodes_a[i], candidate_nodes_b[i]));
+            if (!candidate_edges.insert(edge).second)
+            {
+                candidate_nodes_a[i] = nullptr;
+            }
+        }
+    }
 
-            // Find distance between nodes
-            double distance_between_nodes = this->GetDistanceBetweenNodes(p_current_node->GetIndex(), p_anticlockwise_node->GetIndex());
+    /*
+     * Perform swaps in element order, as repeated calls to CheckForSwapsFromShortEdges() would. Each swap
+     * only changes elements near its edge, so the remaining candidates are unchanged unless they are near
+     * a swap already performed, in which case we stop and search the mesh again. The same applies if a
+     * swap leaves a short edge in a nearby element that would be found before the next candidate.
+     */
+    std::vector<bool> element_is_affected(this->mElements.size(), false);
+    unsigned first_affected_element_with_short_edge = UNSIGNED_UNSET;
+    bool swap_performed = false;
+
+    for (unsigned i=0; i<num_elements; i++)
+    {
+        if (candidate_nodes_a[i] == nullptr)
+        {
+            continue;
+        }
+        if (first_affected_element_with_short_edge < elements[i]->GetIndex())
+        {
+            break;
+        }
 
-            // If the nodes are too close together...
-            if (distance_between_nodes < mCellRearrangementThreshold)
+        bool is_near_previous_swap = false;
+        for (unsigned k=0; k<nearby_elements[i].size(); k++)
+        {
+            if (element_is_affected[nearby_elements[i][k]])
             {
-                // ...then check if any triangular elements are shared by these nodes...
-                std::set<unsigned> elements_of_node_a = p_current_node->rGetContainingElementIndices();
-                std::set<unsigned> elements_of_node_b = p_anticlockwise_node->rGetContainingElementIndices();
-
-                std::set<unsigned> shared_elements;
-                std::set_intersection(elements_of_node_a.begin(), elements_of_node_a.end(),
-                               elements_of_node_b.begin(), elements_of_node_b.end(),
-                               std::inserter(shared_elements, shared_elements.begin()));
-
-                bool both_nodes_share_triangular_element = false;
-                for (std::set<unsigned>::const_iterator it = shared_elements.begin();
-                     it != shared_elements.end();
-                     ++it)
-                {
-                    if (this->GetElement(*it)->GetNumNodes() <= 3)
-                    {
-                        both_nodes_share_triangular_element = true;
-                        break;
-                    }
-                }
+                is_near_previous_swap = true;
+                break;
+            }
+        }
+        if (is_near_previous_swap)
+        {
+            break;
+        }
+
+        const unsigned num_elements_before_swap = this->mElements.size();
+        IdentifySwapType(candidate_nodes_a[i], candidate_nodes_b[i]);
+        swap_performed = true;
 
-                // ...and if none are, then perform the required type of swap and halt the search, returning true
-                if (!both_nodes_share_triangular_element)
+        // Any elements added by the swap are also affected by it
+        std::vector<unsigned> affected_elements = nearby_elements[i];
+        for (unsigned index=num_elements_before_swap; index<this->mElements.size(); index++)
+        {
+            affected_elements.push_back(index);
+        }
+        element_is_affected.resize(this->mElements.size(), false);
+
+        for (unsigned k=0; k<affected_elements.size(); k++)
+        {
+            unsigned elem_index = affected_elements[k];
+            element_is_affected[elem_index] = true;
+
+            Node<SPACE_DIM>* p_node_a;
+            Node<SPACE_DIM>* p_node_b;
+            if (!this->mElements[elem_index]->IsDeleted()
+                && elem_index < first_affected_element_with_short_edge
+                && FindShortEdgeForSwap(this->mElements[elem_index], p_node_a, p_node_b))
+            {
+                first_affected_element_with_short_edge = elem_index;
+            }
+        }
+    }
+
+    return swap_performed;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::FindShortEdgeForSwap(VertexElement<ELEMENT_DIM,SPACE_DIM>* pElement,
+                                                                     Node<SPACE_DIM>*& rpNodeA,
+                                                                     Node<SPACE_DIM>*& rpNodeB)
+{
+    unsigned num_nodes = pElement->GetNumNodes();
+    assert(num_nodes > 0);
+
+    // Loop over the nodes contained in this element
+    for (unsigned local_index=0; local_index<num_nodes; local_index++)
+    {
+        // Find locations of the current node and anticlockwise node
+        Node<SPACE_DIM>* p_current_node = pElement->GetNode(local_index);
+        unsigned local_index_plus_one = (local_index+1)%num_nodes;    ///\todo Use iterators to tidy this up (see #2401)
+        Node<SPACE_DIM>* p_anticlockwise_node = pElement->GetNode(local_index_plus_one);
+
+        // Find distance between nodes
+        double distance_between_nodes = this->GetDistanceBetweenNodes(p_current_node->GetIndex(), p_anticlockwise_node->GetIndex());
+
+        // If the nodes are too close together...
+        if (distance_between_nodes < mCellRearrangementThreshold)
+        {
+            // ...then check if any triangular elements are shared by these nodes...
+            const std::set<unsigned>& elements_of_node_a = p_current_node->rGetContainingElementIndices();
+            const std::set<unsigned>& elements_of_node_b = p_anticlockwise_node->rGetContainingElementIndices();
+
+            std::set<unsigned> shared_elements;
+            std::set_intersection(elements_of_node_a.begin(), elements_of_node_a.end(),
+                           elements_of_node_b.begin(), elements_of_node_b.end(),
+                           std::inserter(shared_elements, shared_elements.begin()));
+
+            bool both_nodes_share_triangular_element = false;
+            for (std::set<unsigned>::const_iterator it = shared_elements.begin();
+                 it != shared_elements.end();
+                 ++it)
+            {
+                if (this->GetElement(*it)->GetNumNodes() <= 3)
                 {
-                    IdentifySwapType(p_current_node, p_anticlockwise_node);
-                    return true;
+                    both_nodes_share_triangular_element = true;
+                    break;
                 }
             }
+
+            // ...and if none are, then a swap is required, which can be performed if the elements around both nodes are owned
+            if (!both_nodes_share_triangular_element
+                && CanRearrangeAroundNode(p_current_node)
+                && CanRearrangeAroundNode(p_anticlockwise_node))
+            {
+                rpNodeA = p_current_node;
+                rpNodeB = p_anticlockwise_node;
+                return true;
+            }
         }
     }
 
     return false;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetElementsNearEdge(Node<SPACE_DIM>* pNodeA,
+                                                                    Node<SPACE_DIM>* pNodeB,
+                                                                    std::vector<unsigned>& rElementIndices)
+{
+    std::set<unsigned> elements_containing_edge_nodes = pNodeA->rGetContainingElementIndices();
+    elements_containing_edge_nodes.insert(pNodeB->rGetContainingElementIndices().begin(), pNodeB->rGetContainingElementIndices().end());
+
+    std::set<unsigned> nearby_elements;
+    for (std::set<unsigned>::iterator elem_iter = elements_containing_edge_nodes.begin();
+         elem_iter != elements_containing_edge_nodes.end();
+         ++elem_iter)
+    {
+        VertexElement<ELEMENT_DIM,SPACE_DIM>* p_element = this->GetElement(*elem_iter);
+        for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            const std::set<unsigned>& r_containing_elements = p_element->GetNode(local_index)->rGetContainingElementIndices();
+            nearby_elements.insert(r_containing_elements.begin(), r_containing_elements.end());
+        }
+    }
+
+    rElementIndices.assign(nearby_elements.begin(), nearby_elements.end());
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForT2Swaps(VertexElementMap& rElementMap)
 {
-    // Loop over elements to check for T2 swaps
+    std::vector<VertexElement<ELEMENT_DIM,SPACE_DIM>*> elements;
+    elements.reserve(GetNumElements());
     for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
          elem_iter != this->GetElementIteratorEnd();
          ++elem_iter)
     {
-        // If this element is triangular...
-        if (elem_iter->GetNumNodes() == 3)
+        elements.push_back(&(*elem_iter));
+    }
+    const unsigned num_elements = elements.size();
+
+    /*
+     * Find the first triangular element smaller than the threshold area. Each thread records the first
+     * such element it finds, and skips any elements after one already found by another thread.
+     */
+    const unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+    std::vector<unsigned> thread_first_elements(num_threads, UNSIGNED_UNSET);
+    unsigned found_element = UNSIGNED_UNSET;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (mUseParallelRemeshing)
+#endif // CHASTE_OPENMP
+    for (unsigned i=0; i<num_elements; i++)
+    {
+        unsigned found;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+        found = found_element;
+        if (i > found)
         {
-            // ...and smaller than the threshold area...
-            if (this->GetVolumeOfElement(elem_iter->GetIndex()) < GetT2Threshold())
-            {
-                // ...then perform a T2 swap and break out of the loop
-                PerformT2Swap(*elem_iter);
-                ///\todo: cover this line in a test
-                rElementMap.SetDeleted(elem_iter->GetIndex());
-                return true;
-            }
+            continue;
         }
+
+        // If this element is triangular and smaller than the threshold area, and the elements around it are owned...
+        if (elements[i]->GetNumNodes() == 3
+            && this->GetVolumeOfElement(elements[i]->GetIndex()) < GetT2Threshold()
+            && CanRearrangeAroundNode(elements[i]->GetNode(0))
+            && CanRearrangeAroundNode(elements[i]->GetNode(1))
+            && CanRearrangeAroundNode(elements[i]->GetNode(2)))
+        {
+            const unsigned thread = OpenMpTools::GetThreadNum();
+            thread_first_elements[thread] = std::min(thread_first_elements[thread], i);
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+            found_element = i;
+        }
+    }
+
+    unsigned first_element = *std::min_element(thread_first_elements.begin(), thread_first_elements.end());
+    if (first_element != UNSIGNED_UNSET)
+    {
+        // ...then perform a T2 swap
+        PerformT2Swap(*(elements[first_element]));
+        ///\todo: cover this line in a test
+        rElementMap.SetDeleted(elements[first_element]->GetIndex());
+        return true;
     }
     return false;
 }
@@ -1015,93 +1370,280 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForT2Swaps(VertexElementMap
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
 {
+    std::vector<unsigned> element_indices;
+    std::vector< c_vector<double, SPACE_DIM> > element_centroids;
+    const bool use_element_grid = UpdateElementGrid();
+
     // If checking for internal intersections as well as on the boundary, then check that no nodes have overlapped any elements...
     if (mCheckForInternalIntersections)
     {
-        ///\todo Change to only loop over neighbouring elements (see #2401)
-        for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
-             node_iter != this->GetNodeIteratorEnd();
-             ++node_iter)
+        for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+             elem_iter != this->GetElementIteratorEnd();
+             ++elem_iter)
         {
-            assert(!(node_iter->IsDeleted()));
-
-            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-                 elem_iter != this->GetElementIteratorEnd();
-                 ++elem_iter)
-            {
-                unsigned elem_index = elem_iter->GetIndex();
+            element_indices.push_back(elem_iter->GetIndex());
+        }
 
-                // Check that the node is not part of this element
-                if (node_iter->rGetContainingElementIndices().count(elem_index) == 0)
-                {
-                    if (this->ElementIncludesPoint(node_iter->rGetLocation(), elem_index))
-                    {
-                        PerformIntersectionSwap(&(*node_iter), elem_index);
-                        return true;
-                    }
-                }
-            }
+        Node<SPACE_DIM>* p_node;
+        unsigned elem_index;
+        if (FindFirstIntersection(element_indices, element_centroids, use_element_grid, p_node, elem_index))
+        {
+            PerformIntersectionSwap(p_node, elem_index);
+            return true;
         }
     }
     else
     {
         // ...otherwise, just check that no boundary nodes have overlapped any boundary elements
         // First: find all boundary element and calculate their centroid only once
-        std::vector<unsigned> boundary_element_indices;
-        std::vector< c_vector<double, SPACE_DIM> > boundary_element_centroids;
         for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
                 elem_iter != this->GetElementIteratorEnd();
                 ++elem_iter)
         {
             if (elem_iter->IsElementOnBoundary())
             {
-                unsigned element_index = elem_iter->GetIndex();
-                boundary_element_indices.push_back(element_index);
-                // should be a map but I am too lazy to look up the syntax
-                boundary_element_centroids.push_back(this->GetCentroidOfElement(element_index));
+                element_indices.push_back(elem_iter->GetIndex());
             }
         }
+        element_centroids.resize(element_indices.size());
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (mUseParallelRemeshing)
+#endif // CHASTE_OPENMP
+        for (unsigned i=0; i<element_indices.size(); i++)
+        {
+            element_centroids[i] = this->GetCentroidOfElement(element_indices[i]);
+        }
 
         // Second: Check intersections only for those nodes and elements within
         // mDistanceForT3SwapChecking within each other (node<-->element centroid)
-        for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
-                node_iter != this->GetNodeIteratorEnd();
-                ++node_iter)
+        Node<SPACE_DIM>* p_node;
+        unsigned elem_index;
+        if (FindFirstIntersection(element_indices, element_centroids, use_element_grid, p_node, elem_index))
+        {
+            this->PerformT3Swap(p_node, elem_index);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateElementGrid()
+{
+    /*
+     * The grid uses the coordinates of nodes directly, so can only be used if no two points in the
+     * mesh are closer together across a periodic boundary. Since GetVectorFromAtoB() wraps each
+     * component independently, it is enough to check the corners of the bounding box of the mesh.
+     */
+    ChasteCuboid<SPACE_DIM> bounding_box = this->CalculateBoundingBox();
+    const c_vector<double, SPACE_DIM>& r_lower_corner = bounding_box.rGetLowerCorner().rGetLocation();
+    const c_vector<double, SPACE_DIM>& r_upper_corner = bounding_box.rGetUpperCorner().rGetLocation();
+    c_vector<double, SPACE_DIM> diagonal = r_upper_corner - r_lower_corner;
+    if (norm_inf(this->GetVectorFromAtoB(r_lower_corner, r_upper_corner) - diagonal) > 1e-12*(1.0 + norm_inf(diagonal)))
+    {
+        mElementGrid.Clear();
+        return false;
+    }
+
+    const unsigned num_elements = this->mElements.size();
+    std::vector<c_vector<double, 2*SPACE_DIM> > bounding_boxes(num_elements);
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) if (mUseParallelRemeshing)
+#endif // CHASTE_OPENMP
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[elem_index];
+        if (!p_element->IsDeleted())
+        {
+            c_vector<double, 2*SPACE_DIM>& r_bounding_box = bounding_boxes[elem_index];
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                r_bounding_box[2*d] = DBL_MAX;
+                r_bounding_box[2*d+1] = -DBL_MAX;
+            }
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                const c_vector<double, SPACE_DIM>& r_location = p_element->GetNode(local_index)->rGetLocation();
+                for (unsigned d=0; d<SPACE_DIM; d++)
+                {
+                    r_bounding_box[2*d] = std::min(r_bounding_box[2*d], r_location[d]);
+                    r_bounding_box[2*d+1] = std::max(r_bounding_box[2*d+1], r_location[d]);
+                }
+            }
+        }
+    }
+
+    // Elements are only moved between boxes if they now overlap different boxes
+    mElementGrid.SetNumElements(num_elements);
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        if (this->mElements[elem_index]->IsDeleted())
+        {
+            mElementGrid.RemoveElement(elem_index);
+        }
+        else
+        {
+            mElementGrid.SetBoundingBox(elem_index, bounding_boxes[elem_index]);
+        }
+    }
+    mElementGrid.RebuildIfNecessary();
+
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::FindFirstIntersection(const std::vector<unsigned>& rElementIndices,
+                                                                      const std::vector<c_vector<double, SPACE_DIM> >& rElementCentroids,
+                                                                      bool useElementGrid,
+                                                                      Node<SPACE_DIM>*& rpNode,
+                                                                      unsigned& rElementIndex)
+{
+    const bool check_boundary_only = !rElementCentroids.empty();
+
+    std::vector<Node<SPACE_DIM>*> nodes;
+    nodes.reserve(this->GetNumNodes());
+    for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
+         node_iter != this->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        assert(!(node_iter->IsDeleted()));
+        if (!check_boundary_only || node_iter->IsBoundaryNode())
+        {
+            nodes.push_back(&(*node_iter));
+        }
+    }
+    const unsigned num_nodes = nodes.size();
+
+    /*
+     * Each thread records the first node it finds inside an element, and the element, and skips
+     * any nodes after one already found by another thread.
+     */
+    const unsigned num_threads = OpenMpTools::GetMaxNumThreads();
+    std::vector<unsigned> thread_first_nodes(num_threads, UNSIGNED_UNSET);
+    std::vector<unsigned> thread_first_elements(num_threads, UNSIGNED_UNSET);
+    unsigned found_node = UNSIGNED_UNSET;
+
+    /*
+     * If using the element grid, record the position of each element in rElementIndices, so that
+     * the candidate elements for each node can be tried in the same order as the given elements.
+     */
+    std::vector<unsigned> element_positions;
+    if (useElementGrid)
+    {
+        element_positions.assign(this->mElements.size(), UNSIGNED_UNSET);
+        for (unsigned k=0; k<rElementIndices.size(); k++)
+        {
+            element_positions[rElementIndices[k]] = k;
+        }
+    }
+    std::vector<std::vector<unsigned> > thread_candidates(num_threads);
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (mUseParallelRemeshing)
+#endif // CHASTE_OPENMP
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        unsigned found;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+        found = found_node;
+        if (i > found)
         {
-            if (node_iter->IsBoundaryNode())
+            continue;
+        }
+
+        const c_vector<double, SPACE_DIM>& r_node_location = nodes[i]->rGetLocation();
+
+        std::vector<unsigned>& r_candidates = thread_candidates[OpenMpTools::GetThreadNum()];
+        unsigned num_candidates = rElementIndices.size();
+        if (useElementGrid)
+        {
+            mElementGrid.GetCandidateElements(r_node_location, r_candidates);
+            num_candidates = 0;
+            for (unsigned j=0; j<r_candidates.size(); j++)
             {
-                assert(!(node_iter->IsDeleted()));
+                if (element_positions[r_candidates[j]] != UNSIGNED_UNSET)
+                {
+                    r_candidates[num_candidates++] = element_positions[r_candidates[j]];
+                }
+            }
+            r_candidates.resize(num_candidates);
+            std::sort(r_candidates.begin(), r_candidates.end());
+        }
 
-                // index in boundary_element_centroids and boundary_element_indices
-                unsigned boundary_element_index = 0;
-                for (std::vector<unsigned>::iterator elem_iter = boundary_element_indices.begin();
-                        elem_iter != boundary_element_indices.end();
-                        ++elem_iter)
+        for (unsigned j=0; j<num_candidates; j++)
+        {
+            const unsigned k = useElementGrid ? r_candidates[j] : j;
+
+            // Check that the node is not part of this element
+            if (nodes[i]->rGetContainingElementIndices().count(rElementIndices[k]) == 0)
+            {
+                if (check_boundary_only)
                 {
-                    // Check that the node is not part of this element
-                    if (node_iter->rGetContainingElementIndices().count(*elem_iter) == 0)
+                    double node_element_distance = norm_2(this->GetVectorFromAtoB(r_node_location, rElementCentroids[k]));
+                    if (node_element_distance >= mDistanceForT3SwapChecking)
                     {
-                        c_vector<double, SPACE_DIM> node_location = node_iter->rGetLocation();
-                        c_vector<double, SPACE_DIM> element_centroid = boundary_element_centroids[boundary_element_index];
-                        double node_element_distance = norm_2(this->GetVectorFromAtoB(node_location, element_centroid));
+                        continue;
+                    }
+                }
 
-                        if ( node_element_distance < mDistanceForT3SwapChecking )
-                        {
-                            if (this->ElementIncludesPoint(node_iter->rGetLocation(), *elem_iter))
-                            {
-                                this->PerformT3Swap(&(*node_iter), *elem_iter);
-                                return true;
-                            }
-                        }
+                if (this->ElementIncludesPoint(r_node_location, rElementIndices[k])
+                    && CanRearrangeAroundIntersection(nodes[i], rElementIndices[k]))
+                {
+                    const unsigned thread = OpenMpTools::GetThreadNum();
+                    if (i < thread_first_nodes[thread])
+                    {
+                        thread_first_nodes[thread] = i;
+                        thread_first_elements[thread] = rElementIndices[k];
                     }
-                    // increment the boundary element index
-                    boundary_element_index +=1u;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+                    found_node = i;
+                    break;
                 }
             }
         }
+    }
 
+    unsigned first_thread = 0;
+    for (unsigned thread=1; thread<num_threads; thread++)
+    {
+        if (thread_first_nodes[thread] < thread_first_nodes[first_thread])
+        {
+            first_thread = thread;
+        }
     }
-    return false;
+    if (thread_first_nodes[first_thread] == UNSIGNED_UNSET)
+    {
+        return false;
+    }
+
+    rpNode = nodes[thread_first_nodes[first_thread]];
+    rElementIndex = thread_first_elements[first_thread];
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CanRearrangeAroundIntersection(Node<SPACE_DIM>* pNode, unsigned elementIndex)
+{
+    if (!CanRearrangeAroundNode(pNode))
+    {
+        return false;
+    }
+
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[elementIndex];
+    for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+    {
+        if (!CanRearrangeAroundNode(p_element->GetNode(local_index)))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -3083,9 +3625,9 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForRosettes()
         Node<SPACE_DIM>* current_node = this->GetNode(node_idx);
         unsigned node_rank = current_node->rGetContainingElementIndices().size();
 
-        if (node_rank < 4)
+        if (node_rank < 4 || !CanRearrangeAroundNode(current_node))
         {
-            // Nothing to do if the node is not high-rank
+            // Nothing to do if the node is not high-rank, or the elements around it are not all owned
             continue;
         }
         else if (node_rank == 4)
@@ -49,6 +49,7 @@ class VertexMeshWriter;
 #include <boost/serialization/split_member.hpp>
 
 #include "VertexMesh.hpp"
+#include "VertexElementGrid.hpp"
 #include "RandomNumberGenerator.hpp"
 
 /**
@@ -108,6 +109,20 @@ protected:
      */
     double mDistanceForT3SwapChecking;
 
+    /**
+     * Whether ReMesh() searches for swaps in parallel and performs swaps from short edges in batches
+     * of non-overlapping swaps, rather than rescanning the mesh after every swap. Defaults to false.
+     * The swaps performed, and the order in which they are performed, are the same either way.
+     */
+    bool mUseParallelRemeshing;
+
+    /**
+     * A uniform grid over the bounding boxes of the elements, used by CheckForIntersections() to find
+     * the elements that may contain each node. Updated incrementally by UpdateElementGrid() and not
+     * archived.
+     */
+    VertexElementGrid<SPACE_DIM> mElementGrid;
+
     /**
      * Locations of T1 swaps (the mid point of the moving nodes), stored so they can be accessed and output by the cell population.
      * The locations are stored until they are cleared by ClearLocationsOfT1Swaps().
@@ -155,6 +170,48 @@ protected:
      */
     virtual bool CheckForSwapsFromShortEdges();
 
+    /**
+     * Helper method for ReMesh(), used instead of CheckForSwapsFromShortEdges() if mUseParallelRemeshing
+     * is set.
+     *
+     * Find the short edges that CheckForSwapsFromShortEdges() would find first in each element, in parallel,
+     * then call IdentifySwapType() on as many of these as possible in the order that repeated calls to
+     * CheckForSwapsFromShortEdges() would. A swap is performed only if it cannot interact with the swaps
+     * already performed, and if none of these has created a short edge in an element earlier in the mesh.
+     * Swaps are assumed to affect only elements containing a node of an element that contains the short edge.
+     *
+     * @return whether we need to check for, and implement, any further local remeshing operations
+     *                   (true if any swaps are performed).
+     */
+    bool PerformNonOverlappingSwapsFromShortEdges();
+
+    /**
+     * Helper method for CheckForSwapsFromShortEdges() and PerformNonOverlappingSwapsFromShortEdges().
+     *
+     * Find the first pair of neighbouring nodes in an element that are closer than the
+     * mCellRearrangementThreshold and are not both contained in any triangular element.
+     *
+     * @param pElement the element to search
+     * @param rpNodeA set to the first node of the pair, if one is found
+     * @param rpNodeB set to the anticlockwise node of the pair, if one is found
+     * @return whether such a pair of nodes was found
+     */
+    bool FindShortEdgeForSwap(VertexElement<ELEMENT_DIM,SPACE_DIM>* pElement,
+                              Node<SPACE_DIM>*& rpNodeA,
+                              Node<SPACE_DIM>*& rpNodeB);
+
+    /**
+     * Helper method for PerformNonOverlappingSwapsFromShortEdges().
+     *
+     * @param pNodeA one of the nodes of a short edge
+     * @param pNodeB the other node of the short edge
+     * @param rElementIndices filled with the sorted indices of the elements containing any node
+     *     of an element that contains pNodeA or pNodeB
+     */
+    void GetElementsNearEdge(Node<SPACE_DIM>* pNodeA,
+                             Node<SPACE_DIM>* pNodeB,
+                             std::vector<unsigned>& rElementIndices);
+
     /**
      * Helper method for ReMesh().
      *
@@ -165,6 +222,47 @@ protected:
      */
     bool CheckForIntersections();
 
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Update the bounding box of each element in mElementGrid.
+     *
+     * @return whether mElementGrid may be used to find the elements that may contain a node; this is
+     *     not the case if GetVectorFromAtoB() wraps around a periodic boundary within the mesh
+     */
+    bool UpdateElementGrid();
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Find the first node, in node iterator order, that lies inside one of the given elements
+     * that does not contain it, trying the elements in the given order. The search is carried
+     * out in parallel if mUseParallelRemeshing is set.
+     *
+     * @param rElementIndices the global indices of the elements to check
+     * @param rElementCentroids if not empty, the centroids of these elements; only boundary nodes,
+     *     and elements whose centroids lie within mDistanceForT3SwapChecking of them, are then checked
+     * @param useElementGrid whether to only try, for each node, the elements returned by mElementGrid
+     * @param rpNode set to the node found, if any
+     * @param rElementIndex set to the global index of the element containing this node
+     * @return whether such a node was found
+     */
+    bool FindFirstIntersection(const std::vector<unsigned>& rElementIndices,
+                               const std::vector<c_vector<double, SPACE_DIM> >& rElementCentroids,
+                               bool useElementGrid,
+                               Node<SPACE_DIM>*& rpNode,
+                               unsigned& rElementIndex);
+
+    /**
+     * Helper method for FindFirstIntersection().
+     *
+     * @param pNode pointer to a node that has been found to overlap an element
+     * @param elementIndex global index of the element
+     * @return whether the elements around the node, and around each node of the element, may be
+     *     rearranged (see CanRearrangeAroundNode())
+     */
+    bool CanRearrangeAroundIntersection(Node<SPACE_DIM>* pNode, unsigned elementIndex);
+
     /**
      * Helper method for ReMesh(), called by CheckForSwapsFromShortEdges() when
      * neighbouring nodes in an element have been found to be closer than the mCellRearrangementThreshold
@@ -514,6 +612,18 @@ public:
      */
     bool GetCheckForInternalIntersections() const;
 
+    /**
+     * Set mUseParallelRemeshing.
+     *
+     * @param useParallelRemeshing whether to search for swaps in parallel and perform non-overlapping swaps in batches
+     */
+    void SetUseParallelRemeshing(bool useParallelRemeshing=true);
+
+    /**
+     * @return mUseParallelRemeshing
+     */
+    bool GetUseParallelRemeshing() const;
+
     /**
      * @return the locations of the T1 swaps
      */
@@ -558,6 +668,35 @@ public:
      */
     void DeleteElementPriorToReMesh(unsigned index);
 
+    /**
+     * Mark an element, and any nodes contained only in it, as deleted. Unlike DeleteElementPriorToReMesh(),
+     * this does not mark the remaining nodes of the element as boundary nodes, so is used to remove elements
+     * that are moved to, or are copies of elements owned by, another process. Should only be called
+     * immediately prior to a ReMesh() being called.
+     *
+     * @param index  the global index of a specified vertex element
+     */
+    void RemoveElementPriorToReMesh(unsigned index);
+
+    /**
+     * Whether ReMesh() may rearrange the elements around a node. This requires each element containing
+     * the node, and each element sharing a node with one of these, to be owned by this process, which is
+     * always the case unless the mesh is distributed between processes (see VertexBasedCellPopulation).
+     *
+     * @param pNode pointer to the node
+     * @return whether the elements around the node may be rearranged
+     */
+    bool CanRearrangeAroundNode(Node<SPACE_DIM>* pNode);
+
+    /**
+     * Find the owned elements near which ReMesh() would rearrange the mesh (by a T1, T2 or T3 swap, or by
+     * removing an intersection), but for some of the elements involved not being owned by this process.
+     * Only implemented in 2D.
+     *
+     * @param rElementIndices filled with the global indices of these elements
+     */
+    void GetOwnedElementsAwaitingRearrangement(std::vector<unsigned>& rElementIndices);
+
     /**
      * Mark a given node as deleted. Note that this method DOES NOT deal with the
      * associated elements and therefore should only be called immediately prior
@@ -652,6 +791,7 @@ public:
      * the given VertexElementMap.
      *
      * This method calls several other methods, in particular CheckForT2Swaps(), CheckForSwapsFromShortEdges()
+     * (or PerformNonOverlappingSwapsFromShortEdges(), if SetUseParallelRemeshing() has been called)
      * and CheckForIntersections().
      *
      * @param rElementMap a VertexElementMap which associates the indices of VertexElements in the old mesh
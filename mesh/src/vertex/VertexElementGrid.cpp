@@ -0,0 +1,362 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "VertexElementGrid.hpp"
+#include "Exception.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+template<unsigned SPACE_DIM>
+VertexElementGrid<SPACE_DIM>::VertexElementGrid()
+    : mBoxWidth(0.0),
+      mNeedsRebuild(false),
+      mNumRebuilds(0)
+{
+    mOrigin = zero_vector<double>(SPACE_DIM);
+    mNumBoxes = zero_vector<unsigned>(SPACE_DIM);
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::Clear()
+{
+    mBoxWidth = 0.0;
+    mNumBoxes = zero_vector<unsigned>(SPACE_DIM);
+    mBoxes.clear();
+    mBoundingBoxes.clear();
+    mBoxRanges.clear();
+    mIsBounded.clear();
+    mIsInGrid.clear();
+    mNeedsRebuild = false;
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::SetNumElements(unsigned numElements)
+{
+    for (unsigned elem_index=numElements; elem_index<mBoundingBoxes.size(); elem_index++)
+    {
+        RemoveFromGrid(elem_index);
+    }
+
+    mBoundingBoxes.resize(numElements);
+    mBoxRanges.resize(numElements);
+    mIsBounded.resize(numElements, false);
+    mIsInGrid.resize(numElements, false);
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::SetBoundingBox(unsigned elementIndex, const c_vector<double, 2*SPACE_DIM>& rBoundingBox)
+{
+    if (elementIndex >= mBoundingBoxes.size())
+    {
+        SetNumElements(elementIndex + 1);
+    }
+    mIsBounded[elementIndex] = true;
+    mBoundingBoxes[elementIndex] = rBoundingBox;
+
+    if (mNeedsRebuild)
+    {
+        return;
+    }
+
+    c_vector<unsigned, 2*SPACE_DIM> box_range;
+    if (!CalculateBoxRange(rBoundingBox, box_range))
+    {
+        mNeedsRebuild = true;
+        return;
+    }
+
+    if (mIsInGrid[elementIndex])
+    {
+        bool range_has_changed = false;
+        for (unsigned i=0; i<2*SPACE_DIM; i++)
+        {
+            if (box_range[i] != mBoxRanges[elementIndex][i])
+            {
+                range_has_changed = true;
+                break;
+            }
+        }
+        if (!range_has_changed)
+        {
+            return;
+        }
+        UpdateBoxes(elementIndex, mBoxRanges[elementIndex], false);
+    }
+
+    UpdateBoxes(elementIndex, box_range, true);
+    mBoxRanges[elementIndex] = box_range;
+    mIsInGrid[elementIndex] = true;
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::RemoveElement(unsigned elementIndex)
+{
+    if (elementIndex < mBoundingBoxes.size())
+    {
+        RemoveFromGrid(elementIndex);
+        mIsBounded[elementIndex] = false;
+    }
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::RebuildIfNecessary()
+{
+    if (mNeedsRebuild)
+    {
+        Rebuild();
+    }
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::GetCandidateElements(const c_vector<double, SPACE_DIM>& rPoint, std::vector<unsigned>& rElementIndices) const
+{
+    assert(!mNeedsRebuild);
+
+    rElementIndices.clear();
+    if (mBoxes.empty())
+    {
+        return;
+    }
+
+    // Find the box containing the point, if any
+    unsigned box_index = 0;
+    for (unsigned d=SPACE_DIM; d-- > 0; )
+    {
+        double grid_index = floor((rPoint[d] - mOrigin[d])/mBoxWidth);
+        if (grid_index < 0.0 || grid_index >= mNumBoxes[d])
+        {
+            return;
+        }
+        box_index = box_index*mNumBoxes[d] + (unsigned) grid_index;
+    }
+
+    // Bounding boxes are padded slightly, so that points on an element's boundary are not missed
+    const double tolerance = 1e-8*mBoxWidth;
+    const std::vector<unsigned>& r_box = mBoxes[box_index];
+    for (unsigned i=0; i<r_box.size(); i++)
+    {
+        const c_vector<double, 2*SPACE_DIM>& r_bounding_box = mBoundingBoxes[r_box[i]];
+        bool contains_point = true;
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            if (rPoint[d] < r_bounding_box[2*d] - tolerance || rPoint[d] > r_bounding_box[2*d+1] + tolerance)
+            {
+                contains_point = false;
+                break;
+            }
+        }
+        if (contains_point)
+        {
+            rElementIndices.push_back(r_box[i]);
+        }
+    }
+}
+
+template<unsigned SPACE_DIM>
+double VertexElementGrid<SPACE_DIM>::GetBoxWidth() const
+{
+    return mBoxWidth;
+}
+
+template<unsigned SPACE_DIM>
+unsigned VertexElementGrid<SPACE_DIM>::GetNumRebuilds() const
+{
+    return mNumRebuilds;
+}
+
+template<unsigned SPACE_DIM>
+bool VertexElementGrid<SPACE_DIM>::CalculateBoxRange(const c_vector<double, 2*SPACE_DIM>& rBoundingBox, c_vector<unsigned, 2*SPACE_DIM>& rBoxRange) const
+{
+    if (mBoxes.empty())
+    {
+        return false;
+    }
+
+    const double tolerance = 1e-8*mBoxWidth;
+    for (unsigned d=0; d<SPACE_DIM; d++)
+    {
+        double first_index = floor((rBoundingBox[2*d] - tolerance - mOrigin[d])/mBoxWidth);
+        double last_index = floor((rBoundingBox[2*d+1] + tolerance - mOrigin[d])/mBoxWidth);
+        if (first_index < 0.0 || last_index >= mNumBoxes[d])
+        {
+            return false;
+        }
+        rBoxRange[2*d] = (unsigned) first_index;
+        rBoxRange[2*d+1] = (unsigned) last_index;
+    }
+    return true;
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::UpdateBoxes(unsigned elementIndex, const c_vector<unsigned, 2*SPACE_DIM>& rBoxRange, bool add)
+{
+    // Loop over all boxes in the range
+    c_vector<unsigned, SPACE_DIM> grid_indices;
+    for (unsigned d=0; d<SPACE_DIM; d++)
+    {
+        grid_indices[d] = rBoxRange[2*d];
+    }
+
+    while (true)
+    {
+        unsigned box_index = 0;
+        for (unsigned d=SPACE_DIM; d-- > 0; )
+        {
+            box_index = box_index*mNumBoxes[d] + grid_indices[d];
+        }
+
+        std::vector<unsigned>& r_box = mBoxes[box_index];
+        if (add)
+        {
+            r_box.push_back(elementIndex);
+        }
+        else
+        {
+            std::vector<unsigned>::iterator it = std::find(r_box.begin(), r_box.end(), elementIndex);
+            assert(it != r_box.end());
+            *it = r_box.back();
+            r_box.pop_back();
+        }
+
+        // Move on to the next box
+        unsigned d = 0;
+        while (d < SPACE_DIM && grid_indices[d] == rBoxRange[2*d+1])
+        {
+            grid_indices[d] = rBoxRange[2*d];
+            d++;
+        }
+        if (d == SPACE_DIM)
+        {
+            break;
+        }
+        grid_indices[d]++;
+    }
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::RemoveFromGrid(unsigned elementIndex)
+{
+    if (mIsInGrid[elementIndex])
+    {
+        if (!mNeedsRebuild)
+        {
+            UpdateBoxes(elementIndex, mBoxRanges[elementIndex], false);
+        }
+        mIsInGrid[elementIndex] = false;
+    }
+}
+
+template<unsigned SPACE_DIM>
+void VertexElementGrid<SPACE_DIM>::Rebuild()
+{
+    mNeedsRebuild = false;
+    mNumRebuilds++;
+    mBoxes.clear();
+    mIsInGrid.assign(mIsInGrid.size(), false);
+
+    // Find the extent of the bounded elements, and their mean size
+    c_vector<double, SPACE_DIM> lower_corner = scalar_vector<double>(SPACE_DIM, DBL_MAX);
+    c_vector<double, SPACE_DIM> upper_corner = scalar_vector<double>(SPACE_DIM, -DBL_MAX);
+    double total_size = 0.0;
+    unsigned num_bounded_elements = 0;
+    for (unsigned elem_index=0; elem_index<mBoundingBoxes.size(); elem_index++)
+    {
+        if (mIsBounded[elem_index])
+        {
+            double size = 0.0;
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                lower_corner[d] = std::min(lower_corner[d], mBoundingBoxes[elem_index][2*d]);
+                upper_corner[d] = std::max(upper_corner[d], mBoundingBoxes[elem_index][2*d+1]);
+                size = std::max(size, mBoundingBoxes[elem_index][2*d+1] - mBoundingBoxes[elem_index][2*d]);
+            }
+            total_size += size;
+            num_bounded_elements++;
+        }
+    }
+    if (num_bounded_elements == 0)
+    {
+        mNumBoxes = zero_vector<unsigned>(SPACE_DIM);
+        return;
+    }
+
+    /*
+     * Use boxes about the size of a typical element, so that each element overlaps only a few boxes,
+     * but no more than a few boxes per element. Leave a margin of one box around the elements, so
+     * that small movements do not require the grid to be rebuilt.
+     */
+    mBoxWidth = total_size/num_bounded_elements;
+    if (mBoxWidth <= 0.0)
+    {
+        mBoxWidth = 1.0;
+    }
+    unsigned num_boxes;
+    while (true)
+    {
+        num_boxes = 1;
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            mNumBoxes[d] = (unsigned) floor((upper_corner[d] - lower_corner[d])/mBoxWidth) + 3;
+            num_boxes *= mNumBoxes[d];
+        }
+        if (num_boxes <= 4*num_bounded_elements + 64)
+        {
+            break;
+        }
+        mBoxWidth *= 2.0;
+    }
+    mOrigin = lower_corner - scalar_vector<double>(SPACE_DIM, mBoxWidth);
+    mBoxes.resize(num_boxes);
+
+    for (unsigned elem_index=0; elem_index<mBoundingBoxes.size(); elem_index++)
+    {
+        if (mIsBounded[elem_index])
+        {
+            bool is_in_domain = CalculateBoxRange(mBoundingBoxes[elem_index], mBoxRanges[elem_index]);
+            assert(is_in_domain);
+            UNUSED_OPT(is_in_domain);
+            UpdateBoxes(elem_index, mBoxRanges[elem_index], true);
+            mIsInGrid[elem_index] = true;
+        }
+    }
+}
+
+// Explicit instantiation
+template class VertexElementGrid<1>;
+template class VertexElementGrid<2>;
+template class VertexElementGrid<3>;
@@ -0,0 +1,179 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef VERTEXELEMENTGRID_HPP_
+#define VERTEXELEMENTGRID_HPP_
+
+#include <vector>
+
+#include "UblasVectorInclude.hpp"
+
+/**
+ * A uniform grid of boxes over the bounding boxes of the elements of a vertex mesh, used by
+ * MutableVertexMesh to find the elements that may contain a given point without checking
+ * every element.
+ *
+ * Bounding boxes are stored as c_vectors of the form (xmin, xmax, ymin, ymax, zmin, zmax).
+ * The grid is updated incrementally: setting the bounding box of an element only moves it
+ * between boxes if it now overlaps different boxes. The grid is rebuilt from scratch only
+ * when a bounding box extends beyond it.
+ */
+template<unsigned SPACE_DIM>
+class VertexElementGrid
+{
+private:
+
+    /** The width of each box. */
+    double mBoxWidth;
+
+    /** The lower corner of the grid. */
+    c_vector<double, SPACE_DIM> mOrigin;
+
+    /** The number of boxes in each direction. */
+    c_vector<unsigned, SPACE_DIM> mNumBoxes;
+
+    /** The indices of the (bounded) elements overlapping each box. */
+    std::vector<std::vector<unsigned> > mBoxes;
+
+    /** The bounding box of each element, indexed by element index. */
+    std::vector<c_vector<double, 2*SPACE_DIM> > mBoundingBoxes;
+
+    /** The first and last boxes overlapped by each element that is in the grid, in each direction. */
+    std::vector<c_vector<unsigned, 2*SPACE_DIM> > mBoxRanges;
+
+    /** Whether each element has a bounding box. */
+    std::vector<bool> mIsBounded;
+
+    /** Whether each bounded element is in the boxes given by mBoxRanges. */
+    std::vector<bool> mIsInGrid;
+
+    /** Whether the grid must be rebuilt before it is next queried. */
+    bool mNeedsRebuild;
+
+    /** The number of times the grid has been rebuilt. */
+    unsigned mNumRebuilds;
+
+    /**
+     * Find the boxes overlapped by a bounding box.
+     *
+     * @param rBoundingBox the bounding box
+     * @param rBoxRange set to the first and last boxes overlapped in each direction
+     * @return whether the bounding box lies within the grid
+     */
+    bool CalculateBoxRange(const c_vector<double, 2*SPACE_DIM>& rBoundingBox, c_vector<unsigned, 2*SPACE_DIM>& rBoxRange) const;
+
+    /**
+     * Add an element to, or remove it from, each box in a range.
+     *
+     * @param elementIndex the index of the element
+     * @param rBoxRange the first and last boxes in each direction
+     * @param add whether to add (true) or remove (false) the element
+     */
+    void UpdateBoxes(unsigned elementIndex, const c_vector<unsigned, 2*SPACE_DIM>& rBoxRange, bool add);
+
+    /**
+     * Remove an element from the boxes it overlaps, if any.
+     *
+     * @param elementIndex the index of the element
+     */
+    void RemoveFromGrid(unsigned elementIndex);
+
+    /**
+     * Choose a box width and domain for the current bounding boxes and place each bounded
+     * element in the boxes it overlaps.
+     */
+    void Rebuild();
+
+public:
+
+    /**
+     * Constructor.
+     */
+    VertexElementGrid();
+
+    /**
+     * Remove all elements from the grid.
+     */
+    void Clear();
+
+    /**
+     * Set the number of element indices in use. Any elements with larger indices are removed.
+     *
+     * @param numElements the number of element indices
+     */
+    void SetNumElements(unsigned numElements);
+
+    /**
+     * Set the bounding box of an element, moving it between boxes if necessary.
+     *
+     * @param elementIndex the index of the element
+     * @param rBoundingBox the bounding box of the element
+     */
+    void SetBoundingBox(unsigned elementIndex, const c_vector<double, 2*SPACE_DIM>& rBoundingBox);
+
+    /**
+     * Remove an element from the grid.
+     *
+     * @param elementIndex the index of the element
+     */
+    void RemoveElement(unsigned elementIndex);
+
+    /**
+     * Rebuild the grid if any bounding box extends beyond it. Must be called after updating
+     * bounding boxes and before calling GetCandidateElements().
+     */
+    void RebuildIfNecessary();
+
+    /**
+     * Find the elements that may contain a given point, namely those whose bounding boxes
+     * contain the point. Safe to call from several threads at once.
+     *
+     * @param rPoint the point
+     * @param rElementIndices filled with the indices of these elements, in no particular order
+     */
+    void GetCandidateElements(const c_vector<double, SPACE_DIM>& rPoint, std::vector<unsigned>& rElementIndices) const;
+
+    /**
+     * @return the width of each box.
+     */
+    double GetBoxWidth() const;
+
+    /**
+     * @return the number of times the grid has been rebuilt.
+     */
+    unsigned GetNumRebuilds() const;
+};
+
+#endif /*VERTEXELEMENTGRID_HPP_*/
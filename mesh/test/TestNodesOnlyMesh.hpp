@@ -237,6 +237,13 @@ public:
             location[2] = 0.1;    // This should be owned by process 0 in any space decomposition.
             TS_ASSERT(mesh.IsOwned(location));
         }
+
+        // Resetting the box collection keeps the domain and changes the box width
+        mesh.ResetBoxCollection(1.5);
+        TS_ASSERT_DELTA(mesh.GetMaximumInteractionDistance(), 1.5, 1e-4);
+        TS_ASSERT_DELTA(mesh.GetBoxCollection()->GetBoxWidth(), 1.5, 1e-4);
+        TS_ASSERT_DELTA(mesh.GetBoxCollection()->rGetDomainSize()[0], 0.0, 1e-4);
+        TS_ASSERT_DELTA(mesh.GetBoxCollection()->rGetDomainSize()[1], 3.0, 1e-4);
     }
 
     void TestConstuctingAndEnlargingInitialBoxCollection()
@@ -879,8 +886,9 @@ public:
             TetrahedralMesh<2,2> generating_mesh;
             generating_mesh.ConstructFromMeshReader(mesh_reader);
 
-            // Convert this to a NodesOnlyMesh
+            // Convert this to a NodesOnlyMesh, whose box collection is split into blocks
             NodesOnlyMesh<2> mesh;
+            mesh.SetUseBlockDecomposition();
             mesh.ConstructNodesWithoutMesh(generating_mesh, 1.5);
 
             TS_ASSERT_EQUALS(mesh.GetNumNodes(), 543u);
@@ -926,6 +934,7 @@ public:
 
             // Check we have the right number of nodes & elements
             TS_ASSERT_EQUALS(p_nodes_only_mesh->GetNumNodes(), 543u - 1u);
+            TS_ASSERT(p_nodes_only_mesh->GetUseBlockDecomposition());
             TS_ASSERT_EQUALS(p_nodes_only_mesh->GetNumElements(), 0u);
 
             // Check some node co-ordinates
@@ -1057,6 +1066,75 @@ public:
             }
         }
     }
+
+    void TestBlockDecompositionOfBoxCollection()
+    {
+        std::vector<Node<3>*> nodes;
+        for (unsigned i=0; i<64; i++)
+        {
+            nodes.push_back(new Node<3>(i, false, 0.5 + (i%4), 0.5 + ((i/4)%4), 0.5 + (i/16)));
+        }
+
+        NodesOnlyMesh<3> mesh;
+        TS_ASSERT(!mesh.GetUseBlockDecomposition());
+        mesh.SetUseBlockDecomposition();
+        TS_ASSERT(mesh.GetUseBlockDecomposition());
+
+        mesh.ConstructNodesWithoutMesh(nodes, 1.0);
+        TS_ASSERT(mesh.mpBoxCollection->GetUsesBlockDecomposition());
+
+        TS_ASSERT_THROWS_THIS(mesh.SetUseBlockDecomposition(false),
+                              "SetUseBlockDecomposition() must be called before the box collection is set up.");
+
+        // Each node is owned by exactly one process
+        unsigned num_local_nodes = mesh.GetNumNodes();
+        unsigned total_num_nodes = 0;
+        MPI_Allreduce(&num_local_nodes, &total_num_nodes, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_num_nodes, 64u);
+
+        for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+             node_iter != mesh.GetNodeIteratorEnd();
+             ++node_iter)
+        {
+            TS_ASSERT_EQUALS(mesh.mpBoxCollection->GetProcessOwningNode(&(*node_iter)), PetscTools::GetMyRank());
+        }
+
+        // Nothing has moved, so nothing needs to be sent
+        mesh.CalculateNodesOutsideLocalDomain();
+        TS_ASSERT(mesh.rGetNodesToSendToProcesses().empty());
+
+        // Enlarging keeps the blocks and the nodes in the same places
+        unsigned num_boxes = mesh.mpBoxCollection->GetNumBoxes();
+        mesh.EnlargeBoxCollection();
+        TS_ASSERT(mesh.mpBoxCollection->GetUsesBlockDecomposition());
+        TS_ASSERT_LESS_THAN(num_boxes, mesh.mpBoxCollection->GetNumBoxes());
+
+        mesh.AddNodesToBoxes();
+        mesh.LoadBalanceMesh();
+        TS_ASSERT(mesh.mpBoxCollection->GetUsesBlockDecomposition());
+
+        unsigned num_local_boxes = mesh.mpBoxCollection->GetNumLocalBoxes();
+        unsigned total_num_boxes = 0;
+        MPI_Allreduce(&num_local_boxes, &total_num_boxes, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_num_boxes, mesh.mpBoxCollection->GetNumBoxes());
+
+        // Block decompositions are not available for periodic meshes
+        NodesOnlyMesh<3> periodic_mesh;
+        periodic_mesh.SetUseBlockDecomposition();
+        c_vector<double, 6> domain_size;
+        for (unsigned i=0; i<3; i++)
+        {
+            domain_size[2*i] = 0.0;
+            domain_size[2*i+1] = 4.0;
+        }
+        TS_ASSERT_THROWS_THIS(periodic_mesh.SetUpBoxCollection(1.0, domain_size, PETSC_DECIDE, true),
+                              "Block decompositions of the box collection are not available for periodic meshes.");
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
 };
 
 #endif /*TESTNODESONLYMESH_HPP_*/
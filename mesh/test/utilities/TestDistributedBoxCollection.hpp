@@ -2297,6 +2297,365 @@ public:
             delete nodes[i];
         }
     }
+
+    void TestAddNodesToBoxes()
+    {
+        c_vector<double, 2> domain_size;
+        domain_size(0) = 0.0;
+        domain_size(1) = 9.0;
+
+        DistributedBoxCollection<1> box_collection(1.0, domain_size);
+
+        // Three owned nodes in each owned box, added out of box and index order
+        std::vector<Node<1>* > nodes;
+        for (unsigned i=27; i-- > 0; )
+        {
+            c_vector<double, 1> location;
+            location(0) = 0.5 + (i%9);
+            if (box_collection.IsOwned(location))
+            {
+                nodes.push_back(new Node<1>(i, location));
+            }
+        }
+
+        box_collection.AddNodesToBoxes(nodes);
+
+        for (unsigned i=0; i<box_collection.GetNumBoxes(); i++)
+        {
+            if (box_collection.IsBoxOwned(i))
+            {
+                const std::vector<Node<1>* >& r_nodes = box_collection.rGetBox(i).rGetNodesContainedVector();
+                TS_ASSERT_EQUALS(r_nodes.size(), 3u);
+
+                // Each box is sorted by node index
+                for (unsigned k=0; k<r_nodes.size(); k++)
+                {
+                    TS_ASSERT_EQUALS(r_nodes[k]->GetIndex(), i + 9*k);
+                }
+
+                // The contents are also available as a set
+                std::set<Node<1>* >& r_node_set = box_collection.rGetBox(i).rGetNodesContained();
+                TS_ASSERT_EQUALS(r_node_set.size(), 3u);
+                TS_ASSERT_EQUALS(r_node_set.count(r_nodes[0]), 1u);
+                TS_ASSERT(box_collection.rGetBox(i).rGetElementsContained().empty());
+            }
+        }
+
+        // Emptying the boxes keeps their storage, and refilling them gives the same result
+        box_collection.EmptyBoxes();
+        for (unsigned i=0; i<box_collection.GetNumBoxes(); i++)
+        {
+            if (box_collection.IsBoxOwned(i))
+            {
+                TS_ASSERT(box_collection.rGetBox(i).rGetNodesContainedVector().empty());
+                TS_ASSERT_LESS_THAN_EQUALS(3u, box_collection.rGetBox(i).rGetNodesContainedVector().capacity());
+            }
+        }
+        box_collection.AddNodesToBoxes(nodes);
+        std::vector<int> local_distribution = box_collection.CalculateNumberOfNodesInEachStrip();
+        for (unsigned i=0; i<local_distribution.size(); i++)
+        {
+            TS_ASSERT_EQUALS(local_distribution[i], 3);
+        }
+
+        // Tidy up
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+    void TestCalculateProcessGrid()
+    {
+        // A cube of boxes is split into cubes
+        c_vector<unsigned, 3> num_boxes_3d = scalar_vector<unsigned>(3, 10u);
+        c_vector<unsigned, 3> grid_3d = DistributedBoxCollection<3>::CalculateProcessGrid(num_boxes_3d, 8);
+        TS_ASSERT_EQUALS(grid_3d[0], 2u);
+        TS_ASSERT_EQUALS(grid_3d[1], 2u);
+        TS_ASSERT_EQUALS(grid_3d[2], 2u);
+
+        // A flat domain is not cut through its thin direction
+        num_boxes_3d[0] = 20;
+        num_boxes_3d[1] = 20;
+        num_boxes_3d[2] = 5;
+        grid_3d = DistributedBoxCollection<3>::CalculateProcessGrid(num_boxes_3d, 4);
+        TS_ASSERT_EQUALS(grid_3d[0], 2u);
+        TS_ASSERT_EQUALS(grid_3d[1], 2u);
+        TS_ASSERT_EQUALS(grid_3d[2], 1u);
+
+        // Too few boxes for any grid, so fall back to slabs in the last direction
+        num_boxes_3d = scalar_vector<unsigned>(3, 2u);
+        grid_3d = DistributedBoxCollection<3>::CalculateProcessGrid(num_boxes_3d, 16);
+        TS_ASSERT_EQUALS(grid_3d[0], 1u);
+        TS_ASSERT_EQUALS(grid_3d[1], 1u);
+        TS_ASSERT_EQUALS(grid_3d[2], 16u);
+
+        c_vector<unsigned, 2> num_boxes_2d = scalar_vector<unsigned>(2, 10u);
+        c_vector<unsigned, 2> grid_2d = DistributedBoxCollection<2>::CalculateProcessGrid(num_boxes_2d, 4);
+        TS_ASSERT_EQUALS(grid_2d[0], 2u);
+        TS_ASSERT_EQUALS(grid_2d[1], 2u);
+
+        c_vector<unsigned, 1> num_boxes_1d = scalar_vector<unsigned>(1, 10u);
+        c_vector<unsigned, 1> grid_1d = DistributedBoxCollection<1>::CalculateProcessGrid(num_boxes_1d, 5);
+        TS_ASSERT_EQUALS(grid_1d[0], 5u);
+    }
+
+    void TestBlockDecomposition3d()
+    {
+        c_vector<double, 6> domain_size;
+        for (unsigned i=0; i<3; i++)
+        {
+            domain_size[2*i] = 0.0;
+            domain_size[2*i+1] = 6.0;
+        }
+
+        DistributedBoxCollection<3> box_collection(1.0, domain_size, std::vector<std::vector<unsigned> >());
+        box_collection.SetupLocalBoxesHalfOnly();
+
+        TS_ASSERT(box_collection.GetUsesBlockDecomposition());
+        c_vector<unsigned, 3> num_processes = box_collection.GetNumProcessesEachDirection();
+        TS_ASSERT_EQUALS(num_processes[0]*num_processes[1]*num_processes[2], PetscTools::GetNumProcs());
+        TS_ASSERT_EQUALS(box_collection.rGetBlockBoundaries().size(), 3u);
+        TS_ASSERT_EQUALS(box_collection.GetNeighbouringProcess(13), UNSIGNED_UNSET);
+
+        // Every box is owned by exactly one process
+        unsigned num_local_boxes = box_collection.GetNumLocalBoxes();
+        unsigned total_num_boxes = 0;
+        MPI_Allreduce(&num_local_boxes, &total_num_boxes, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_num_boxes, box_collection.GetNumBoxes());
+
+        // One node at the centre of each box, indexed by its box
+        c_vector<unsigned, 3> num_boxes = box_collection.mNumBoxesEachDirection;
+        std::vector<Node<3>* > nodes;
+        std::vector<Node<3>* > owned_nodes;
+        for (unsigned i=0; i<box_collection.GetNumBoxes(); i++)
+        {
+            c_vector<unsigned, 3> grid_indices = box_collection.CalculateGridIndices(i);
+            c_vector<double, 3> location;
+            for (unsigned d=0; d<3; d++)
+            {
+                location[d] = grid_indices[d] + 0.5;
+            }
+            nodes.push_back(new Node<3>(i, location));
+            TS_ASSERT_EQUALS(box_collection.CalculateContainingBox(nodes[i]), i);
+
+            if (box_collection.IsBoxOwned(i))
+            {
+                TS_ASSERT(!box_collection.IsHaloBox(i));
+                TS_ASSERT_EQUALS(box_collection.GetProcessOwningNode(nodes[i]), PetscTools::GetMyRank());
+                box_collection.rGetBox(i).AddNode(nodes[i]);
+                owned_nodes.push_back(nodes[i]);
+            }
+            if (box_collection.IsHaloBox(i))
+            {
+                box_collection.rGetHaloBox(i).AddNode(nodes[i]);
+            }
+        }
+
+        // Every neighbour of an owned box is owned or a halo, and interior boxes have no halo neighbours
+        for (unsigned i=0; i<box_collection.GetNumBoxes(); i++)
+        {
+            if (box_collection.IsBoxOwned(i))
+            {
+                bool has_halo_neighbour = false;
+                c_vector<unsigned, 3> grid_indices = box_collection.CalculateGridIndices(i);
+                for (unsigned j=0; j<box_collection.GetNumBoxes(); j++)
+                {
+                    c_vector<unsigned, 3> other_indices = box_collection.CalculateGridIndices(j);
+                    bool adjacent = true;
+                    for (unsigned d=0; d<3; d++)
+                    {
+                        adjacent = adjacent && (abs((int)grid_indices[d] - (int)other_indices[d]) <= 1);
+                    }
+                    if (adjacent && !box_collection.IsBoxOwned(j))
+                    {
+                        TS_ASSERT(box_collection.IsHaloBox(j));
+                        has_halo_neighbour = true;
+                    }
+                }
+                TS_ASSERT_EQUALS(box_collection.IsInteriorBox(i), !has_halo_neighbour);
+            }
+        }
+
+        // Each owned node has all the nodes in adjacent boxes as neighbours
+        std::vector<std::pair<Node<3>*, Node<3>* > > pairs;
+        box_collection.CalculateNodePairs(owned_nodes, pairs);
+
+        std::vector<std::pair<Node<3>*, Node<3>* > > split_pairs;
+        box_collection.CalculateInteriorNodePairs(owned_nodes, split_pairs);
+        box_collection.CalculateBoundaryNodePairs(owned_nodes, split_pairs);
+        TS_ASSERT_EQUALS(split_pairs.size(), pairs.size());
+
+        for (unsigned k=0; k<owned_nodes.size(); k++)
+        {
+            unsigned i = owned_nodes[k]->GetIndex();
+            c_vector<unsigned, 3> grid_indices = box_collection.CalculateGridIndices(i);
+            std::set<unsigned> expected;
+            for (unsigned j=0; j<box_collection.GetNumBoxes(); j++)
+            {
+                c_vector<unsigned, 3> other_indices = box_collection.CalculateGridIndices(j);
+                bool adjacent = (i != j);
+                for (unsigned d=0; d<3; d++)
+                {
+                    adjacent = adjacent && (abs((int)grid_indices[d] - (int)other_indices[d]) <= 1);
+                }
+                if (adjacent)
+                {
+                    expected.insert(j);
+                }
+            }
+            std::vector<unsigned>& r_neighbours = owned_nodes[k]->rGetNeighbours();
+            std::set<unsigned> neighbours(r_neighbours.begin(), r_neighbours.end());
+            TS_ASSERT_EQUALS(neighbours.size(), r_neighbours.size());
+            TS_ASSERT(neighbours == expected);
+        }
+
+        // Each slice through the domain contains one node per box across the slice
+        box_collection.EmptyBoxes();
+        box_collection.AddNodesToBoxes(owned_nodes);
+        std::vector<std::vector<int> > slices = box_collection.CalculateNumberOfNodesInEachSlice();
+        TS_ASSERT_EQUALS(slices.size(), 3u);
+        for (unsigned d=0; d<3; d++)
+        {
+            TS_ASSERT_EQUALS(slices[d].size(), num_boxes[d]);
+            for (unsigned i=0; i<slices[d].size(); i++)
+            {
+                TS_ASSERT_EQUALS(slices[d][i], (int)(num_boxes[0]*num_boxes[1]*num_boxes[2]/num_boxes[d]));
+            }
+        }
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+    void TestBlockDecompositionExceptions()
+    {
+        c_vector<double, 4> domain_size;
+        domain_size[0] = 0.0;
+        domain_size[1] = PetscTools::GetNumProcs() + 1.0;
+        domain_size[2] = 0.0;
+        domain_size[3] = 4.0;
+
+        std::vector<std::vector<unsigned> > boundaries(1);
+        boundaries[0].push_back(0);
+        boundaries[0].push_back(PetscTools::GetNumProcs() + 1);
+        TS_ASSERT_THROWS_THIS(DistributedBoxCollection<2>(1.0, domain_size, boundaries),
+                              "Block boundaries must be given for each axis.");
+
+        boundaries.resize(2);
+        boundaries[1].push_back(0);
+        boundaries[1].push_back(3);
+        TS_ASSERT_THROWS_THIS(DistributedBoxCollection<2>(1.0, domain_size, boundaries),
+                              "The block boundaries along each axis must run from 0 to the number of boxes along that axis.");
+
+        boundaries[1][1] = 0;
+        boundaries[1].push_back(4);
+        TS_ASSERT_THROWS_THIS(DistributedBoxCollection<2>(1.0, domain_size, boundaries),
+                              "Each block must have at least one slice of boxes along each axis.");
+
+        // One more block than there are processes
+        boundaries[0].clear();
+        for (unsigned i=0; i<=PetscTools::GetNumProcs()+1; i++)
+        {
+            boundaries[0].push_back(i);
+        }
+        boundaries[1].clear();
+        boundaries[1].push_back(0);
+        boundaries[1].push_back(4);
+        TS_ASSERT_THROWS_THIS(DistributedBoxCollection<2>(1.0, domain_size, boundaries),
+                              "The number of blocks must be equal to the number of processes.");
+    }
+
+    void TestLoadBalanceBlocks()
+    {
+        c_vector<double, 4> domain_size;
+        domain_size[0] = 0.0;
+        domain_size[1] = 4.0*PetscTools::GetNumProcs();
+        domain_size[2] = 0.0;
+        domain_size[3] = 4.0*PetscTools::GetNumProcs();
+
+        DistributedBoxCollection<2> box_collection(1.0, domain_size, std::vector<std::vector<unsigned> >());
+        std::vector<std::vector<unsigned> > old_boundaries = box_collection.rGetBlockBoundaries();
+
+        // Uniform load except for a heavy first slice in y
+        std::vector<std::vector<int> > slices(2);
+        for (unsigned d=0; d<2; d++)
+        {
+            slices[d].assign(old_boundaries[d].back(), 1);
+        }
+        slices[1][0] = 100;
+
+        std::vector<std::vector<unsigned> > new_boundaries = box_collection.LoadBalanceBlocks(slices);
+        TS_ASSERT_EQUALS(new_boundaries.size(), 2u);
+        for (unsigned d=0; d<2; d++)
+        {
+            TS_ASSERT_EQUALS(new_boundaries[d].size(), old_boundaries[d].size());
+            TS_ASSERT_EQUALS(new_boundaries[d].front(), 0u);
+            TS_ASSERT_EQUALS(new_boundaries[d].back(), old_boundaries[d].back());
+            for (unsigned i=1; i<new_boundaries[d].size(); i++)
+            {
+                TS_ASSERT_LESS_THAN_EQUALS(std::abs((int)new_boundaries[d][i] - (int)old_boundaries[d][i]), 1);
+                TS_ASSERT_LESS_THAN(new_boundaries[d][i-1], new_boundaries[d][i]);
+            }
+        }
+
+        // The first layer in y gives up a slice to its neighbour if it can
+        if (old_boundaries[1].size() > 2 && old_boundaries[1][1] > 2)
+        {
+            TS_ASSERT_EQUALS(new_boundaries[1][1], old_boundaries[1][1] - 1);
+        }
+
+        // The balanced blocks make a valid collection
+        DistributedBoxCollection<2> balanced_collection(1.0, box_collection.rGetDomainSize(), new_boundaries);
+        unsigned num_local_boxes = balanced_collection.GetNumLocalBoxes();
+        unsigned total_num_boxes = 0;
+        MPI_Allreduce(&num_local_boxes, &total_num_boxes, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_num_boxes, balanced_collection.GetNumBoxes());
+    }
+
+    void TestArchivingBlockDistributedBoxCollection()
+    {
+        FileFinder archive_dir("archive", RelativeTo::ChasteTestOutput);
+        std::string archive_file = "block_box_collection.arch";
+        std::vector<std::vector<unsigned> > boundaries;
+
+        c_vector<double, 6> domain_size;
+        for (unsigned i=0; i<3; i++)
+        {
+            domain_size[2*i] = 0.0;
+            domain_size[2*i+1] = 4.0;
+        }
+
+        {
+            DistributedBoxCollection<3>* p_box_collection = new DistributedBoxCollection<3>(1.0, domain_size, std::vector<std::vector<unsigned> >());
+            boundaries = p_box_collection->rGetBlockBoundaries();
+
+            {
+                ArchiveOpener<boost::archive::text_oarchive, std::ofstream> arch_opener(archive_dir, archive_file);
+                boost::archive::text_oarchive* p_arch = arch_opener.GetCommonArchive();
+
+                DistributedBoxCollection<3>* const p_const_box_collection = p_box_collection;
+                (*p_arch) << p_const_box_collection;
+            }
+
+            delete p_box_collection;
+        }
+
+        {
+            DistributedBoxCollection<3>* p_box_collection;
+
+            ArchiveOpener<boost::archive::text_iarchive, std::ifstream> arch_opener(archive_dir, archive_file);
+            boost::archive::text_iarchive* p_arch = arch_opener.GetCommonArchive();
+
+            (*p_arch) >> p_box_collection;
+            TS_ASSERT(p_box_collection->GetUsesBlockDecomposition());
+            TS_ASSERT(p_box_collection->rGetBlockBoundaries() == boundaries);
+
+            delete p_box_collection;
+        }
+    }
 };
 
 #endif /*TESTDISTRIBUTEDBOXCOLLECTION_HPP_*/
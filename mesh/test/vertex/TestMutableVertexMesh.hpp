@@ -957,6 +957,94 @@ public:
         }
     }
 
+    void TestRemoveElementPriorToReMesh()
+    {
+        // Create the same mesh as in TestDeleteElementWithBoundaryNodes()
+        std::vector<Node<2>*> nodes;
+        nodes.push_back(new Node<2>(0, true, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, true, 0.5, 0.0));
+        nodes.push_back(new Node<2>(2, true, 1.0, 0.0));
+        nodes.push_back(new Node<2>(3, true, 1.0, 1.0));
+        nodes.push_back(new Node<2>(4, true, 0.5, 1.0));
+        nodes.push_back(new Node<2>(5, true, 0.0, 1.0));
+        nodes.push_back(new Node<2>(6, true, 0.0, 0.5));
+        nodes.push_back(new Node<2>(7, false, 0.4, 0.6));
+
+        std::vector<Node<2>*> nodes_elem_0, nodes_elem_1;
+        unsigned node_indices_elem_0[7] = {0, 1, 2, 3, 4, 7, 6};
+        unsigned node_indices_elem_1[4] = {6, 7, 4, 5};
+        for (unsigned i=0; i<7; i++)
+        {
+            nodes_elem_0.push_back(nodes[node_indices_elem_0[i]]);
+            if (i < 4)
+            {
+                nodes_elem_1.push_back(nodes[node_indices_elem_1[i]]);
+            }
+        }
+
+        std::vector<VertexElement<2,2>*> vertex_elements;
+        vertex_elements.push_back(new VertexElement<2,2>(0, nodes_elem_0));
+        vertex_elements.push_back(new VertexElement<2,2>(1, nodes_elem_1));
+
+        MutableVertexMesh<2,2> vertex_mesh(nodes, vertex_elements);
+
+        // Remove the smaller element, as if it had been sent to another process
+        vertex_mesh.RemoveElementPriorToReMesh(1);
+
+        // Only node 5 is deleted along with the element
+        TS_ASSERT_EQUALS(vertex_mesh.GetNumElements(), 1u);
+        TS_ASSERT_EQUALS(vertex_mesh.GetNumNodes(), 7u);
+        TS_ASSERT_EQUALS(vertex_mesh.GetNode(5)->IsDeleted(), true);
+
+        // Unlike DeleteElementPriorToReMesh(), the remaining nodes keep their 'boundaryness'
+        for (unsigned i=0; i<8; i++)
+        {
+            if (i != 5)
+            {
+                bool expected_boundary_node = (i!=7);
+                TS_ASSERT_EQUALS(vertex_mesh.GetNode(i)->IsBoundaryNode(), expected_boundary_node);
+            }
+        }
+
+        vertex_mesh.ReMesh();
+        TS_ASSERT_EQUALS(vertex_mesh.GetNumAllElements(), 1u);
+        TS_ASSERT_EQUALS(vertex_mesh.GetNumAllNodes(), 7u);
+        TS_ASSERT_EQUALS(vertex_mesh.GetElement(0)->GetNumNodes(), 7u);
+    }
+
+    void TestCanRearrangeAroundNode()
+    {
+        HoneycombVertexMeshGenerator generator(4, 4);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        // By default every element is owned, so the mesh may be rearranged around any node
+        for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(p_mesh->GetNode(i)), true);
+        }
+
+        // Suppose the first element is owned by another process
+        p_mesh->GetElement(0)->SetOwnership(false);
+
+        // The mesh may no longer be rearranged around its nodes...
+        for (unsigned local_index=0; local_index<p_mesh->GetElement(0)->GetNumNodes(); local_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(p_mesh->GetElement(0)->GetNode(local_index)), false);
+        }
+
+        // ...or around the nodes of its neighbours...
+        for (unsigned local_index=0; local_index<p_mesh->GetElement(1)->GetNumNodes(); local_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(p_mesh->GetElement(1)->GetNode(local_index)), false);
+        }
+
+        // ...but may still be rearranged around nodes far from it
+        for (unsigned local_index=0; local_index<p_mesh->GetElement(15)->GetNumNodes(); local_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->CanRearrangeAroundNode(p_mesh->GetElement(15)->GetNode(local_index)), true);
+        }
+    }
+
     /**
      * Test that in the case where the given axis of division does not
      * cross two edges of the element, an exception is thrown.
@@ -40,6 +40,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "VertexMeshWriter.hpp"
 #include "MutableVertexMesh.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
 #include "FileComparison.hpp"
 #include "Warnings.hpp"
 
@@ -1181,6 +1183,78 @@ public:
         TS_ASSERT(comparer2.CompareFiles());
     }
 
+    void TestReMeshWithParallelRemeshing()
+    {
+        /*
+         * Create two identical honeycomb meshes and shorten one edge of several interior elements
+         * in each, so that a T1 swap is required on each of these edges. Remeshing with and without
+         * parallel remeshing should give identical meshes.
+         */
+        HoneycombVertexMeshGenerator serial_generator(10, 10);
+        MutableVertexMesh<2,2>* p_serial_mesh = serial_generator.GetMesh();
+        HoneycombVertexMeshGenerator parallel_generator(10, 10);
+        MutableVertexMesh<2,2>* p_parallel_mesh = parallel_generator.GetMesh();
+
+        TS_ASSERT_EQUALS(p_parallel_mesh->GetUseParallelRemeshing(), false);
+        p_parallel_mesh->SetUseParallelRemeshing();
+        TS_ASSERT_EQUALS(p_parallel_mesh->GetUseParallelRemeshing(), true);
+
+        unsigned elements_with_short_edges[6] = {22, 26, 53, 57, 75, 78};
+        MutableVertexMesh<2,2>* meshes[2] = {p_serial_mesh, p_parallel_mesh};
+        for (unsigned m=0; m<2; m++)
+        {
+            meshes[m]->SetCellRearrangementThreshold(0.1);
+            for (unsigned i=0; i<6; i++)
+            {
+                Node<2>* p_node_a = meshes[m]->GetElement(elements_with_short_edges[i])->GetNode(0);
+                Node<2>* p_node_b = meshes[m]->GetElement(elements_with_short_edges[i])->GetNode(1);
+
+                c_vector<double, 2> midpoint = 0.5*(p_node_a->rGetLocation() + p_node_b->rGetLocation());
+                c_vector<double, 2> direction = p_node_a->rGetLocation() - p_node_b->rGetLocation();
+                direction /= norm_2(direction);
+
+                p_node_a->rGetModifiableLocation() = midpoint + 0.02*direction;
+                p_node_b->rGetModifiableLocation() = midpoint - 0.02*direction;
+            }
+        }
+
+        VertexElementMap serial_map(p_serial_mesh->GetNumElements());
+        p_serial_mesh->ReMesh(serial_map);
+        VertexElementMap parallel_map(p_parallel_mesh->GetNumElements());
+        p_parallel_mesh->ReMesh(parallel_map);
+
+        // Check that the same T1 swaps have been performed, in the same order
+        std::vector<c_vector<double, 2> > serial_t1_locations = p_serial_mesh->GetLocationsOfT1Swaps();
+        std::vector<c_vector<double, 2> > parallel_t1_locations = p_parallel_mesh->GetLocationsOfT1Swaps();
+        TS_ASSERT_EQUALS(serial_t1_locations.size(), 6u);
+        TS_ASSERT_EQUALS(parallel_t1_locations.size(), serial_t1_locations.size());
+        for (unsigned i=0; i<std::min(serial_t1_locations.size(), parallel_t1_locations.size()); i++)
+        {
+            TS_ASSERT_DELTA(norm_2(parallel_t1_locations[i] - serial_t1_locations[i]), 0.0, 1e-12);
+        }
+
+        // Check that the meshes and element maps are identical
+        TS_ASSERT_EQUALS(parallel_map.IsIdentityMap(), serial_map.IsIdentityMap());
+        TS_ASSERT_EQUALS(p_parallel_mesh->GetNumNodes(), p_serial_mesh->GetNumNodes());
+        TS_ASSERT_EQUALS(p_parallel_mesh->GetNumElements(), p_serial_mesh->GetNumElements());
+        for (unsigned node_index=0; node_index<p_serial_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2> difference = p_parallel_mesh->GetNode(node_index)->rGetLocation() - p_serial_mesh->GetNode(node_index)->rGetLocation();
+            TS_ASSERT_DELTA(norm_2(difference), 0.0, 1e-12);
+            TS_ASSERT_EQUALS(p_parallel_mesh->GetNode(node_index)->IsBoundaryNode(), p_serial_mesh->GetNode(node_index)->IsBoundaryNode());
+        }
+        for (unsigned elem_index=0; elem_index<p_serial_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_serial_element = p_serial_mesh->GetElement(elem_index);
+            VertexElement<2,2>* p_parallel_element = p_parallel_mesh->GetElement(elem_index);
+            TS_ASSERT_EQUALS(p_parallel_element->GetNumNodes(), p_serial_element->GetNumNodes());
+            for (unsigned i=0; i<std::min(p_serial_element->GetNumNodes(), p_parallel_element->GetNumNodes()); i++)
+            {
+                TS_ASSERT_EQUALS(p_parallel_element->GetNodeGlobalIndex(i), p_serial_element->GetNodeGlobalIndex(i));
+            }
+        }
+    }
+
     void TestReMeshExceptionWhenNonBoundaryNodesAreContainedOnlyInTwoElements()
     {
         /*
@@ -2820,6 +2894,55 @@ public:
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(2), 2.7294, 1e-4);
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(3), 2.3062, 1e-4);
     }
+
+    void TestCheckForIntersectionsUsingElementGrid()
+    {
+        HoneycombVertexMeshGenerator generator(10, 10);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        TS_ASSERT_EQUALS(p_mesh->UpdateElementGrid(), true);
+
+        // Every element containing a point is a candidate, and there are only a few candidates
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        std::vector<unsigned> candidates;
+        for (unsigned i=0; i<1000; i++)
+        {
+            c_vector<double, 2> point;
+            point[0] = 11.0*p_gen->ranf();
+            point[1] = 9.0*p_gen->ranf();
+            p_mesh->mElementGrid.GetCandidateElements(point, candidates);
+            TS_ASSERT_LESS_THAN_EQUALS(candidates.size(), 4u);
+
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                if (p_mesh->ElementIncludesPoint(point, elem_index))
+                {
+                    TS_ASSERT(std::find(candidates.begin(), candidates.end(), elem_index) != candidates.end());
+                }
+            }
+        }
+
+        // Small movements of the nodes are dealt with without rebuilding the grid
+        unsigned num_rebuilds = p_mesh->mElementGrid.GetNumRebuilds();
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2>& r_location = p_mesh->GetNode(node_index)->rGetModifiableLocation();
+            r_location[0] += 0.01*(p_gen->ranf() - 0.5);
+            r_location[1] += 0.01*(p_gen->ranf() - 0.5);
+        }
+        p_mesh->SetCheckForInternalIntersections(true);
+        TS_ASSERT_EQUALS(p_mesh->CheckForIntersections(), false);
+        TS_ASSERT_EQUALS(p_mesh->mElementGrid.GetNumRebuilds(), num_rebuilds);
+
+        // Moving the whole mesh causes the grid to be rebuilt
+        p_mesh->Translate(100.0, -100.0);
+        TS_ASSERT_EQUALS(p_mesh->CheckForIntersections(), false);
+        TS_ASSERT_EQUALS(p_mesh->mElementGrid.GetNumRebuilds(), num_rebuilds + 1);
+
+        // The grid is not used for periodic meshes
+        CylindricalHoneycombVertexMeshGenerator cylindrical_generator(6, 6);
+        Cylindrical2dVertexMesh* p_cylindrical_mesh = cylindrical_generator.GetCylindricalMesh();
+        TS_ASSERT_EQUALS(p_cylindrical_mesh->UpdateElementGrid(), false);
+    }
 };
 
 #endif /*TESTMUTABLEVERTEXMESHREMESH_HPP_*/
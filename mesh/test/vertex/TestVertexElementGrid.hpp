@@ -0,0 +1,139 @@
+/*
+
+Copyright (c) 2005-2018, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXELEMENTGRID_HPP_
+#define TESTVERTEXELEMENTGRID_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+
+#include "VertexElementGrid.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestVertexElementGrid : public CxxTest::TestSuite
+{
+private:
+
+    c_vector<double, 4> MakeBoundingBox(double xMin, double xMax, double yMin, double yMax)
+    {
+        c_vector<double, 4> bounding_box;
+        bounding_box[0] = xMin;
+        bounding_box[1] = xMax;
+        bounding_box[2] = yMin;
+        bounding_box[3] = yMax;
+        return bounding_box;
+    }
+
+    bool Contains(const std::vector<unsigned>& rIndices, unsigned index)
+    {
+        return std::find(rIndices.begin(), rIndices.end(), index) != rIndices.end();
+    }
+
+public:
+
+    void TestCandidateElements()
+    {
+        VertexElementGrid<2> grid;
+        grid.SetBoundingBox(0, MakeBoundingBox(0.0, 1.0, 0.0, 1.0));
+        grid.SetBoundingBox(1, MakeBoundingBox(1.0, 2.0, 0.0, 1.0));
+        grid.SetBoundingBox(2, MakeBoundingBox(0.0, 2.0, 1.0, 2.0));
+        grid.RebuildIfNecessary();
+
+        TS_ASSERT_EQUALS(grid.GetNumRebuilds(), 1u);
+        TS_ASSERT_DELTA(grid.GetBoxWidth(), 4.0/3.0, 1e-12);
+
+        std::vector<unsigned> candidates;
+        c_vector<double, 2> point;
+        point[0] = 0.5;
+        point[1] = 0.5;
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 1u);
+        TS_ASSERT_EQUALS(candidates[0], 0u);
+
+        // Points on the boundary of a bounding box are included
+        point[0] = 1.0;
+        point[1] = 1.0;
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 3u);
+
+        // Points outside the grid have no candidates
+        point[0] = -10.0;
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 0u);
+
+        // Small movements are dealt with without rebuilding the grid
+        grid.SetBoundingBox(0, MakeBoundingBox(0.1, 1.1, 0.0, 1.0));
+        grid.RebuildIfNecessary();
+        TS_ASSERT_EQUALS(grid.GetNumRebuilds(), 1u);
+
+        point[0] = 1.05;
+        point[1] = 0.5;
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 2u);
+        TS_ASSERT(Contains(candidates, 0));
+        TS_ASSERT(Contains(candidates, 1));
+
+        // Removed elements are no longer candidates
+        grid.RemoveElement(1);
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 1u);
+        TS_ASSERT_EQUALS(candidates[0], 0u);
+
+        // Moving an element outside the grid causes it to be rebuilt
+        grid.SetBoundingBox(1, MakeBoundingBox(10.0, 11.0, 0.0, 1.0));
+        grid.RebuildIfNecessary();
+        TS_ASSERT_EQUALS(grid.GetNumRebuilds(), 2u);
+
+        point[0] = 10.5;
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 1u);
+        TS_ASSERT_EQUALS(candidates[0], 1u);
+
+        // Reducing the number of elements removes those with larger indices
+        grid.SetNumElements(1);
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 0u);
+
+        grid.Clear();
+        point[0] = 0.5;
+        grid.GetCandidateElements(point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 0u);
+    }
+};
+
+#endif /*TESTVERTEXELEMENTGRID_HPP_*/
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define _ABSTRACTIVPODESOLVER_HPP_
 
 #include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "ChasteSerialization.hpp"
 #include "ClassIsAbstract.hpp"
@@ -154,6 +155,15 @@ public:
      */
     double GetStoppingTime();
 
+    /**
+     * Create a new solver of the same type and with the same settings as this one, for
+     * use by another thread.  Solvers keep working memory and stopping-event state, so a
+     * single solver must not be used by several threads at once.
+     *
+     * @return the new solver, or an empty pointer if this solver cannot be copied (the default)
+     */
+    virtual boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
+
     /**
      * Constructor.
      */
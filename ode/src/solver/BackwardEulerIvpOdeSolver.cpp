@@ -250,6 +250,16 @@ void BackwardEulerIvpOdeSolver::ForceUseOfNumericalJacobian()
     mForceUseOfNumericalJacobian = true;
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> BackwardEulerIvpOdeSolver::CreateCopyForThread() const
+{
+    boost::shared_ptr<BackwardEulerIvpOdeSolver> p_copy(new BackwardEulerIvpOdeSolver(mSizeOfOdeSystem));
+    p_copy->SetEpsilonForNumericalJacobian(mNumericalJacobianEpsilon);
+    if (mForceUseOfNumericalJacobian)
+    {
+        p_copy->ForceUseOfNumericalJacobian();
+    }
+    return p_copy;
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
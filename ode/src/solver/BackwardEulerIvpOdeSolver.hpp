@@ -213,6 +213,11 @@ public:
      * @return the size of the system
      */
      unsigned GetSystemSize() const {return mSizeOfOdeSystem;};
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -78,7 +78,7 @@ int CvodeRhsAdaptor(realtype t, N_Vector y, N_Vector ydot, void* pData)
     assert(pData != nullptr);
     CvodeData* p_data = (CvodeData*)pData;
     // Get y, ydot into std::vector<>s
-    static std::vector<realtype> ydot_vec;
+    std::vector<realtype>& ydot_vec = p_data->ydot;
     CopyToStdVector(y, *p_data->pY);
     CopyToStdVector(ydot, ydot_vec);
     // Call our function
@@ -570,6 +570,11 @@ void CvodeAdaptor::CheckForStoppingEvents()
     mCheckForRoots = true;
 }
 
+bool CvodeAdaptor::GetCheckForStoppingEvents()
+{
+    return mCheckForRoots;
+}
+
 void CvodeAdaptor::SetMaxSteps(long int numSteps)
 {
     mMaxSteps = numSteps;
@@ -72,6 +72,8 @@ typedef struct CvodeData_
 {
     /** Working memory. */
     std::vector<realtype>* pY;
+    /** Working memory for the derivatives, kept per solver so that solvers may be used on different threads. */
+    std::vector<realtype> ydot;
     /** The ODE system being solved. */
     AbstractOdeSystem* pSystem;
 } CvodeData;
@@ -316,6 +318,11 @@ public:
      */
     void CheckForStoppingEvents();
 
+    /**
+     * @return whether the solver checks for stopping events (see CheckForStoppingEvents()).
+     */
+    bool GetCheckForStoppingEvents();
+
     /**
      * Change the maximum number of steps to be taken by the solver
      * in its attempt to reach the next output time.  Default is 500.
@@ -56,6 +56,10 @@ void EulerIvpOdeSolver::CalculateNextYValue(AbstractOdeSystem* pAbstractOdeSyste
     }
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> EulerIvpOdeSolver::CreateCopyForThread() const
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new EulerIvpOdeSolver);
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
@@ -99,6 +99,11 @@ public:
      */
     virtual ~EulerIvpOdeSolver()
     {}
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -106,6 +106,11 @@ public:
      */
     GRL1IvpOdeSolver()
     {}
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -111,6 +111,11 @@ public:
      */
     GRL2IvpOdeSolver()
     {}
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
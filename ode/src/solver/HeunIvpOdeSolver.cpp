@@ -74,6 +74,10 @@ void HeunIvpOdeSolver::CalculateNextYValue(AbstractOdeSystem* pAbstractOdeSystem
     }
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> HeunIvpOdeSolver::CreateCopyForThread() const
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new HeunIvpOdeSolver);
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
@@ -88,6 +88,11 @@ public:
      */
     HeunIvpOdeSolver()
     {}
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -62,6 +62,10 @@ void MockEulerIvpOdeSolver::InternalSolve(AbstractOdeSystem* pAbstractOdeSystem,
                                      timeStep);
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> MockEulerIvpOdeSolver::CreateCopyForThread() const
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>();
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
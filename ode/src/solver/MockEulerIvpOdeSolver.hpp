@@ -108,6 +108,14 @@ public:
      */
     virtual ~MockEulerIvpOdeSolver()
     {}
+
+    /**
+     * Overridden so that every call is counted by this object: a mock solver is
+     * never copied for use by other threads.
+     *
+     * @return an empty pointer
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -107,6 +107,10 @@ void RKC21IvpOdeSolver::CalculateNextYValue(AbstractOdeSystem* pAbstractOdeSyste
     }
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> RKC21IvpOdeSolver::CreateCopyForThread() const
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new RKC21IvpOdeSolver);
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
@@ -93,6 +93,10 @@ public:
     RKC21IvpOdeSolver()
     {}
 
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -70,6 +70,10 @@ void RungeKutta2IvpOdeSolver::CalculateNextYValue(AbstractOdeSystem* pAbstractOd
     }
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> RungeKutta2IvpOdeSolver::CreateCopyForThread() const
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new RungeKutta2IvpOdeSolver);
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
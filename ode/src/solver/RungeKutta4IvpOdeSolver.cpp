@@ -89,6 +89,10 @@ void RungeKutta4IvpOdeSolver::CalculateNextYValue(AbstractOdeSystem* pAbstractOd
     }
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> RungeKutta4IvpOdeSolver::CreateCopyForThread() const
+{
+    return boost::shared_ptr<AbstractIvpOdeSolver>(new RungeKutta4IvpOdeSolver);
+}
 
 // Serialization for Boost >= 1.36
 #include "SerializationExportWrapperForCpp.hpp"
@@ -88,6 +88,11 @@ private:
     std::vector<double> k3;  /**< Working memory: expression k3 in the RK4 method. */
     std::vector<double> k4;  /**< Working memory: expression k4 in the RK4 method. */
     std::vector<double> yki; /**< Working memory: expression yki in the RK4 method. */
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
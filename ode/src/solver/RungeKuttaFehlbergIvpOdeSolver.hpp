@@ -223,6 +223,11 @@ public:
                double startTime,
                double endTime,
                double timeStep);
+
+    /**
+     * @return a new solver of this type, for use by another thread
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> CreateCopyForThread() const;
 };
 
 #include "SerializationExportWrapper.hpp"
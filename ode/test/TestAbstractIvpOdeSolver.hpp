@@ -602,6 +602,33 @@ public:
         TS_ASSERT_DELTA(testvalue_rk4, exact_solution, global_error_rk4);
     }
 
+    void TestCreateCopyForThread()
+    {
+        EulerIvpOdeSolver euler_solver;
+        RungeKutta2IvpOdeSolver rk2_solver;
+        RungeKutta4IvpOdeSolver rk4_solver;
+        std::vector<AbstractIvpOdeSolver*> solvers;
+        solvers.push_back(&euler_solver);
+        solvers.push_back(&rk2_solver);
+        solvers.push_back(&rk4_solver);
+
+        for (unsigned i=0; i<solvers.size(); i++)
+        {
+            // The copy is a separate solver of the same type...
+            boost::shared_ptr<AbstractIvpOdeSolver> p_copy = solvers[i]->CreateCopyForThread();
+            TS_ASSERT(p_copy);
+            TS_ASSERT_DIFFERS(p_copy.get(), solvers[i]);
+            TS_ASSERT_EQUALS(p_copy->GetIdentifier(), solvers[i]->GetIdentifier());
+
+            // ...which gives identical results
+            Ode1 ode_system;
+            Ode1 ode_system_for_copy;
+            solvers[i]->SolveAndUpdateStateVariable(&ode_system, 0, 1, 0.01);
+            p_copy->SolveAndUpdateStateVariable(&ode_system_for_copy, 0, 1, 0.01);
+            TS_ASSERT_EQUALS(ode_system_for_copy.rGetStateVariables()[0], ode_system.rGetStateVariables()[0]);
+        }
+    }
+
     void TestArchivingSolvers()
     {
         OutputFileHandler handler("archive",false);
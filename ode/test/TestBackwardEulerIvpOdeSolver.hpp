@@ -91,6 +91,16 @@ public:
         TS_ASSERT_DELTA(numerical_solution[0], analytical_solution[0], global_error_euler);
         TS_ASSERT_DELTA(numerical_solution[1], analytical_solution[1], global_error_euler);
         TS_ASSERT_DELTA(numerical_solution[2], analytical_solution[2], global_error_euler);
+
+        // A copy for another thread has the same settings, so gives identical results
+        boost::shared_ptr<AbstractIvpOdeSolver> p_copy = backward_euler_solver.CreateCopyForThread();
+        TS_ASSERT_EQUALS(boost::static_pointer_cast<BackwardEulerIvpOdeSolver>(p_copy)->GetSystemSize(), 3u);
+        std::vector<double> copy_state_variables = ode_system.GetInitialConditions();
+        OdeSolution copy_solutions = p_copy->Solve(&ode_system, copy_state_variables, 0.0, 2.0, h_value, h_value);
+        for (unsigned i=0; i<3; i++)
+        {
+            TS_ASSERT_EQUALS(copy_solutions.rGetSolutions()[last][i], solutions.rGetSolutions()[last][i]);
+        }
     }
 
     void TestBackwardEulerNonlinearEquation()
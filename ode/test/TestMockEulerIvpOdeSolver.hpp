@@ -75,6 +75,9 @@ public:
 
         TS_ASSERT_EQUALS(euler_solver.GetCallCount(), 1U);
 
+        // A mock solver is never copied, so that every call is counted
+        TS_ASSERT(!euler_solver.CreateCopyForThread());
+
         ode_system.SetDefaultInitialCondition(0, 0.0);
 
         state_variables = ode_system.GetInitialConditions();
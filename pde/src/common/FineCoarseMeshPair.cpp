@@ -562,8 +562,8 @@ void FineCoarseMeshPair<DIM>::CollectElementsInContainingBox(DistributedBoxColle
                                                              unsigned boxIndex,
                                                              std::set<unsigned>& rElementIndices)
 {
-    for (typename std::set<Element<DIM,DIM>*>::iterator elem_iter = rpBoxCollection->rGetBox(boxIndex).rGetElementsContained().begin();
-         elem_iter != rpBoxCollection->rGetBox(boxIndex).rGetElementsContained().end();
+    for (typename std::vector<Element<DIM,DIM>*>::const_iterator elem_iter = rpBoxCollection->rGetBox(boxIndex).rGetElementsContainedVector().begin();
+         elem_iter != rpBoxCollection->rGetBox(boxIndex).rGetElementsContainedVector().end();
          ++elem_iter)
     {
         rElementIndices.insert((*elem_iter)->GetIndex());
@@ -580,8 +580,8 @@ void FineCoarseMeshPair<DIM>::CollectElementsInLocalBoxes(DistributedBoxCollecti
          local_box_iter != local_boxes.end();
          ++local_box_iter)
     {
-        for (typename std::set<Element<DIM,DIM>*>::iterator elem_iter = rpBoxCollection->rGetBox(*local_box_iter).rGetElementsContained().begin();
-             elem_iter != rpBoxCollection->rGetBox(*local_box_iter).rGetElementsContained().end();
+        for (typename std::vector<Element<DIM,DIM>*>::const_iterator elem_iter = rpBoxCollection->rGetBox(*local_box_iter).rGetElementsContainedVector().begin();
+             elem_iter != rpBoxCollection->rGetBox(*local_box_iter).rGetElementsContainedVector().end();
              ++elem_iter)
         {
             rElementIndices.insert((*elem_iter)->GetIndex());
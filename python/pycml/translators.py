@@ -1074,14 +1074,25 @@ class CellMLTranslator(object):
         """
         # Don't use table lookups to generate the tables!
         self.use_lookup_tables = False
+        # The separate class gets its (possibly shared) memory from AbstractLookupTableCollection,
+        # which needs to know when each set of tables is complete
+        use_table_memory = getattr(self, 'separate_lut_class', False) and only_index is not None
         # Allocate memory for tables
         for key, idx in self.doc.lookup_table_indexes.iteritems():
             if only_index is None or only_index == idx:
                 min, max, step, _ = self.lut_parameters(key)
                 self.writeln(self.TYPE_CONST_UNSIGNED, '_table_size_', idx, self.EQ_ASSIGN,
                              self.lut_size_calculation(min, max, step), self.STMT_END)
-                self.writeln('_lookup_table_', idx, self.EQ_ASSIGN, 'new double[_table_size_', idx,
-                             '][', self.doc.lookup_tables_num_per_index[idx], ']', self.STMT_END)
+                if use_table_memory:
+                    row_type = 'double (*)[' + self.lut_row_length(idx) + ']'
+                    self.writeln('_lookup_table_', idx, self.EQ_ASSIGN, 'reinterpret_cast<', row_type,
+                                 '>(AllocateTableMemory(', idx, ', _table_size_', idx, ', ',
+                                 self.lut_row_length(idx), '))', self.STMT_END)
+                    self.writeln('if (!IsTableMemoryShared(', idx, '))')
+                    self.open_block()
+                else:
+                    self.writeln('_lookup_table_', idx, self.EQ_ASSIGN, 'new double[_table_size_', idx,
+                                 '][', self.lut_row_length(idx), ']', self.STMT_END)
         # Generate each table in a separate loop
         for expr in self.doc.lookup_tables:
             var = expr.component.get_variable_by_name(expr.var)
@@ -1099,12 +1110,33 @@ class CellMLTranslator(object):
             self.output_expr(expr, False)
             self.writeln(self.STMT_END, indent=False)
             self.close_block()
+        if use_table_memory:
+            self.close_block(blank_line=False)
+            row_type = 'double (*)[' + self.lut_row_length(only_index) + ']'
+            self.writeln('_lookup_table_', only_index, self.EQ_ASSIGN, 'reinterpret_cast<', row_type,
+                         '>(FinaliseTableMemory(', only_index, '))', self.STMT_END)
         self.use_lookup_tables = True
 
+    def lut_row_length(self, idx):
+        """Return the number of doubles in each row of the tables keyed by the given index.
+
+        In a separate lookup table class rows are padded to whole cache lines
+        (see AbstractLookupTableCollection::GetPaddedRowLength).
+        """
+        num_tables = self.doc.lookup_tables_num_per_index[idx]
+        if getattr(self, 'separate_lut_class', False):
+            doubles_per_line = 8
+            num_tables = doubles_per_line * ((num_tables + doubles_per_line - 1) // doubles_per_line)
+        return unicode(num_tables)
+
     def output_lut_deletion(self, only_index=None):
         """Output code to delete memory allocated for lookup tables."""
         for idx in self.doc.lookup_table_indexes.itervalues():
             if only_index is None or only_index == idx:
+                if getattr(self, 'separate_lut_class', False):
+                    self.writeln('FreeTableMemory(', idx, ')', self.STMT_END)
+                    self.writeln('_lookup_table_', idx, self.EQ_ASSIGN, 'NULL', self.STMT_END)
+                    continue
                 self.writeln('if (_lookup_table_', idx, ')')
                 self.open_block()
                 self.writeln('delete[] _lookup_table_', idx, self.STMT_END)
@@ -1116,8 +1148,7 @@ class CellMLTranslator(object):
         self.output_comment('Lookup tables')
         # Allocate memory, per index variable for cache efficiency
         for idx in self.doc.lookup_table_indexes.itervalues():
-            num_tables = unicode(self.doc.lookup_tables_num_per_index[idx])
-            self.writeln(self.TYPE_DOUBLE, '(*_lookup_table_', idx, ')[', num_tables, ']', self.STMT_END)
+            self.writeln(self.TYPE_DOUBLE, '(*_lookup_table_', idx, ')[', self.lut_row_length(idx), ']', self.STMT_END)
         self.writeln()
 
     def output_lut_index_declarations(self, idx):
@@ -2240,6 +2271,7 @@ class CellMLToChasteTranslator(CellMLTranslator):
         self.writeln(self.lt_class_name, '()')
         self.open_block()
         self.writeln('assert(mpInstance.get() == NULL);')
+        self.writeln('mTableCacheIdentifier = "', self.lt_class_name, ' " __DATE__ " " __TIME__;')
         if self.config.options.include_dt_in_tables:
             self.writeln('mDt = HeartConfig::Instance()->GetOdeTimeStep();')
             self.writeln('assert(mDt > 0.0);')